@@ -17,10 +17,13 @@ import sys
 from optparse import OptionParser, OptionGroup
 
 index = 0
+# (string, index) pairs of the reserved keys, in dictionary order
+keystrings = []
 
 
 def harvest_constants(options, path, constants):
     global index
+    global keystrings
     # open the file
     try:
         inputfile = open(path, "r")
@@ -73,6 +76,7 @@ def harvest_constants(options, path, constants):
                         constants.write(",\n\n")
                     firstline = False
                     constants.write("    {.index = " + str(index) + ", .name = \"" + tokens[0] + "\", .string = " + tokens[1])
+                    keystrings.append((tokens[1].strip('"'), index))
                     index = index + 1
                     # only one attribute violates the one-word rule for type
                     if tokens[0] == "PMIX_EVENT_BASE":
@@ -239,7 +243,82 @@ def harvest_constants(options, path, constants):
     return 0
 
 
-def _write_header(options, base_path, num_elements):
+def _phash(seed, key):
+    # 32-bit FNV-1a with the offset basis perturbed by the seed - this
+    # must match PMIX_HASH_FNV1A in src/include/pmix_hash_string.h
+    h = (0x811c9dc5 ^ seed) & 0xffffffff
+    for c in key.encode():
+        h ^= c
+        h = (h * 0x01000193) & 0xffffffff
+    return h
+
+
+def construct_phash():
+    # Build a minimal perfect hash over the reserved key strings using
+    # the "hash, displace" method: keys are first spread across buckets
+    # using seed zero, and then each bucket is assigned the first seed
+    # that maps all of its members into unused slots. Buckets holding a
+    # single key are placed directly into a remaining free slot, which
+    # is flagged by storing a negative displacement. Lookups therefore
+    # cost at most two hashes plus one strcmp to confirm the match.
+    #
+    # Some strings appear more than once in the dictionary (e.g., when
+    # a deprecated name was retained for an existing string) - we
+    # always resolve to the first index to mirror a linear scan
+    unique = {}
+    for (key, idx) in keystrings:
+        if key not in unique:
+            unique[key] = idx
+    size = len(unique)
+    buckets = [[] for _ in range(size)]
+    for key in unique:
+        buckets[_phash(0, key) % size].append(key)
+    displace = [0] * size
+    slots = [None] * size
+    for bucket in sorted(buckets, key=len, reverse=True):
+        if len(bucket) < 2:
+            break
+        seed = 1
+        n = 0
+        taken = []
+        while n < len(bucket):
+            slot = _phash(seed, bucket[n]) % size
+            if slots[slot] is not None or slot in taken:
+                seed += 1
+                n = 0
+                taken = []
+            else:
+                taken.append(slot)
+                n += 1
+        displace[_phash(0, bucket[0]) % size] = seed
+        for n in range(len(bucket)):
+            slots[taken[n]] = unique[bucket[n]]
+    free = [n for n in range(size) if slots[n] is None]
+    for bucket in buckets:
+        if len(bucket) != 1:
+            continue
+        slot = free.pop()
+        displace[_phash(0, bucket[0]) % size] = -slot - 1
+        slots[slot] = unique[bucket[0]]
+    return displace, slots
+
+
+def _write_phash(constants, displace, slots):
+    constants.write("const int32_t pmix_dictionary_phash_displace[] = {")
+    for n in range(len(displace)):
+        if 0 == n % 10:
+            constants.write("\n   ")
+        constants.write(" " + str(displace[n]) + ",")
+    constants.write("\n};\n\n")
+    constants.write("const uint32_t pmix_dictionary_phash_index[] = {")
+    for n in range(len(slots)):
+        if 0 == n % 10:
+            constants.write("\n   ")
+        constants.write(" " + str(slots[n]) + ",")
+    constants.write("\n};\n")
+
+
+def _write_header(options, base_path, num_elements, phash_size):
     contents = '''/*
  * This file is autogenerated by construct_dictionary.py.
  * Do not edit this file by hand.
@@ -258,10 +337,23 @@ PMIX_EXPORT extern const pmix_regattr_input_t pmix_dictionary[{ne}];
 
 #define PMIX_INDEX_BOUNDARY {nem1}
 
+/* Minimal perfect hash over the reserved key strings. Hash the
+ * key with seed zero and take it modulo PMIX_DICTIONARY_PHASH_SIZE
+ * to obtain its displacement. A negative displacement "d" directly
+ * identifies slot (-d - 1), while a positive displacement is the
+ * seed with which to rehash the key to find its slot. The slot
+ * holds the dictionary index of the candidate key, which must be
+ * confirmed by comparing strings as unreserved keys will also
+ * hash to some slot */
+#define PMIX_DICTIONARY_PHASH_SIZE {phs}
+
+PMIX_EXPORT extern const int32_t pmix_dictionary_phash_displace[{phs}];
+PMIX_EXPORT extern const uint32_t pmix_dictionary_phash_index[{phs}];
+
 END_C_DECLS
 
 #endif\n
-'''.format(ne=num_elements, nem1=num_elements - 1)
+'''.format(ne=num_elements, nem1=num_elements - 1, phs=phash_size)
 
     if options.dryrun:
         constants = sys.stdout
@@ -368,10 +460,14 @@ const pmix_regattr_input_t pmix_dictionary[] = {
 };
 """)
     constants.write("\n")
+
+    # add the perfect hash tables used to lookup reserved keys
+    displace, slots = construct_phash()
+    _write_phash(constants, displace, slots)
     constants.close()
 
     # write the header
-    return _write_header(options, build_src_include_dir, index + 1)
+    return _write_header(options, build_src_include_dir, index + 1, len(slots))
 
 
 if __name__ == '__main__':
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Prefetch the data posted by the other procs in the job and retrieve
+ * it while it is still in transit, then do the same for a proc that
+ * cannot be found - the gets must still complete, with an error.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pmix.h>
+
+#include "examples.h"
+
+static pmix_proc_t myproc;
+
+static void opcbfunc(pmix_status_t status, void *cbdata)
+{
+    mylock_t *lock = (mylock_t *) cbdata;
+
+    lock->status = status;
+    DEBUG_WAKEUP_THREAD(lock);
+}
+
+static void valcbfunc(pmix_status_t status, pmix_value_t *val, void *cbdata)
+{
+    mylock_t *lock = (mylock_t *) cbdata;
+
+    lock->status = status;
+    if (PMIX_SUCCESS == status && NULL != val && PMIX_STRING == val->type) {
+        lock->answer = strdup(val->data.string);
+    }
+    DEBUG_WAKEUP_THREAD(lock);
+}
+
+int main(int argc, char **argv)
+{
+    pmix_status_t rc;
+    pmix_value_t value;
+    pmix_value_t *val = NULL;
+    pmix_proc_t proc, *peers = NULL;
+    pmix_info_t info;
+    mylock_t pflock, *locks = NULL;
+    char *keys[] = {"prefetch-key", NULL};
+    char tmp[1024];
+    uint32_t nprocs, n, npeers = 0;
+    int tlimit = 5;
+    int exit_code = 0;
+
+    EXAMPLES_HIDE_UNUSED_PARAMS(argc, argv);
+
+    /* init us */
+    if (PMIX_SUCCESS != (rc = PMIx_Init(&myproc, NULL, 0))) {
+        fprintf(stderr, "Client ns %s rank %d: PMIx_Init failed: %s\n", myproc.nspace,
+                myproc.rank, PMIx_Error_string(rc));
+        exit(0);
+    }
+
+    /* get our job size */
+    PMIX_LOAD_PROCID(&proc, myproc.nspace, PMIX_RANK_WILDCARD);
+    if (PMIX_SUCCESS != (rc = PMIx_Get(&proc, PMIX_JOB_SIZE, NULL, 0, &val))) {
+        fprintf(stderr, "Client ns %s rank %d: PMIx_Get job size failed: %s\n", myproc.nspace,
+                myproc.rank, PMIx_Error_string(rc));
+        exit_code = 1;
+        goto done;
+    }
+    nprocs = val->data.uint32;
+    PMIX_VALUE_RELEASE(val);
+
+    /* post our data and make it available - the fence does not
+     * collect it, so the others must ask for it */
+    (void) snprintf(tmp, 1024, "%s-%u", myproc.nspace, myproc.rank);
+    value.type = PMIX_STRING;
+    value.data.string = tmp;
+    if (PMIX_SUCCESS != (rc = PMIx_Put(PMIX_GLOBAL, keys[0], &value))) {
+        fprintf(stderr, "Client ns %s rank %d: PMIx_Put failed: %s\n", myproc.nspace,
+                myproc.rank, PMIx_Error_string(rc));
+        exit_code = 1;
+        goto done;
+    }
+    if (PMIX_SUCCESS != (rc = PMIx_Commit())) {
+        fprintf(stderr, "Client ns %s rank %d: PMIx_Commit failed: %s\n", myproc.nspace,
+                myproc.rank, PMIx_Error_string(rc));
+        exit_code = 1;
+        goto done;
+    }
+    if (PMIX_SUCCESS != (rc = PMIx_Fence(NULL, 0, NULL, 0))) {
+        fprintf(stderr, "Client ns %s rank %d: PMIx_Fence failed: %s\n", myproc.nspace,
+                myproc.rank, PMIx_Error_string(rc));
+        exit_code = 1;
+        goto done;
+    }
+
+    PMIX_INFO_LOAD(&info, PMIX_TIMEOUT, &tlimit, PMIX_INT);
+
+    /* prefetch everyone else's data, asking for each of them
+     * while the data is still on its way */
+    npeers = nprocs - 1;
+    if (0 < npeers) {
+        PMIX_PROC_CREATE(peers, npeers);
+        locks = (mylock_t *) malloc(npeers * sizeof(mylock_t));
+        for (n = 0; n < npeers; n++) {
+            PMIX_LOAD_PROCID(&peers[n], myproc.nspace, (n < myproc.rank) ? n : n + 1);
+            DEBUG_CONSTRUCT_LOCK(&locks[n]);
+        }
+        DEBUG_CONSTRUCT_LOCK(&pflock);
+        rc = PMIx_Prefetch_nb(peers, npeers, keys, NULL, 0, opcbfunc, &pflock);
+        if (PMIX_SUCCESS != rc) {
+            fprintf(stderr, "Client ns %s rank %d: PMIx_Prefetch_nb failed: %s\n",
+                    myproc.nspace, myproc.rank, PMIx_Error_string(rc));
+            DEBUG_DESTRUCT_LOCK(&pflock);
+            exit_code = 1;
+            goto cleanup;
+        }
+        for (n = 0; n < npeers; n++) {
+            rc = PMIx_Get_nb(&peers[n], keys[0], &info, 1, valcbfunc, &locks[n]);
+            if (PMIX_SUCCESS != rc) {
+                locks[n].status = rc;
+                locks[n].active = false;
+            }
+        }
+        DEBUG_WAIT_THREAD(&pflock);
+        if (PMIX_SUCCESS != pflock.status) {
+            fprintf(stderr, "Client ns %s rank %d: prefetch returned %s\n", myproc.nspace,
+                    myproc.rank, PMIx_Error_string(pflock.status));
+            exit_code = 1;
+        }
+        DEBUG_DESTRUCT_LOCK(&pflock);
+        for (n = 0; n < npeers; n++) {
+            DEBUG_WAIT_THREAD(&locks[n]);
+            (void) snprintf(tmp, 1024, "%s-%u", peers[n].nspace, peers[n].rank);
+            if (PMIX_SUCCESS != locks[n].status) {
+                fprintf(stderr, "Client ns %s rank %d: PMIx_Get_nb for %u failed: %s\n",
+                        myproc.nspace, myproc.rank, peers[n].rank,
+                        PMIx_Error_string(locks[n].status));
+                exit_code = 1;
+            } else if (NULL == locks[n].answer || 0 != strcmp(tmp, locks[n].answer)) {
+                fprintf(stderr, "Client ns %s rank %d: PMIx_Get_nb for %u returned %s\n",
+                        myproc.nspace, myproc.rank, peers[n].rank,
+                        (NULL == locks[n].answer) ? "NULL" : locks[n].answer);
+                exit_code = 1;
+            }
+            DEBUG_DESTRUCT_LOCK(&locks[n]);
+        }
+        free(locks);
+        locks = NULL;
+    }
+
+    /* prefetch a proc that cannot be found - the server is told not
+     * to look for it, so the prefetch fails. A get made meanwhile
+     * carries no such directive and is then passed on to the server
+     * in its own right, and must complete within its timeout */
+    PMIX_LOAD_PROCID(&proc, "prefetch.missing", 0);
+    DEBUG_CONSTRUCT_LOCK(&pflock);
+    PMIX_INFO_LOAD(&info, PMIX_IMMEDIATE, NULL, PMIX_BOOL);
+    rc = PMIx_Prefetch_nb(&proc, 1, keys, &info, 1, opcbfunc, &pflock);
+    PMIX_INFO_DESTRUCT(&info);
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "Client ns %s rank %d: PMIx_Prefetch_nb failed: %s\n", myproc.nspace,
+                myproc.rank, PMIx_Error_string(rc));
+        DEBUG_DESTRUCT_LOCK(&pflock);
+        exit_code = 1;
+        goto cleanup;
+    }
+    locks = (mylock_t *) malloc(sizeof(mylock_t));
+    DEBUG_CONSTRUCT_LOCK(&locks[0]);
+    PMIX_INFO_LOAD(&info, PMIX_TIMEOUT, &tlimit, PMIX_INT);
+    rc = PMIx_Get_nb(&proc, keys[0], &info, 1, valcbfunc, &locks[0]);
+    if (PMIX_SUCCESS != rc) {
+        locks[0].status = rc;
+        locks[0].active = false;
+    }
+    DEBUG_WAIT_THREAD(&pflock);
+    if (PMIX_SUCCESS == pflock.status) {
+        fprintf(stderr, "Client ns %s rank %d: prefetch of a missing proc succeeded\n",
+                myproc.nspace, myproc.rank);
+        exit_code = 1;
+    }
+    DEBUG_DESTRUCT_LOCK(&pflock);
+    DEBUG_WAIT_THREAD(&locks[0]);
+    if (PMIX_SUCCESS == locks[0].status) {
+        fprintf(stderr, "Client ns %s rank %d: PMIx_Get_nb of a missing proc succeeded\n",
+                myproc.nspace, myproc.rank);
+        exit_code = 1;
+    }
+    DEBUG_DESTRUCT_LOCK(&locks[0]);
+
+    if (0 == exit_code && 0 == myproc.rank) {
+        fprintf(stderr, "Client ns %s rank %d: prefetch of %u procs completed\n", myproc.nspace,
+                myproc.rank, npeers);
+    }
+
+cleanup:
+    if (NULL != locks) {
+        free(locks);
+    }
+    if (NULL != peers) {
+        PMIX_PROC_FREE(peers, npeers);
+    }
+
+done:
+    /* call fence so everyone waits before leaving */
+    if (PMIX_SUCCESS != (rc = PMIx_Fence(NULL, 0, NULL, 0))) {
+        fprintf(stderr, "Client ns %s rank %d: PMIx_Fence failed: %s\n", myproc.nspace,
+                myproc.rank, PMIx_Error_string(rc));
+        exit_code = 1;
+    }
+
+    if (PMIX_SUCCESS != (rc = PMIx_Finalize(NULL, 0))) {
+        fprintf(stderr, "Client ns %s rank %d: PMIx_Finalize failed: %s\n", myproc.nspace,
+                myproc.rank, PMIx_Error_string(rc));
+        exit_code = 1;
+    }
+    fflush(stderr);
+    return exit_code;
+}
@@ -215,6 +215,28 @@ PMIX_EXPORT pmix_status_t PMIx_Get_nb(const pmix_proc_t *proc, const char key[],
                                       const pmix_info_t info[], size_t ninfo,
                                       pmix_value_cbfunc_t cbfunc, void *cbdata);
 
+/* Ask the local server for the data posted by each of the given procs
+ * so that subsequent calls to PMIx_Get for those procs can be satisfied
+ * locally. The request is sent to the server as a single message, and
+ * the data for each proc is stored in the local cache as soon as the
+ * server has it - calls to PMIx_Get for a proc whose data is still in
+ * transit will wait for it rather than generating another request. Such
+ * a call still honors its own PMIX_TIMEOUT, and is sent to the server
+ * with its own directives if the prefetch fails for that proc.
+ *
+ * The optional NULL-terminated _keys_ array names the keys the caller
+ * intends to retrieve - procs for which all of those keys are already
+ * available locally are not requested. The info array is passed to the
+ * server with the request for each proc as described for PMIx_Get.
+ *
+ * The callback function will be executed once data (or an error) has
+ * been returned for every requested proc. The status will be the first
+ * error returned for any of the procs, or PMIX_SUCCESS. */
+PMIX_EXPORT pmix_status_t PMIx_Prefetch_nb(const pmix_proc_t procs[], size_t nprocs,
+                                           char **keys,
+                                           const pmix_info_t info[], size_t ninfo,
+                                           pmix_op_cbfunc_t cbfunc, void *cbdata);
+
 
 /* Publish the data in the info array for lookup. By default,
  * the data will be published into the PMIX_SESSION range and
@@ -145,6 +145,29 @@ typedef pmix_status_t (*pmix_server_dmodex_req_fn_t)(const pmix_proc_t *proc,
                                                      const pmix_info_t info[], size_t ninfo,
                                                      pmix_modex_cbfunc_t cbfunc, void *cbdata);
 
+/* Callback function for returning the direct modex blob of one of
+ * the procs included in a batched direct modex request. The host
+ * must execute the callback once for each proc in the request, in
+ * any order, passing the same cbdata each time */
+typedef void (*pmix_dmodex_batch_cbfunc_t)(pmix_status_t status, const pmix_proc_t *proc,
+                                           const char *data, size_t ndata, void *cbdata,
+                                           pmix_release_cbfunc_t release_fn,
+                                           void *release_cbdata);
+
+/* Used by the PMIx server to request that its local host obtain the
+ * direct modex blobs for an array of procs in a single operation.
+ * The PMIx server collects requests for remote data over a short
+ * window and passes them up together, grouped by nspace, when the
+ * host provides this entry - otherwise, each proc is requested
+ * individually using the direct_modex entry.
+ *
+ * The procs and info arrays remain valid until the callback has
+ * been executed for every proc in the request. */
+typedef pmix_status_t (*pmix_server_dmodex_batch_fn_t)(const pmix_proc_t procs[], size_t nprocs,
+                                                       const pmix_info_t info[], size_t ninfo,
+                                                       pmix_dmodex_batch_cbfunc_t cbfunc,
+                                                       void *cbdata);
+
 
 /* Publish data per the PMIx API specification. The callback is to be executed
  * upon completion of the operation. The default data range is expected to be
@@ -577,6 +600,7 @@ typedef struct pmix_server_module_4_0_0_t {
     pmix_server_client_connected2_fn_t  client_connected2;
     /* v5x interfaces */
     pmix_server_session_control_fn_t    session_control;
+    pmix_server_dmodex_batch_fn_t       direct_modex_batch;
 } pmix_server_module_t;
 
 /****    HOST RM FUNCTIONS FOR INTERFACE TO PMIX SERVER    ****/
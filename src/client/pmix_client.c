@@ -209,6 +209,9 @@ pmix_client_globals_t pmix_client_globals = {
     .myserver = NULL,
     .singleton = false,
     .pending_requests = PMIX_LIST_STATIC_INIT,
+    .prefetches = PMIX_LIST_STATIC_INIT,
+    .prefetch_index = PMIX_HASH_TABLE_STATIC_INIT,
+    .prefetch_id = 0,
     .peers = PMIX_POINTER_ARRAY_STATIC_INIT,
     .get_output = -1,
     .get_verbose = 0,
@@ -601,6 +604,11 @@ PMIX_EXPORT pmix_status_t PMIx_Init(pmix_proc_t *proc, pmix_info_t info[], size_
     rcv->cbfunc = client_iof_handler;
     /* add it to the end of the list of recvs */
     pmix_list_append(&pmix_ptl_base.posted_recvs, &rcv->super);
+    /* setup the recv for streamed prefetch data */
+    rcv = PMIX_NEW(pmix_ptl_posted_recv_t);
+    rcv->tag = PMIX_PTL_TAG_PREFETCH;
+    rcv->cbfunc = pmix_client_prefetch_recv;
+    pmix_list_append(&pmix_ptl_base.posted_recvs, &rcv->super);
     /* create the default iof handler */
     iofreq = PMIX_NEW(pmix_iof_req_t);
     iofreq->channels = PMIX_FWD_STDOUT_CHANNEL | PMIX_FWD_STDERR_CHANNEL | PMIX_FWD_STDDIAG_CHANNEL;
@@ -613,6 +621,9 @@ PMIX_EXPORT pmix_status_t PMIx_Init(pmix_proc_t *proc, pmix_info_t info[], size_
 
     /* setup the globals */
     PMIX_CONSTRUCT(&pmix_client_globals.pending_requests, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_client_globals.prefetches, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_client_globals.prefetch_index, pmix_hash_table_t);
+    pmix_hash_table_init(&pmix_client_globals.prefetch_index, 256);
     PMIX_CONSTRUCT(&pmix_client_globals.peers, pmix_pointer_array_t);
     pmix_pointer_array_init(&pmix_client_globals.peers, 1, INT_MAX, 1);
     pmix_client_globals.myserver = PMIX_NEW(pmix_peer_t);
@@ -1064,6 +1075,8 @@ PMIX_EXPORT pmix_status_t PMIx_Finalize(const pmix_info_t info[], size_t ninfo)
     pmix_iof_static_dump_output(&pmix_client_globals.iof_stderr);
 
     PMIX_LIST_DESTRUCT(&pmix_client_globals.pending_requests);
+    PMIX_LIST_DESTRUCT(&pmix_client_globals.prefetches);
+    PMIX_DESTRUCT(&pmix_client_globals.prefetch_index);
     for (i = 0; i < pmix_client_globals.peers.size; i++) {
         if (NULL
             != (peer = (pmix_peer_t *) pmix_pointer_array_get_item(&pmix_client_globals.peers,
@@ -74,6 +74,12 @@ static pmix_status_t process_values(pmix_cb_t *cb);
 
 static pmix_status_t refresh_cache(void);
 
+static void resolve_pending(const pmix_proc_t *p, pmix_status_t ret);
+
+static void *prefetch_lookup(const pmix_proc_t *proc);
+
+static void prefetch_wait(void *ptr, pmix_cb_t *cb);
+
 static pmix_status_t process_request(const pmix_proc_t *proc, const char key[],
                                      const pmix_info_t info[], size_t ninfo,
                                      pmix_get_logic_t *lg, pmix_value_t **val)
@@ -518,11 +524,8 @@ static void _getnb_cbfunc(struct pmix_peer_t *pr, pmix_ptl_hdr_t *hdr,
                           pmix_buffer_t *buf, void *cbdata)
 {
     pmix_cb_t *cb = (pmix_cb_t *) cbdata;
-    pmix_cb_t *cb2;
     pmix_status_t rc, ret = PMIX_ERR_NOT_FOUND;
-    pmix_value_t *val = NULL;
     int32_t cnt;
-    pmix_kval_t *kv;
     pmix_get_logic_t *lg;
 
     PMIX_ACQUIRE_OBJECT(cb);
@@ -571,13 +574,30 @@ static void _getnb_cbfunc(struct pmix_peer_t *pr, pmix_ptl_hdr_t *hdr,
 
 done:
     /* now search any pending requests (including the one this was in
-     * response to) to see if they can be met. Note that this function
-     * will only be called if the user requested a specific key - we
-     * don't support calls to "get" for a NULL key */
+     * response to) to see if they can be met */
+    resolve_pending(&lg->p, ret);
+}
+
+/* complete any pending requests for data from the given proc now
+ * that the server has responded. Note that this function will only
+ * be called if the user requested a specific key - we don't support
+ * calls to "get" for a NULL key */
+static void resolve_pending(const pmix_proc_t *p, pmix_status_t ret)
+{
+    pmix_cb_t *cb, *cb2;
+    pmix_status_t rc;
+    pmix_value_t *val = NULL;
+    pmix_kval_t *kv;
+    pmix_proc_t proc;
+
+    /* take a copy of the proc ID as it may belong to
+     * one of the requests we are about to complete */
+    PMIX_LOAD_PROCID(&proc, p->nspace, p->rank);
+
     pmix_output_verbose(2, pmix_client_globals.get_output,
                         "pmix: get_nb looking for requested key");
     PMIX_LIST_FOREACH_SAFE (cb, cb2, &pmix_client_globals.pending_requests, pmix_cb_t) {
-        if (PMIX_CHECK_NSPACE(lg->p.nspace, cb->pname.nspace) && cb->pname.rank == lg->p.rank) {
+        if (PMIX_CHECK_NSPACE(proc.nspace, cb->pname.nspace) && cb->pname.rank == proc.rank) {
             pmix_list_remove_item(&pmix_client_globals.pending_requests, &cb->super);
             if (PMIX_SUCCESS != ret) {
                 if (cb->checked) {
@@ -589,7 +609,7 @@ done:
                 continue;
             }
             /* we have the data for this proc - see if we can find the key */
-            cb->proc = &lg->p;
+            cb->proc = &proc;
             cb->scope = PMIX_SCOPE_UNDEF;
             pmix_output_verbose(2, pmix_client_globals.get_output,
                                 "pmix: get_nb searching for key %s for rank %s", cb->key,
@@ -693,6 +713,7 @@ static void get_data(int sd, short args, void *cbdata)
     pmix_info_t optional, *iptr;
     size_t nfo, n;
     pmix_kval_t *kv;
+    void *pf;
     PMIX_HIDE_UNUSED_PARAMS(sd, args);
 
     PMIX_ACQUIRE_OBJECT(cb);
@@ -1052,6 +1073,18 @@ doget:
         goto done;
     }
 
+    /* if the data for this proc is already on its way as part of
+     * a prefetch, then just wait for it to arrive - unless they
+     * want the host asked for a fresh copy */
+    if (proc.rank == lg->p.rank && !lg->refresh_cache &&
+        NULL != (pf = prefetch_lookup(&proc))) {
+        pmix_output_verbose(2, pmix_client_globals.get_output,
+                            "%s WAITING FOR PREFETCHED DATA FOR %s",
+                            PMIX_NAME_PRINT(&pmix_globals.myid), PMIX_NAME_PRINT(&proc));
+        prefetch_wait(pf, cb);
+        return;
+    }
+
     /* see if we already have a request in place with the server for data from
      * this nspace:rank. If we do, then no need to ask again as the
      * request will return _all_ data from that proc */
@@ -1175,3 +1208,517 @@ static pmix_status_t refresh_cache(void)
     PMIX_DESTRUCT(&cb);
     return rc;
 }
+
+/* tracks a prefetch request. Procs whose data is still in transit
+ * are held in the prefetch index so that a get for one of them
+ * can wait for the data instead of asking the server again */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_event_t ev;
+    uint32_t id;
+    pmix_proc_t *procs;
+    size_t nprocs;
+    char **keys;
+    pmix_info_t *info;
+    size_t ninfo;
+    size_t nremaining;  // number of procs still awaiting data
+    pmix_list_t waiting; // gets waiting for data still in transit
+    pmix_status_t status;
+    pmix_op_cbfunc_t cbfunc;
+    void *cbdata;
+} pmix_prefetch_t;
+static void pfcon(pmix_prefetch_t *p)
+{
+    p->id = 0;
+    p->procs = NULL;
+    p->nprocs = 0;
+    p->keys = NULL;
+    p->info = NULL;
+    p->ninfo = 0;
+    p->nremaining = 0;
+    PMIX_CONSTRUCT(&p->waiting, pmix_list_t);
+    p->status = PMIX_SUCCESS;
+    p->cbfunc = NULL;
+    p->cbdata = NULL;
+}
+static void pfdes(pmix_prefetch_t *p)
+{
+    if (NULL != p->procs) {
+        PMIX_PROC_FREE(p->procs, p->nprocs);
+    }
+    if (NULL != p->keys) {
+        PMIx_Argv_free(p->keys);
+    }
+    if (NULL != p->info) {
+        PMIX_INFO_FREE(p->info, p->ninfo);
+    }
+    PMIX_LIST_DESTRUCT(&p->waiting);
+}
+static PMIX_CLASS_INSTANCE(pmix_prefetch_t, pmix_list_item_t, pfcon, pfdes);
+
+static size_t prefetch_key(const pmix_proc_t *proc, char *key)
+{
+    size_t len;
+
+    len = strnlen(proc->nspace, PMIX_MAX_NSLEN);
+    memcpy(key, proc->nspace, len);
+    memcpy(key + len, &proc->rank, sizeof(pmix_rank_t));
+    return len + sizeof(pmix_rank_t);
+}
+
+static void *prefetch_lookup(const pmix_proc_t *proc)
+{
+    char key[PMIX_MAX_NSLEN + sizeof(pmix_rank_t)];
+    size_t len;
+    void *ptr;
+
+    len = prefetch_key(proc, key);
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&pmix_client_globals.prefetch_index,
+                                                      key, len, &ptr)) {
+        return NULL;
+    }
+    return ptr;
+}
+
+static void prefetch_complete_get(pmix_cb_t *cb, pmix_status_t status)
+{
+    if (cb->checked) {
+        cb->status = status;
+        gcbfn(0, 0, cb);
+    } else {
+        cb->cbfunc.valuefn(status, NULL, cb->cbdata);
+    }
+}
+
+/* a get waiting for prefetched data ran out of time */
+static void prefetch_get_timeout(int sd, short args, void *cbdata)
+{
+    pmix_cb_t *cb = (pmix_cb_t *) cbdata;
+    pmix_prefetch_t *pf;
+    pmix_proc_t proc;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    cb->timer_running = false;
+    PMIX_LOAD_PROCID(&proc, cb->pname.nspace, cb->pname.rank);
+    pf = (pmix_prefetch_t *) prefetch_lookup(&proc);
+    if (NULL != pf) {
+        pmix_list_remove_item(&pf->waiting, &cb->super);
+    }
+    pmix_output_verbose(2, pmix_client_globals.get_output,
+                        "pmix: get for %s timed out waiting for prefetched data",
+                        PMIX_NAME_PRINT(&proc));
+    prefetch_complete_get(cb, PMIX_ERR_TIMEOUT);
+}
+
+/* hold a get until the prefetched data for its proc arrives,
+ * honoring any timeout the caller gave */
+static void prefetch_wait(void *ptr, pmix_cb_t *cb)
+{
+    pmix_prefetch_t *pf = (pmix_prefetch_t *) ptr;
+    struct timeval tv = {0, 0};
+    size_t n;
+
+    for (n = 0; n < cb->ninfo; n++) {
+        if (PMIX_CHECK_KEY(&cb->info[n], PMIX_TIMEOUT)) {
+            tv.tv_sec = cb->info[n].value.data.uint32;
+            break;
+        }
+    }
+    if (0 < tv.tv_sec) {
+        pmix_event_evtimer_set(pmix_globals.evbase, &cb->ev, prefetch_get_timeout, cb);
+        pmix_event_evtimer_add(&cb->ev, &tv);
+        cb->timer_running = true;
+    }
+    pmix_list_append(&pf->waiting, &cb->super);
+}
+
+/* the prefetch could not get the data for the proc a get was
+ * waiting on, so ask the server for it using the get's own
+ * directives - the host may be able to do better for those */
+static void prefetch_reissue(pmix_cb_t *cb)
+{
+    pmix_buffer_t *msg;
+    pmix_cb_t *cbret;
+    pmix_status_t rc;
+
+    cb->proc = &cb->lg->p;
+    PMIX_LIST_FOREACH (cbret, &pmix_client_globals.pending_requests, pmix_cb_t) {
+        if (PMIX_CHECK_NAMES(&cbret->pname, &cb->pname)) {
+            /* another get for this proc was already reissued */
+            pmix_list_append(&pmix_client_globals.pending_requests, &cb->super);
+            return;
+        }
+    }
+
+    msg = _pack_get(cb, cb->pname.rank, PMIX_GETNB_CMD);
+    if (NULL == msg) {
+        PMIX_ERROR_LOG(PMIX_ERROR);
+        prefetch_complete_get(cb, PMIX_ERROR);
+        return;
+    }
+    pmix_output_verbose(2, pmix_client_globals.get_output,
+                        "%s REISSUING REQUEST FOR %s:%s KEY %s",
+                        PMIX_NAME_PRINT(&pmix_globals.myid), cb->pname.nspace,
+                        PMIX_RANK_PRINT(cb->pname.rank), cb->key);
+    pmix_list_append(&pmix_client_globals.pending_requests, &cb->super);
+    PMIX_PTL_SEND_RECV(rc, pmix_client_globals.myserver, msg, _getnb_cbfunc, (void *) cb);
+    if (PMIX_SUCCESS != rc) {
+        pmix_list_remove_item(&pmix_client_globals.pending_requests, &cb->super);
+        prefetch_complete_get(cb, PMIX_ERROR);
+    }
+}
+
+/* account for the arrival of the data (or an error) for one
+ * of the procs in a prefetch */
+static void prefetch_proc_done(pmix_prefetch_t *pf, const pmix_proc_t *proc,
+                               pmix_status_t status)
+{
+    char key[PMIX_MAX_NSLEN + sizeof(pmix_rank_t)];
+    pmix_cb_t *cb, *cbnext;
+    pmix_list_t waiting;
+    size_t len;
+
+    if (prefetch_lookup(proc) != pf) {
+        /* not one of ours, or already accounted for */
+        return;
+    }
+    len = prefetch_key(proc, key);
+    pmix_hash_table_remove_value_ptr(&pmix_client_globals.prefetch_index, key, len);
+
+    /* collect the gets that were waiting for this proc */
+    PMIX_CONSTRUCT(&waiting, pmix_list_t);
+    PMIX_LIST_FOREACH_SAFE (cb, cbnext, &pf->waiting, pmix_cb_t) {
+        if (PMIX_CHECK_NSPACE(proc->nspace, cb->pname.nspace) && cb->pname.rank == proc->rank) {
+            pmix_list_remove_item(&pf->waiting, &cb->super);
+            if (cb->timer_running) {
+                pmix_event_del(&cb->ev);
+                cb->timer_running = false;
+            }
+            pmix_list_append(&waiting, &cb->super);
+        }
+    }
+    if (PMIX_SUCCESS == status || PMIX_ERR_LOST_CONNECTION == status) {
+        /* they can now be answered from the cache - or
+         * there is nobody left to ask */
+        while (NULL != (cb = (pmix_cb_t *) pmix_list_remove_first(&waiting))) {
+            pmix_list_append(&pmix_client_globals.pending_requests, &cb->super);
+        }
+        resolve_pending(proc, status);
+    } else {
+        while (NULL != (cb = (pmix_cb_t *) pmix_list_remove_first(&waiting))) {
+            prefetch_reissue(cb);
+        }
+    }
+    PMIX_DESTRUCT(&waiting);
+
+    if (PMIX_SUCCESS != status && PMIX_SUCCESS == pf->status) {
+        pf->status = status;
+    }
+    --pf->nremaining;
+    if (0 == pf->nremaining) {
+        pmix_list_remove_item(&pmix_client_globals.prefetches, &pf->super);
+        if (NULL != pf->cbfunc) {
+            pf->cbfunc(pf->status, pf->cbdata);
+        }
+        PMIX_RELEASE(pf);
+    }
+}
+
+/* fail all procs of a prefetch that are still awaiting data */
+static void prefetch_abort(pmix_prefetch_t *pf, pmix_status_t status)
+{
+    size_t n;
+
+    PMIX_RETAIN(pf);
+    for (n = 0; n < pf->nprocs; n++) {
+        prefetch_proc_done(pf, &pf->procs[n], status);
+    }
+    PMIX_RELEASE(pf);
+}
+
+/* check if all the given keys for a proc are already available */
+static bool prefetch_have_keys(pmix_proc_t *proc, char **keys)
+{
+    pmix_cb_t cb;
+    pmix_info_t optional;
+    pmix_status_t rc;
+    size_t n;
+
+    PMIX_INFO_LOAD(&optional, PMIX_OPTIONAL, NULL, PMIX_BOOL);
+    for (n = 0; NULL != keys[n]; n++) {
+        PMIX_CONSTRUCT(&cb, pmix_cb_t);
+        cb.proc = proc;
+        cb.key = keys[n];
+        cb.info = &optional;
+        cb.ninfo = 1;
+        PMIX_GDS_FETCH_KV(rc, pmix_client_globals.myserver, &cb);
+        if (PMIX_SUCCESS != rc && PMIX_OPERATION_SUCCEEDED != rc &&
+            !PMIX_GDS_CHECK_COMPONENT(pmix_client_globals.myserver, "hash")) {
+            PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
+        }
+        cb.key = NULL;
+        cb.info = NULL;
+        cb.ninfo = 0;
+        PMIX_DESTRUCT(&cb);
+        if (PMIX_SUCCESS != rc && PMIX_OPERATION_SUCCEEDED != rc) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* the server acknowledges receipt of the prefetch request - the
+ * data itself is streamed back on the prefetch tag */
+static void prefetch_ackcb(struct pmix_peer_t *pr, pmix_ptl_hdr_t *hdr,
+                           pmix_buffer_t *buf, void *cbdata)
+{
+    pmix_prefetch_t *pf = (pmix_prefetch_t *) cbdata;
+    pmix_status_t rc, ret;
+    int32_t cnt;
+
+    PMIX_ACQUIRE_OBJECT(pf);
+    PMIX_HIDE_UNUSED_PARAMS(pr, hdr);
+
+    /* a lost connection is reported to all prefetches
+     * by the prefetch recv, so nothing to do here */
+    if (!PMIX_BUFFER_IS_EMPTY(buf)) {
+        cnt = 1;
+        PMIX_BFROPS_UNPACK(rc, pmix_client_globals.myserver, buf, &ret, &cnt, PMIX_STATUS);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            ret = rc;
+        }
+        if (PMIX_SUCCESS != ret) {
+            /* the server did not accept the request */
+            pmix_output_verbose(2, pmix_client_globals.get_output,
+                                "pmix: prefetch %u rejected by server: %s",
+                                pf->id, PMIx_Error_string(ret));
+            prefetch_abort(pf, ret);
+        }
+    }
+    PMIX_RELEASE(pf);
+}
+
+void pmix_client_prefetch_recv(struct pmix_peer_t *peer, pmix_ptl_hdr_t *hdr,
+                               pmix_buffer_t *buf, void *cbdata)
+{
+    pmix_prefetch_t *pf, *pfnext;
+    pmix_status_t rc, ret;
+    pmix_proc_t proc;
+    uint32_t id;
+    int32_t cnt;
+
+    PMIX_HIDE_UNUSED_PARAMS(peer, hdr, cbdata);
+
+    /* a zero-byte buffer indicates that this recv is being
+     * completed due to a lost connection */
+    if (PMIX_BUFFER_IS_EMPTY(buf)) {
+        PMIX_LIST_FOREACH_SAFE (pf, pfnext, &pmix_client_globals.prefetches, pmix_prefetch_t) {
+            prefetch_abort(pf, PMIX_ERR_LOST_CONNECTION);
+        }
+        return;
+    }
+
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, pmix_client_globals.myserver, buf, &id, &cnt, PMIX_UINT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return;
+    }
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, pmix_client_globals.myserver, buf, &proc, &cnt, PMIX_PROC);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return;
+    }
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, pmix_client_globals.myserver, buf, &ret, &cnt, PMIX_STATUS);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        ret = rc;
+    }
+
+    pmix_output_verbose(2, pmix_client_globals.get_output,
+                        "pmix: prefetch %u recvd data for %s: %s",
+                        id, PMIX_NAME_PRINT(&proc), PMIx_Error_string(ret));
+
+    if (PMIX_SUCCESS == ret) {
+        /* store it just as we would the response to a get */
+        PMIX_GDS_ACCEPT_KVS_RESP(rc, pmix_globals.mypeer, buf);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            ret = rc;
+        }
+    }
+
+    PMIX_LIST_FOREACH (pf, &pmix_client_globals.prefetches, pmix_prefetch_t) {
+        if (pf->id == id) {
+            prefetch_proc_done(pf, &proc, ret);
+            return;
+        }
+    }
+}
+
+static void prefetch_data(int sd, short args, void *cbdata)
+{
+    pmix_prefetch_t *pf = (pmix_prefetch_t *) cbdata;
+    char key[PMIX_MAX_NSLEN + sizeof(pmix_rank_t)];
+    pmix_buffer_t *msg;
+    pmix_cmd_t cmd = PMIX_PREFETCH_CMD;
+    pmix_proc_t *procs;
+    pmix_cb_t *cb;
+    pmix_status_t rc;
+    size_t n, nreq, len;
+    bool pending;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    PMIX_ACQUIRE_OBJECT(pf);
+
+    /* only request the procs whose data we neither
+     * have nor are already waiting for */
+    PMIX_PROC_CREATE(procs, pf->nprocs);
+    nreq = 0;
+    for (n = 0; n < pf->nprocs; n++) {
+        if (NULL != prefetch_lookup(&pf->procs[n])) {
+            continue;
+        }
+        pending = false;
+        PMIX_LIST_FOREACH (cb, &pmix_client_globals.pending_requests, pmix_cb_t) {
+            if (PMIX_CHECK_NSPACE(pf->procs[n].nspace, cb->pname.nspace) &&
+                pf->procs[n].rank == cb->pname.rank) {
+                pending = true;
+                break;
+            }
+        }
+        if (pending) {
+            continue;
+        }
+        if (NULL != pf->keys && prefetch_have_keys(&pf->procs[n], pf->keys)) {
+            continue;
+        }
+        PMIX_LOAD_PROCID(&procs[nreq], pf->procs[n].nspace, pf->procs[n].rank);
+        len = prefetch_key(&procs[nreq], key);
+        pmix_hash_table_set_value_ptr(&pmix_client_globals.prefetch_index, key, len, pf);
+        ++nreq;
+    }
+    PMIX_PROC_FREE(pf->procs, pf->nprocs);
+    pf->procs = procs;
+    pf->nprocs = nreq;
+    pf->nremaining = nreq;
+
+    pmix_output_verbose(2, pmix_client_globals.get_output,
+                        "%s REQUESTING PREFETCH OF %lu PROCS FROM SERVER",
+                        PMIX_NAME_PRINT(&pmix_globals.myid), (unsigned long) nreq);
+
+    if (0 == nreq) {
+        /* nothing to do */
+        if (NULL != pf->cbfunc) {
+            pf->cbfunc(PMIX_SUCCESS, pf->cbdata);
+        }
+        PMIX_RELEASE(pf);
+        return;
+    }
+
+    pf->id = pmix_client_globals.prefetch_id++;
+    pmix_list_append(&pmix_client_globals.prefetches, &pf->super);
+
+    msg = PMIX_NEW(pmix_buffer_t);
+    PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msg, &cmd, 1, PMIX_COMMAND);
+    if (PMIX_SUCCESS != rc) {
+        goto error;
+    }
+    PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msg, &pf->id, 1, PMIX_UINT32);
+    if (PMIX_SUCCESS != rc) {
+        goto error;
+    }
+    PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msg, &pf->nprocs, 1, PMIX_SIZE);
+    if (PMIX_SUCCESS != rc) {
+        goto error;
+    }
+    PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msg, pf->procs, pf->nprocs, PMIX_PROC);
+    if (PMIX_SUCCESS != rc) {
+        goto error;
+    }
+    PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msg, &pf->ninfo, 1, PMIX_SIZE);
+    if (PMIX_SUCCESS != rc) {
+        goto error;
+    }
+    if (0 < pf->ninfo) {
+        PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msg, pf->info, pf->ninfo, PMIX_INFO);
+        if (PMIX_SUCCESS != rc) {
+            goto error;
+        }
+    }
+
+    /* hold the tracker until the server acknowledges the request */
+    PMIX_RETAIN(pf);
+    PMIX_PTL_SEND_RECV(rc, pmix_client_globals.myserver, msg, prefetch_ackcb, (void *) pf);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_RELEASE(pf);
+        goto error;
+    }
+    return;
+
+error:
+    PMIX_ERROR_LOG(rc);
+    PMIX_RELEASE(msg);
+    prefetch_abort(pf, rc);
+}
+
+PMIX_EXPORT pmix_status_t PMIx_Prefetch_nb(const pmix_proc_t procs[], size_t nprocs,
+                                           char **keys,
+                                           const pmix_info_t info[], size_t ninfo,
+                                           pmix_op_cbfunc_t cbfunc, void *cbdata)
+{
+    pmix_prefetch_t *pf;
+    size_t n;
+
+    PMIX_ACQUIRE_THREAD(&pmix_global_lock);
+
+    if (pmix_globals.init_cntr <= 0) {
+        PMIX_RELEASE_THREAD(&pmix_global_lock);
+        return PMIX_ERR_INIT;
+    }
+
+    /* if we aren't connected, there is nobody to ask */
+    if (PMIX_PEER_IS_SERVER(pmix_globals.mypeer) || !pmix_globals.connected) {
+        PMIX_RELEASE_THREAD(&pmix_global_lock);
+        return PMIX_ERR_UNREACH;
+    }
+    PMIX_RELEASE_THREAD(&pmix_global_lock);
+
+    if (NULL == procs || 0 == nprocs) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+
+    pmix_output_verbose(2, pmix_client_globals.get_output,
+                        "pmix:client prefetch for %lu procs", (unsigned long) nprocs);
+
+    pf = PMIX_NEW(pmix_prefetch_t);
+    PMIX_PROC_CREATE(pf->procs, nprocs);
+    if (NULL == pf->procs) {
+        PMIX_RELEASE(pf);
+        return PMIX_ERR_NOMEM;
+    }
+    pf->nprocs = nprocs;
+    for (n = 0; n < nprocs; n++) {
+        PMIX_LOAD_PROCID(&pf->procs[n], procs[n].nspace, procs[n].rank);
+    }
+    if (NULL != keys && NULL != keys[0]) {
+        pf->keys = PMIx_Argv_copy(keys);
+    }
+    if (0 < ninfo) {
+        pf->ninfo = ninfo;
+        PMIX_INFO_CREATE(pf->info, pf->ninfo);
+        for (n = 0; n < ninfo; n++) {
+            PMIX_INFO_XFER(&pf->info[n], &info[n]);
+        }
+    }
+    pf->cbfunc = cbfunc;
+    pf->cbdata = cbdata;
+
+    /* MUST threadshift here to avoid touching global
+     * data while in the user's thread */
+    PMIX_THREADSHIFT(pf, prefetch_data);
+    return PMIX_SUCCESS;
+}
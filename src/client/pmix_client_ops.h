@@ -13,6 +13,7 @@
 
 #include "src/include/pmix_config.h"
 
+#include "src/class/pmix_hash_table.h"
 #include "src/class/pmix_list.h"
 #include "src/class/pmix_pointer_array.h"
 #include "src/common/pmix_iof.h"
@@ -25,6 +26,9 @@ typedef struct {
     pmix_peer_t *myserver;        // messaging support to/from my server
     bool singleton;               // no server
     pmix_list_t pending_requests; // list of pmix_cb_t pending data requests
+    pmix_list_t prefetches;       // list of active prefetch requests
+    pmix_hash_table_t prefetch_index; // procs with prefetched data in transit
+    uint32_t prefetch_id;         // id of the next prefetch request
     pmix_pointer_array_t peers;   // array of pmix_peer_t cached for data ops
     // verbosity for client get operations
     int get_output;
@@ -57,6 +61,9 @@ typedef struct {
 
 PMIX_EXPORT extern pmix_client_globals_t pmix_client_globals;
 
+PMIX_EXPORT void pmix_client_prefetch_recv(struct pmix_peer_t *peer, pmix_ptl_hdr_t *hdr,
+                                           pmix_buffer_t *buf, void *cbdata);
+
 END_C_DECLS
 
 #endif /* PMIX_CLIENT_OPS_H */
@@ -1061,12 +1061,25 @@ pmix_status_t pmix_iof_process_iof(pmix_iof_channel_t channels, const pmix_proc_
     return PMIX_OPERATION_SUCCEEDED;
 }
 
+/* point an output at a range of bytes held in a shared chunk */
+static void output_ref(pmix_iof_write_output_t *output, pmix_iof_chunk_t *chunk,
+                       char *data, size_t size)
+{
+    PMIX_RETAIN(chunk);
+    output->chunk = chunk;
+    output->data = data;
+    output->numbytes = size;
+}
+
+/* if chunk is not NULL, then the bytes in bo lie within it and
+ * are referenced rather than copied */
 static pmix_status_t write_output_line(const pmix_proc_t *name,
                                        pmix_iof_write_event_t *channel,
                                        pmix_iof_flags_t *myflags,
                                        pmix_iof_channel_t stream,
                                        bool copystdout, bool copystderr,
-                                       const pmix_byte_object_t *bo)
+                                       const pmix_byte_object_t *bo,
+                                       pmix_iof_chunk_t *chunk)
 {
     char starttag[PMIX_IOF_BASE_TAG_MAX], endtag[PMIX_IOF_BASE_TAG_MAX], *suffix;
     char timestamp[PMIX_IOF_BASE_TAG_MAX], outtag[PMIX_IOF_BASE_TAG_MAX];
@@ -1101,6 +1114,10 @@ static pmix_status_t write_output_line(const pmix_proc_t *name,
              * the zero bytes so the fd can be closed
              * after it writes everything out
              */
+            if (NULL != chunk) {
+                output_ref(output, chunk, bo->bytes, bo->size);
+                goto process;
+            }
             output->data = (char*)malloc(bo->size);
             memcpy(output->data, bo->bytes, bo->size);
         }
@@ -1132,9 +1149,13 @@ static pmix_status_t write_output_line(const pmix_proc_t *name,
     }
 
     if (!myflags->set) {
-        /* the data is not to be tagged - just copy it
-         * and move on to processing
+        /* the data is not to be tagged - just reference or
+         * copy it and move on to processing
          */
+        if (NULL != chunk) {
+            output_ref(output, chunk, bo->bytes, bo->size);
+            goto process;
+        }
         output->data = (char*)malloc(bo->size);
         memcpy(output->data, bo->bytes, bo->size);
         output->numbytes = bo->size;
@@ -1443,24 +1464,26 @@ static pmix_status_t write_output_line(const pmix_proc_t *name,
 
 process:
     /* add this data to the write list for this fd */
-    pmix_list_append(&channel->outputs, &output->super);
+    PMIX_IOF_SINK_QUEUE(channel, output);
 
+    if ((copystdout || copystderr) && NULL == output->chunk && 0 < output->numbytes) {
+        /* share the output bytes with the copies */
+        output->chunk = PMIX_NEW(pmix_iof_chunk_t);
+        output->chunk->bo.bytes = output->data;
+        output->chunk->bo.size = output->numbytes;
+    }
     if (copystdout){
         copy = PMIX_NEW(pmix_iof_write_output_t);
-        copy->data = (char *) malloc(output->numbytes);
-        memcpy(copy->data, output->data, output->numbytes);
-        copy->numbytes = output->numbytes;
-        pmix_list_append(&pmix_client_globals.iof_stdout.wev.outputs, &copy->super);
+        output_ref(copy, output->chunk, output->data, output->numbytes);
+        PMIX_IOF_SINK_QUEUE(&pmix_client_globals.iof_stdout.wev, copy);
         if (!pmix_client_globals.iof_stdout.wev.pending) {
             PMIX_IOF_SINK_ACTIVATE(&pmix_client_globals.iof_stdout.wev);
         }
     }
     if (copystderr){
         copy = PMIX_NEW(pmix_iof_write_output_t);
-        copy->data = (char *) malloc(output->numbytes);
-        memcpy(copy->data, output->data, output->numbytes);
-        copy->numbytes = output->numbytes;
-        pmix_list_append(&pmix_client_globals.iof_stderr.wev.outputs, &copy->super);
+        output_ref(copy, output->chunk, output->data, output->numbytes);
+        PMIX_IOF_SINK_QUEUE(&pmix_client_globals.iof_stderr.wev, copy);
         if (!pmix_client_globals.iof_stderr.wev.pending) {
             PMIX_IOF_SINK_ACTIVATE(&pmix_client_globals.iof_stderr.wev);
         }
@@ -1478,8 +1501,10 @@ process:
     return PMIX_SUCCESS;
 }
 
-pmix_status_t pmix_iof_write_output(const pmix_proc_t *name, pmix_iof_channel_t stream,
-                                    const pmix_byte_object_t *bo)
+/* if chunk is not NULL, then bo is the chunk's data and the
+ * lines written out of it are referenced rather than copied */
+static pmix_status_t iof_write_output(const pmix_proc_t *name, pmix_iof_channel_t stream,
+                                      const pmix_byte_object_t *bo, pmix_iof_chunk_t *chunk)
 {
     pmix_status_t rc;
     size_t n, start;
@@ -1494,7 +1519,7 @@ pmix_status_t pmix_iof_write_output(const pmix_proc_t *name, pmix_iof_channel_t
     pmix_iof_residual_t *res;
     char *inputdata;
     size_t inputsize;
-    bool copied;
+    pmix_iof_chunk_t *lines;
 
     /* stdin doesn't come thru here*/
     if (PMIX_FWD_STDIN_CHANNEL & stream) {
@@ -1606,28 +1631,41 @@ pmix_status_t pmix_iof_write_output(const pmix_proc_t *name, pmix_iof_channel_t
     /* zero bytes can just be passed along */
     if (0 == bo->size) {
         rc = write_output_line(name, channel, &myflags, stream,
-                               false, false, bo);
+                               false, false, bo, NULL);
         return rc;
     }
 
     /* see if we have some residual for this name/stream */
-    inputdata = bo->bytes;
-    inputsize = bo->size;
-    copied = false;
+    lines = NULL;
     PMIX_LIST_FOREACH(res, &pmix_server_globals.iof_residuals, pmix_iof_residual_t) {
         if (PMIX_CHECK_PROCID(name, &res->name) || (stream & res->stream)) {
             /* we need to pre-pend the residual data to the new
              * data so any lines can be completed */
-            inputdata = (char*)malloc(inputsize + res->bo.size);
-            memcpy(inputdata, res->bo.bytes, res->bo.size);
-            memcpy(&inputdata[res->bo.size], bo->bytes, bo->size);
-            inputsize += res->bo.size;
-            copied = true;
+            lines = PMIX_NEW(pmix_iof_chunk_t);
+            lines->bo.size = res->bo.size + bo->size;
+            lines->bo.bytes = (char*)malloc(lines->bo.size);
+            memcpy(lines->bo.bytes, res->bo.bytes, res->bo.size);
+            memcpy(&lines->bo.bytes[res->bo.size], bo->bytes, bo->size);
             pmix_list_remove_item(&pmix_server_globals.iof_residuals, &res->super);
             PMIX_RELEASE(res);
             break;
         }
     }
+    if (NULL == lines) {
+        if (NULL != chunk) {
+            PMIX_RETAIN(chunk);
+            lines = chunk;
+        } else {
+            /* take a single copy of the caller's data that
+             * all the lines can then share */
+            lines = PMIX_NEW(pmix_iof_chunk_t);
+            lines->bo.bytes = (char*)malloc(bo->size);
+            memcpy(lines->bo.bytes, bo->bytes, bo->size);
+            lines->bo.size = bo->size;
+        }
+    }
+    inputdata = lines->bo.bytes;
+    inputsize = lines->bo.size;
 
     /* search the input data stream for '\n' */
     start = 0;
@@ -1636,11 +1674,9 @@ pmix_status_t pmix_iof_write_output(const pmix_proc_t *name, pmix_iof_channel_t
             bopass.bytes = &inputdata[start];
             bopass.size = n - start + 1;
             rc = write_output_line(name, channel, &myflags, stream,
-                                   copystdout, copystderr, &bopass);
+                                   copystdout, copystderr, &bopass, lines);
             if (PMIX_SUCCESS != rc) {
-                if (copied) {
-                    free(inputdata);
-                }
+                PMIX_RELEASE(lines);
                 return rc;
             }
             start = n + 1;
@@ -1652,11 +1688,9 @@ pmix_status_t pmix_iof_write_output(const pmix_proc_t *name, pmix_iof_channel_t
             bopass.bytes = &inputdata[start];
             bopass.size = inputsize - start;
             rc = write_output_line(name, channel, &myflags, stream,
-                                   copystdout, copystderr, &bopass);
+                                   copystdout, copystderr, &bopass, lines);
             if (PMIX_SUCCESS != rc) {
-                if (copied) {
-                    free(inputdata);
-                }
+                PMIX_RELEASE(lines);
                 return rc;
             }
         } else {
@@ -1675,12 +1709,16 @@ pmix_status_t pmix_iof_write_output(const pmix_proc_t *name, pmix_iof_channel_t
             pmix_list_append(&pmix_server_globals.iof_residuals, &res->super);
         }
     }
-    if (copied) {
-        free(inputdata);
-    }
+    PMIX_RELEASE(lines);
     return PMIX_SUCCESS;
 }
 
+pmix_status_t pmix_iof_write_output(const pmix_proc_t *name, pmix_iof_channel_t stream,
+                                    const pmix_byte_object_t *bo)
+{
+    return iof_write_output(name, stream, bo, NULL);
+}
+
 void pmix_iof_flush_residuals(void)
 {
     pmix_status_t rc;
@@ -1688,7 +1726,7 @@ void pmix_iof_flush_residuals(void)
 
     PMIX_LIST_FOREACH(res, &pmix_server_globals.iof_residuals, pmix_iof_residual_t) {
         rc = write_output_line(&res->name, res->channel, &res->flags,
-                               res->stream, res->copystdout, res->copystderr, &res->bo);
+                               res->stream, res->copystdout, res->copystderr, &res->bo, NULL);
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
             return;
@@ -1716,16 +1754,32 @@ void pmix_iof_static_dump_output(pmix_iof_sink_t *sink)
             }
             PMIX_RELEASE(output);
         }
+        wev->backlog = 0;
     }
 }
 
+static void report_sink_stats(pmix_iof_write_event_t *wev)
+{
+    pmix_output_verbose(2, pmix_client_globals.iof_output,
+                        "%s iof: fd %d wrote %" PRIu64 " bytes in %" PRIu64
+                        " writes (%" PRIu64 " bytes/write) backlog %lu max backlog %lu",
+                        PMIX_NAME_PRINT(&pmix_globals.myid), wev->fd,
+                        wev->nbytes, wev->nwrites,
+                        (0 == wev->nwrites) ? (uint64_t) 0 : wev->nbytes / wev->nwrites,
+                        (unsigned long) wev->backlog, (unsigned long) wev->backlog_hwm);
+}
+
 void pmix_iof_write_handler(int sd, short args, void *cbdata)
 {
     pmix_iof_sink_t *sink = (pmix_iof_sink_t *) cbdata;
     pmix_iof_write_event_t *wev = &sink->wev;
+    struct iovec iov[PMIX_IOF_SINK_MAX_IOV];
     pmix_list_item_t *item;
     pmix_iof_write_output_t *output;
-    int num_written, total_written = 0;
+    ssize_t num_written;
+    size_t gathered, remaining;
+    int iovcnt;
+    bool close_fd;
     PMIX_HIDE_UNUSED_PARAMS(sd, args);
 
     PMIX_ACQUIRE_OBJECT(sink);
@@ -1734,26 +1788,55 @@ void pmix_iof_write_handler(int sd, short args, void *cbdata)
                          "%s write:handler writing data to %d",
                          PMIX_NAME_PRINT(&pmix_globals.myid), wev->fd);
 
-    while (NULL != (item = pmix_list_remove_first(&wev->outputs))) {
-        output = (pmix_iof_write_output_t *) item;
-        if (0 == output->numbytes) {
+    while (!pmix_list_is_empty(&wev->outputs)) {
+        /* gather as many queued outputs as we can into a single
+         * writev, stopping at a zero-byte output as that marks
+         * the end of the channel */
+        iovcnt = 0;
+        gathered = 0;
+        close_fd = false;
+        PMIX_LIST_FOREACH (output, &wev->outputs, pmix_iof_write_output_t) {
+            if (0 == output->numbytes) {
+                close_fd = (0 == iovcnt);
+                break;
+            }
+            iov[iovcnt].iov_base = output->data;
+            iov[iovcnt].iov_len = output->numbytes;
+            gathered += output->numbytes;
+            ++iovcnt;
+            if (PMIX_IOF_SINK_MAX_IOV == iovcnt) {
+                break;
+            }
+            /* If this is a regular file it will never tell us it will block
+             * Write no more than PMIX_IOF_SINK_BLOCKSIZE at a time to allow
+             * other fds to progress
+             */
+            if (wev->always_writable && PMIX_IOF_SINK_BLOCKSIZE <= gathered) {
+                break;
+            }
+        }
+        if (close_fd) {
             /* don't reactivate the event */
-            PMIX_RELEASE(output);
+            item = pmix_list_remove_first(&wev->outputs);
+            PMIX_RELEASE(item);
+            report_sink_stats(wev);
             if (2 < wev->fd) {  // close the channel
                 close(wev->fd);
                 wev->fd = -1;
             }
+            wev->pending = false;
+            PMIX_POST_OBJECT(wev);
             return;
         }
-        num_written = write(wev->fd, output->data, output->numbytes);
+
+        num_written = writev(wev->fd, iov, iovcnt);
         if (num_written < 0) {
             if (EAGAIN == errno || EINTR == errno) {
-                /* push this item back on the front of the list */
-                pmix_list_prepend(&wev->outputs, item);
                 /* if the list is getting too large, abort */
                 if (pmix_globals.output_limit < pmix_list_get_size(&wev->outputs)) {
                     pmix_output(0, "IO Forwarding is running too far behind - something is "
-                                   "blocking us from writing");
+                                   "blocking us from writing (%lu bytes backlogged)",
+                                   (unsigned long) wev->backlog);
                     goto ABORT;
                 }
                 /* leave the write event running so it will call us again
@@ -1771,36 +1854,54 @@ void pmix_iof_write_handler(int sd, short args, void *cbdata)
             /* otherwise, something bad happened so all we can do is abort
              * this attempt
              */
+            item = pmix_list_remove_first(&wev->outputs);
+            output = (pmix_iof_write_output_t *) item;
+            wev->backlog -= output->numbytes;
             PMIX_RELEASE(output);
             goto ABORT;
-        } else if (num_written < output->numbytes) {
-            /* incomplete write - adjust data to avoid duplicate output */
-            memmove(output->data, &output->data[num_written], output->numbytes - num_written);
-            /* adjust the number of bytes remaining to be written */
-            output->numbytes -= num_written;
-            /* push this item back on the front of the list */
-            pmix_list_prepend(&wev->outputs, item);
-            /* if the list is getting too large, abort */
+        }
+        wev->numtries = 0;
+        wev->nwrites++;
+        wev->nbytes += num_written;
+        wev->backlog -= num_written;
+
+        /* release everything that was completely written */
+        remaining = (size_t) num_written;
+        while (0 < remaining) {
+            output = (pmix_iof_write_output_t *) pmix_list_get_first(&wev->outputs);
+            if (remaining < (size_t) output->numbytes) {
+                /* incomplete write - adjust data to avoid duplicate output. Shared
+                 * chunks may be referenced by other outputs, so just step past
+                 * what was written */
+                if (NULL != output->chunk) {
+                    output->data += remaining;
+                } else {
+                    memmove(output->data, &output->data[remaining], output->numbytes - remaining);
+                }
+                /* adjust the number of bytes remaining to be written */
+                output->numbytes -= remaining;
+                break;
+            }
+            remaining -= output->numbytes;
+            item = pmix_list_remove_first(&wev->outputs);
+            PMIX_RELEASE(item);
+        }
+
+        if ((size_t) num_written < gathered) {
+            /* the fd is full - if the list is getting too large, abort */
             if (pmix_globals.output_limit < pmix_list_get_size(&wev->outputs)) {
                 pmix_output(0, "IO Forwarding is running too far behind - something is blocking us "
-                               "from writing");
+                               "from writing (%lu bytes backlogged)",
+                               (unsigned long) wev->backlog);
                 goto ABORT;
             }
             /* leave the write event running so it will call us again
              * when the fd is ready
              */
-            wev->numtries = 0;
             goto NEXT_CALL;
         }
-        PMIX_RELEASE(output);
-        wev->numtries = 0;
-
-        total_written += num_written;
-        if (wev->always_writable && (PMIX_IOF_SINK_BLOCKSIZE <= total_written)) {
-            /* If this is a regular file it will never tell us it will block
-             * Write no more than PMIX_IOF_SINK_BLOCKSIZE at a time to allow
-             * other fds to progress
-             */
+        if (wev->always_writable && PMIX_IOF_SINK_BLOCKSIZE <= gathered
+            && !pmix_list_is_empty(&wev->outputs)) {
             goto NEXT_CALL;
         }
     }
@@ -1879,24 +1980,99 @@ static void iof_stdin_cbfunc(struct pmix_peer_t *peer, pmix_ptl_hdr_t *hdr,
 
 static void opcbfn(pmix_status_t status, void *cbdata)
 {
-    pmix_byte_object_t *boptr = (pmix_byte_object_t *) cbdata;
+    pmix_iof_chunk_t *chunk = (pmix_iof_chunk_t *) cbdata;
     PMIX_HIDE_UNUSED_PARAMS(status);
 
-    PMIX_ACQUIRE_OBJECT(boptr);
-    PMIX_BYTE_OBJECT_FREE(boptr, 1);
+    PMIX_ACQUIRE_OBJECT(chunk);
+    PMIX_RELEASE(chunk);
 }
 
+#if defined(HAVE_SPLICE)
+/* if the output of this child goes only to an undecorated file sink
+ * that has nothing queued, then return that sink so the data can be
+ * spliced straight into it from the child's pipe without passing
+ * through our memory. Otherwise return NULL and let the data take
+ * the normal path */
+static pmix_iof_write_event_t *splice_sink(pmix_iof_read_event_t *rev)
+{
+    pmix_namespace_t *nptr, *ns;
+    pmix_iof_flags_t *flags;
+    pmix_iof_sink_t *sink;
+    pmix_iof_residual_t *res;
+    pmix_iof_write_event_t *channel;
+
+    nptr = NULL;
+    PMIX_LIST_FOREACH (ns, &pmix_globals.nspaces, pmix_namespace_t) {
+        if (0 == strcmp(ns->nspace, rev->name.nspace)) {
+            nptr = ns;
+            break;
+        }
+    }
+    if (NULL == nptr || !nptr->iof_flags.set) {
+        return NULL;
+    }
+    flags = &nptr->iof_flags;
+    if (NULL == flags->file && NULL == flags->directory) {
+        return NULL;
+    }
+    /* anything that decorates or copies the output needs the bytes */
+    if (flags->tag || flags->tag_detailed || flags->tag_fullname || flags->rank ||
+        flags->timestamp || flags->xml) {
+        return NULL;
+    }
+    if (flags->local_output_given && !flags->local_output) {
+        return NULL;
+    }
+    if (!flags->nocopy && pmix_globals.iof_flags.local_output) {
+        return NULL;
+    }
+    /* merged streams are written a line at a time */
+    if (flags->merge && !flags->raw) {
+        return NULL;
+    }
+    /* a partial line must be completed before we can move on */
+    PMIX_LIST_FOREACH (res, &pmix_server_globals.iof_residuals, pmix_iof_residual_t) {
+        if (PMIX_CHECK_PROCID(&rev->name, &res->name) && (rev->channel & res->stream)) {
+            return NULL;
+        }
+    }
+
+    channel = NULL;
+    PMIX_LIST_FOREACH (sink, &nptr->sinks, pmix_iof_sink_t) {
+        if (sink->name.rank == rev->name.rank &&
+            ((rev->channel & sink->tag) || flags->merge)) {
+            channel = &sink->wev;
+            break;
+        }
+    }
+    if (NULL == channel) {
+        channel = pmix_iof_setup(nptr, rev->name.rank, rev->channel);
+        if (NULL == channel) {
+            return NULL;
+        }
+    }
+    /* only files, and only once everything already queued is out */
+    if (!channel->always_writable || !pmix_list_is_empty(&channel->outputs)) {
+        return NULL;
+    }
+    return channel;
+}
+#endif
+
 /* this is the read handler for stdin */
 void pmix_iof_read_local_handler(int sd, short args, void *cbdata)
 {
     pmix_iof_read_event_t *rev = (pmix_iof_read_event_t *) cbdata;
-    unsigned char data[PMIX_IOF_BASE_MSG_MAX];
-    int32_t numbytes;
+    ssize_t numbytes;
     pmix_status_t rc;
     pmix_buffer_t *msg;
     pmix_cmd_t cmd = PMIX_IOF_PUSH_CMD;
-    pmix_byte_object_t bo, *boptr;
+    pmix_iof_chunk_t *chunk;
+    char *bytes;
     int fd;
+#if defined(HAVE_SPLICE)
+    pmix_iof_write_event_t *channel;
+#endif
     pmix_pfexec_child_t *child = (pmix_pfexec_child_t *) rev->childproc;
     PMIX_HIDE_UNUSED_PARAMS(sd, args);
 
@@ -1907,19 +2083,62 @@ void pmix_iof_read_local_handler(int sd, short args, void *cbdata)
     } else {
         fd = rev->fd;
     }
-    /* read up to the fragment size */
-    memset(data, 0, PMIX_IOF_BASE_MSG_MAX);
-    numbytes = read(fd, data, sizeof(data));
 
     /* The event has fired, so it's no longer active until we
      re-add it */
     rev->active = false;
 
+#if defined(HAVE_SPLICE)
+    if (pmix_globals.iof_splice && !rev->nosplice && NULL != child &&
+        (PMIX_FWD_STDOUT_CHANNEL == rev->channel ||
+         PMIX_FWD_STDERR_CHANNEL == rev->channel) &&
+        NULL != (channel = splice_sink(rev))) {
+        numbytes = splice(fd, NULL, channel->fd, NULL, rev->rdsize,
+                          SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+        if (0 < numbytes) {
+            channel->nwrites++;
+            channel->nbytes += numbytes;
+            PMIX_IOF_READ_ACTIVATE(rev);
+            return;
+        }
+        if (numbytes < 0) {
+            if (EAGAIN == errno || EINTR == errno) {
+                PMIX_IOF_READ_ACTIVATE(rev);
+                return;
+            }
+            /* these fds cannot be spliced - don't try again */
+            pmix_output_verbose(2, pmix_client_globals.iof_output,
+                                "%s iof:read handler cannot splice %s: %s",
+                                PMIX_NAME_PRINT(&pmix_globals.myid),
+                                PMIx_IOF_channel_string(rev->channel), strerror(errno));
+            rev->nosplice = true;
+        }
+        /* fall thru so the read sees the EOF or retrieves the data */
+    }
+#endif
+
+    /* read directly into a chunk that can be shared by everyone we
+     * deliver the data to. Grow the read size while the fd keeps
+     * filling it, and shrink it back when it doesn't */
+    chunk = PMIX_NEW(pmix_iof_chunk_t);
+    chunk->bo.bytes = (char *) malloc(rev->rdsize);
+    numbytes = read(fd, chunk->bo.bytes, rev->rdsize);
+
+    /* the chunk may be held until every sink has written it, so
+     * don't let a short read pin a mostly empty buffer */
+    if (0 < numbytes && (size_t) numbytes < rev->rdsize / 2) {
+        bytes = (char *) realloc(chunk->bo.bytes, numbytes);
+        if (NULL != bytes) {
+            chunk->bo.bytes = bytes;
+        }
+    }
+
     if (numbytes < 0) {
         /* either we have a connection error or it was a non-blocking read */
 
         /* non-blocking, retry */
         if (EAGAIN == errno || EINTR == errno) {
+            PMIX_RELEASE(chunk);
             PMIX_IOF_READ_ACTIVATE(rev);
             return;
         }
@@ -1929,25 +2148,34 @@ void pmix_iof_read_local_handler(int sd, short args, void *cbdata)
                              PMIX_NAME_PRINT(&pmix_globals.myid),
                              PMIx_IOF_channel_string(rev->channel));
         /* Un-recoverable error */
-        bo.bytes = NULL;
-        bo.size = 0;
         numbytes = 0;
-    } else {
-        bo.bytes = (char *) data;
-        bo.size = numbytes;
+    } else if ((size_t) numbytes == rev->rdsize) {
+        if (rev->rdsize < PMIX_IOF_READ_MAX) {
+            rev->rdsize *= 2;
+        }
+    } else if ((size_t) numbytes < rev->rdsize / 4 && PMIX_IOF_BASE_MSG_MAX < rev->rdsize) {
+        rev->rdsize /= 2;
     }
+    if (0 == numbytes) {
+        free(chunk->bo.bytes);
+        chunk->bo.bytes = NULL;
+    }
+    chunk->bo.size = numbytes;
 
     /* if this is stdout or stderr of a child, then just output it */
     if (NULL != child &&
         (PMIX_FWD_STDOUT_CHANNEL == rev->channel ||
          PMIX_FWD_STDERR_CHANNEL == rev->channel)) {
         if (PMIX_FWD_STDOUT_CHANNEL == rev->channel) {
-            rc = pmix_iof_write_output(&child->stdoutev->name, PMIX_FWD_STDOUT_CHANNEL, &bo);
+            rc = iof_write_output(&child->stdoutev->name, PMIX_FWD_STDOUT_CHANNEL,
+                                  &chunk->bo, chunk);
         } else if (PMIX_FWD_STDERR_CHANNEL == rev->channel) {
-            rc = pmix_iof_write_output(&child->stderrev->name, PMIX_FWD_STDERR_CHANNEL, &bo);
+            rc = iof_write_output(&child->stderrev->name, PMIX_FWD_STDERR_CHANNEL,
+                                  &chunk->bo, chunk);
         } else {
             rc = PMIX_ERR_BAD_PARAM;
         }
+        PMIX_RELEASE(chunk);
         if (0 > rc) {
             PMIX_ERROR_LOG(rc);
         }
@@ -1974,7 +2202,9 @@ void pmix_iof_read_local_handler(int sd, short args, void *cbdata)
                 if (PMIX_CHECK_PROCID(&child->proc, &rev->targets[0])) {
                     /* send the input to that target */
                     rc = write_output_line(&child->proc, &child->stdinsink.wev, NULL,
-                                           PMIX_FWD_STDIN_CHANNEL, false, false, &bo);
+                                           PMIX_FWD_STDIN_CHANNEL, false, false,
+                                           &chunk->bo, chunk);
+                    PMIX_RELEASE(chunk);
                     goto reactivate;
                 }
             }
@@ -1993,16 +2223,15 @@ void pmix_iof_read_local_handler(int sd, short args, void *cbdata)
     if (PMIX_PEER_IS_SERVER(pmix_globals.mypeer)) {
         if (NULL == pmix_host_server.push_stdin) {
             /* nothing we can do with this info - no point in reactivating it */
-            return;
-        }
-        PMIX_BYTE_OBJECT_CREATE(boptr, 1);
-        if (0 < bo.size) {
-            boptr->bytes = (char*)malloc(bo.size);
-            memcpy(boptr->bytes, bo.bytes, bo.size);
-            boptr->size = bo.size;
+            goto release;
         }
+        /* the host holds our reference to the chunk until it calls us back */
         rc = pmix_host_server.push_stdin(&pmix_globals.myid, rev->targets, rev->ntargets,
-                                         rev->directives, rev->ndirs, boptr, opcbfn, (void*)boptr);
+                                         rev->directives, rev->ndirs, &chunk->bo,
+                                         opcbfn, (void*)chunk);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_RELEASE(chunk);
+        }
         goto reactivate;
     }
 
@@ -2012,20 +2241,20 @@ forward:
     msg = PMIX_NEW(pmix_buffer_t);
     if (NULL == msg) {
         /* don't restart the event - just return */
-        return;
+        goto release;
     }
     PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msg, &cmd, 1, PMIX_COMMAND);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         PMIX_RELEASE(msg);
-        return;
+        goto release;
     }
     /* pack the number of targets */
     PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msg, &rev->ntargets, 1, PMIX_SIZE);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         PMIX_RELEASE(msg);
-        return;
+        goto release;
     }
     /* and the targets */
     if (0 < rev->ntargets) {
@@ -2034,7 +2263,7 @@ forward:
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
             PMIX_RELEASE(msg);
-            return;
+            goto release;
         }
     }
     /* pack the number of directives */
@@ -2042,7 +2271,7 @@ forward:
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         PMIX_RELEASE(msg);
-        return;
+        goto release;
     }
     /* and the directives */
     if (0 < rev->ndirs) {
@@ -2051,16 +2280,16 @@ forward:
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
             PMIX_RELEASE(msg);
-            return;
+            goto release;
         }
     }
 
     /* pack the data */
-    PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msg, &bo, 1, PMIX_BYTE_OBJECT);
+    PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msg, &chunk->bo, 1, PMIX_BYTE_OBJECT);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         PMIX_RELEASE(msg);
-        return;
+        goto release;
     }
 
     /* send it to the server */
@@ -2069,6 +2298,7 @@ forward:
         PMIX_ERROR_LOG(rc);
         PMIX_RELEASE(msg);
     }
+    PMIX_RELEASE(chunk);
 
 reactivate:
     if (0 < numbytes) {
@@ -2077,6 +2307,10 @@ reactivate:
 
     /* nothing more to do */
     return;
+
+release:
+    /* don't restart the event */
+    PMIX_RELEASE(chunk);
 }
 
 /* class instances */
@@ -2111,6 +2345,8 @@ static void iof_read_event_construct(pmix_iof_read_event_t *rev)
     rev->ntargets = 0;
     rev->directives = NULL;
     rev->ndirs = 0;
+    rev->rdsize = PMIX_IOF_BASE_MSG_MAX;
+    rev->nosplice = false;
 }
 static void iof_read_event_destruct(pmix_iof_read_event_t *rev)
 {
@@ -2143,6 +2379,10 @@ static void iof_write_event_construct(pmix_iof_write_event_t *wev)
     PMIX_CONSTRUCT(&wev->outputs, pmix_list_t);
     wev->tv.tv_sec = 0;
     wev->tv.tv_usec = 0;
+    wev->backlog = 0;
+    wev->backlog_hwm = 0;
+    wev->nwrites = 0;
+    wev->nbytes = 0;
 }
 static void iof_write_event_destruct(pmix_iof_write_event_t *wev)
 {
@@ -2150,6 +2390,9 @@ static void iof_write_event_destruct(pmix_iof_write_event_t *wev)
         pmix_event_del(wev->ev);
     }
     free(wev->ev);
+    if (0 < wev->nwrites) {
+        report_sink_stats(wev);
+    }
     if (2 < wev->fd) {
         pmix_output_verbose(20, pmix_client_globals.iof_output,
                              "%s iof: closing fd %d for write event",
@@ -2161,14 +2404,31 @@ static void iof_write_event_destruct(pmix_iof_write_event_t *wev)
 PMIX_CLASS_INSTANCE(pmix_iof_write_event_t, pmix_list_item_t, iof_write_event_construct,
                     iof_write_event_destruct);
 
+static void chcon(pmix_iof_chunk_t *p)
+{
+    PMIX_BYTE_OBJECT_CONSTRUCT(&p->bo);
+}
+static void chdes(pmix_iof_chunk_t *p)
+{
+    if (NULL != p->bo.bytes) {
+        free(p->bo.bytes);
+    }
+}
+PMIX_CLASS_INSTANCE(pmix_iof_chunk_t,
+                    pmix_object_t,
+                    chcon, chdes);
+
 static void wocon(pmix_iof_write_output_t *p)
 {
+    p->chunk = NULL;
     p->data = NULL;
     p->numbytes = 0;
 }
 static void wodes(pmix_iof_write_output_t *p)
 {
-    if (NULL != p->data) {
+    if (NULL != p->chunk) {
+        PMIX_RELEASE(p->chunk);
+    } else if (NULL != p->data) {
         free(p->data);
     }
 }
@@ -47,6 +47,7 @@
 #ifdef HAVE_UNISTD_H
 #    include <unistd.h>
 #endif
+#include <limits.h>
 #include <signal.h>
 
 #include "src/class/pmix_list.h"
@@ -56,13 +57,25 @@
 BEGIN_C_DECLS
 
 /*
- * Maximum size of single msg
+ * Maximum size of single msg - reads from a local fd start at
+ * PMIX_IOF_BASE_MSG_MAX and grow up to PMIX_IOF_READ_MAX while
+ * the fd keeps filling the buffer
  */
 #define PMIX_IOF_BASE_MSG_MAX        8192
+#define PMIX_IOF_READ_MAX            65536
 #define PMIX_IOF_BASE_TAG_MAX        1024
 #define PMIX_IOF_MAX_INPUT_BUFFERS   50
 #define PMIX_IOF_MAX_RETRIES         4
 
+/*
+ * Max number of queued outputs gathered into a single writev
+ */
+#if defined(IOV_MAX) && IOV_MAX < 64
+#    define PMIX_IOF_SINK_MAX_IOV    IOV_MAX
+#else
+#    define PMIX_IOF_SINK_MAX_IOV    64
+#endif
+
 typedef struct {
     pmix_list_item_t super;
     bool pending;
@@ -72,6 +85,13 @@ typedef struct {
     struct timeval tv;
     int fd;
     pmix_list_t outputs;
+    /* bytes queued on outputs but not yet written, and the
+     * largest value it has reached */
+    size_t backlog;
+    size_t backlog_hwm;
+    /* number of successful write syscalls and the bytes they moved */
+    uint64_t nwrites;
+    uint64_t nbytes;
 } pmix_iof_write_event_t;
 PMIX_EXPORT PMIX_CLASS_DECLARATION(pmix_iof_write_event_t);
 #define PMIX_IOF_WRITE_EVENT_STATIC_INIT    \
@@ -83,7 +103,11 @@ PMIX_EXPORT PMIX_CLASS_DECLARATION(pmix_iof_write_event_t);
     .ev = NULL,                             \
     .tv = {0, 0},                           \
     .fd = 0,                                \
-    .outputs = PMIX_LIST_STATIC_INIT        \
+    .outputs = PMIX_LIST_STATIC_INIT,       \
+    .backlog = 0,                           \
+    .backlog_hwm = 0,                       \
+    .nwrites = 0,                           \
+    .nbytes = 0                             \
 }
 
 typedef struct {
@@ -107,8 +131,20 @@ PMIX_EXPORT PMIX_CLASS_DECLARATION(pmix_iof_sink_t);
     .closed = false                             \
 }
 
+/* a block of data read from a local fd. It is shared by reference
+ * between every output and forwarder it is delivered to, and the
+ * bytes are free'd when the last of them releases it */
+typedef struct {
+    pmix_object_t super;
+    pmix_byte_object_t bo;
+} pmix_iof_chunk_t;
+PMIX_EXPORT PMIX_CLASS_DECLARATION(pmix_iof_chunk_t);
+
 typedef struct {
     pmix_list_item_t super;
+    /* if chunk is not NULL, then data points into it
+     * and is not owned by this output */
+    pmix_iof_chunk_t *chunk;
     char *data;
     int numbytes;
 } pmix_iof_write_output_t;
@@ -128,6 +164,8 @@ typedef struct {
     size_t ntargets;
     pmix_info_t *directives;
     size_t ndirs;
+    size_t rdsize;
+    bool nosplice;
 } pmix_iof_read_event_t;
 PMIX_EXPORT PMIX_CLASS_DECLARATION(pmix_iof_read_event_t);
 
@@ -167,6 +205,17 @@ static inline bool pmix_iof_fd_always_ready(int fd)
         }                                                              \
     } while (0);
 
+/* queue an output on a write event, tracking the
+ * number of bytes waiting to be written */
+#define PMIX_IOF_SINK_QUEUE(w, out)                                    \
+    do {                                                               \
+        pmix_list_append(&(w)->outputs, &(out)->super);                \
+        (w)->backlog += (out)->numbytes;                               \
+        if ((w)->backlog_hwm < (w)->backlog) {                         \
+            (w)->backlog_hwm = (w)->backlog;                           \
+        }                                                              \
+    } while (0);
+
 /* define an output "sink", adding it to the provided
  * endpoint list for this proc */
 #define PMIX_IOF_SINK_DEFINE(snk, nm, fid, tg, wrthndlr)                                           \
@@ -112,48 +112,131 @@ static void notify_event_cbfunc(struct pmix_peer_t *pr,
     PMIX_RELEASE(cb);
 }
 
+static void cache_link(pmix_notify_caddy_t *cd)
+{
+    pmix_notify_cache_t *cache = &pmix_globals.notify_cache;
+    uint64_t key = (uint64_t) (uint32_t) cd->status;
+    void *ptr;
+
+    /* append to the arrival order */
+    cd->lru_next = NULL;
+    cd->lru_prev = cache->newest;
+    if (NULL != cache->newest) {
+        cache->newest->lru_next = cd;
+    } else {
+        cache->oldest = cd;
+    }
+    cache->newest = cd;
+
+    /* and to the thread for its status code */
+    cd->code_next = NULL;
+    cd->code_prev = NULL;
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_uint64(&cache->bycode, key, &ptr)) {
+        cd->code_prev = (pmix_notify_caddy_t *) ptr;
+        cd->code_prev->code_next = cd;
+    }
+    pmix_hash_table_set_value_uint64(&cache->bycode, key, cd);
+}
+
+void pmix_notify_event_unlink(pmix_notify_caddy_t *cd)
+{
+    pmix_notify_cache_t *cache = &pmix_globals.notify_cache;
+    uint64_t key = (uint64_t) (uint32_t) cd->status;
+    void *ptr;
+
+    if (NULL != cd->lru_prev) {
+        cd->lru_prev->lru_next = cd->lru_next;
+    } else if (cache->oldest == cd) {
+        cache->oldest = cd->lru_next;
+    } else {
+        /* not in the cache */
+        return;
+    }
+    if (NULL != cd->lru_next) {
+        cd->lru_next->lru_prev = cd->lru_prev;
+    } else {
+        cache->newest = cd->lru_prev;
+    }
+
+    if (NULL != cd->code_prev) {
+        cd->code_prev->code_next = cd->code_next;
+    }
+    if (NULL != cd->code_next) {
+        cd->code_next->code_prev = cd->code_prev;
+    } else if (PMIX_SUCCESS == pmix_hash_table_get_value_uint64(&cache->bycode, key, &ptr)
+               && ptr == (void *) cd) {
+        /* this was the newest with this code */
+        if (NULL != cd->code_prev) {
+            pmix_hash_table_set_value_uint64(&cache->bycode, key, cd->code_prev);
+        } else {
+            pmix_hash_table_remove_value_uint64(&cache->bycode, key);
+        }
+    }
+    cd->lru_prev = NULL;
+    cd->lru_next = NULL;
+    cd->code_prev = NULL;
+    cd->code_next = NULL;
+}
+
 pmix_status_t pmix_notify_event_cache(pmix_notify_caddy_t *cd)
 {
-    pmix_status_t rc;
-    int j;
     pmix_notify_caddy_t *pk;
-    int idx;
-    time_t etime;
+    pmix_status_t rc;
 
     /* add to our cache */
     rc = pmix_hotel_checkin(&pmix_globals.notifications, cd, &cd->room);
-    /* if there wasn't room, then search for the longest tenured
-     * occupant and evict them */
+    /* if there wasn't room, then evict the longest tenured
+     * occupant - it is always at the front of the line */
     if (PMIX_SUCCESS != rc) {
-        etime = 0;
-        idx = -1;
-        for (j = 0; j < pmix_globals.max_events; j++) {
-            pmix_hotel_knock(&pmix_globals.notifications, j, (void **) &pk);
-            if (NULL == pk) {
-                /* hey, there is room! */
-                pmix_hotel_checkin_with_res(&pmix_globals.notifications, cd, &cd->room);
-                return PMIX_SUCCESS;
-            }
-            /* check the age */
-            if (0 == j) {
-                etime = pk->ts;
-                idx = j;
-            } else {
-                if (difftime(pk->ts, etime) < 0) {
-                    etime = pk->ts;
-                    idx = j;
-                }
-            }
+        pk = pmix_globals.notify_cache.oldest;
+        if (NULL == pk) {
+            return rc;
         }
-        if (0 <= idx) {
-            /* we found the oldest occupant - evict it */
-            pmix_hotel_checkout_and_return_occupant(&pmix_globals.notifications, idx,
-                                                    (void **) &pk);
-            PMIX_RELEASE(pk);
-            rc = pmix_hotel_checkin(&pmix_globals.notifications, cd, &cd->room);
+        pmix_notify_event_uncache(pk);
+        PMIX_RELEASE(pk);
+        pmix_globals.notify_cache.stats.nevicted++;
+        rc = pmix_hotel_checkin(&pmix_globals.notifications, cd, &cd->room);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
         }
     }
-    return rc;
+    cache_link(cd);
+    pmix_globals.notify_cache.stats.ncached++;
+    return PMIX_SUCCESS;
+}
+
+void pmix_notify_event_uncache(pmix_notify_caddy_t *cd)
+{
+    if (0 <= cd->room) {
+        pmix_hotel_checkout(&pmix_globals.notifications, cd->room);
+        cd->room = -1;
+    }
+    pmix_notify_event_unlink(cd);
+}
+
+pmix_notify_caddy_t *pmix_notify_event_cached(pmix_status_t code)
+{
+    pmix_notify_caddy_t *cd;
+    void *ptr;
+
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_uint64(&pmix_globals.notify_cache.bycode,
+                                                         (uint64_t) (uint32_t) code, &ptr)) {
+        return NULL;
+    }
+    /* the index holds the newest - walk back to the oldest */
+    for (cd = (pmix_notify_caddy_t *) ptr; NULL != cd->code_prev; cd = cd->code_prev) {
+        continue;
+    }
+    return cd;
+}
+
+void pmix_notify_event_replayed(size_t nreplayed)
+{
+    pmix_globals.notify_cache.stats.nlookups++;
+    if (0 < nreplayed) {
+        pmix_globals.notify_cache.stats.nhits++;
+        pmix_globals.notify_cache.stats.nreplayed += nreplayed;
+    }
 }
 
 /* as a client, we pass the notification to our server */
@@ -906,24 +989,116 @@ static void local_cbfunc(pmix_status_t status, void *cbdata)
     PMIX_RELEASE(cd);
 }
 
+/* a notification packed for one combination of bfrops
+ * module and buffer type */
+#define PMIX_NOTIFY_MAX_PAYLOADS 8
+typedef struct {
+    pmix_bfrops_module_t *bfrops;
+    pmix_bfrop_buffer_type_t type;
+    pmix_buffer_t *bfr;
+} pmix_notify_payload_t;
+
+static pmix_buffer_t *pack_notification(pmix_notify_caddy_t *cd, pmix_peer_t *peer)
+{
+    pmix_buffer_t *bfr;
+    pmix_cmd_t cmd = PMIX_NOTIFY_CMD;
+    pmix_status_t rc;
+
+    bfr = PMIX_NEW(pmix_buffer_t);
+    if (NULL == bfr) {
+        return NULL;
+    }
+    /* pack the command */
+    PMIX_BFROPS_PACK(rc, peer, bfr, &cmd, 1, PMIX_COMMAND);
+    if (PMIX_SUCCESS != rc) {
+        goto error;
+    }
+    /* pack the status */
+    PMIX_BFROPS_PACK(rc, peer, bfr, &cd->status, 1, PMIX_STATUS);
+    if (PMIX_SUCCESS != rc) {
+        goto error;
+    }
+    /* pack the source */
+    PMIX_BFROPS_PACK(rc, peer, bfr, &cd->source, 1, PMIX_PROC);
+    if (PMIX_SUCCESS != rc) {
+        goto error;
+    }
+    /* pack any info */
+    PMIX_BFROPS_PACK(rc, peer, bfr, &cd->ninfo, 1, PMIX_SIZE);
+    if (PMIX_SUCCESS != rc) {
+        goto error;
+    }
+    if (0 < cd->ninfo) {
+        PMIX_BFROPS_PACK(rc, peer, bfr, cd->info, cd->ninfo, PMIX_INFO);
+        if (PMIX_SUCCESS != rc) {
+            goto error;
+        }
+    }
+    /* pack the range in case they need to relay */
+    PMIX_BFROPS_PACK(rc, peer, bfr, &cd->range, 1, PMIX_DATA_RANGE);
+    if (PMIX_SUCCESS != rc) {
+        goto error;
+    }
+    return bfr;
+
+error:
+    PMIX_ERROR_LOG(rc);
+    PMIX_RELEASE(bfr);
+    return NULL;
+}
+
+/* return the notification as packed for this peer, packing it only
+ * if no earlier peer used the same bfrops module and buffer type. The
+ * returned buffer carries a reference for the caller to hand to the
+ * send queue - it is shared by all such sends and so must be treated
+ * as immutable */
+static pmix_buffer_t *notify_payload(pmix_notify_caddy_t *cd, pmix_peer_t *peer,
+                                     pmix_notify_payload_t *payloads, size_t *npayloads)
+{
+    pmix_bfrops_module_t *bfrops = peer->nptr->compat.bfrops;
+    pmix_bfrop_buffer_type_t type = peer->nptr->compat.type;
+    pmix_buffer_t *bfr;
+    size_t n;
+
+    for (n = 0; n < *npayloads; n++) {
+        if (payloads[n].bfrops == bfrops && payloads[n].type == type) {
+            PMIX_RETAIN(payloads[n].bfr);
+            return payloads[n].bfr;
+        }
+    }
+    bfr = pack_notification(cd, peer);
+    if (NULL == bfr) {
+        return NULL;
+    }
+    if (*npayloads < PMIX_NOTIFY_MAX_PAYLOADS) {
+        /* keep a reference for the peers that follow */
+        payloads[*npayloads].bfrops = bfrops;
+        payloads[*npayloads].type = type;
+        payloads[*npayloads].bfr = bfr;
+        ++(*npayloads);
+        PMIX_RETAIN(bfr);
+    }
+    return bfr;
+}
+
 static void _notify_client_event(int sd, short args, void *cbdata)
 {
     (void) sd;
     (void) args;
     pmix_notify_caddy_t *cd = (pmix_notify_caddy_t *) cbdata;
-    pmix_regevents_info_t *reginfoptr;
+    pmix_regevents_info_t *regs[2];
     pmix_peer_events_info_t *pr;
     pmix_event_chain_t *chain;
-    size_t n, nleft;
-    bool matched, holdcd;
+    size_t n, m, nleft;
+    bool holdcd;
+    int peerid;
     pmix_buffer_t *bfr;
-    pmix_cmd_t cmd = PMIX_NOTIFY_CMD;
     pmix_status_t rc;
-    pmix_list_t trk;
-    pmix_namelist_t *nm;
-    pmix_namespace_t *nptr, *tmp;
+    pmix_namespace_t *nptr;
     pmix_range_trkr_t rngtrk;
     pmix_proc_t proc;
+    pmix_notify_payload_t payloads[PMIX_NOTIFY_MAX_PAYLOADS];
+    size_t npayloads = 0;
 
     /* need to acquire the object from its originating thread */
     PMIX_ACQUIRE_OBJECT(cd);
@@ -1007,13 +1182,7 @@ static void _notify_client_event(int sd, short args, void *cbdata)
                 ++nleft;
             } else {
                 /* look up the nspace for this proc */
-                nptr = NULL;
-                PMIX_LIST_FOREACH (tmp, &pmix_globals.nspaces, pmix_namespace_t) {
-                    if (PMIX_CHECK_NSPACE(tmp->nspace, cd->targets[n].nspace)) {
-                        nptr = tmp;
-                        break;
-                    }
-                }
+                nptr = pmix_server_nspace_lookup(cd->targets[n].nspace);
                 /* if we don't yet know it, then nothing to do */
                 if (NULL == nptr) {
                     nleft = SIZE_MAX;
@@ -1100,132 +1269,103 @@ static void _notify_client_event(int sd, short args, void *cbdata)
 
     holdcd = false;
     if (PMIX_RANGE_PROC_LOCAL != cd->range) {
-        PMIX_CONSTRUCT(&trk, pmix_list_t);
         rngtrk.procs = NULL;
         rngtrk.nprocs = 0;
-        /* cycle across our registered events and send the message to
-         * any client who registered for it */
-        PMIX_LIST_FOREACH (reginfoptr, &pmix_server_globals.events, pmix_regevents_info_t) {
-            if ((PMIX_MAX_ERR_CONSTANT == reginfoptr->code && !cd->nondefault) ||
-                cd->status == reginfoptr->code) {
-                PMIX_LIST_FOREACH (pr, &reginfoptr->peers, pmix_peer_events_info_t) {
-                    /* if this client was the source of the event, then
-                     * don't send it back as they will have processed it
-                     * when they generated it */
-                    if (PMIX_CHECK_NAMES(&cd->source, &pr->peer->info->pname)) {
-                        continue;
-                    }
-                    /* don't notify ourselves - we handle this internally */
-                    if (PMIX_CHECK_NAMES(&pmix_globals.myid, &pr->peer->info->pname)) {
-                        continue;
-                    }
-                    /* if we have already notified this client, then don't do it again */
-                    matched = false;
-                    PMIX_LIST_FOREACH (nm, &trk, pmix_namelist_t) {
-                        if (nm->pname == &pr->peer->info->pname) {
-                            matched = true;
-                            break;
-                        }
-                    }
-                    if (matched) {
-                        continue;
-                    }
-                    /* check if the affected procs (if given) match those they
-                     * wanted to know about */
-                    if (!pmix_notify_check_affected(cd->affected, cd->naffected, pr->affected,
-                                                    pr->naffected)) {
-                        continue;
-                    }
-                    if (!PMIX_PEER_IS_TOOL(pmix_globals.mypeer) && NULL != cd->targets) {
-                        rngtrk.procs = cd->targets;
-                        rngtrk.nprocs = cd->ntargets;
-                        rngtrk.range = cd->range;
-                        PMIX_LOAD_PROCID(&proc, pr->peer->info->pname.nspace,
-                                         pr->peer->info->pname.rank);
-                        if (!pmix_notify_check_range(&rngtrk, &proc)) {
-                            continue;
-                        }
-                    }
-                    pmix_output_verbose(2, pmix_server_globals.event_output,
-                                        "pmix_server: notifying client %s:%u on status %s",
-                                        pr->peer->info->pname.nspace, pr->peer->info->pname.rank,
-                                        PMIx_Error_string(cd->status));
-
-                    /* record that we notified this client */
-                    nm = PMIX_NEW(pmix_namelist_t);
-                    nm->pname = &pr->peer->info->pname;
-                    pmix_list_append(&trk, &nm->super);
-
-                    bfr = PMIX_NEW(pmix_buffer_t);
-                    if (NULL == bfr) {
-                        continue;
-                    }
-                    /* pack the command */
-                    PMIX_BFROPS_PACK(rc, pr->peer, bfr, &cmd, 1, PMIX_COMMAND);
-                    if (PMIX_SUCCESS != rc) {
-                        PMIX_ERROR_LOG(rc);
-                        PMIX_RELEASE(bfr);
-                        continue;
-                    }
-
-                    /* pack the status */
-                    PMIX_BFROPS_PACK(rc, pr->peer, bfr, &cd->status, 1, PMIX_STATUS);
-                    if (PMIX_SUCCESS != rc) {
-                        PMIX_ERROR_LOG(rc);
-                        PMIX_RELEASE(bfr);
-                        continue;
-                    }
-
-                    /* pack the source */
-                    PMIX_BFROPS_PACK(rc, pr->peer, bfr, &cd->source, 1, PMIX_PROC);
-                    if (PMIX_SUCCESS != rc) {
-                        PMIX_ERROR_LOG(rc);
-                        PMIX_RELEASE(bfr);
-                        continue;
-                    }
-                    /* pack any info */
-                    PMIX_BFROPS_PACK(rc, pr->peer, bfr, &cd->ninfo, 1, PMIX_SIZE);
-                    if (PMIX_SUCCESS != rc) {
-                        PMIX_ERROR_LOG(rc);
-                        PMIX_RELEASE(bfr);
-                        continue;
-                    }
-
-                    if (0 < cd->ninfo) {
-                        PMIX_BFROPS_PACK(rc, pr->peer, bfr, cd->info, cd->ninfo, PMIX_INFO);
-                        if (PMIX_SUCCESS != rc) {
-                            PMIX_ERROR_LOG(rc);
-                            PMIX_RELEASE(bfr);
-                            continue;
-                        }
-                    }
-                    /* pack the range in case they need to relay */
-                    PMIX_BFROPS_PACK(rc, pr->peer, bfr, &cd->range, 1, PMIX_DATA_RANGE);
-                    if (PMIX_SUCCESS != rc) {
-                        PMIX_ERROR_LOG(rc);
-                        PMIX_RELEASE(bfr);
+        /* the registrations are indexed by code, so we only need
+         * to look at those for this status and, if permitted, the
+         * default handlers */
+        regs[0] = pmix_server_event_lookup(cd->status);
+        regs[1] = NULL;
+        if (!cd->nondefault && PMIX_MAX_ERR_CONSTANT != cd->status) {
+            regs[1] = pmix_server_event_lookup(PMIX_MAX_ERR_CONSTANT);
+        }
+        /* send the message to any client who registered for it */
+        for (m = 0; m < 2; m++) {
+            if (NULL == regs[m]) {
+                continue;
+            }
+            PMIX_LIST_FOREACH (pr, &regs[m]->peers, pmix_peer_events_info_t) {
+                /* if this client was the source of the event, then
+                 * don't send it back as they will have processed it
+                 * when they generated it */
+                if (PMIX_CHECK_NAMES(&cd->source, &pr->peer->info->pname)) {
+                    continue;
+                }
+                /* don't notify ourselves - we handle this internally */
+                if (PMIX_CHECK_NAMES(&pmix_globals.myid, &pr->peer->info->pname)) {
+                    continue;
+                }
+                /* if we have already notified this client, then don't do it again.
+                 * Clones of a proc share its rank info, and hence its peerid */
+                peerid = pr->peer->info->peerid;
+                if (0 <= peerid && pmix_bitmap_is_set_bit(&pmix_server_globals.evnotified, peerid)) {
+                    continue;
+                }
+                /* check if the affected procs (if given) match those they
+                 * wanted to know about */
+                if (!pmix_notify_check_affected(cd->affected, cd->naffected, pr->affected,
+                                                pr->naffected)) {
+                    continue;
+                }
+                if (!PMIX_PEER_IS_TOOL(pmix_globals.mypeer) && NULL != cd->targets) {
+                    rngtrk.procs = cd->targets;
+                    rngtrk.nprocs = cd->ntargets;
+                    rngtrk.range = cd->range;
+                    PMIX_LOAD_PROCID(&proc, pr->peer->info->pname.nspace,
+                                     pr->peer->info->pname.rank);
+                    if (!pmix_notify_check_range(&rngtrk, &proc)) {
                         continue;
                     }
+                }
+                pmix_output_verbose(2, pmix_server_globals.event_output,
+                                    "pmix_server: notifying client %s:%u on status %s",
+                                    pr->peer->info->pname.nspace, pr->peer->info->pname.rank,
+                                    PMIx_Error_string(cd->status));
+
+                /* record that we notified this client */
+                if (0 <= peerid) {
+                    pmix_bitmap_set_bit(&pmix_server_globals.evnotified, peerid);
+                }
 
-                    PMIX_SERVER_QUEUE_REPLY(rc, pr->peer, 0, bfr);
-                    if (PMIX_SUCCESS != rc) {
-                        PMIX_RELEASE(bfr);
-                    }
-                    if (NULL != cd->targets && 0 < cd->nleft) {
-                        /* track the number of targets we have left to notify */
-                        --cd->nleft;
-                        /* if the event was cached and this is the last one,
-                         * then evict this event from the cache */
-                        if (0 == cd->nleft) {
-                            pmix_hotel_checkout(&pmix_globals.notifications, cd->room);
-                            holdcd = false;
-                            break;
-                        }
+                /* every peer using the same bfrops module and buffer
+                 * type gets the same payload - it is packed once and
+                 * each send holds a reference to it */
+                bfr = notify_payload(cd, pr->peer, payloads, &npayloads);
+                if (NULL == bfr) {
+                    continue;
+                }
+                PMIX_SERVER_QUEUE_REPLY(rc, pr->peer, 0, bfr);
+                if (PMIX_SUCCESS != rc) {
+                    PMIX_RELEASE(bfr);
+                }
+                if (NULL != cd->targets && 0 < cd->nleft) {
+                    /* track the number of targets we have left to notify */
+                    --cd->nleft;
+                    /* if the event was cached and this is the last one,
+                     * then evict this event from the cache */
+                    if (0 == cd->nleft) {
+                        pmix_notify_event_uncache(cd);
+                        holdcd = false;
+                        break;
                     }
                 }
             }
         }
-        PMIX_LIST_DESTRUCT(&trk);
+        /* reset the record of who we notified - only the bits
+         * belonging to these registrations can have been set */
+        for (m = 0; m < 2; m++) {
+            if (NULL == regs[m]) {
+                continue;
+            }
+            PMIX_LIST_FOREACH (pr, &regs[m]->peers, pmix_peer_events_info_t) {
+                if (0 <= pr->peer->info->peerid) {
+                    pmix_bitmap_clear_bit(&pmix_server_globals.evnotified, pr->peer->info->peerid);
+                }
+            }
+        }
+        for (n = 0; n < npayloads; n++) {
+            PMIX_RELEASE(payloads[n].bfr);
+        }
         if (PMIX_RANGE_LOCAL != cd->range &&
             PMIX_CHECK_PROCID(&cd->source, &pmix_globals.myid)) {
             /* if we are the source, then we need to post this upwards as
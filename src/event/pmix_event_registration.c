@@ -355,103 +355,137 @@ static pmix_status_t _add_hdlr(pmix_rshift_caddy_t *cd, pmix_list_t *xfer)
     return PMIX_SUCCESS;
 }
 
-static void check_cached_events(pmix_rshift_caddy_t *cd)
+/* replay a cached notification to a new registration, returning
+ * true if it was delivered */
+static bool replay_cached_event(pmix_rshift_caddy_t *cd, pmix_notify_caddy_t *ncd)
 {
     size_t n;
-    pmix_notify_caddy_t *ncd;
-    bool found, matched;
+    bool matched;
     pmix_event_chain_t *chain;
-    int j;
 
-    for (j = 0; j < pmix_globals.max_events; j++) {
-        pmix_hotel_knock(&pmix_globals.notifications, j, (void **) &ncd);
-        if (NULL == ncd) {
-            continue;
-        }
-        found = false;
-        if (NULL == cd->codes) {
-            if (!ncd->nondefault) {
-                /* they registered a default event handler - always matches */
-                found = true;
+    /* it may have left the cache while we replayed others */
+    if (0 > ncd->room) {
+        return false;
+    }
+    /* if we were given specific targets, check if we are one */
+    if (NULL != ncd->targets) {
+        matched = false;
+        for (n = 0; n < ncd->ntargets; n++) {
+            if (PMIX_CHECK_PROCID(&pmix_globals.myid, &ncd->targets[n])) {
+                matched = true;
+                break;
             }
-        } else {
-            for (n = 0; n < cd->ncodes; n++) {
-                if (cd->codes[n] == ncd->status) {
-                    found = true;
-                    break;
+        }
+        if (!matched) {
+            /* do not notify this one */
+            return false;
+        }
+    }
+    /* if they specified affected proc(s) they wanted to know about, check */
+    if (!pmix_notify_check_affected(cd->affected, cd->naffected, ncd->affected,
+                                    ncd->naffected)) {
+        return false;
+    }
+    /* create the chain */
+    chain = PMIX_NEW(pmix_event_chain_t);
+    chain->status = ncd->status;
+    pmix_strncpy(chain->source.nspace, pmix_globals.myid.nspace, PMIX_MAX_NSLEN);
+    chain->source.rank = pmix_globals.myid.rank;
+    /* we always leave space for event hdlr name and a callback object */
+    chain->nallocated = ncd->ninfo + 2;
+    PMIX_INFO_CREATE(chain->info, chain->nallocated);
+    if (0 < ncd->ninfo) {
+        chain->ninfo = ncd->ninfo;
+        /* need to copy the info */
+        for (n = 0; n < ncd->ninfo; n++) {
+            PMIX_INFO_XFER(&chain->info[n], &ncd->info[n]);
+            if (PMIX_CHECK_KEY(&ncd->info[n], PMIX_EVENT_NON_DEFAULT)) {
+                chain->nondefault = true;
+            } else if (PMIX_CHECK_KEY(&ncd->info[n], PMIX_EVENT_AFFECTED_PROC)) {
+                PMIX_PROC_CREATE(chain->affected, 1);
+                if (NULL == chain->affected) {
+                    PMIX_RELEASE(chain);
+                    return false;
+                }
+                chain->naffected = 1;
+                memcpy(chain->affected, ncd->info[n].value.data.proc, sizeof(pmix_proc_t));
+            } else if (PMIX_CHECK_KEY(&ncd->info[n], PMIX_EVENT_AFFECTED_PROCS)) {
+                chain->naffected = ncd->info[n].value.data.darray->size;
+                PMIX_PROC_CREATE(chain->affected, chain->naffected);
+                if (NULL == chain->affected) {
+                    chain->naffected = 0;
+                    PMIX_RELEASE(chain);
+                    return false;
                 }
+                memcpy(chain->affected, ncd->info[n].value.data.darray->array,
+                       chain->naffected * sizeof(pmix_proc_t));
             }
         }
-        if (!found) {
-            continue;
+    }
+    /* check this event out of the cache since we
+     * are processing it */
+    pmix_notify_event_uncache(ncd);
+    /* release the storage */
+    PMIX_RELEASE(ncd);
+
+    /* we don't want this chain to propagate, so indicate it
+     * should only be run as a single-shot */
+    chain->endchain = true;
+    /* now notify any matching registered callbacks we have */
+    pmix_invoke_local_event_hdlr(chain);
+    return true;
+}
+
+static void check_cached_events(pmix_rshift_caddy_t *cd)
+{
+    pmix_notify_caddy_t *ncd, *nnext;
+    pmix_pointer_array_t matches;
+    size_t n, k, nreplayed = 0;
+    int m;
+
+    /* collect the candidates before replaying any of them, as
+     * the handlers we invoke may themselves add to the cache */
+    PMIX_CONSTRUCT(&matches, pmix_pointer_array_t);
+    pmix_pointer_array_init(&matches, 8, INT_MAX, 8);
+    if (NULL == cd->codes) {
+        /* they registered a default event handler - matches
+         * everything not restricted to non-default handlers */
+        PMIX_NOTIFY_CACHE_FOREACH (ncd, nnext) {
+            if (!ncd->nondefault) {
+                PMIX_RETAIN(ncd);
+                pmix_pointer_array_add(&matches, ncd);
+            }
         }
-        /* if we were given specific targets, check if we are one */
-        if (NULL != ncd->targets) {
-            matched = false;
-            for (n = 0; n < ncd->ntargets; n++) {
-                if (PMIX_CHECK_PROCID(&pmix_globals.myid, &ncd->targets[n])) {
-                    matched = true;
+    } else {
+        for (n = 0; n < cd->ncodes; n++) {
+            /* only look at each code once */
+            for (k = 0; k < n; k++) {
+                if (cd->codes[k] == cd->codes[n]) {
                     break;
                 }
             }
-            if (!matched) {
-                /* do not notify this one */
+            if (k < n) {
                 continue;
             }
+            PMIX_NOTIFY_CACHE_FOREACH_CODE (ncd, nnext, cd->codes[n]) {
+                PMIX_RETAIN(ncd);
+                pmix_pointer_array_add(&matches, ncd);
+            }
         }
-        /* if they specified affected proc(s) they wanted to know about, check */
-        if (!pmix_notify_check_affected(cd->affected, cd->naffected, ncd->affected,
-                                        ncd->naffected)) {
+    }
+
+    for (m = 0; m < matches.size; m++) {
+        ncd = (pmix_notify_caddy_t *) pmix_pointer_array_get_item(&matches, m);
+        if (NULL == ncd) {
             continue;
         }
-        /* create the chain */
-        chain = PMIX_NEW(pmix_event_chain_t);
-        chain->status = ncd->status;
-        pmix_strncpy(chain->source.nspace, pmix_globals.myid.nspace, PMIX_MAX_NSLEN);
-        chain->source.rank = pmix_globals.myid.rank;
-        /* we always leave space for event hdlr name and a callback object */
-        chain->nallocated = ncd->ninfo + 2;
-        PMIX_INFO_CREATE(chain->info, chain->nallocated);
-        if (0 < ncd->ninfo) {
-            chain->ninfo = ncd->ninfo;
-            /* need to copy the info */
-            for (n = 0; n < ncd->ninfo; n++) {
-                PMIX_INFO_XFER(&chain->info[n], &ncd->info[n]);
-                if (PMIX_CHECK_KEY(&ncd->info[n], PMIX_EVENT_NON_DEFAULT)) {
-                    chain->nondefault = true;
-                } else if (PMIX_CHECK_KEY(&ncd->info[n], PMIX_EVENT_AFFECTED_PROC)) {
-                    PMIX_PROC_CREATE(chain->affected, 1);
-                    if (NULL == chain->affected) {
-                        PMIX_RELEASE(chain);
-                        return;
-                    }
-                    chain->naffected = 1;
-                    memcpy(chain->affected, ncd->info[n].value.data.proc, sizeof(pmix_proc_t));
-                } else if (PMIX_CHECK_KEY(&ncd->info[n], PMIX_EVENT_AFFECTED_PROCS)) {
-                    chain->naffected = ncd->info[n].value.data.darray->size;
-                    PMIX_PROC_CREATE(chain->affected, chain->naffected);
-                    if (NULL == chain->affected) {
-                        chain->naffected = 0;
-                        PMIX_RELEASE(chain);
-                        return;
-                    }
-                    memcpy(chain->affected, ncd->info[n].value.data.darray->array,
-                           chain->naffected * sizeof(pmix_proc_t));
-                }
-            }
+        if (replay_cached_event(cd, ncd)) {
+            ++nreplayed;
         }
-        /* check this event out of the cache since we
-         * are processing it */
-        pmix_hotel_checkout(&pmix_globals.notifications, ncd->room);
-        /* release the storage */
         PMIX_RELEASE(ncd);
-
-        /* we don't want this chain to propagate, so indicate it
-         * should only be run as a single-shot */
-        chain->endchain = true;
-        /* now notify any matching registered callbacks we have */
-        pmix_invoke_local_event_hdlr(chain);
     }
+    PMIX_DESTRUCT(&matches);
+    pmix_notify_event_replayed(nreplayed);
 }
 
 static void reg_event_hdlr(int sd, short args, void *cbdata)
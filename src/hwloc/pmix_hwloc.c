@@ -212,6 +212,7 @@ pmix_status_t pmix_hwloc_setup_topology(pmix_info_t *info, size_t ninfo)
         /* record locally in case someone does a PMIx_Get to retrieve it */
         kv.key = PMIX_TOPOLOGY2;
         kv.value = &val;
+        kv.storage = NULL;
         val.type = PMIX_TOPO;
         val.data.topo = &pmix_globals.topology;
         PMIX_GDS_STORE_KV(rc, pmix_globals.mypeer, &pmix_globals.myid, PMIX_INTERNAL, &kv);
@@ -293,6 +294,7 @@ pmix_status_t pmix_hwloc_setup_topology(pmix_info_t *info, size_t ninfo)
         /* record locally in case someone does a PMIx_Get to retrieve it */
         kv.key = PMIX_TOPOLOGY2;
         kv.value = &val;
+        kv.storage = NULL;
         val.type = PMIX_TOPO;
         val.data.topo = &pmix_globals.topology;
         PMIX_GDS_STORE_KV(rc, pmix_globals.mypeer, &pmix_globals.myid, PMIX_INTERNAL, &kv);
@@ -329,6 +331,7 @@ tryxml:
             /* record locally in case someone does a PMIx_Get to retrieve it */
             kv.key = PMIX_TOPOLOGY2;
             kv.value = &val;
+            kv.storage = NULL;
             val.type = PMIX_TOPO;
             val.data.topo = &pmix_globals.topology;
             PMIX_GDS_STORE_KV(rc, pmix_globals.mypeer, &pmix_globals.myid, PMIX_INTERNAL, &kv);
@@ -368,6 +371,7 @@ tryxml:
             /* record locally in case someone does a PMIx_Get to retrieve it */
             kv.key = PMIX_TOPOLOGY2;
             kv.value = &val;
+            kv.storage = NULL;
             val.type = PMIX_TOPO;
             val.data.topo = &pmix_globals.topology;
             PMIX_GDS_STORE_KV(rc, pmix_globals.mypeer, &pmix_globals.myid, PMIX_INTERNAL, &kv);
@@ -441,6 +445,7 @@ tryself:
     /* record locally in case someone does a PMIx_Get to retrieve it */
     kv.key = PMIX_TOPOLOGY2;
     kv.value = &val;
+    kv.storage = NULL;
     val.type = PMIX_TOPO;
     val.data.topo = &pmix_globals.topology;
     PMIX_GDS_STORE_KV(rc, pmix_globals.mypeer, &pmix_globals.myid, PMIX_INTERNAL, &kv);
@@ -61,6 +61,11 @@
 
 #include <stdatomic.h>
 
+static inline void pmix_atomic_mb(void)
+{
+    atomic_thread_fence(memory_order_seq_cst);
+}
+
 static inline void pmix_atomic_wmb(void)
 {
     atomic_thread_fence(memory_order_release);
@@ -80,6 +85,11 @@ static inline void pmix_atomic_rmb(void)
 
 #elif PMIX_ATOMIC_GCC_BUILTIN
 
+static inline void pmix_atomic_mb(void)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
 static inline void pmix_atomic_wmb(void)
 {
     __atomic_thread_fence(__ATOMIC_RELEASE);
@@ -225,6 +225,10 @@ static void pcon(pmix_peer_t *p)
     PMIX_CONSTRUCT(&p->send_queue, pmix_list_t);
     p->send_msg = NULL;
     p->recv_msg = NULL;
+    p->rstage = NULL;
+    p->rstage_off = 0;
+    p->rstage_len = 0;
+    p->ring = NULL;
     p->commit_cnt = 0;
     PMIX_CONSTRUCT(&p->epilog.cleanup_dirs, pmix_list_t);
     PMIX_CONSTRUCT(&p->epilog.cleanup_files, pmix_list_t);
@@ -254,6 +258,12 @@ static void pdes(pmix_peer_t *p)
     if (NULL != p->recv_msg) {
         PMIX_RELEASE(p->recv_msg);
     }
+    if (NULL != p->rstage) {
+        free(p->rstage);
+    }
+    if (NULL != p->ring) {
+        PMIX_RELEASE(p->ring);
+    }
     /* perform any epilog */
     pmix_execute_epilog(&p->epilog);
     /* cleanup the epilog */
@@ -462,6 +472,10 @@ static void ncon(pmix_notify_caddy_t *p)
     p->ts = tv.tv_sec;
 #endif
     p->room = -1;
+    p->lru_prev = NULL;
+    p->lru_next = NULL;
+    p->code_prev = NULL;
+    p->code_next = NULL;
     memset(p->source.nspace, 0, PMIX_MAX_NSLEN + 1);
     p->source.rank = PMIX_RANK_UNDEF;
     p->range = PMIX_RANGE_UNDEF;
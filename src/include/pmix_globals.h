@@ -108,10 +108,16 @@ do {                                    \
     }                                   \
 } while(0)
 
-typedef struct {
+typedef struct pmix_dstor {
     uint32_t index;
     uint32_t qualindex;
     pmix_value_t *value;
+    /* if non-NULL, the string or byte object in the
+     * value is borrowed from this storage */
+    pmix_buffer_storage_t *storage;
+    /* next entry for the same key, if the key is stored
+     * more than once (i.e., with different qualifiers) */
+    struct pmix_dstor *next;
 } pmix_dstor_t;
 #define PMIX_DSTOR_NEW(d, k)                                \
 do {                                                        \
@@ -120,13 +126,27 @@ do {                                                        \
         (d)->index = k;                                     \
         (d)->qualindex = UINT32_MAX;                        \
         (d)->value = NULL;                                  \
+        (d)->storage = NULL;                                \
+        (d)->next = NULL;                                   \
     }                                                       \
 } while(0)
+#define PMIX_DSTOR_VALUE_RELEASE(d)          \
+do {                                         \
+    if (NULL != (d)->value) {                \
+        if (NULL != (d)->storage) {          \
+            PMIX_VALUE_UNBORROW((d)->value); \
+        }                                    \
+        PMIX_VALUE_RELEASE((d)->value);      \
+        (d)->value = NULL;                   \
+    }                                        \
+    if (NULL != (d)->storage) {              \
+        PMIX_RELEASE((d)->storage);          \
+        (d)->storage = NULL;                 \
+    }                                        \
+} while(0)
 #define PMIX_DSTOR_RELEASE(d)           \
 do {                                    \
-    if (NULL != (d)->value) {           \
-        PMIX_VALUE_RELEASE((d)->value); \
-    }                                   \
+    PMIX_DSTOR_VALUE_RELEASE(d);        \
     free(d);                            \
 } while(0)
 
@@ -177,6 +197,7 @@ typedef uint8_t pmix_cmd_t;
 #define PMIX_FABRIC_UPDATE_CMD            31
 #define PMIX_COMPUTE_DEVICE_DISTANCES_CMD 32
 #define PMIX_REFRESH_CACHE                33
+#define PMIX_PREFETCH_CMD                 34
 
 /* provide a "pretty-print" function for cmds */
 const char *pmix_command_string(pmix_cmd_t cmd);
@@ -384,6 +405,10 @@ typedef struct pmix_peer_t {
     pmix_list_t send_queue;    /**< list of messages to send */
     pmix_ptl_send_t *send_msg; /**< current send in progress */
     pmix_ptl_recv_t *recv_msg; /**< current recv in progress */
+    char *rstage;              /**< staging buffer for speculative reads */
+    size_t rstage_off;         /**< offset of the first unconsumed staged byte */
+    size_t rstage_len;         /**< number of bytes in the staging buffer */
+    struct pmix_ptl_ring_t *ring; /**< shared-memory message rings, if negotiated */
     int commit_cnt;
     pmix_epilog_t epilog; /**< things to be performed upon
                                termination of this peer */
@@ -445,7 +470,7 @@ PMIX_CLASS_DECLARATION(pmix_grpinfo_t);
 
 /* define a tracker for collective operations
  * - instanced in pmix_server_ops.c */
-typedef struct {
+typedef struct pmix_server_trkr {
     pmix_list_item_t super;
     pmix_event_t ev;
     bool event_active;
@@ -457,6 +482,9 @@ typedef struct {
     bool hybrid;            // true if participating procs are from more than one nspace
     pmix_proc_t *pcs;       // copy of the original array of participants
     size_t npcs;            // number of procs in the array
+    pmix_proc_t *spcs;      // participants sorted by nspace and rank for lookup
+    uint64_t sig;           // order-independent signature of type and participants
+    struct pmix_server_trkr *signext; // next tracker whose signature collides with ours
     pmix_list_t nslist;     // unique nspace list of participants
     pmix_lock_t lock;       // flag for waiting for completion
     bool def_complete;      // all local procs have been registered and the trk definition is complete
@@ -611,15 +639,22 @@ PMIX_CLASS_DECLARATION(pmix_cb_t);
         pmix_event_evtimer_add(&(r)->ev, &_tv);                          \
     } while (0)
 
-typedef struct {
+typedef struct pmix_notify_caddy_t {
     pmix_object_t super;
     pmix_event_t ev;
     pmix_lock_t lock;
-    /* timestamp receipt of the notification so we
-     * can evict the oldest one if we get overwhelmed */
+    /* timestamp receipt of the notification */
     time_t ts;
     /* what room of the hotel they are in */
     int room;
+    /* while cached, the notification is threaded onto a list
+     * in order of arrival so the oldest can be evicted if we
+     * get overwhelmed, and onto a list of those with the same
+     * status code so they can be replayed to new registrations */
+    struct pmix_notify_caddy_t *lru_prev;
+    struct pmix_notify_caddy_t *lru_next;
+    struct pmix_notify_caddy_t *code_prev;
+    struct pmix_notify_caddy_t *code_next;
     pmix_status_t status;
     pmix_proc_t source;
     pmix_data_range_t range;
@@ -656,6 +691,25 @@ typedef struct {
 } pmix_notify_caddy_t;
 PMIX_CLASS_DECLARATION(pmix_notify_caddy_t);
 
+/* statistics on the notification cache */
+typedef struct {
+    size_t ncached;   // notifications added to the cache
+    size_t nlookups;  // searches of the cache on behalf of new registrations
+    size_t nhits;     // searches that found at least one notification to replay
+    size_t nreplayed; // cached notifications replayed to new registrations
+    size_t nevicted;  // notifications evicted to make room for newer ones
+    size_t nexpired;  // notifications that timed out of the cache
+} pmix_notify_cache_stats_t;
+
+/* the notifications held in the hotel, indexed for eviction
+ * and replay without having to knock on every room */
+typedef struct {
+    pmix_notify_caddy_t *oldest;
+    pmix_notify_caddy_t *newest;
+    pmix_hash_table_t bycode; // status code -> newest cached notification with it
+    pmix_notify_cache_stats_t stats;
+} pmix_notify_cache_t;
+
 /****    GLOBAL STORAGE    ****/
 /* define a global construct that includes values that must be shared
  * between various parts of the code library. The client, tool,
@@ -686,6 +740,7 @@ typedef struct {
     int max_events;                    // size of the notifications hotel
     int event_eviction_time;           // max time to cache notifications
     pmix_hotel_t notifications;        // hotel of pending notifications
+    pmix_notify_cache_t notify_cache;  // order and index of the notifications hotel
     /* IOF controls */
     bool pushstdin;
     pmix_list_t stdin_targets; // list of pmix_namelist_t
@@ -693,6 +748,7 @@ typedef struct {
     bool xml_output;
     bool timestamp_output;
     size_t output_limit;
+    bool iof_splice;
     pmix_list_t nspaces;
     pmix_topology_t topology;
     pmix_cpuset_t cpuset;
@@ -700,13 +756,45 @@ typedef struct {
     bool external_progress;
     pmix_iof_flags_t iof_flags;
     pmix_pointer_array_t keyindex;  // translation table of key <-> index
+    pmix_hash_table_t keymap;       // hashed lookup of unreserved key string -> index entry
     uint32_t next_keyid;
 } pmix_globals_t;
 
 /* provide access to a function to cleanup epilogs */
 PMIX_EXPORT void pmix_execute_epilog(pmix_epilog_t *ep);
 
+/* add a notification to the cache, evicting the oldest
+ * occupant if the cache is full */
 PMIX_EXPORT pmix_status_t pmix_notify_event_cache(pmix_notify_caddy_t *cd);
+/* check a notification out of the cache - the caller is
+ * responsible for releasing it */
+PMIX_EXPORT void pmix_notify_event_uncache(pmix_notify_caddy_t *cd);
+/* remove a notification that has already been checked out
+ * of the hotel from the cache order and index */
+PMIX_EXPORT void pmix_notify_event_unlink(pmix_notify_caddy_t *cd);
+/* return the oldest cached notification for the given status
+ * code - the rest follow it on its code_next thread */
+PMIX_EXPORT pmix_notify_caddy_t *pmix_notify_event_cached(pmix_status_t code);
+/* record the outcome of a search of the cache on behalf of
+ * a new registration */
+PMIX_EXPORT void pmix_notify_event_replayed(size_t nreplayed);
+
+/* cycle across the cached notifications, oldest first. The
+ * current item may be checked out while doing so */
+#define PMIX_NOTIFY_CACHE_FOREACH(cd, nxt)                                   \
+    for ((cd) = pmix_globals.notify_cache.oldest,                            \
+        (nxt) = (NULL == (cd)) ? NULL : (cd)->lru_next;                      \
+         NULL != (cd);                                                       \
+         (cd) = (nxt), (nxt) = (NULL == (cd)) ? NULL : (cd)->lru_next)
+
+/* cycle across the cached notifications for the given status
+ * code, oldest first. The current item may be checked out while
+ * doing so */
+#define PMIX_NOTIFY_CACHE_FOREACH_CODE(cd, nxt, code)                        \
+    for ((cd) = pmix_notify_event_cached(code),                              \
+        (nxt) = (NULL == (cd)) ? NULL : (cd)->code_next;                     \
+         NULL != (cd);                                                       \
+         (cd) = (nxt), (nxt) = (NULL == (cd)) ? NULL : (cd)->code_next)
 
 PMIX_EXPORT extern pmix_globals_t pmix_globals;
 PMIX_EXPORT extern pmix_lock_t pmix_global_lock;
@@ -67,4 +67,29 @@
         (hash) = (_hash + (_hash << 15));  \
     } while (0)
 
+/**
+ *  Compute a seeded 32-bit FNV-1a hash value
+ *
+ *  This is the hash used by the perfect hash over the reserved
+ *  dictionary keys - it must be kept in sync with the version
+ *  in contrib/construct_dictionary.py
+ *
+ *  @param str (IN)     The string which will be parsed   (char*)
+ *  @param seed (IN)    The seed to perturb the hash      (uint32_t)
+ *  @param hash (OUT)   Where the hash value will be stored (uint32_t)
+ */
+#define PMIX_HASH_FNV1A(str, seed, hash)                         \
+    do {                                                         \
+        register const unsigned char *_str;                      \
+        register uint32_t _hash;                                 \
+                                                                 \
+        _str = (const unsigned char *) (str);                    \
+        _hash = UINT32_C(0x811c9dc5) ^ (uint32_t) (seed);        \
+        while (*_str) {                                          \
+            _hash ^= *_str++;                                    \
+            _hash *= UINT32_C(0x01000193);                       \
+        }                                                        \
+        (hash) = _hash;                                          \
+    } while (0)
+
 #endif /* PMIX_HASH_STRING_H */
@@ -76,6 +76,7 @@ struct pmix_bfrops_globals_t {
     size_t initial_size;
     size_t threshold_size;
     pmix_bfrop_buffer_type_t default_type;
+    size_t plan_cache_size;
 };
 typedef struct pmix_bfrops_globals_t pmix_bfrops_globals_t;
 
@@ -90,6 +91,10 @@ PMIX_EXPORT extern pmix_bfrops_globals_t pmix_bfrops_globals;
  * buffer size to additively increasing it
  */
 #define PMIX_BFROP_DEFAULT_THRESHOLD_SIZE 1024
+/*
+ * The default number of info array pack plans to cache
+ */
+#define PMIX_BFROP_DEFAULT_PLAN_CACHE_SIZE 64
 
 /*
  * Internal type corresponding to size_t.  Do not use this in
@@ -247,6 +252,17 @@ typedef pmix_status_t (*pmix_bfrop_internal_unpack_fn_t)(pmix_pointer_array_t *r
                                                          int32_t *max_num_values,
                                                          pmix_data_type_t type);
 
+/* Keys of info, pdata and kval structs can be packed either as
+ * plain strings or, between peers that share the dictionary of
+ * reserved attributes, in a compact form. The unpack functions
+ * return a pointer to a NULL-terminated key held in the buffer or
+ * the dictionary, which the caller must copy if it is to be kept */
+typedef pmix_status_t (*pmix_bfrop_pack_key_fn_t)(pmix_pointer_array_t *regtypes,
+                                                  pmix_buffer_t *buffer, const char *key);
+
+typedef pmix_status_t (*pmix_bfrop_unpack_key_fn_t)(pmix_pointer_array_t *regtypes,
+                                                    pmix_buffer_t *buffer, const char **key);
+
 /**
  * Internal struct used for holding registered bfrop functions
  */
@@ -396,6 +412,22 @@ PMIX_EXPORT pmix_status_t pmix_bfrops_base_pack_app(pmix_pointer_array_t *regtyp
 PMIX_EXPORT pmix_status_t pmix_bfrops_base_pack_kval(pmix_pointer_array_t *regtypes,
                                                      pmix_buffer_t *buffer, const void *src,
                                                      int32_t num_vals, pmix_data_type_t type);
+PMIX_EXPORT pmix_status_t pmix_bfrops_base_pack_info_keyid(pmix_pointer_array_t *regtypes,
+                                                           pmix_buffer_t *buffer, const void *src,
+                                                           int32_t num_vals,
+                                                           pmix_data_type_t type);
+PMIX_EXPORT pmix_status_t pmix_bfrops_base_pack_pdata_keyid(pmix_pointer_array_t *regtypes,
+                                                            pmix_buffer_t *buffer, const void *src,
+                                                            int32_t num_vals,
+                                                            pmix_data_type_t type);
+PMIX_EXPORT pmix_status_t pmix_bfrops_base_pack_kval_keyid(pmix_pointer_array_t *regtypes,
+                                                           pmix_buffer_t *buffer, const void *src,
+                                                           int32_t num_vals,
+                                                           pmix_data_type_t type);
+PMIX_EXPORT pmix_status_t pmix_bfrops_base_pack_key(pmix_pointer_array_t *regtypes,
+                                                    pmix_buffer_t *buffer, const char *key);
+PMIX_EXPORT pmix_status_t pmix_bfrops_base_pack_keyid(pmix_pointer_array_t *regtypes,
+                                                      pmix_buffer_t *buffer, const char *key);
 PMIX_EXPORT pmix_status_t pmix_bfrops_base_pack_array(pmix_pointer_array_t *regtypes,
                                                       pmix_buffer_t *buffer, const void *src,
                                                       int32_t num_vals, pmix_data_type_t type);
@@ -596,6 +628,22 @@ PMIX_EXPORT pmix_status_t pmix_bfrops_base_unpack_app(pmix_pointer_array_t *regt
 PMIX_EXPORT pmix_status_t pmix_bfrops_base_unpack_kval(pmix_pointer_array_t *regtypes,
                                                        pmix_buffer_t *buffer, void *dest,
                                                        int32_t *num_vals, pmix_data_type_t type);
+PMIX_EXPORT pmix_status_t pmix_bfrops_base_unpack_info_keyid(pmix_pointer_array_t *regtypes,
+                                                             pmix_buffer_t *buffer, void *dest,
+                                                             int32_t *num_vals,
+                                                             pmix_data_type_t type);
+PMIX_EXPORT pmix_status_t pmix_bfrops_base_unpack_pdata_keyid(pmix_pointer_array_t *regtypes,
+                                                              pmix_buffer_t *buffer, void *dest,
+                                                              int32_t *num_vals,
+                                                              pmix_data_type_t type);
+PMIX_EXPORT pmix_status_t pmix_bfrops_base_unpack_kval_keyid(pmix_pointer_array_t *regtypes,
+                                                             pmix_buffer_t *buffer, void *dest,
+                                                             int32_t *num_vals,
+                                                             pmix_data_type_t type);
+PMIX_EXPORT pmix_status_t pmix_bfrops_base_unpack_key(pmix_pointer_array_t *regtypes,
+                                                      pmix_buffer_t *buffer, const char **key);
+PMIX_EXPORT pmix_status_t pmix_bfrops_base_unpack_keyid(pmix_pointer_array_t *regtypes,
+                                                        pmix_buffer_t *buffer, const char **key);
 PMIX_EXPORT pmix_status_t pmix_bfrops_base_unpack_modex(pmix_pointer_array_t *regtypes,
                                                         pmix_buffer_t *buffer, void *dest,
                                                         int32_t *num_vals, pmix_data_type_t type);
@@ -983,6 +1031,32 @@ PMIX_EXPORT pmix_status_t pmix_bfrops_base_print_satyp(char **output, char *pref
 
 PMIX_EXPORT char *pmix_bfrop_buffer_extend(pmix_buffer_t *bptr, size_t bytes_to_add);
 
+PMIX_EXPORT char *pmix_bfrop_buffer_reserve(pmix_buffer_t *bptr, size_t bytes_to_add);
+
+/* Hand the payload of a buffer that is only going to be unpacked
+ * over to reference-counted storage. Top-level string and byte
+ * object values of any pmix_kval_t subsequently unpacked from the
+ * buffer borrow their data from the storage rather than copying
+ * it, and the kval holds a reference to the storage. The buffer
+ * must not be packed into, or its payload unloaded, afterwards */
+PMIX_EXPORT pmix_status_t pmix_bfrop_buffer_share(pmix_buffer_t *buffer);
+
+/* Pack an array of info structs by following the cached plan for
+ * its shape. Returns PMIX_ERR_NOT_AVAILABLE, having packed nothing,
+ * if there is no plan for it yet */
+PMIX_EXPORT pmix_status_t pmix_bfrops_base_plan_pack_info(pmix_pointer_array_t *regtypes,
+                                                          pmix_buffer_t *buffer,
+                                                          const pmix_info_t *info, int32_t nvals,
+                                                          pmix_bfrop_pack_key_fn_t packkey);
+PMIX_EXPORT void pmix_bfrops_base_plan_init(void);
+PMIX_EXPORT void pmix_bfrops_base_plan_finalize(void);
+
+/* true if a pmix_value_t of this type holds its data by pointer */
+PMIX_EXPORT bool pmix_bfrops_base_value_byref(pmix_data_type_t type);
+
+PMIX_EXPORT size_t pmix_bfrops_base_packed_size(const void *src, size_t num_vals,
+                                                pmix_data_type_t type);
+
 PMIX_EXPORT bool pmix_bfrop_too_small(pmix_buffer_t *buffer, size_t bytes_reqd);
 
 PMIX_EXPORT pmix_status_t pmix_bfrop_store_data_type(pmix_pointer_array_t *regtypes,
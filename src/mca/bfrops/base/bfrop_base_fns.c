@@ -661,6 +661,29 @@ char *pmix_bfrop_buffer_extend(pmix_buffer_t *buffer, size_t bytes_to_add)
     return pmix_bfrops_base_tma_buffer_extend(buffer, bytes_to_add, NULL);
 }
 
+/*
+ * Internal function that sizes the buffer so the specified number of
+ * bytes can be packed without further allocations
+ */
+char *pmix_bfrop_buffer_reserve(pmix_buffer_t *buffer, size_t bytes_to_add)
+{
+    return pmix_bfrops_base_tma_buffer_reserve(buffer, bytes_to_add, NULL);
+}
+
+pmix_status_t pmix_bfrop_buffer_share(pmix_buffer_t *buffer)
+{
+    if (NULL != buffer->storage) {
+        return PMIX_SUCCESS;
+    }
+    buffer->storage = PMIX_NEW(pmix_buffer_storage_t);
+    if (NULL == buffer->storage) {
+        return PMIX_ERR_NOMEM;
+    }
+    buffer->storage->base_ptr = buffer->base_ptr;
+    buffer->storage->size = buffer->bytes_allocated;
+    return PMIX_SUCCESS;
+}
+
 /*
  * Internal function that checks to see if the specified number of bytes
  * remain in the buffer for unpacking
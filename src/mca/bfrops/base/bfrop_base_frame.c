@@ -53,6 +53,7 @@ pmix_bfrops_globals_t pmix_bfrops_globals = {
     .initialized = false,
     .initial_size = 0,
     .threshold_size = 0,
+    .plan_cache_size = 0,
 #if PMIX_ENABLE_DEBUG
     .default_type = PMIX_BFROP_BUFFER_FULLY_DESC
 #else
@@ -80,6 +81,13 @@ static int pmix_bfrop_register(pmix_mca_base_register_flag_t flags)
                                PMIX_MCA_BASE_VAR_TYPE_SIZE_T,
                                &pmix_bfrops_globals.threshold_size);
 
+    pmix_bfrops_globals.plan_cache_size = PMIX_BFROP_DEFAULT_PLAN_CACHE_SIZE;
+    pmix_mca_base_var_register("pmix", "bfrops", "base", "plan_cache_size",
+                               "Number of info array shapes for which to cache a pack plan "
+                               "(0 disables the cache)",
+                               PMIX_MCA_BASE_VAR_TYPE_SIZE_T,
+                               &pmix_bfrops_globals.plan_cache_size);
+
 #if PMIX_ENABLE_DEBUG
     pmix_bfrops_globals.default_type = PMIX_BFROP_BUFFER_FULLY_DESC;
 #else
@@ -98,6 +106,7 @@ static pmix_status_t pmix_bfrop_close(void)
     }
     pmix_bfrops_globals.initialized = false;
     pmix_bfrops_globals.selected = false;
+    pmix_bfrops_base_plan_finalize();
 
     /* the components will cleanup when closed */
     PMIX_LIST_DESTRUCT(&pmix_bfrops_globals.actives);
@@ -112,6 +121,7 @@ static pmix_status_t pmix_bfrop_open(pmix_mca_base_open_flag_t flags)
     /* initialize globals */
     pmix_bfrops_globals.initialized = true;
     PMIX_CONSTRUCT(&pmix_bfrops_globals.actives, pmix_list_t);
+    pmix_bfrops_base_plan_init();
 
     /* Open up all available components */
     rc = pmix_mca_base_framework_components_open(&pmix_bfrops_base_framework, flags);
@@ -145,17 +155,34 @@ static void pmix_buffer_construct(pmix_buffer_t *buffer)
     /* Make everything NULL to begin with */
     buffer->base_ptr = buffer->pack_ptr = buffer->unpack_ptr = NULL;
     buffer->bytes_allocated = buffer->bytes_used = 0;
+    buffer->storage = NULL;
 }
 
 static void pmix_buffer_destruct(pmix_buffer_t *buffer)
 {
-    if (NULL != buffer->base_ptr) {
+    if (NULL != buffer->storage) {
+        /* the memory lives on for as long as values borrow it */
+        PMIX_RELEASE(buffer->storage);
+    } else if (NULL != buffer->base_ptr) {
         free(buffer->base_ptr);
     }
 }
 
 PMIX_CLASS_INSTANCE(pmix_buffer_t, pmix_object_t, pmix_buffer_construct, pmix_buffer_destruct);
 
+static void stcon(pmix_buffer_storage_t *p)
+{
+    p->base_ptr = NULL;
+    p->size = 0;
+}
+static void stdes(pmix_buffer_storage_t *p)
+{
+    if (NULL != p->base_ptr) {
+        free(p->base_ptr);
+    }
+}
+PMIX_CLASS_INSTANCE(pmix_buffer_storage_t, pmix_object_t, stcon, stdes);
+
 static void pmix_bfrop_type_info_construct(pmix_bfrop_type_info_t *obj)
 {
     obj->odti_name = NULL;
@@ -179,6 +206,7 @@ static void kvcon(pmix_kval_t *k)
 {
     k->key = NULL;
     k->value = NULL;
+    k->storage = NULL;
 }
 static void kvdes(pmix_kval_t *k)
 {
@@ -186,7 +214,13 @@ static void kvdes(pmix_kval_t *k)
         free(k->key);
     }
     if (NULL != k->value) {
+        if (NULL != k->storage) {
+            PMIX_VALUE_UNBORROW(k->value);
+        }
         PMIX_VALUE_RELEASE(k->value);
     }
+    if (NULL != k->storage) {
+        PMIX_RELEASE(k->storage);
+    }
 }
 PMIX_CLASS_INSTANCE(pmix_kval_t, pmix_list_item_t, kvcon, kvdes);
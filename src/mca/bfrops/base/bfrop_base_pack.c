@@ -29,10 +29,13 @@
 
 #include "src/class/pmix_pointer_array.h"
 #include "src/hwloc/pmix_hwloc.h"
+#include "src/include/pmix_dictionary.h"
 #include "src/include/pmix_globals.h"
 #include "src/mca/preg/preg.h"
 #include "src/util/pmix_argv.h"
+#include "src/util/pmix_bswap.h"
 #include "src/util/pmix_error.h"
+#include "src/util/pmix_hash.h"
 #include "src/util/pmix_output.h"
 
 #include "src/mca/bfrops/base/base.h"
@@ -48,6 +51,18 @@ pmix_status_t pmix_bfrops_base_pack(pmix_pointer_array_t *regtypes, pmix_buffer_
         return PMIX_ERR_BAD_PARAM;
     }
 
+    /* structured types would otherwise grow the buffer a field at a
+     * time - size it for the whole payload, plus room for the count
+     * and type descriptors, before packing anything */
+    if (0 < num_vals
+        && (PMIX_INFO == type || PMIX_VALUE == type || PMIX_DATA_ARRAY == type
+            || PMIX_KVAL == type)) {
+        if (NULL == pmix_bfrop_buffer_reserve(buffer, 16 + pmix_bfrops_base_packed_size(
+                                                               src, num_vals, type))) {
+            return PMIX_ERR_OUT_OF_RESOURCE;
+        }
+    }
+
     /* Pack the number of values */
     if (PMIX_BFROP_BUFFER_FULLY_DESC == buffer->type) {
         if (PMIX_SUCCESS != (rc = pmix_bfrop_store_data_type(regtypes, buffer, PMIX_INT32))) {
@@ -215,8 +230,7 @@ pmix_status_t pmix_bfrops_base_pack_byte(pmix_pointer_array_t *regtypes, pmix_bu
 pmix_status_t pmix_bfrops_base_pack_int16(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
                                           const void *src, int32_t num_vals, pmix_data_type_t type)
 {
-    int32_t i;
-    uint16_t tmp, *srctmp = (uint16_t *) src;
+    uint16_t tmp;
     char *dst;
 
     pmix_output_verbose(20, pmix_bfrops_base_framework.framework_output,
@@ -229,11 +243,7 @@ pmix_status_t pmix_bfrops_base_pack_int16(pmix_pointer_array_t *regtypes, pmix_b
         return PMIX_ERR_OUT_OF_RESOURCE;
     }
 
-    for (i = 0; i < num_vals; ++i) {
-        tmp = pmix_htons(srctmp[i]);
-        memcpy(dst, &tmp, sizeof(tmp));
-        dst += sizeof(tmp);
-    }
+    pmix_bswap16_array(dst, src, num_vals);
     buffer->pack_ptr += num_vals * sizeof(tmp);
     buffer->bytes_used += num_vals * sizeof(tmp);
 
@@ -246,8 +256,7 @@ pmix_status_t pmix_bfrops_base_pack_int16(pmix_pointer_array_t *regtypes, pmix_b
 pmix_status_t pmix_bfrops_base_pack_int32(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
                                           const void *src, int32_t num_vals, pmix_data_type_t type)
 {
-    int32_t i;
-    uint32_t tmp, *srctmp = (uint32_t *) src;
+    uint32_t tmp;
     char *dst;
 
     pmix_output_verbose(20, pmix_bfrops_base_framework.framework_output,
@@ -259,11 +268,7 @@ pmix_status_t pmix_bfrops_base_pack_int32(pmix_pointer_array_t *regtypes, pmix_b
     if (NULL == (dst = pmix_bfrop_buffer_extend(buffer, num_vals * sizeof(tmp)))) {
         return PMIX_ERR_OUT_OF_RESOURCE;
     }
-    for (i = 0; i < num_vals; ++i) {
-        tmp = htonl(srctmp[i]);
-        memcpy(dst, &tmp, sizeof(tmp));
-        dst += sizeof(tmp);
-    }
+    pmix_bswap32_array(dst, src, num_vals);
     buffer->pack_ptr += num_vals * sizeof(tmp);
     buffer->bytes_used += num_vals * sizeof(tmp);
 
@@ -276,10 +281,8 @@ pmix_status_t pmix_bfrops_base_pack_int32(pmix_pointer_array_t *regtypes, pmix_b
 pmix_status_t pmix_bfrops_base_pack_int64(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
                                           const void *src, int32_t num_vals, pmix_data_type_t type)
 {
-    int32_t i;
-    uint64_t tmp, tmp2;
     char *dst;
-    size_t bytes_packed = num_vals * sizeof(tmp);
+    size_t bytes_packed = num_vals * sizeof(uint64_t);
 
     pmix_output_verbose(20, pmix_bfrops_base_framework.framework_output,
                         "pmix_bfrops_base_pack_int64 * %d\n", num_vals);
@@ -291,12 +294,7 @@ pmix_status_t pmix_bfrops_base_pack_int64(pmix_pointer_array_t *regtypes, pmix_b
         return PMIX_ERR_OUT_OF_RESOURCE;
     }
 
-    for (i = 0; i < num_vals; ++i) {
-        memcpy(&tmp2, (char *) src + i * sizeof(uint64_t), sizeof(uint64_t));
-        tmp = pmix_hton64(tmp2);
-        memcpy(dst, &tmp, sizeof(tmp));
-        dst += sizeof(tmp);
-    }
+    pmix_bswap64_array(dst, src, num_vals);
     buffer->pack_ptr += bytes_packed;
     buffer->bytes_used += bytes_packed;
 
@@ -567,22 +565,24 @@ pmix_status_t pmix_bfrops_base_pack_value(pmix_pointer_array_t *regtypes, pmix_b
     return PMIX_SUCCESS;
 }
 
-pmix_status_t pmix_bfrops_base_pack_info(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
-                                         const void *src, int32_t num_vals, pmix_data_type_t type)
+static pmix_status_t pack_info(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
+                               const void *src, int32_t num_vals, pmix_bfrop_pack_key_fn_t packkey)
 {
     pmix_info_t *info;
     int32_t i;
     int ret;
-    char *foo;
-
-    PMIX_HIDE_UNUSED_PARAMS(type);
 
     info = (pmix_info_t *) src;
 
+    /* arrays of a shape we have packed before can follow a plan */
+    ret = pmix_bfrops_base_plan_pack_info(regtypes, buffer, info, num_vals, packkey);
+    if (PMIX_ERR_NOT_AVAILABLE != ret) {
+        return ret;
+    }
+
     for (i = 0; i < num_vals; ++i) {
         /* pack key */
-        foo = info[i].key;
-        PMIX_BFROPS_PACK_TYPE(ret, buffer, &foo, 1, PMIX_STRING, regtypes);
+        ret = packkey(regtypes, buffer, info[i].key);
         if (PMIX_SUCCESS != ret) {
             return ret;
         }
@@ -604,15 +604,29 @@ pmix_status_t pmix_bfrops_base_pack_info(pmix_pointer_array_t *regtypes, pmix_bu
     return PMIX_SUCCESS;
 }
 
-pmix_status_t pmix_bfrops_base_pack_pdata(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
-                                          const void *src, int32_t num_vals, pmix_data_type_t type)
+pmix_status_t pmix_bfrops_base_pack_info(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
+                                         const void *src, int32_t num_vals, pmix_data_type_t type)
+{
+    PMIX_HIDE_UNUSED_PARAMS(type);
+
+    return pack_info(regtypes, buffer, src, num_vals, pmix_bfrops_base_pack_key);
+}
+
+pmix_status_t pmix_bfrops_base_pack_info_keyid(pmix_pointer_array_t *regtypes,
+                                               pmix_buffer_t *buffer, const void *src,
+                                               int32_t num_vals, pmix_data_type_t type)
+{
+    PMIX_HIDE_UNUSED_PARAMS(type);
+
+    return pack_info(regtypes, buffer, src, num_vals, pmix_bfrops_base_pack_keyid);
+}
+
+static pmix_status_t pack_pdata(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
+                                const void *src, int32_t num_vals, pmix_bfrop_pack_key_fn_t packkey)
 {
     pmix_pdata_t *pdata;
     int32_t i;
     int ret;
-    char *foo;
-
-    PMIX_HIDE_UNUSED_PARAMS(type);
 
     pdata = (pmix_pdata_t *) src;
 
@@ -623,8 +637,7 @@ pmix_status_t pmix_bfrops_base_pack_pdata(pmix_pointer_array_t *regtypes, pmix_b
             return ret;
         }
         /* pack key */
-        foo = pdata[i].key;
-        PMIX_BFROPS_PACK_TYPE(ret, buffer, &foo, 1, PMIX_STRING, regtypes);
+        ret = packkey(regtypes, buffer, pdata[i].key);
         if (PMIX_SUCCESS != ret) {
             PMIX_ERROR_LOG(ret);
             return ret;
@@ -644,6 +657,23 @@ pmix_status_t pmix_bfrops_base_pack_pdata(pmix_pointer_array_t *regtypes, pmix_b
     return PMIX_SUCCESS;
 }
 
+pmix_status_t pmix_bfrops_base_pack_pdata(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
+                                          const void *src, int32_t num_vals, pmix_data_type_t type)
+{
+    PMIX_HIDE_UNUSED_PARAMS(type);
+
+    return pack_pdata(regtypes, buffer, src, num_vals, pmix_bfrops_base_pack_key);
+}
+
+pmix_status_t pmix_bfrops_base_pack_pdata_keyid(pmix_pointer_array_t *regtypes,
+                                                pmix_buffer_t *buffer, const void *src,
+                                                int32_t num_vals, pmix_data_type_t type)
+{
+    PMIX_HIDE_UNUSED_PARAMS(type);
+
+    return pack_pdata(regtypes, buffer, src, num_vals, pmix_bfrops_base_pack_keyid);
+}
+
 pmix_status_t pmix_bfrops_base_pack_app(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
                                         const void *src, int32_t num_vals, pmix_data_type_t type)
 {
@@ -716,20 +746,18 @@ pmix_status_t pmix_bfrops_base_pack_app(pmix_pointer_array_t *regtypes, pmix_buf
     return PMIX_SUCCESS;
 }
 
-pmix_status_t pmix_bfrops_base_pack_kval(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
-                                         const void *src, int32_t num_vals, pmix_data_type_t type)
+static pmix_status_t pack_kval(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
+                               const void *src, int32_t num_vals, pmix_bfrop_pack_key_fn_t packkey)
 {
     pmix_kval_t *ptr;
     int32_t i;
     int ret;
 
-    PMIX_HIDE_UNUSED_PARAMS(type);
-
     ptr = (pmix_kval_t *) src;
 
     for (i = 0; i < num_vals; ++i) {
         /* pack the key */
-        PMIX_BFROPS_PACK_TYPE(ret, buffer, &ptr[i].key, 1, PMIX_STRING, regtypes);
+        ret = packkey(regtypes, buffer, ptr[i].key);
         if (PMIX_SUCCESS != ret) {
             return ret;
         }
@@ -742,6 +770,73 @@ pmix_status_t pmix_bfrops_base_pack_kval(pmix_pointer_array_t *regtypes, pmix_bu
     return PMIX_SUCCESS;
 }
 
+pmix_status_t pmix_bfrops_base_pack_kval(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
+                                         const void *src, int32_t num_vals, pmix_data_type_t type)
+{
+    PMIX_HIDE_UNUSED_PARAMS(type);
+
+    return pack_kval(regtypes, buffer, src, num_vals, pmix_bfrops_base_pack_key);
+}
+
+pmix_status_t pmix_bfrops_base_pack_kval_keyid(pmix_pointer_array_t *regtypes,
+                                               pmix_buffer_t *buffer, const void *src,
+                                               int32_t num_vals, pmix_data_type_t type)
+{
+    PMIX_HIDE_UNUSED_PARAMS(type);
+
+    return pack_kval(regtypes, buffer, src, num_vals, pmix_bfrops_base_pack_keyid);
+}
+
+/* KEYS */
+pmix_status_t pmix_bfrops_base_pack_key(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
+                                        const char *key)
+{
+    pmix_status_t ret;
+
+    PMIX_BFROPS_PACK_TYPE(ret, buffer, &key, 1, PMIX_STRING, regtypes);
+    return ret;
+}
+
+/* Keys found in the dictionary of reserved attributes are sent as
+ * their index and all others as a string. Both start with a tag
+ * whose low bit tells them apart - the rest of the tag holds the
+ * index or the length of the string, including its terminator. A
+ * zero tag is a NULL key. The tag is packed as an unsigned integer,
+ * so the squash component keeps small indexes to a byte or two */
+pmix_status_t pmix_bfrops_base_pack_keyid(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
+                                          const char *key)
+{
+    pmix_regattr_input_t *p;
+    pmix_status_t ret;
+    uint32_t tag;
+    size_t len;
+
+    if (NULL == key) {
+        tag = 0;
+        PMIX_BFROPS_PACK_TYPE(ret, buffer, &tag, 1, PMIX_UINT32, regtypes);
+        return ret;
+    }
+    if (PMIX_CHECK_RESERVED_KEY(key)) {
+        p = pmix_hash_lookup_key(UINT32_MAX, key);
+        if (NULL != p && p->index < PMIX_INDEX_BOUNDARY) {
+            tag = (p->index << 1) | 1;
+            PMIX_BFROPS_PACK_TYPE(ret, buffer, &tag, 1, PMIX_UINT32, regtypes);
+            return ret;
+        }
+    }
+    len = strlen(key) + 1;
+    if (INT32_MAX < len) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+    tag = (uint32_t) len << 1;
+    PMIX_BFROPS_PACK_TYPE(ret, buffer, &tag, 1, PMIX_UINT32, regtypes);
+    if (PMIX_SUCCESS != ret) {
+        return ret;
+    }
+    PMIX_BFROPS_PACK_TYPE(ret, buffer, key, len, PMIX_BYTE, regtypes);
+    return ret;
+}
+
 pmix_status_t pmix_bfrops_base_pack_persist(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
                                             const void *src, int32_t num_vals,
                                             pmix_data_type_t type)
@@ -960,16 +1055,11 @@ pmix_status_t pmix_bfrops_base_pack_query(pmix_pointer_array_t *regtypes, pmix_b
 
 /********************/
 /* PACK FUNCTIONS FOR VALUE TYPES */
-pmix_status_t pmix_bfrops_base_pack_val(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
-                                        pmix_value_t *p)
+/* need to callout all the fields that are pointers to
+ * a data object as opposed to a simple value */
+bool pmix_bfrops_base_value_byref(pmix_data_type_t type)
 {
-    pmix_status_t ret;
-
-    switch (p->type) {
-    case PMIX_UNDEF:
-        break;
-    /* need to callout all the fields that are pointers to
-     * a data object as opposed to a simple value */
+    switch (type) {
     case PMIX_PROC:
     case PMIX_PROC_NSPACE:
     case PMIX_PROC_INFO:
@@ -985,12 +1075,26 @@ pmix_status_t pmix_bfrops_base_pack_val(pmix_pointer_array_t *regtypes, pmix_buf
     case PMIX_DISK_STATS:
     case PMIX_NET_STATS:
     case PMIX_NODE_STATS:
+        return true;
+    default:
+        return false;
+    }
+}
+
+pmix_status_t pmix_bfrops_base_pack_val(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
+                                        pmix_value_t *p)
+{
+    pmix_status_t ret;
+
+    if (PMIX_UNDEF == p->type) {
+        return PMIX_SUCCESS;
+    }
+    if (pmix_bfrops_base_value_byref(p->type)) {
         PMIX_BFROPS_PACK_TYPE(ret, buffer, p->data.ptr, 1, p->type, regtypes);
         if (PMIX_SUCCESS != ret) {
             return ret;
         }
-        break;
-    default:
+    } else {
         /* pass the address of the value instead of the value itself */
         PMIX_BFROPS_PACK_TYPE(ret, buffer, &p->data, 1, p->type, regtypes);
         if (PMIX_ERR_UNKNOWN_DATA_TYPE == ret) {
@@ -0,0 +1,335 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "src/include/pmix_config.h"
+
+#include <string.h>
+
+#include "src/include/pmix_globals.h"
+#include "src/threads/pmix_mutex.h"
+#include "src/util/pmix_error.h"
+
+#include "src/mca/bfrops/base/base.h"
+
+/* Pack plans for arrays of pmix_info_t
+ *
+ * Messages such as get requests and fence directives carry info
+ * arrays of the same shape - the same keys holding the same types of
+ * value - over and over. Packing one normally walks each key through
+ * the key packer and looks up the pack function for every field.
+ * A plan records, for one shape and one bfrops module, the encoded
+ * form of each key and value type together with the pack functions
+ * for the directives and value, so subsequent arrays of that shape
+ * copy the encoded key and type and call straight into the value
+ * packer. The encoded bytes are produced by the module's own key and
+ * type packers, so plans do not change the wire format.
+ *
+ * Plans are held in a small direct-mapped cache indexed by a hash of
+ * the shape. A plan is only built the second time its shape is seen
+ * so that one-off arrays do not churn the cache */
+
+typedef struct {
+    pmix_data_type_t type;
+    /* pack function for the value - NULL if it has none */
+    pmix_bfrop_type_info_t *vinfo;
+    /* whether the value is held by pointer */
+    bool byref;
+    /* offsets and lengths of the encoded key and type */
+    size_t koff;
+    size_t klen;
+    size_t toff;
+    size_t tlen;
+} pmix_bfrop_plan_elem_t;
+
+typedef struct {
+    pmix_object_t super;
+    pmix_pointer_array_t *regtypes;
+    uint64_t hash;
+    int32_t nvals;
+    pmix_bfrop_type_info_t *dinfo;
+    pmix_bfrop_plan_elem_t *elems;
+    /* the keys of the shape, used to confirm a match */
+    pmix_key_t *keys;
+    char *bytes;
+} pmix_bfrop_plan_t;
+
+static void plcon(pmix_bfrop_plan_t *p)
+{
+    p->regtypes = NULL;
+    p->hash = 0;
+    p->nvals = 0;
+    p->dinfo = NULL;
+    p->elems = NULL;
+    p->keys = NULL;
+    p->bytes = NULL;
+}
+static void pldes(pmix_bfrop_plan_t *p)
+{
+    if (NULL != p->elems) {
+        free(p->elems);
+    }
+    if (NULL != p->keys) {
+        free(p->keys);
+    }
+    if (NULL != p->bytes) {
+        free(p->bytes);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_bfrop_plan_t, pmix_object_t, plcon, pldes);
+
+typedef struct {
+    /* a non-zero hash without a plan marks a shape seen once */
+    uint64_t hash;
+    pmix_pointer_array_t *regtypes;
+    pmix_bfrop_plan_t *plan;
+} pmix_bfrop_plan_slot_t;
+
+static pmix_bfrop_plan_slot_t *slots = NULL;
+static size_t nslots = 0;
+static pmix_mutex_t plan_lock;
+
+void pmix_bfrops_base_plan_init(void)
+{
+    PMIX_CONSTRUCT(&plan_lock, pmix_mutex_t);
+    nslots = pmix_bfrops_globals.plan_cache_size;
+    if (0 < nslots) {
+        slots = (pmix_bfrop_plan_slot_t *) calloc(nslots, sizeof(pmix_bfrop_plan_slot_t));
+        if (NULL == slots) {
+            nslots = 0;
+        }
+    }
+}
+
+void pmix_bfrops_base_plan_finalize(void)
+{
+    size_t n;
+
+    if (NULL != slots) {
+        for (n = 0; n < nslots; n++) {
+            if (NULL != slots[n].plan) {
+                PMIX_RELEASE(slots[n].plan);
+            }
+        }
+        free(slots);
+        slots = NULL;
+    }
+    nslots = 0;
+    PMIX_DESTRUCT(&plan_lock);
+}
+
+/* FNV-1a over the module, the keys and the value types */
+static uint64_t shape_hash(pmix_pointer_array_t *regtypes, const pmix_info_t *info,
+                           int32_t nvals)
+{
+    uint64_t h = 14695981039346656037ULL;
+    const unsigned char *c;
+    int32_t i;
+
+    h = (h ^ (uint64_t) (uintptr_t) regtypes) * 1099511628211ULL;
+    h = (h ^ (uint64_t) nvals) * 1099511628211ULL;
+    for (i = 0; i < nvals; i++) {
+        for (c = (const unsigned char *) info[i].key; '\0' != *c; c++) {
+            h = (h ^ *c) * 1099511628211ULL;
+        }
+        h = (h ^ (uint64_t) info[i].value.type) * 1099511628211ULL;
+    }
+    /* zero marks an empty slot */
+    return (0 == h) ? 1 : h;
+}
+
+static bool plan_matches(const pmix_bfrop_plan_t *plan, const pmix_info_t *info)
+{
+    int32_t i;
+
+    for (i = 0; i < plan->nvals; i++) {
+        if (plan->elems[i].type != info[i].value.type
+            || 0 != strncmp(plan->keys[i], info[i].key, PMIX_MAX_KEYLEN)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static pmix_bfrop_plan_t *plan_build(pmix_pointer_array_t *regtypes, const pmix_info_t *info,
+                                     int32_t nvals, uint64_t hash,
+                                     pmix_bfrop_pack_key_fn_t packkey)
+{
+    pmix_bfrop_plan_t *plan;
+    pmix_bfrop_plan_elem_t *e;
+    pmix_buffer_t scratch;
+    pmix_status_t rc;
+    int32_t i;
+
+    plan = PMIX_NEW(pmix_bfrop_plan_t);
+    if (NULL == plan) {
+        return NULL;
+    }
+    plan->regtypes = regtypes;
+    plan->hash = hash;
+    plan->nvals = nvals;
+    plan->dinfo = (pmix_bfrop_type_info_t *) pmix_pointer_array_get_item(regtypes,
+                                                                          PMIX_INFO_DIRECTIVES);
+    plan->elems = (pmix_bfrop_plan_elem_t *) calloc(nvals, sizeof(pmix_bfrop_plan_elem_t));
+    plan->keys = (pmix_key_t *) calloc(nvals, sizeof(pmix_key_t));
+    if (NULL == plan->dinfo || NULL == plan->elems || NULL == plan->keys) {
+        PMIX_RELEASE(plan);
+        return NULL;
+    }
+
+    PMIX_CONSTRUCT(&scratch, pmix_buffer_t);
+    for (i = 0; i < nvals; i++) {
+        e = &plan->elems[i];
+        e->type = info[i].value.type;
+        PMIX_LOAD_KEY(plan->keys[i], info[i].key);
+        if (PMIX_UNDEF != e->type) {
+            e->vinfo = (pmix_bfrop_type_info_t *) pmix_pointer_array_get_item(regtypes, e->type);
+            if (NULL == e->vinfo) {
+                /* leave the error reporting to the regular path */
+                goto fail;
+            }
+            e->byref = pmix_bfrops_base_value_byref(e->type);
+        }
+        e->koff = scratch.bytes_used;
+        rc = packkey(regtypes, &scratch, plan->keys[i]);
+        if (PMIX_SUCCESS != rc) {
+            goto fail;
+        }
+        e->klen = scratch.bytes_used - e->koff;
+        e->toff = scratch.bytes_used;
+        rc = pmix_bfrop_store_data_type(regtypes, &scratch, e->type);
+        if (PMIX_SUCCESS != rc) {
+            goto fail;
+        }
+        e->tlen = scratch.bytes_used - e->toff;
+    }
+    /* take the encoded bytes */
+    plan->bytes = scratch.base_ptr;
+    scratch.base_ptr = NULL;
+    PMIX_DESTRUCT(&scratch);
+    return plan;
+
+fail:
+    PMIX_DESTRUCT(&scratch);
+    PMIX_RELEASE(plan);
+    return NULL;
+}
+
+static pmix_bfrop_plan_t *plan_lookup(pmix_pointer_array_t *regtypes, const pmix_info_t *info,
+                                      int32_t nvals, pmix_bfrop_pack_key_fn_t packkey)
+{
+    pmix_bfrop_plan_slot_t *slot;
+    pmix_bfrop_plan_t *plan = NULL;
+    uint64_t hash;
+
+    hash = shape_hash(regtypes, info, nvals);
+    slot = &slots[hash % nslots];
+
+    pmix_mutex_lock(&plan_lock);
+    if (slot->hash == hash && slot->regtypes == regtypes) {
+        plan = slot->plan;
+        if (NULL != plan) {
+            PMIX_RETAIN(plan);
+            pmix_mutex_unlock(&plan_lock);
+            if (plan_matches(plan, info)) {
+                return plan;
+            }
+            /* a different shape with the same hash */
+            PMIX_RELEASE(plan);
+            return NULL;
+        }
+        pmix_mutex_unlock(&plan_lock);
+        /* second sighting - worth building */
+        plan = plan_build(regtypes, info, nvals, hash, packkey);
+        if (NULL == plan) {
+            return NULL;
+        }
+        pmix_mutex_lock(&plan_lock);
+        if (NULL != slot->plan) {
+            PMIX_RELEASE(slot->plan);
+        }
+        PMIX_RETAIN(plan);
+        slot->hash = hash;
+        slot->regtypes = regtypes;
+        slot->plan = plan;
+        pmix_mutex_unlock(&plan_lock);
+        return plan;
+    }
+    /* first sighting - just remember it */
+    if (NULL != slot->plan) {
+        PMIX_RELEASE(slot->plan);
+        slot->plan = NULL;
+    }
+    slot->hash = hash;
+    slot->regtypes = regtypes;
+    pmix_mutex_unlock(&plan_lock);
+    return NULL;
+}
+
+static pmix_status_t copy_bytes(pmix_buffer_t *buffer, const char *src, size_t len)
+{
+    char *dst;
+
+    if (NULL == (dst = pmix_bfrop_buffer_extend(buffer, len))) {
+        return PMIX_ERR_OUT_OF_RESOURCE;
+    }
+    memcpy(dst, src, len);
+    buffer->pack_ptr += len;
+    buffer->bytes_used += len;
+    return PMIX_SUCCESS;
+}
+
+pmix_status_t pmix_bfrops_base_plan_pack_info(pmix_pointer_array_t *regtypes,
+                                              pmix_buffer_t *buffer, const pmix_info_t *info,
+                                              int32_t nvals, pmix_bfrop_pack_key_fn_t packkey)
+{
+    pmix_bfrop_plan_t *plan;
+    pmix_bfrop_plan_elem_t *e;
+    const void *src;
+    pmix_status_t rc = PMIX_SUCCESS;
+    int32_t i;
+
+    if (0 == nslots || 0 >= nvals) {
+        return PMIX_ERR_NOT_AVAILABLE;
+    }
+    plan = plan_lookup(regtypes, info, nvals, packkey);
+    if (NULL == plan) {
+        return PMIX_ERR_NOT_AVAILABLE;
+    }
+
+    for (i = 0; i < nvals; i++) {
+        e = &plan->elems[i];
+        rc = copy_bytes(buffer, plan->bytes + e->koff, e->klen);
+        if (PMIX_SUCCESS != rc) {
+            break;
+        }
+        rc = plan->dinfo->odti_pack_fn(regtypes, buffer, &info[i].flags, 1,
+                                       PMIX_INFO_DIRECTIVES);
+        if (PMIX_SUCCESS != rc) {
+            break;
+        }
+        rc = copy_bytes(buffer, plan->bytes + e->toff, e->tlen);
+        if (PMIX_SUCCESS != rc) {
+            break;
+        }
+        if (NULL == e->vinfo) {
+            continue;
+        }
+        if (e->byref) {
+            src = info[i].value.data.ptr;
+        } else {
+            src = &info[i].value.data;
+        }
+        rc = e->vinfo->odti_pack_fn(regtypes, buffer, src, 1, e->type);
+        if (PMIX_SUCCESS != rc) {
+            break;
+        }
+    }
+    PMIX_RELEASE(plan);
+    return rc;
+}
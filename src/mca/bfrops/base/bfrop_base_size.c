@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "src/include/pmix_config.h"
+
+#include <string.h>
+
+#include "src/include/pmix_globals.h"
+#include "src/mca/psquash/psquash.h"
+
+#include "src/mca/bfrops/base/base.h"
+
+/* Compute the number of bytes that packing a set of values will add
+ * to a buffer so the space can be reserved in a single allocation.
+ * The width of an integer on the wire depends on the bfrops module
+ * and psquash component in use, so each integer is charged the
+ * larger of its native and maximum encoded widths - the result is
+ * therefore exact for fixed-width encodings and a tight upper bound
+ * for variable-length ones. Types that are rarely found in info or
+ * value arrays are not charged at all, which only means the buffer
+ * may still need to grow while packing them */
+
+typedef struct {
+    size_t w16;
+    size_t w32;
+    size_t w64;
+} pmix_bfrop_widths_t;
+
+static size_t int_width(pmix_data_type_t type, size_t native)
+{
+    size_t sz;
+
+    if (NULL != pmix_psquash.get_max_size
+        && PMIX_SUCCESS == pmix_psquash.get_max_size(type, &sz) && native < sz) {
+        return sz;
+    }
+    return native;
+}
+
+static size_t str_size(const pmix_bfrop_widths_t *w, const char *s)
+{
+    if (NULL == s) {
+        return w->w32;
+    }
+    return w->w32 + strlen(s) + 1;
+}
+
+static size_t elem_size(const pmix_bfrop_widths_t *w, const void *src, pmix_data_type_t type);
+
+static size_t val_size(const pmix_bfrop_widths_t *w, const pmix_value_t *v)
+{
+    size_t sz = w->w16; // the type
+
+    switch (v->type) {
+    case PMIX_UNDEF:
+        break;
+    case PMIX_PROC:
+    case PMIX_PROC_INFO:
+    case PMIX_DATA_ARRAY:
+        sz += elem_size(w, v->data.ptr, v->type);
+        break;
+    case PMIX_PROC_NSPACE:
+        sz += str_size(w, (const char *) v->data.ptr);
+        break;
+    default:
+        sz += elem_size(w, &v->data, v->type);
+        break;
+    }
+    return sz;
+}
+
+static size_t elem_size(const pmix_bfrop_widths_t *w, const void *src, pmix_data_type_t type)
+{
+    const pmix_info_t *info;
+    const pmix_proc_info_t *pinfo;
+    const pmix_data_array_t *darray;
+    const pmix_kval_t *kv;
+    const pmix_envar_t *envar;
+    size_t sz;
+
+    switch (type) {
+    case PMIX_BOOL:
+    case PMIX_BYTE:
+    case PMIX_INT8:
+    case PMIX_UINT8:
+    case PMIX_PERSIST:
+    case PMIX_SCOPE:
+    case PMIX_DATA_RANGE:
+    case PMIX_COMMAND:
+    case PMIX_PROC_STATE:
+    case PMIX_ALLOC_DIRECTIVE:
+    case PMIX_JOB_STATE:
+    case PMIX_LINK_STATE:
+    case PMIX_POINTER:
+        return 1;
+    case PMIX_INT16:
+    case PMIX_UINT16:
+    case PMIX_DATA_TYPE:
+    case PMIX_IOF_CHANNEL:
+    case PMIX_LOCTYPE:
+    case PMIX_STOR_ACCESS_TYPE:
+        return w->w16;
+    case PMIX_INT32:
+    case PMIX_UINT32:
+    case PMIX_STATUS:
+    case PMIX_PROC_RANK:
+    case PMIX_INFO_DIRECTIVES:
+        return w->w32;
+    case PMIX_INT64:
+    case PMIX_UINT64:
+    case PMIX_TIME:
+    case PMIX_DEVTYPE:
+    case PMIX_STOR_MEDIUM:
+    case PMIX_STOR_ACCESS:
+    case PMIX_STOR_PERSIST:
+        return w->w64;
+    case PMIX_INT:
+    case PMIX_UINT:
+    case PMIX_SIZE:
+    case PMIX_PID:
+        /* these carry a description of their native type */
+        return w->w16 + w->w64;
+    case PMIX_TIMEVAL:
+        return 2 * w->w64;
+    case PMIX_FLOAT:
+    case PMIX_DOUBLE:
+        /* converted to a string - charge for a typical one */
+        return w->w32 + 16;
+    case PMIX_STRING:
+        return str_size(w, *(char *const *) src);
+    case PMIX_BYTE_OBJECT:
+    case PMIX_COMPRESSED_STRING:
+    case PMIX_COMPRESSED_BYTE_OBJECT:
+    case PMIX_REGEX:
+        return w->w16 + w->w64 + ((const pmix_byte_object_t *) src)->size;
+    case PMIX_PROC:
+        return str_size(w, ((const pmix_proc_t *) src)->nspace) + w->w32;
+    case PMIX_PROC_INFO:
+        pinfo = (const pmix_proc_info_t *) src;
+        return elem_size(w, &pinfo->proc, PMIX_PROC) + str_size(w, pinfo->hostname)
+               + str_size(w, pinfo->executable_name) + elem_size(w, &pinfo->pid, PMIX_PID)
+               + w->w32 + 1;
+    case PMIX_ENVAR:
+        envar = (const pmix_envar_t *) src;
+        return str_size(w, envar->envar) + str_size(w, envar->value) + 1;
+    case PMIX_VALUE:
+        return val_size(w, (const pmix_value_t *) src);
+    case PMIX_INFO:
+        info = (const pmix_info_t *) src;
+        return str_size(w, info->key) + w->w32 + val_size(w, &info->value);
+    case PMIX_KVAL:
+        kv = (const pmix_kval_t *) src;
+        sz = str_size(w, kv->key);
+        if (NULL != kv->value) {
+            sz += val_size(w, kv->value);
+        }
+        return sz;
+    case PMIX_DATA_ARRAY:
+        darray = (const pmix_data_array_t *) src;
+        sz = w->w16 + w->w16 + w->w64;
+        if (0 == darray->size || PMIX_UNDEF == darray->type || NULL == darray->array) {
+            return sz;
+        }
+        return sz + pmix_bfrops_base_packed_size(darray->array, darray->size, darray->type);
+    default:
+        return 0;
+    }
+}
+
+size_t pmix_bfrops_base_packed_size(const void *src, size_t num_vals, pmix_data_type_t type)
+{
+    pmix_bfrop_widths_t w;
+    size_t n, sz = 0;
+
+    if (NULL == src || 0 == num_vals) {
+        return 0;
+    }
+    w.w16 = int_width(PMIX_UINT16, sizeof(uint16_t));
+    w.w32 = int_width(PMIX_UINT32, sizeof(uint32_t));
+    w.w64 = int_width(PMIX_UINT64, sizeof(uint64_t));
+
+    switch (type) {
+    case PMIX_INFO:
+        for (n = 0; n < num_vals; n++) {
+            sz += elem_size(&w, &((const pmix_info_t *) src)[n], type);
+        }
+        break;
+    case PMIX_VALUE:
+        for (n = 0; n < num_vals; n++) {
+            sz += elem_size(&w, &((const pmix_value_t *) src)[n], type);
+        }
+        break;
+    case PMIX_DATA_ARRAY:
+        for (n = 0; n < num_vals; n++) {
+            sz += elem_size(&w, &((const pmix_data_array_t *) src)[n], type);
+        }
+        break;
+    case PMIX_KVAL:
+        for (n = 0; n < num_vals; n++) {
+            sz += elem_size(&w, &((const pmix_kval_t *) src)[n], type);
+        }
+        break;
+    case PMIX_STRING:
+        for (n = 0; n < num_vals; n++) {
+            sz += str_size(&w, ((char *const *) src)[n]);
+        }
+        break;
+    case PMIX_PROC:
+        for (n = 0; n < num_vals; n++) {
+            sz += elem_size(&w, &((const pmix_proc_t *) src)[n], type);
+        }
+        break;
+    case PMIX_BYTE_OBJECT:
+        for (n = 0; n < num_vals; n++) {
+            sz += elem_size(&w, &((const pmix_byte_object_t *) src)[n], type);
+        }
+        break;
+    default:
+        /* fixed-size elements */
+        sz = num_vals * elem_size(&w, src, type);
+        break;
+    }
+    return sz;
+}
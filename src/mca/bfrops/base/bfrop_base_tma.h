@@ -51,6 +51,41 @@ pmix_bfrops_base_tma_value_xfer(
     pmix_tma_t *tma
 );
 
+/* Resize the storage behind a buffer to exactly to_alloc bytes. Fresh
+ * space is not zeroed - everything up to pack_ptr has been written, and
+ * nothing beyond it is read until it has been packed */
+static inline char *
+pmix_bfrops_base_tma_buffer_resize(
+    pmix_buffer_t *buffer,
+    size_t to_alloc,
+    pmix_tma_t *tma
+) {
+    size_t pack_offset, unpack_offset;
+    char *ptr;
+
+    if (NULL != buffer->base_ptr) {
+        pack_offset = ((char *) buffer->pack_ptr) - ((char *) buffer->base_ptr);
+        unpack_offset = ((char *) buffer->unpack_ptr) - ((char *) buffer->base_ptr);
+        ptr = (char *) pmix_tma_realloc(tma, buffer->base_ptr, to_alloc);
+    } else {
+        pack_offset = 0;
+        unpack_offset = 0;
+        buffer->bytes_used = 0;
+        ptr = (char *) pmix_tma_malloc(tma, to_alloc);
+    }
+
+    if (NULL == ptr) {
+        /* the original storage is untouched */
+        return NULL;
+    }
+    buffer->base_ptr = ptr;
+    buffer->pack_ptr = ((char *) buffer->base_ptr) + pack_offset;
+    buffer->unpack_ptr = ((char *) buffer->base_ptr) + unpack_offset;
+    buffer->bytes_allocated = to_alloc;
+
+    return buffer->pack_ptr;
+}
+
 static inline char *
 pmix_bfrops_base_tma_buffer_extend(
     pmix_buffer_t *buffer,
@@ -58,7 +93,6 @@ pmix_bfrops_base_tma_buffer_extend(
     pmix_tma_t *tma
 ) {
     size_t required, to_alloc;
-    size_t pack_offset, unpack_offset;
 
     /* Check to see if we have enough space already */
     if (0 == bytes_to_add) {
@@ -84,28 +118,20 @@ pmix_bfrops_base_tma_buffer_extend(
         }
     }
 
-    if (NULL != buffer->base_ptr) {
-        pack_offset = ((char *) buffer->pack_ptr) - ((char *) buffer->base_ptr);
-        unpack_offset = ((char *) buffer->unpack_ptr) - ((char *) buffer->base_ptr);
-        buffer->base_ptr = (char *) pmix_tma_realloc(tma, buffer->base_ptr, to_alloc);
-        memset(buffer->base_ptr + pack_offset, 0, to_alloc - buffer->bytes_allocated);
-    } else {
-        pack_offset = 0;
-        unpack_offset = 0;
-        buffer->bytes_used = 0;
-        buffer->base_ptr = (char *)pmix_tma_malloc(tma, to_alloc);
-        memset(buffer->base_ptr, 0, to_alloc);
-    }
-
-    if (NULL == buffer->base_ptr) {
-        return NULL;
-    }
-    buffer->pack_ptr = ((char *) buffer->base_ptr) + pack_offset;
-    buffer->unpack_ptr = ((char *) buffer->base_ptr) + unpack_offset;
-    buffer->bytes_allocated = to_alloc;
+    return pmix_bfrops_base_tma_buffer_resize(buffer, to_alloc, tma);
+}
 
-    /* All done */
-    return buffer->pack_ptr;
+/* Ensure the buffer can take bytes_to_add more bytes without
+ * growing, so a caller that knows the size of what it is about
+ * to pack grows the buffer at most once. Growth follows the same
+ * policy as extend so that repeated reserves stay amortised */
+static inline char *
+pmix_bfrops_base_tma_buffer_reserve(
+    pmix_buffer_t *buffer,
+    size_t bytes_to_add,
+    pmix_tma_t *tma
+) {
+    return pmix_bfrops_base_tma_buffer_extend(buffer, bytes_to_add, tma);
 }
 
 static inline pmix_status_t
@@ -26,10 +26,13 @@
 #include "src/include/pmix_config.h"
 
 #include "src/hwloc/pmix_hwloc.h"
+#include "src/include/pmix_dictionary.h"
 #include "src/include/pmix_globals.h"
 #include "src/mca/preg/preg.h"
 #include "src/util/pmix_argv.h"
+#include "src/util/pmix_bswap.h"
 #include "src/util/pmix_error.h"
+#include "src/util/pmix_hash.h"
 #include "src/util/pmix_output.h"
 
 #include "src/mca/bfrops/base/base.h"
@@ -305,8 +308,7 @@ pmix_status_t pmix_bfrops_base_unpack_byte(pmix_pointer_array_t *regtypes, pmix_
 pmix_status_t pmix_bfrops_base_unpack_int16(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
                                             void *dest, int32_t *num_vals, pmix_data_type_t type)
 {
-    int32_t i;
-    uint16_t tmp, *desttmp = (uint16_t *) dest;
+    uint16_t tmp;
 
     pmix_output_verbose(20, pmix_bfrops_base_framework.framework_output,
                         "pmix_bfrop_unpack_int16 * %d\n", (int) *num_vals);
@@ -319,12 +321,8 @@ pmix_status_t pmix_bfrops_base_unpack_int16(pmix_pointer_array_t *regtypes, pmix
     }
 
     /* unpack the data */
-    for (i = 0; i < (*num_vals); ++i) {
-        memcpy(&(tmp), buffer->unpack_ptr, sizeof(tmp));
-        tmp = pmix_ntohs(tmp);
-        memcpy(&desttmp[i], &tmp, sizeof(tmp));
-        buffer->unpack_ptr += sizeof(tmp);
-    }
+    pmix_bswap16_array(dest, buffer->unpack_ptr, *num_vals);
+    buffer->unpack_ptr += (*num_vals) * sizeof(tmp);
 
     return PMIX_SUCCESS;
 }
@@ -332,8 +330,7 @@ pmix_status_t pmix_bfrops_base_unpack_int16(pmix_pointer_array_t *regtypes, pmix
 pmix_status_t pmix_bfrops_base_unpack_int32(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
                                             void *dest, int32_t *num_vals, pmix_data_type_t type)
 {
-    int32_t i;
-    uint32_t tmp, *desttmp = (uint32_t *) dest;
+    uint32_t tmp;
 
     pmix_output_verbose(20, pmix_bfrops_base_framework.framework_output,
                         "pmix_bfrop_unpack_int32 * %d\n", (int) *num_vals);
@@ -346,12 +343,8 @@ pmix_status_t pmix_bfrops_base_unpack_int32(pmix_pointer_array_t *regtypes, pmix
     }
 
     /* unpack the data */
-    for (i = 0; i < (*num_vals); ++i) {
-        memcpy(&(tmp), buffer->unpack_ptr, sizeof(tmp));
-        tmp = ntohl(tmp);
-        memcpy(&desttmp[i], &tmp, sizeof(tmp));
-        buffer->unpack_ptr += sizeof(tmp);
-    }
+    pmix_bswap32_array(dest, buffer->unpack_ptr, *num_vals);
+    buffer->unpack_ptr += (*num_vals) * sizeof(tmp);
 
     return PMIX_SUCCESS;
 }
@@ -371,8 +364,7 @@ pmix_status_t pmix_bfrops_base_unpack_datatype(pmix_pointer_array_t *regtypes,
 pmix_status_t pmix_bfrops_base_unpack_int64(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
                                             void *dest, int32_t *num_vals, pmix_data_type_t type)
 {
-    int32_t i;
-    uint64_t tmp, *desttmp = (uint64_t *) dest;
+    uint64_t tmp;
 
     pmix_output_verbose(20, pmix_bfrops_base_framework.framework_output,
                         "pmix_bfrop_unpack_int64 * %d\n", (int) *num_vals);
@@ -385,12 +377,8 @@ pmix_status_t pmix_bfrops_base_unpack_int64(pmix_pointer_array_t *regtypes, pmix
     }
 
     /* unpack the data */
-    for (i = 0; i < (*num_vals); ++i) {
-        memcpy(&(tmp), buffer->unpack_ptr, sizeof(tmp));
-        tmp = pmix_ntoh64(tmp);
-        memcpy(&desttmp[i], &tmp, sizeof(tmp));
-        buffer->unpack_ptr += sizeof(tmp);
-    }
+    pmix_bswap64_array(dest, buffer->unpack_ptr, *num_vals);
+    buffer->unpack_ptr += (*num_vals) * sizeof(tmp);
 
     return PMIX_SUCCESS;
 }
@@ -409,6 +397,9 @@ pmix_status_t pmix_bfrops_base_unpack_string(pmix_pointer_array_t *regtypes, pmi
         if (PMIX_SUCCESS != ret) {
             return ret;
         }
+        if (0 > len) {
+            return PMIX_ERR_UNPACK_FAILURE;
+        }
         if (0 == len) { /* zero-length string - unpack the NULL */
             sdest[i] = NULL;
         } else {
@@ -418,8 +409,17 @@ pmix_status_t pmix_bfrops_base_unpack_string(pmix_pointer_array_t *regtypes, pmi
             }
             PMIX_BFROPS_UNPACK_TYPE(ret, buffer, sdest[i], &len, PMIX_BYTE, regtypes);
             if (PMIX_SUCCESS != ret) {
+                free(sdest[i]);
+                sdest[i] = NULL;
                 return ret;
             }
+            /* the NULL terminator must be there - anything
+             * else would be read past the end */
+            if ('\0' != sdest[i][len - 1]) {
+                free(sdest[i]);
+                sdest[i] = NULL;
+                return PMIX_ERR_UNPACK_FAILURE;
+            }
         }
     }
 
@@ -723,19 +723,89 @@ pmix_status_t pmix_bfrops_base_unpack_value(pmix_pointer_array_t *regtypes, pmix
     return PMIX_SUCCESS;
 }
 
-pmix_status_t pmix_bfrops_base_unpack_info(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
-                                           void *dest, int32_t *num_vals, pmix_data_type_t type)
+/* point at the next size bytes of the buffer, which must end in a
+ * NULL terminator if they are a string, and step over them */
+static pmix_status_t borrow(pmix_buffer_t *buffer, size_t size, bool string, char **ptr)
+{
+    if (pmix_bfrop_too_small(buffer, size)) {
+        return PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER;
+    }
+    if (0 == size) {
+        *ptr = NULL;
+        return PMIX_SUCCESS;
+    }
+    if (string && '\0' != buffer->unpack_ptr[size - 1]) {
+        return PMIX_ERR_UNPACK_FAILURE;
+    }
+    *ptr = buffer->unpack_ptr;
+    buffer->unpack_ptr += size;
+    return PMIX_SUCCESS;
+}
+
+/* KEYS */
+pmix_status_t pmix_bfrops_base_unpack_key(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
+                                          const char **key)
+{
+    pmix_status_t ret;
+    int32_t len, m = 1;
+    char *ptr = NULL;
+
+    /* same encoding as a string */
+    PMIX_BFROPS_UNPACK_TYPE(ret, buffer, &len, &m, PMIX_INT32, regtypes);
+    if (PMIX_SUCCESS != ret) {
+        return ret;
+    }
+    if (0 > len) {
+        return PMIX_ERR_UNPACK_FAILURE;
+    }
+    ret = borrow(buffer, len, true, &ptr);
+    if (PMIX_SUCCESS == ret) {
+        *key = ptr;
+    }
+    return ret;
+}
+
+/* see pmix_bfrops_base_pack_keyid for the encoding */
+pmix_status_t pmix_bfrops_base_unpack_keyid(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
+                                            const char **key)
+{
+    pmix_regattr_input_t *p;
+    pmix_status_t ret;
+    uint32_t tag;
+    int32_t m = 1;
+    char *ptr = NULL;
+
+    PMIX_BFROPS_UNPACK_TYPE(ret, buffer, &tag, &m, PMIX_UINT32, regtypes);
+    if (PMIX_SUCCESS != ret) {
+        return ret;
+    }
+    if (tag & 1) {
+        tag >>= 1;
+        if (PMIX_INDEX_BOUNDARY <= tag || NULL == (p = pmix_hash_lookup_key(tag, NULL))) {
+            return PMIX_ERR_UNPACK_FAILURE;
+        }
+        *key = p->string;
+        return PMIX_SUCCESS;
+    }
+    ret = borrow(buffer, tag >> 1, true, &ptr);
+    if (PMIX_SUCCESS == ret) {
+        *key = ptr;
+    }
+    return ret;
+}
+
+static pmix_status_t unpack_info(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
+                                 void *dest, int32_t *num_vals,
+                                 pmix_bfrop_unpack_key_fn_t unpackkey)
 {
     pmix_info_t *ptr;
     int32_t i, n, m;
     pmix_status_t ret;
-    char *tmp;
+    const char *key;
 
     pmix_output_verbose(20, pmix_bfrops_base_framework.framework_output,
                         "pmix_bfrop_unpack: %d info", *num_vals);
 
-    PMIX_HIDE_UNUSED_PARAMS(type);
-
     ptr = (pmix_info_t *) dest;
     n = *num_vals;
 
@@ -743,18 +813,15 @@ pmix_status_t pmix_bfrops_base_unpack_info(pmix_pointer_array_t *regtypes, pmix_
         memset(ptr[i].key, 0, sizeof(ptr[i].key));
         memset(&ptr[i].value, 0, sizeof(pmix_value_t));
         /* unpack key */
-        m = 1;
-        tmp = NULL;
-        PMIX_BFROPS_UNPACK_TYPE(ret, buffer, &tmp, &m, PMIX_STRING, regtypes);
+        ret = unpackkey(regtypes, buffer, &key);
         if (PMIX_SUCCESS != ret) {
             PMIX_ERROR_LOG(ret);
             return ret;
         }
-        if (NULL == tmp) {
+        if (NULL == key) {
             return PMIX_ERROR;
         }
-        pmix_strncpy(ptr[i].key, tmp, PMIX_MAX_KEYLEN);
-        free(tmp);
+        pmix_strncpy(ptr[i].key, key, PMIX_MAX_KEYLEN);
         /* unpack the directives */
         m = 1;
         PMIX_BFROPS_UNPACK_TYPE(ret, buffer, &ptr[i].flags, &m, PMIX_INFO_DIRECTIVES, regtypes);
@@ -770,7 +837,6 @@ pmix_status_t pmix_bfrops_base_unpack_info(pmix_pointer_array_t *regtypes, pmix_
         }
         pmix_output_verbose(20, pmix_bfrops_base_framework.framework_output,
                             "pmix_bfrop_unpack: info type %d", ptr[i].value.type);
-        m = 1;
         if (PMIX_SUCCESS != (ret = pmix_bfrops_base_unpack_val(regtypes, buffer, &ptr[i].value))) {
             return ret;
         }
@@ -778,19 +844,35 @@ pmix_status_t pmix_bfrops_base_unpack_info(pmix_pointer_array_t *regtypes, pmix_
     return PMIX_SUCCESS;
 }
 
-pmix_status_t pmix_bfrops_base_unpack_pdata(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
-                                            void *dest, int32_t *num_vals, pmix_data_type_t type)
+pmix_status_t pmix_bfrops_base_unpack_info(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
+                                           void *dest, int32_t *num_vals, pmix_data_type_t type)
+{
+    PMIX_HIDE_UNUSED_PARAMS(type);
+
+    return unpack_info(regtypes, buffer, dest, num_vals, pmix_bfrops_base_unpack_key);
+}
+
+pmix_status_t pmix_bfrops_base_unpack_info_keyid(pmix_pointer_array_t *regtypes,
+                                                 pmix_buffer_t *buffer, void *dest,
+                                                 int32_t *num_vals, pmix_data_type_t type)
+{
+    PMIX_HIDE_UNUSED_PARAMS(type);
+
+    return unpack_info(regtypes, buffer, dest, num_vals, pmix_bfrops_base_unpack_keyid);
+}
+
+static pmix_status_t unpack_pdata(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
+                                  void *dest, int32_t *num_vals,
+                                  pmix_bfrop_unpack_key_fn_t unpackkey)
 {
     pmix_pdata_t *ptr;
     int32_t i, n, m;
     pmix_status_t ret;
-    char *tmp;
+    const char *key;
 
     pmix_output_verbose(20, pmix_bfrops_base_framework.framework_output,
                         "pmix_bfrop_unpack: %d pdata", *num_vals);
 
-    PMIX_HIDE_UNUSED_PARAMS(type);
-
     ptr = (pmix_pdata_t *) dest;
     n = *num_vals;
 
@@ -803,18 +885,15 @@ pmix_status_t pmix_bfrops_base_unpack_pdata(pmix_pointer_array_t *regtypes, pmix
             return ret;
         }
         /* unpack key */
-        m = 1;
-        tmp = NULL;
-        PMIX_BFROPS_UNPACK_TYPE(ret, buffer, &tmp, &m, PMIX_STRING, regtypes);
+        ret = unpackkey(regtypes, buffer, &key);
         if (PMIX_SUCCESS != ret) {
             return ret;
         }
-        if (NULL == tmp) {
+        if (NULL == key) {
             PMIX_ERROR_LOG(PMIX_ERROR);
             return PMIX_ERROR;
         }
-        pmix_strncpy(ptr[i].key, tmp, PMIX_MAX_KEYLEN);
-        free(tmp);
+        pmix_strncpy(ptr[i].key, key, PMIX_MAX_KEYLEN);
         /* unpack value - since the value structure is statically-defined
          * instead of a pointer in this struct, we directly unpack it to
          * avoid the malloc */
@@ -826,7 +905,6 @@ pmix_status_t pmix_bfrops_base_unpack_pdata(pmix_pointer_array_t *regtypes, pmix
         pmix_output_verbose(20, pmix_bfrops_base_framework.framework_output,
                             "pmix_bfrop_unpack: pdata type %d %s", ptr[i].value.type,
                             ptr[i].value.data.string);
-        m = 1;
         if (PMIX_SUCCESS != (ret = pmix_bfrops_base_unpack_val(regtypes, buffer, &ptr[i].value))) {
             PMIX_ERROR_LOG(ret);
             return ret;
@@ -835,6 +913,23 @@ pmix_status_t pmix_bfrops_base_unpack_pdata(pmix_pointer_array_t *regtypes, pmix
     return PMIX_SUCCESS;
 }
 
+pmix_status_t pmix_bfrops_base_unpack_pdata(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
+                                            void *dest, int32_t *num_vals, pmix_data_type_t type)
+{
+    PMIX_HIDE_UNUSED_PARAMS(type);
+
+    return unpack_pdata(regtypes, buffer, dest, num_vals, pmix_bfrops_base_unpack_key);
+}
+
+pmix_status_t pmix_bfrops_base_unpack_pdata_keyid(pmix_pointer_array_t *regtypes,
+                                                  pmix_buffer_t *buffer, void *dest,
+                                                  int32_t *num_vals, pmix_data_type_t type)
+{
+    PMIX_HIDE_UNUSED_PARAMS(type);
+
+    return unpack_pdata(regtypes, buffer, dest, num_vals, pmix_bfrops_base_unpack_keyid);
+}
+
 pmix_status_t pmix_bfrops_base_unpack_buf(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
                                           void *dest, int32_t *num_vals, pmix_data_type_t type)
 {
@@ -1028,31 +1123,87 @@ pmix_status_t pmix_bfrops_base_unpack_app(pmix_pointer_array_t *regtypes, pmix_b
     return PMIX_SUCCESS;
 }
 
-pmix_status_t pmix_bfrops_base_unpack_kval(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
-                                           void *dest, int32_t *num_vals, pmix_data_type_t type)
+/* point a string or byte object value at its data in a shared
+ * buffer instead of copying it out */
+static pmix_status_t unpack_borrowed(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
+                                     pmix_value_t *val)
+{
+    pmix_status_t ret;
+    int32_t len, m = 1;
+    size_t size;
+    char *ptr;
+
+    if (PMIX_STRING == val->type) {
+        PMIX_BFROPS_UNPACK_TYPE(ret, buffer, &len, &m, PMIX_INT32, regtypes);
+        if (PMIX_SUCCESS != ret) {
+            return ret;
+        }
+        if (0 > len) {
+            return PMIX_ERR_UNPACK_FAILURE;
+        }
+        return borrow(buffer, len, true, &val->data.string);
+    }
+    PMIX_BFROPS_UNPACK_TYPE(ret, buffer, &size, &m, PMIX_SIZE, regtypes);
+    if (PMIX_SUCCESS != ret) {
+        return ret;
+    }
+    ret = borrow(buffer, size, false, &ptr);
+    if (PMIX_SUCCESS != ret) {
+        return ret;
+    }
+    val->data.bo.bytes = ptr;
+    val->data.bo.size = size;
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t unpack_kval(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
+                                 void *dest, int32_t *num_vals,
+                                 pmix_bfrop_unpack_key_fn_t unpackkey)
 {
     pmix_kval_t *ptr;
     int32_t i, n, m;
     pmix_status_t ret;
+    const char *key;
 
     pmix_output_verbose(20, pmix_bfrops_base_framework.framework_output,
                         "pmix_bfrop_unpack: %d kvals", *num_vals);
 
-    PMIX_HIDE_UNUSED_PARAMS(type);
-
     ptr = (pmix_kval_t *) dest;
     n = *num_vals;
 
     for (i = 0; i < n; ++i) {
         PMIX_CONSTRUCT(&ptr[i], pmix_kval_t);
         /* unpack the key */
-        m = 1;
-        PMIX_BFROPS_UNPACK_TYPE(ret, buffer, &ptr[i].key, &m, PMIX_STRING, regtypes);
+        ret = unpackkey(regtypes, buffer, &key);
         if (PMIX_SUCCESS != ret) {
             return ret;
         }
+        if (NULL != key) {
+            ptr[i].key = strdup(key);
+        }
         /* allocate the space */
         ptr[i].value = (pmix_value_t *) malloc(sizeof(pmix_value_t));
+        if (NULL != buffer->storage) {
+            /* strings and byte objects can be borrowed */
+            memset(ptr[i].value, 0, sizeof(pmix_value_t));
+            ret = pmix_bfrop_get_data_type(regtypes, buffer, &ptr[i].value->type);
+            if (PMIX_SUCCESS != ret) {
+                return ret;
+            }
+            if (PMIX_STRING != ptr[i].value->type && PMIX_BYTE_OBJECT != ptr[i].value->type) {
+                ret = pmix_bfrops_base_unpack_val(regtypes, buffer, ptr[i].value);
+            } else {
+                ret = unpack_borrowed(regtypes, buffer, ptr[i].value);
+                if (PMIX_SUCCESS == ret) {
+                    PMIX_RETAIN(buffer->storage);
+                    ptr[i].storage = buffer->storage;
+                }
+            }
+            if (PMIX_SUCCESS != ret) {
+                return ret;
+            }
+            continue;
+        }
         /* unpack the value */
         m = 1;
         PMIX_BFROPS_UNPACK_TYPE(ret, buffer, ptr[i].value, &m, PMIX_VALUE, regtypes);
@@ -1063,6 +1214,23 @@ pmix_status_t pmix_bfrops_base_unpack_kval(pmix_pointer_array_t *regtypes, pmix_
     return PMIX_SUCCESS;
 }
 
+pmix_status_t pmix_bfrops_base_unpack_kval(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
+                                           void *dest, int32_t *num_vals, pmix_data_type_t type)
+{
+    PMIX_HIDE_UNUSED_PARAMS(type);
+
+    return unpack_kval(regtypes, buffer, dest, num_vals, pmix_bfrops_base_unpack_key);
+}
+
+pmix_status_t pmix_bfrops_base_unpack_kval_keyid(pmix_pointer_array_t *regtypes,
+                                                 pmix_buffer_t *buffer, void *dest,
+                                                 int32_t *num_vals, pmix_data_type_t type)
+{
+    PMIX_HIDE_UNUSED_PARAMS(type);
+
+    return unpack_kval(regtypes, buffer, dest, num_vals, pmix_bfrops_base_unpack_keyid);
+}
+
 pmix_status_t pmix_bfrops_base_unpack_persist(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
                                               void *dest, int32_t *num_vals, pmix_data_type_t type)
 {
@@ -62,6 +62,19 @@ typedef uint8_t pmix_bfrop_buffer_type_t;
 #define PMIX_BFROP_BUFFER_TYPE_HTON(h)
 #define PMIX_BFROP_BUFFER_TYPE_NTOH(h)
 
+/* Reference-counted storage behind the payload of a received
+ * buffer. Strings and byte objects unpacked from a buffer that
+ * has been shared (see pmix_bfrop_buffer_share) may point into
+ * the storage instead of being copied out of it - anything that
+ * holds such a "borrowed" value must also hold a reference to
+ * the storage, which is freed with the last of them */
+typedef struct {
+    pmix_object_t super;
+    char *base_ptr;
+    size_t size;
+} pmix_buffer_storage_t;
+PMIX_EXPORT PMIX_CLASS_DECLARATION(pmix_buffer_storage_t);
+
 /* internally used object for transferring data
  * to/from the server and for storing in the
  * hash tables */
@@ -69,6 +82,9 @@ typedef struct {
     pmix_list_item_t super;
     char *key;
     pmix_value_t *value;
+    /* if non-NULL, the string or byte object in the
+     * value is borrowed from this storage */
+    pmix_buffer_storage_t *storage;
 } pmix_kval_t;
 PMIX_EXPORT PMIX_CLASS_DECLARATION(pmix_kval_t);
 
@@ -107,6 +123,9 @@ typedef struct {
     /** Number of bytes used by the buffer (i.e., amount of data --
         including overhead -- packed in the buffer) */
     size_t bytes_used;
+    /** If non-NULL, the memory starting at base_ptr belongs to this
+        storage and values may be borrowed from it when unpacking */
+    pmix_buffer_storage_t *storage;
 } pmix_buffer_t;
 PMIX_EXPORT PMIX_CLASS_DECLARATION(pmix_buffer_t);
 
@@ -172,6 +191,18 @@ PMIX_EXPORT PMIX_CLASS_DECLARATION(pmix_buffer_t);
         (b)->unpack_ptr = NULL;         \
     } while (0)
 
+/* Drop the borrowed string or byte object of a value so
+ * that the value can be released without freeing it */
+#define PMIX_VALUE_UNBORROW(v)                      \
+    do {                                            \
+        if (PMIX_STRING == (v)->type) {             \
+            (v)->data.string = NULL;                \
+        } else if (PMIX_BYTE_OBJECT == (v)->type) { \
+            (v)->data.bo.bytes = NULL;              \
+            (v)->data.bo.size = 0;                  \
+        }                                           \
+    } while (0)
+
 /* Convenience macro to check for empty buffer without
  * exposing the internals */
 #define PMIX_BUFFER_IS_EMPTY(b) (0 == (b)->bytes_used || (b)->pack_ptr == (b)->unpack_ptr)
@@ -429,6 +429,9 @@ pmix_status_t pmix12_bfrop_unpack_string(pmix_pointer_array_t *regtypes, pmix_bu
             != (ret = pmix12_bfrop_unpack_int32(regtypes, buffer, &len, &n, PMIX_INT32))) {
             return ret;
         }
+        if (0 > len) {
+            return PMIX_ERR_UNPACK_FAILURE;
+        }
         if (0 == len) { /* zero-length string - unpack the NULL */
             sdest[i] = NULL;
         } else {
@@ -436,10 +439,19 @@ pmix_status_t pmix12_bfrop_unpack_string(pmix_pointer_array_t *regtypes, pmix_bu
             if (NULL == sdest[i]) {
                 return PMIX_ERR_OUT_OF_RESOURCE;
             }
-            if (PMIX_SUCCESS
-                != (ret = pmix12_bfrop_unpack_byte(regtypes, buffer, sdest[i], &len, PMIX_BYTE))) {
+            ret = pmix12_bfrop_unpack_byte(regtypes, buffer, sdest[i], &len, PMIX_BYTE);
+            if (PMIX_SUCCESS != ret) {
+                free(sdest[i]);
+                sdest[i] = NULL;
                 return ret;
             }
+            /* the NULL terminator must be there - anything
+             * else would be read past the end */
+            if ('\0' != sdest[i][len - 1]) {
+                free(sdest[i]);
+                sdest[i] = NULL;
+                return PMIX_ERR_UNPACK_FAILURE;
+            }
         }
     }
 
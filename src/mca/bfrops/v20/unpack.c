@@ -415,6 +415,9 @@ pmix_status_t pmix20_bfrop_unpack_string(pmix_pointer_array_t *regtypes, pmix_bu
         if (PMIX_SUCCESS != ret) {
             return ret;
         }
+        if (0 > len) {
+            return PMIX_ERR_UNPACK_FAILURE;
+        }
         if (0 == len) { /* zero-length string - unpack the NULL */
             sdest[i] = NULL;
         } else {
@@ -424,8 +427,17 @@ pmix_status_t pmix20_bfrop_unpack_string(pmix_pointer_array_t *regtypes, pmix_bu
             }
             PMIX_BFROPS_UNPACK_TYPE(ret, buffer, sdest[i], &len, PMIX_BYTE, regtypes);
             if (PMIX_SUCCESS != ret) {
+                free(sdest[i]);
+                sdest[i] = NULL;
                 return ret;
             }
+            /* the NULL terminator must be there - anything
+             * else would be read past the end */
+            if ('\0' != sdest[i][len - 1]) {
+                free(sdest[i]);
+                sdest[i] = NULL;
+                return PMIX_ERR_UNPACK_FAILURE;
+            }
         }
     }
 
@@ -398,6 +398,17 @@ static pmix_status_t pmix4_bfrops_base_pack_general_int(pmix_pointer_array_t *re
         return rc;
     }
 
+    if (NULL != pmix_psquash.encode_ints) {
+        rc = pmix_psquash.encode_ints(type, src, num_vals, dst, &pkg_size);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            return rc;
+        }
+        buffer->pack_ptr += pkg_size;
+        buffer->bytes_used += pkg_size;
+        return PMIX_SUCCESS;
+    }
+
     for (i = 0; i < num_vals; ++i) {
         rc = (pmix_psquash.encode_int)(type, (uint8_t *) src + i * val_size, dst, &pkg_size);
         if (PMIX_SUCCESS != rc) {
@@ -493,6 +504,20 @@ static pmix_status_t pmix4_bfrops_base_unpack_general_int(pmix_pointer_array_t *
         return rc;
     }
 
+    if (NULL != pmix_psquash.decode_ints) {
+        avail_size = buffer->pack_ptr - buffer->unpack_ptr;
+        rc = pmix_psquash.decode_ints(type, buffer->unpack_ptr, avail_size, dest, *num_vals,
+                                      &unpack_size);
+        if (PMIX_SUCCESS != rc) {
+            if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER != rc) {
+                PMIX_ERROR_LOG(rc);
+            }
+            return rc;
+        }
+        buffer->unpack_ptr += unpack_size;
+        return PMIX_SUCCESS;
+    }
+
     /* unpack the data */
     for (i = 0; i < (*num_vals); ++i) {
         avail_size = buffer->pack_ptr - buffer->unpack_ptr;
@@ -37,7 +37,9 @@
 #    include <string.h>
 #endif
 
+#include "src/class/pmix_hash_table.h"
 #include "src/class/pmix_list.h"
+#include "src/class/pmix_value_array.h"
 #include "src/mca/base/pmix_mca_base_framework.h"
 #include "src/mca/mca.h"
 
@@ -84,6 +86,20 @@ typedef enum {
     PMIX_MODEX_KEY_MAX
 } pmix_gds_modex_key_fmt_t;
 
+/* define a map of key names used when assembling a modex blob.
+ * Each unique key name is assigned the next index in the order
+ * it is first seen, and the number of times each key occurs is
+ * tracked so the most compact key format can be selected */
+typedef struct {
+    pmix_object_t super;
+    pmix_hash_table_t index;   // key name -> index in keys
+    char **keys;               // NULL-terminated array of unique key names
+    uint32_t nkeys;            // number of unique key names
+    size_t kalloc;             // number of slots allocated in keys
+    pmix_value_array_t counts; // uint32_t number of occurrences of each key
+} pmix_gds_modex_kmap_t;
+PMIX_CLASS_DECLARATION(pmix_gds_modex_kmap_t);
+
 /* define a modex blob info */
 typedef uint8_t pmix_gds_modex_blob_info_t;
 
@@ -125,9 +141,19 @@ PMIX_EXPORT pmix_status_t pmix_gds_base_store_modex(struct pmix_namespace_t *nsp
                                                     pmix_gds_base_store_modex_cb_fn_t cb_fn,
                                                     void *cbdata);
 
+PMIX_EXPORT
+pmix_status_t pmix_gds_base_modex_kmap_init(pmix_gds_modex_kmap_t *kmap, size_t size);
+
+PMIX_EXPORT
+pmix_status_t pmix_gds_base_modex_kmap_add(pmix_gds_modex_kmap_t *kmap, const char *key,
+                                           uint32_t *idx);
+
+PMIX_EXPORT
+pmix_gds_modex_key_fmt_t pmix_gds_base_modex_kmap_select(pmix_gds_modex_kmap_t *kmap);
+
 PMIX_EXPORT
 pmix_status_t pmix_gds_base_modex_pack_kval(pmix_gds_modex_key_fmt_t key_fmt, pmix_buffer_t *buf,
-                                            char ***kmap, pmix_kval_t *kv);
+                                            pmix_gds_modex_kmap_t *kmap, pmix_kval_t *kv);
 
 PMIX_EXPORT
 pmix_status_t pmix_gds_base_modex_unpack_kval(pmix_gds_modex_key_fmt_t key_fmt, pmix_buffer_t *buf,
@@ -270,27 +270,191 @@ exit:
     return rc;
 }
 
+static void kmcon(pmix_gds_modex_kmap_t *p)
+{
+    PMIX_CONSTRUCT(&p->index, pmix_hash_table_t);
+    p->keys = NULL;
+    p->nkeys = 0;
+    p->kalloc = 0;
+    PMIX_CONSTRUCT(&p->counts, pmix_value_array_t);
+    pmix_value_array_init(&p->counts, sizeof(uint32_t));
+}
+static void kmdes(pmix_gds_modex_kmap_t *p)
+{
+    PMIX_DESTRUCT(&p->index);
+    if (NULL != p->keys) {
+        PMIx_Argv_free(p->keys);
+    }
+    PMIX_DESTRUCT(&p->counts);
+}
+PMIX_CLASS_INSTANCE(pmix_gds_modex_kmap_t, pmix_object_t, kmcon, kmdes);
+
+/*
+ * Grow the arrays of the key map to hold at least size unique
+ * key names
+ */
+static pmix_status_t kmap_reserve(pmix_gds_modex_kmap_t *kmap, size_t size)
+{
+    char **tmp;
+
+    if (size + 1 > kmap->kalloc) {
+        tmp = (char **) realloc(kmap->keys, (size + 1) * sizeof(char *));
+        if (NULL == tmp) {
+            return PMIX_ERR_NOMEM;
+        }
+        kmap->keys = tmp;
+        kmap->keys[kmap->nkeys] = NULL;
+        kmap->kalloc = size + 1;
+    }
+    if (PMIX_SUCCESS != pmix_value_array_reserve(&kmap->counts, size)) {
+        return PMIX_ERR_NOMEM;
+    }
+    return PMIX_SUCCESS;
+}
+
+/*
+ * Size the key map to hold roughly size unique key names without
+ * having to grow. This is optional - the map is initialized with
+ * a default size on first use if this hasn't been called
+ */
+pmix_status_t pmix_gds_base_modex_kmap_init(pmix_gds_modex_kmap_t *kmap, size_t size)
+{
+    pmix_status_t rc;
+
+    if (0 != kmap->kalloc) {
+        /* already initialized */
+        return PMIX_SUCCESS;
+    }
+    if (0 == size) {
+        size = 32;
+    }
+    rc = pmix_hash_table_init(&kmap->index, size);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    return kmap_reserve(kmap, size);
+}
+
+/*
+ * Return the index of the given key name in the key map, adding
+ * the key if it isn't already present, and count the occurrence
+ */
+pmix_status_t pmix_gds_base_modex_kmap_add(pmix_gds_modex_kmap_t *kmap, const char *key,
+                                           uint32_t *idx)
+{
+    void *ptr;
+    uint32_t *counts;
+    size_t len = strlen(key);
+    pmix_status_t rc;
+
+    if (0 == kmap->kalloc) {
+        rc = pmix_gds_base_modex_kmap_init(kmap, 0);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+    }
+    rc = pmix_hash_table_get_value_ptr(&kmap->index, key, len, &ptr);
+    if (PMIX_SUCCESS != rc) {
+        /* new key - make sure there is room for it */
+        if (kmap->nkeys + 2 > kmap->kalloc) {
+            rc = kmap_reserve(kmap, 2 * kmap->kalloc);
+            if (PMIX_SUCCESS != rc) {
+                return rc;
+            }
+        }
+        ptr = (void *) (uintptr_t) kmap->nkeys;
+        rc = pmix_hash_table_set_value_ptr(&kmap->index, key, len, ptr);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+        kmap->keys[kmap->nkeys] = strdup(key);
+        kmap->keys[kmap->nkeys + 1] = NULL;
+        ++kmap->nkeys;
+        rc = pmix_value_array_set_size(&kmap->counts, kmap->nkeys);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+        counts = PMIX_VALUE_ARRAY_GET_BASE(&kmap->counts, uint32_t);
+        counts[kmap->nkeys - 1] = 0;
+    }
+    *idx = (uint32_t) (uintptr_t) ptr;
+    counts = PMIX_VALUE_ARRAY_GET_BASE(&kmap->counts, uint32_t);
+    counts[*idx]++;
+    return PMIX_SUCCESS;
+}
+
+/*
+ * Evaluate the key name sizes and their counts to select
+ * a format to store key names:
+ * - keymap: use key-map in blob header for key-name resolve
+ *   from idx: key names stored as indexes (avoid key duplication)
+ * - regular: key-names stored as is
+ */
+pmix_gds_modex_key_fmt_t pmix_gds_base_modex_kmap_select(pmix_gds_modex_kmap_t *kmap)
+{
+    size_t key_fmt_size[PMIX_MODEX_KEY_MAX] = {0};
+    uint32_t *counts;
+    pmix_buffer_t tmp;
+    size_t kname_size, kidx_size;
+    uint32_t i;
+    pmix_status_t rc;
+
+    if (0 == kmap->nkeys) {
+        return PMIX_MODEX_KEY_NATIVE_FMT;
+    }
+    counts = PMIX_VALUE_ARRAY_GET_BASE(&kmap->counts, uint32_t);
+
+    /* the packed size of an index doesn't depend on its value */
+    PMIX_CONSTRUCT(&tmp, pmix_buffer_t);
+    i = 0;
+    PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &tmp, &i, 1, PMIX_UINT32);
+    kidx_size = tmp.bytes_used;
+    PMIX_DESTRUCT(&tmp);
+    if (PMIX_SUCCESS != rc) {
+        return PMIX_MODEX_KEY_NATIVE_FMT;
+    }
+
+    for (i = 0; i < kmap->nkeys; i++) {
+        PMIX_CONSTRUCT(&tmp, pmix_buffer_t);
+        PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &tmp, &kmap->keys[i], 1, PMIX_STRING);
+        kname_size = tmp.bytes_used;
+        PMIX_DESTRUCT(&tmp);
+        if (PMIX_SUCCESS != rc) {
+            return PMIX_MODEX_KEY_NATIVE_FMT;
+        }
+
+        /* calculate the key names sizes */
+        key_fmt_size[PMIX_MODEX_KEY_NATIVE_FMT] += kname_size * counts[i];
+        key_fmt_size[PMIX_MODEX_KEY_KEYMAP_FMT] += kname_size + counts[i] * kidx_size;
+    }
+
+    /* select the most efficient key-name pack format */
+    return key_fmt_size[PMIX_MODEX_KEY_NATIVE_FMT] > key_fmt_size[PMIX_MODEX_KEY_KEYMAP_FMT]
+               ? PMIX_MODEX_KEY_KEYMAP_FMT
+               : PMIX_MODEX_KEY_NATIVE_FMT;
+}
+
 /*
  * Pack the key-value as a tuple of key-name index and key-value.
  * The key-name to store replaced by unique key-index that stored
  * to the key-map. So the remote server can determine the key-name
  * by the index from map that packed in modex as well.
  *
- * kmap - key values array by (char*), uses to store unique key
- *        names string and determine their indexes
+ * kmap - map of unique key names, used to determine their indexes.
+ *        Key names not already in the map are added to it
  *
  * buf - output buffer to pack key-values
  *
  * kv - pmix key-value pair
  */
 pmix_status_t pmix_gds_base_modex_pack_kval(pmix_gds_modex_key_fmt_t key_fmt, pmix_buffer_t *buf,
-                                            char ***kmap, pmix_kval_t *kv)
+                                            pmix_gds_modex_kmap_t *kmap, pmix_kval_t *kv)
 {
     uint32_t key_idx;
     pmix_status_t rc = PMIX_SUCCESS;
 
     if (PMIX_MODEX_KEY_KEYMAP_FMT == key_fmt) {
-        rc = pmix_argv_append_unique_idx((int *) &key_idx, kmap, kv->key);
+        rc = pmix_gds_base_modex_kmap_add(kmap, kv->key, &key_idx);
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
             return rc;
@@ -38,7 +38,7 @@
 #include "src/include/pmix_globals.h"
 #include "src/mca/pcompress/base/base.h"
 #include "src/mca/pmdl/pmdl.h"
-#include "src/mca/preg/preg.h"
+#include "src/mca/preg/base/base.h"
 #include "src/mca/ptl/base/base.h"
 #include "src/server/pmix_server_ops.h"
 #include "src/util/pmix_argv.h"
@@ -490,6 +490,79 @@ pmix_status_t pmix_gds_hash_fetch_appinfo(const char *key, pmix_job_t *trk, pmix
     return rc;
 }
 
+static pmix_status_t add_map_value(pmix_list_t *kvs, const char *key,
+                                   void *data, pmix_data_type_t type)
+{
+    pmix_kval_t *kv;
+
+    /* don't duplicate a value that was provided directly */
+    PMIX_LIST_FOREACH (kv, kvs, pmix_kval_t) {
+        if (PMIX_CHECK_KEY(kv, key)) {
+            return PMIX_SUCCESS;
+        }
+    }
+    PMIX_KVAL_NEW(kv, key);
+    if (NULL == kv) {
+        return PMIX_ERR_NOMEM;
+    }
+    PMIX_VALUE_LOAD(kv->value, data, type);
+    pmix_list_append(kvs, &kv->super);
+    return PMIX_SUCCESS;
+}
+
+/* the location of each proc is not stored in the hash table
+ * when the job has a compiled map - answer those keys from
+ * the map instead. A NULL key adds all of them */
+pmix_status_t pmix_gds_hash_fetch_map(pmix_job_t *trk, pmix_rank_t rank, const char *key,
+                                      pmix_list_t *kvs)
+{
+    uint32_t nodeid;
+    uint16_t lrank;
+    char *hostname;
+    pmix_status_t rc;
+
+    if (NULL == trk->map) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    if (NULL != key && !PMIx_Check_key(key, PMIX_HOSTNAME) && !PMIx_Check_key(key, PMIX_NODEID)
+        && !PMIx_Check_key(key, PMIX_LOCAL_RANK) && !PMIx_Check_key(key, PMIX_NODE_RANK)) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    rc = pmix_preg_base_map_locate(trk->map, rank, &nodeid, &lrank);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+
+    if (NULL == key || PMIx_Check_key(key, PMIX_HOSTNAME)) {
+        rc = pmix_preg_base_map_hostname(trk->map, nodeid, &hostname);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+        rc = add_map_value(kvs, PMIX_HOSTNAME, hostname, PMIX_STRING);
+        free(hostname);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+    }
+    if (NULL == key || PMIx_Check_key(key, PMIX_NODEID)) {
+        rc = add_map_value(kvs, PMIX_NODEID, &nodeid, PMIX_UINT32);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+    }
+    if (NULL == key || PMIx_Check_key(key, PMIX_LOCAL_RANK)) {
+        rc = add_map_value(kvs, PMIX_LOCAL_RANK, &lrank, PMIX_UINT16);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+    }
+    /* for now, we assume only the one job is running */
+    if (NULL == key || PMIx_Check_key(key, PMIX_NODE_RANK)) {
+        rc = add_map_value(kvs, PMIX_NODE_RANK, &lrank, PMIX_UINT16);
+    }
+    return rc;
+}
+
 pmix_status_t pmix_gds_hash_fetch(const pmix_proc_t *proc, pmix_scope_t scope, bool copy,
                                   const char *key, pmix_info_t qualifiers[], size_t nqual,
                                   pmix_list_t *kvs)
@@ -571,6 +644,11 @@ pmix_status_t pmix_gds_hash_fetch(const pmix_proc_t *proc, pmix_scope_t scope, b
                 PMIX_LIST_DESTRUCT(&rkvs);
                 return rc;
             }
+            rc = pmix_gds_hash_fetch_map(trk, rnk, NULL, &rkvs);
+            if (PMIX_ERR_NOMEM == rc) {
+                PMIX_LIST_DESTRUCT(&rkvs);
+                return rc;
+            }
             if (0 == pmix_list_get_size(&rkvs)) {
                 PMIX_DESTRUCT(&rkvs);
                 continue;
@@ -707,6 +785,11 @@ doover:
         }
     } else {
         rc = pmix_hash_fetch(ht, proc->rank, key, qualifiers, nqual, kvs);
+        if (ht == &trk->internal && 0 == nqual && (NULL == key || PMIX_SUCCESS != rc)) {
+            if (PMIX_SUCCESS == pmix_gds_hash_fetch_map(trk, proc->rank, key, kvs)) {
+                rc = PMIX_SUCCESS;
+            }
+        }
     }
     if (PMIX_SUCCESS == rc) {
         if (PMIX_GLOBAL == scope) {
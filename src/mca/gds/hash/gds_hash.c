@@ -36,6 +36,7 @@
 #include "src/class/pmix_list.h"
 #include "src/client/pmix_client_ops.h"
 #include "src/include/pmix_globals.h"
+#include "src/mca/bfrops/base/base.h"
 #include "src/mca/pcompress/base/base.h"
 #include "src/mca/pmdl/pmdl.h"
 #include "src/mca/preg/preg.h"
@@ -167,7 +168,7 @@ static pmix_status_t hash_cache_job_info(struct pmix_namespace_t *ns,
     pmix_kval_t *kp2 = NULL, *kvptr, kv;
     pmix_value_t val;
     pmix_info_t *iptr;
-    char **nodes = NULL, **procs = NULL;
+    char *nodes = NULL, *procs = NULL;
     uint32_t sid = UINT32_MAX;
     pmix_rank_t rank;
     pmix_status_t rc = PMIX_SUCCESS;
@@ -233,19 +234,11 @@ static pmix_status_t hash_cache_job_info(struct pmix_namespace_t *ns,
                 PMIX_ERROR_LOG(PMIX_ERR_BAD_PARAM);
                 return PMIX_ERR_BAD_PARAM;
             }
-            /* parse the regex to get the argv array of node names */
+            /* the regex is decoded once both maps are in hand */
             if (PMIX_REGEX == info[n].value.type) {
-                rc = pmix_preg.parse_nodes(info[n].value.data.bo.bytes, &nodes);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    goto release;
-                }
+                nodes = info[n].value.data.bo.bytes;
             } else if (PMIX_STRING == info[n].value.type) {
-                rc = pmix_preg.parse_nodes(info[n].value.data.string, &nodes);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    goto release;
-                }
+                nodes = info[n].value.data.string;
             } else {
                 PMIX_ERROR_LOG(PMIX_ERR_TYPE_MISMATCH);
                 rc = PMIX_ERR_TYPE_MISMATCH;
@@ -259,19 +252,11 @@ static pmix_status_t hash_cache_job_info(struct pmix_namespace_t *ns,
                 PMIX_ERROR_LOG(PMIX_ERR_BAD_PARAM);
                 return PMIX_ERR_BAD_PARAM;
             }
-            /* parse the regex to get the argv array containing proc ranks on each node */
+            /* the regex is decoded once both maps are in hand */
             if (PMIX_REGEX == info[n].value.type) {
-                if (PMIX_SUCCESS
-                    != (rc = pmix_preg.parse_procs(info[n].value.data.bo.bytes, &procs))) {
-                    PMIX_ERROR_LOG(rc);
-                    goto release;
-                }
+                procs = info[n].value.data.bo.bytes;
             } else if (PMIX_STRING == info[n].value.type) {
-                if (PMIX_SUCCESS
-                    != (rc = pmix_preg.parse_procs(info[n].value.data.string, &procs))) {
-                    PMIX_ERROR_LOG(rc);
-                    goto release;
-                }
+                procs = info[n].value.data.string;
             } else {
                 PMIX_ERROR_LOG(PMIX_ERR_TYPE_MISMATCH);
                 rc = PMIX_ERR_TYPE_MISMATCH;
@@ -316,6 +301,7 @@ static pmix_status_t hash_cache_job_info(struct pmix_namespace_t *ns,
                 else {
                     kv.key = iptr[j].key;
                     kv.value = &iptr[j].value;
+                    kv.storage = NULL;
                     /* store it in the hash_table */
                     rc = pmix_hash_store(ht, rank, &kv, NULL, 0);
                     if (PMIX_SUCCESS != rc) {
@@ -338,6 +324,7 @@ static pmix_status_t hash_cache_job_info(struct pmix_namespace_t *ns,
                 uint32_t zero = 0;
                 kv.key = PMIX_APPNUM;
                 kv.value = &val;
+                kv.storage = NULL;
                 PMIX_VALUE_LOAD(&val, &zero, PMIX_UINT32);
                 rc = pmix_hash_store(ht, rank, &kv, NULL, 0);
                 if (PMIX_SUCCESS != rc) {
@@ -448,6 +435,7 @@ static pmix_status_t hash_cache_job_info(struct pmix_namespace_t *ns,
                 /* just a value relating to the entire job */
                 kv.key = info[n].key;
                 kv.value = &info[n].value;
+                kv.storage = NULL;
                 rc = pmix_hash_store(ht, PMIX_RANK_WILDCARD, &kv, NULL, 0);
                 if (PMIX_SUCCESS != rc) {
                     PMIX_ERROR_LOG(rc);
@@ -501,12 +489,6 @@ static pmix_status_t hash_cache_job_info(struct pmix_namespace_t *ns,
     }
 
 release:
-    if (NULL != nodes) {
-        PMIx_Argv_free(nodes);
-    }
-    if (NULL != procs) {
-        PMIx_Argv_free(procs);
-    }
     return rc;
 }
 
@@ -648,6 +630,13 @@ static pmix_status_t register_info(pmix_peer_t *peer,
             PMIX_LIST_DESTRUCT(&values);
             return rc;
         }
+        /* add the location info held in the compiled map */
+        rc = pmix_gds_hash_fetch_map(trk, rank, NULL, &values);
+        if (PMIX_SUCCESS != rc && PMIX_ERR_NOT_FOUND != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_LIST_DESTRUCT(&values);
+            return rc;
+        }
         if (0 == pmix_list_get_size(&values)) {
             PMIX_LIST_DESTRUCT(&values);
             continue;
@@ -935,6 +924,7 @@ static pmix_status_t hash_store_job_info(const char *nspace, pmix_buffer_t *buf)
                  * individual location data */
                 procs = PMIx_Argv_split(kv.value->data.string, ',');
                 kv2.value = &val;
+                kv2.storage = NULL;
                 val.type = PMIX_STRING;
                 for (j = 0; NULL != procs[j]; j++) {
                     /* store the hostname for each proc - again, this is
@@ -965,6 +955,7 @@ static pmix_status_t hash_store_job_info(const char *nspace, pmix_buffer_t *buf)
                  * procs in this nspace */
                 kv2.key = PMIX_NODE_LIST;
                 kv2.value = &val;
+                kv2.storage = NULL;
                 val.type = PMIX_STRING;
                 val.data.string = PMIx_Argv_join(nodelist, ',');
                 PMIx_Argv_free(nodelist);
@@ -1253,6 +1244,7 @@ pmix_status_t pmix_gds_hash_store(const pmix_proc_t *proc,
                 }
                 kp.key = iptr[j].key;
                 kp.value = &iptr[j].value;
+                kp.storage = NULL;
                 pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
                                     "%s gds:hash:STORE data for nspace %s rank %u: key %s",
                                     PMIX_NAME_PRINT(&pmix_globals.myid), trk->ns, rank, kp.key);
@@ -1520,9 +1512,17 @@ static pmix_status_t accept_kvs_resp(pmix_buffer_t *buf)
     cnt = 1;
     PMIX_BFROPS_UNPACK(rc, pmix_client_globals.myserver, buf, &bo, &cnt, PMIX_BYTE_OBJECT);
     while (PMIX_SUCCESS == rc) {
-        /* setup the byte object for unpacking */
+        /* setup the byte object for unpacking - the values we
+         * store can borrow their data from it rather than each
+         * being copied out of it */
         PMIX_CONSTRUCT(&pbkt, pmix_buffer_t);
         PMIX_LOAD_BUFFER(pmix_client_globals.myserver, &pbkt, bo.bytes, bo.size);
+        rc = pmix_bfrop_buffer_share(&pbkt);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_DESTRUCT(&pbkt);
+            return rc;
+        }
         /* unpack the id of the providing process */
         cnt = 1;
         PMIX_BFROPS_UNPACK(rc, pmix_client_globals.myserver, &pbkt, &proct, &cnt, PMIX_PROC);
@@ -23,6 +23,7 @@
 #include "src/util/pmix_output.h"
 
 #include "src/mca/gds/gds.h"
+#include "src/mca/preg/preg_types.h"
 
 BEGIN_C_DECLS
 
@@ -66,6 +67,7 @@ typedef struct {
     pmix_list_t apps;
     pmix_list_t nodeinfo;
     pmix_session_t *session;
+    pmix_preg_map_t *map;
 } pmix_job_t;
 PMIX_CLASS_DECLARATION(pmix_job_t);
 
@@ -92,7 +94,7 @@ extern pmix_status_t pmix_gds_hash_process_node_array(pmix_value_t *val, pmix_li
 extern pmix_status_t pmix_gds_hash_process_app_array(pmix_value_t *val, pmix_job_t *trk);
 
 extern pmix_status_t pmix_gds_hash_process_job_array(pmix_info_t *info, pmix_job_t *trk,
-                                                     uint32_t *flags, char ***procs, char ***nodes);
+                                                     uint32_t *flags, char **procs, char **nodes);
 
 extern pmix_status_t pmix_gds_hash_process_session_array(pmix_value_t *val, pmix_job_t *trk);
 
@@ -112,13 +114,16 @@ extern bool pmix_gds_hash_check_node(pmix_nodeinfo_t *n1, pmix_nodeinfo_t *n2);
 
 extern pmix_nodeinfo_t* pmix_gds_hash_check_nodename(pmix_list_t *nodes, char *hostname);
 
-extern pmix_status_t pmix_gds_hash_store_map(pmix_job_t *trk, char **nodes, char **ppn,
+extern pmix_status_t pmix_gds_hash_store_map(pmix_job_t *trk, const char *nodes, const char *ppn,
                                              uint32_t flags);
 
 extern pmix_status_t pmix_gds_hash_fetch(const pmix_proc_t *proc, pmix_scope_t scope, bool copy,
                                          const char *key, pmix_info_t qualifiers[], size_t nqual,
                                          pmix_list_t *kvs);
 
+extern pmix_status_t pmix_gds_hash_fetch_map(pmix_job_t *trk, pmix_rank_t rank, const char *key,
+                                             pmix_list_t *kvs);
+
 extern pmix_status_t pmix_gds_hash_fetch_sessioninfo(const char *key,
                                                      pmix_job_t *trk,
                                                      pmix_info_t *info, size_t ninfo,
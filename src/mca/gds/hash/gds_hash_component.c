@@ -101,6 +101,7 @@ static void htcon(pmix_job_t *p)
     PMIX_CONSTRUCT(&p->apps, pmix_list_t);
     PMIX_CONSTRUCT(&p->nodeinfo, pmix_list_t);
     p->session = NULL;
+    p->map = NULL;
 }
 static void htdes(pmix_job_t *p)
 {
@@ -122,6 +123,9 @@ static void htdes(pmix_job_t *p)
     if (NULL != p->session) {
         PMIX_RELEASE(p->session);
     }
+    if (NULL != p->map) {
+        PMIX_RELEASE(p->map);
+    }
 }
 PMIX_CLASS_INSTANCE(pmix_job_t, pmix_list_item_t, htcon, htdes);
 
@@ -38,7 +38,7 @@
 #include "src/include/pmix_globals.h"
 #include "src/mca/pcompress/base/base.h"
 #include "src/mca/pmdl/pmdl.h"
-#include "src/mca/preg/preg.h"
+#include "src/mca/preg/base/base.h"
 #include "src/mca/ptl/base/base.h"
 #include "src/server/pmix_server_ops.h"
 #include "src/util/pmix_argv.h"
@@ -289,25 +289,13 @@ pmix_nodeinfo_t* pmix_gds_hash_check_nodename(pmix_list_t *nodes, char *hostname
     return NULL;
 }
 
-pmix_status_t pmix_gds_hash_store_map(pmix_job_t *trk, char **nodes, char **ppn, uint32_t flags)
+/* store the job-level values derived from the map */
+static pmix_status_t store_map_sizes(pmix_job_t *trk, uint32_t nnodes, char *nodelist,
+                                     uint32_t totalprocs, uint32_t flags)
 {
     pmix_status_t rc;
-    size_t m, n;
-    pmix_rank_t rank;
-    pmix_kval_t *kp1, *kp2;
-    char **procs;
-    uint32_t totalprocs = 0;
+    pmix_kval_t *kp2;
     pmix_hash_table_t *ht = &trk->internal;
-    pmix_nodeinfo_t *nd;
-
-    pmix_output_verbose(2, pmix_gds_base_framework.framework_output, "[%s:%d] gds:hash:store_map",
-                        pmix_globals.myid.nspace, pmix_globals.myid.rank);
-
-    /* if the lists don't match, then that's wrong */
-    if (PMIx_Argv_count(nodes) != PMIx_Argv_count(ppn)) {
-        PMIX_ERROR_LOG(PMIX_ERR_BAD_PARAM);
-        return PMIX_ERR_BAD_PARAM;
-    }
 
     /* if they didn't provide the number of nodes, then
      * compute it from the list of nodes */
@@ -316,16 +304,98 @@ pmix_status_t pmix_gds_hash_store_map(pmix_job_t *trk, char **nodes, char **ppn,
         kp2->key = strdup(PMIX_NUM_NODES);
         kp2->value = (pmix_value_t *) malloc(sizeof(pmix_value_t));
         kp2->value->type = PMIX_UINT32;
-        kp2->value->data.uint32 = PMIx_Argv_count(nodes);
+        kp2->value->data.uint32 = nnodes;
         pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
                             "[%s:%d] gds:hash:store_map adding key %s to job info",
                             pmix_globals.myid.nspace, pmix_globals.myid.rank, kp2->key);
+        if (PMIX_SUCCESS != (rc = pmix_hash_store(ht, PMIX_RANK_WILDCARD, kp2, NULL, 0))) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_RELEASE(kp2);
+            free(nodelist);
+            return rc;
+        }
+        PMIX_RELEASE(kp2); // maintain acctg
+    }
+
+    /* store the comma-delimited list of nodes hosting
+     * procs in this nspace in case someone using PMIx v2
+     * requests it */
+    kp2 = PMIX_NEW(pmix_kval_t);
+    kp2->key = strdup(PMIX_NODE_LIST);
+    kp2->value = (pmix_value_t *) malloc(sizeof(pmix_value_t));
+    kp2->value->type = PMIX_STRING;
+    kp2->value->data.string = nodelist;
+    pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
+                        "[%s:%d] gds:hash:store_map for nspace %s: key %s",
+                        pmix_globals.myid.nspace, pmix_globals.myid.rank, trk->ns, kp2->key);
+    if (PMIX_SUCCESS != (rc = pmix_hash_store(ht, PMIX_RANK_WILDCARD, kp2, NULL, 0))) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(kp2);
+        return rc;
+    }
+    PMIX_RELEASE(kp2); // maintain acctg
+
+    /* if they didn't provide the job size, compute it as
+     * being the number of provided procs (i.e., size of
+     * ppn list) */
+    if (!(PMIX_HASH_JOB_SIZE & flags)) {
+        kp2 = PMIX_NEW(pmix_kval_t);
+        kp2->key = strdup(PMIX_JOB_SIZE);
+        kp2->value = (pmix_value_t *) malloc(sizeof(pmix_value_t));
+        kp2->value->type = PMIX_UINT32;
+        kp2->value->data.uint32 = totalprocs;
+        pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
+                            "[%s:%d] gds:hash:store_map for nspace %s: key %s",
+                            pmix_globals.myid.nspace, pmix_globals.myid.rank, trk->ns, kp2->key);
         if (PMIX_SUCCESS != (rc = pmix_hash_store(ht, PMIX_RANK_WILDCARD, kp2, NULL, 0))) {
             PMIX_ERROR_LOG(rc);
             PMIX_RELEASE(kp2);
             return rc;
         }
         PMIX_RELEASE(kp2); // maintain acctg
+        flags |= PMIX_HASH_JOB_SIZE;
+        trk->nptr->nprocs = totalprocs;
+    }
+
+    /* if they didn't provide a value for max procs, just
+     * assume it is the same as the number of procs in the
+     * job and store it */
+    if (!(PMIX_HASH_MAX_PROCS & flags)) {
+        kp2 = PMIX_NEW(pmix_kval_t);
+        kp2->key = strdup(PMIX_MAX_PROCS);
+        kp2->value = (pmix_value_t *) malloc(sizeof(pmix_value_t));
+        kp2->value->type = PMIX_UINT32;
+        kp2->value->data.uint32 = totalprocs;
+        pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
+                            "[%s:%d] gds:hash:store_map for nspace %s: key %s",
+                            pmix_globals.myid.nspace, pmix_globals.myid.rank, trk->ns, kp2->key);
+        if (PMIX_SUCCESS != (rc = pmix_hash_store(ht, PMIX_RANK_WILDCARD, kp2, NULL, 0))) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_RELEASE(kp2);
+            return rc;
+        }
+        PMIX_RELEASE(kp2); // maintain acctg
+        flags |= PMIX_HASH_MAX_PROCS;
+    }
+
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t store_argv_map(pmix_job_t *trk, char **nodes, char **ppn, uint32_t flags)
+{
+    pmix_status_t rc;
+    size_t m, n;
+    pmix_rank_t rank;
+    pmix_kval_t *kp1, *kp2;
+    char **procs;
+    uint32_t totalprocs = 0;
+    pmix_hash_table_t *ht = &trk->internal;
+    pmix_nodeinfo_t *nd;
+
+    /* if the lists don't match, then that's wrong */
+    if (PMIx_Argv_count(nodes) != PMIx_Argv_count(ppn)) {
+        PMIX_ERROR_LOG(PMIX_ERR_BAD_PARAM);
+        return PMIX_ERR_BAD_PARAM;
     }
 
     for (n = 0; NULL != nodes[n]; n++) {
@@ -501,68 +571,141 @@ pmix_status_t pmix_gds_hash_store_map(pmix_job_t *trk, char **nodes, char **ppn,
         PMIx_Argv_free(procs);
     }
 
-    /* store the comma-delimited list of nodes hosting
-     * procs in this nspace in case someone using PMIx v2
-     * requests it */
-    kp2 = PMIX_NEW(pmix_kval_t);
-    kp2->key = strdup(PMIX_NODE_LIST);
-    kp2->value = (pmix_value_t *) malloc(sizeof(pmix_value_t));
-    kp2->value->type = PMIX_STRING;
-    kp2->value->data.string = PMIx_Argv_join(nodes, ',');
+    return store_map_sizes(trk, PMIx_Argv_count(nodes), PMIx_Argv_join(nodes, ','), totalprocs,
+                           flags);
+}
+
+static pmix_status_t store_node_value(pmix_nodeinfo_t *nd, const char *key,
+                                      void *data, pmix_data_type_t type)
+{
+    pmix_kval_t *kp1, *kp2;
+
+    PMIX_KVAL_NEW(kp2, key);
+    if (NULL == kp2) {
+        return PMIX_ERR_NOMEM;
+    }
+    PMIX_VALUE_LOAD(kp2->value, data, type);
     pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
-                        "[%s:%d] gds:hash:store_map for nspace %s: key %s",
-                        pmix_globals.myid.nspace, pmix_globals.myid.rank, trk->ns, kp2->key);
-    if (PMIX_SUCCESS != (rc = pmix_hash_store(ht, PMIX_RANK_WILDCARD, kp2, NULL, 0))) {
-        PMIX_ERROR_LOG(rc);
-        PMIX_RELEASE(kp2);
-        return rc;
+                        "[%s:%d] gds:hash:store_map adding key %s to node %s info",
+                        pmix_globals.myid.nspace, pmix_globals.myid.rank, key, nd->hostname);
+    /* ensure this item only appears once on the list */
+    PMIX_LIST_FOREACH (kp1, &nd->info, pmix_kval_t) {
+        if (PMIX_CHECK_KEY(kp1, key)) {
+            pmix_list_remove_item(&nd->info, &kp1->super);
+            PMIX_RELEASE(kp1);
+            break;
+        }
     }
-    PMIX_RELEASE(kp2); // maintain acctg
+    pmix_list_append(&nd->info, &kp2->super);
+    return PMIX_SUCCESS;
+}
 
-    /* if they didn't provide the job size, compute it as
-     * being the number of provided procs (i.e., size of
-     * ppn list) */
-    if (!(PMIX_HASH_JOB_SIZE & flags)) {
-        kp2 = PMIX_NEW(pmix_kval_t);
-        kp2->key = strdup(PMIX_JOB_SIZE);
-        kp2->value = (pmix_value_t *) malloc(sizeof(pmix_value_t));
-        kp2->value->type = PMIX_UINT32;
-        kp2->value->data.uint32 = totalprocs;
-        pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
-                            "[%s:%d] gds:hash:store_map for nspace %s: key %s",
-                            pmix_globals.myid.nspace, pmix_globals.myid.rank, trk->ns, kp2->key);
-        if (PMIX_SUCCESS != (rc = pmix_hash_store(ht, PMIX_RANK_WILDCARD, kp2, NULL, 0))) {
-            PMIX_ERROR_LOG(rc);
-            PMIX_RELEASE(kp2);
+/* store the node-level info from a compiled map. The location
+ * of each proc is answered from the map itself, so nothing is
+ * stored per rank */
+static pmix_status_t store_compiled_map(pmix_job_t *trk, pmix_preg_map_t *map, uint32_t flags)
+{
+    pmix_status_t rc;
+    uint32_t n, nlocal;
+    pmix_rank_t leader;
+    char *hostname, *peers, **nodelist = NULL;
+    pmix_nodeinfo_t *nd;
+
+    /* the tracker owns the map from here on */
+    if (NULL != trk->map) {
+        PMIX_RELEASE(trk->map);
+    }
+    trk->map = map;
+
+    /* the number of nodes is known, so size the list once */
+    nodelist = (char **) calloc(map->nnodes + 1, sizeof(char *));
+    if (NULL == nodelist) {
+        return PMIX_ERR_NOMEM;
+    }
+    for (n = 0; n < map->nnodes; n++) {
+        rc = pmix_preg_base_map_hostname(map, n, &hostname);
+        if (PMIX_SUCCESS != rc) {
+            PMIx_Argv_free(nodelist);
+            return rc;
+        }
+        nodelist[n] = strdup(hostname);
+        if (NULL == nodelist[n]) {
+            free(hostname);
+            PMIx_Argv_free(nodelist);
+            return PMIX_ERR_NOMEM;
+        }
+        /* check and see if we already have this node */
+        nd = pmix_gds_hash_check_nodename(&trk->nodeinfo, hostname);
+        if (NULL == nd) {
+            nd = PMIX_NEW(pmix_nodeinfo_t);
+            nd->hostname = hostname;
+            nd->nodeid = n;
+            pmix_list_append(&trk->nodeinfo, &nd->super);
+        } else {
+            free(hostname);
+        }
+        rc = pmix_preg_base_map_local_procs(map, n, &nlocal, &leader);
+        if (PMIX_SUCCESS == rc) {
+            rc = pmix_preg_base_map_local_peers(map, n, &peers);
+        }
+        if (PMIX_SUCCESS != rc) {
+            PMIx_Argv_free(nodelist);
+            return rc;
+        }
+        rc = store_node_value(nd, PMIX_LOCAL_PEERS, peers, PMIX_STRING);
+        free(peers);
+        if (PMIX_SUCCESS == rc) {
+            rc = store_node_value(nd, PMIX_LOCALLDR, &leader, PMIX_PROC_RANK);
+        }
+        if (PMIX_SUCCESS == rc) {
+            rc = store_node_value(nd, PMIX_LOCAL_SIZE, &nlocal, PMIX_UINT32);
+        }
+        if (PMIX_SUCCESS != rc) {
+            PMIx_Argv_free(nodelist);
             return rc;
         }
-        PMIX_RELEASE(kp2); // maintain acctg
-        flags |= PMIX_HASH_JOB_SIZE;
-        trk->nptr->nprocs = totalprocs;
     }
 
-    /* if they didn't provide a value for max procs, just
-     * assume it is the same as the number of procs in the
-     * job and store it */
-    if (!(PMIX_HASH_MAX_PROCS & flags)) {
-        kp2 = PMIX_NEW(pmix_kval_t);
-        kp2->key = strdup(PMIX_MAX_PROCS);
-        kp2->value = (pmix_value_t *) malloc(sizeof(pmix_value_t));
-        kp2->value->type = PMIX_UINT32;
-        kp2->value->data.uint32 = totalprocs;
-        pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
-                            "[%s:%d] gds:hash:store_map for nspace %s: key %s",
-                            pmix_globals.myid.nspace, pmix_globals.myid.rank, trk->ns, kp2->key);
-        if (PMIX_SUCCESS != (rc = pmix_hash_store(ht, PMIX_RANK_WILDCARD, kp2, NULL, 0))) {
+    rc = store_map_sizes(trk, map->nnodes, PMIx_Argv_join(nodelist, ','), map->nprocs, flags);
+    PMIx_Argv_free(nodelist);
+    return rc;
+}
+
+pmix_status_t pmix_gds_hash_store_map(pmix_job_t *trk, const char *nodes, const char *ppn,
+                                      uint32_t flags)
+{
+    pmix_status_t rc;
+    pmix_preg_map_t *map;
+    char **nodelist = NULL, **procs = NULL;
+
+    pmix_output_verbose(2, pmix_gds_base_framework.framework_output, "[%s:%d] gds:hash:store_map",
+                        pmix_globals.myid.nspace, pmix_globals.myid.rank);
+
+    if (PMIX_SUCCESS == pmix_preg.compile_map(nodes, ppn, &map)) {
+        rc = store_compiled_map(trk, map, flags);
+        if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
-            PMIX_RELEASE(kp2);
-            return rc;
         }
-        PMIX_RELEASE(kp2); // maintain acctg
-        flags |= PMIX_HASH_MAX_PROCS;
+        return rc;
     }
 
-    return PMIX_SUCCESS;
+    /* nobody could compile the regex, so expand the
+     * full lists of nodes and procs */
+    rc = pmix_preg.parse_nodes(nodes, &nodelist);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    rc = pmix_preg.parse_procs(ppn, &procs);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIx_Argv_free(nodelist);
+        return rc;
+    }
+    rc = store_argv_map(trk, nodelist, procs, flags);
+    PMIx_Argv_free(nodelist);
+    PMIx_Argv_free(procs);
+    return rc;
 }
 
 pmix_status_t pmix_gds_hash_store_qualified(pmix_hash_table_t *ht,
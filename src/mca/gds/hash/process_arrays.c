@@ -366,7 +366,7 @@ release:
 
 /* process a job array */
 pmix_status_t pmix_gds_hash_process_job_array(pmix_info_t *info, pmix_job_t *trk, uint32_t *flags,
-                                              char ***procs, char ***nodes)
+                                              char **procs, char **nodes)
 {
     pmix_list_t cache;
     size_t j, size;
@@ -402,11 +402,8 @@ pmix_status_t pmix_gds_hash_process_job_array(pmix_info_t *info, pmix_job_t *trk
                 PMIX_ERROR_LOG(PMIX_ERR_BAD_PARAM);
                 return PMIX_ERR_BAD_PARAM;
             }
-            /* parse the regex to get the argv array containing proc ranks on each node */
-            if (PMIX_SUCCESS != (rc = pmix_preg.parse_procs(iptr[j].value.data.bo.bytes, procs))) {
-                PMIX_ERROR_LOG(rc);
-                return rc;
-            }
+            /* the regex is decoded once both maps are in hand */
+            *procs = iptr[j].value.data.bo.bytes;
             /* mark that we got the map */
             *flags |= PMIX_HASH_PROC_MAP;
         } else if (PMIX_CHECK_KEY(&iptr[j], PMIX_NODE_MAP)) {
@@ -415,11 +412,8 @@ pmix_status_t pmix_gds_hash_process_job_array(pmix_info_t *info, pmix_job_t *trk
                 PMIX_ERROR_LOG(PMIX_ERR_BAD_PARAM);
                 return PMIX_ERR_BAD_PARAM;
             }
-            /* parse the regex to get the argv array of node names */
-            if (PMIX_SUCCESS != (rc = pmix_preg.parse_nodes(iptr[j].value.data.bo.bytes, nodes))) {
-                PMIX_ERROR_LOG(rc);
-                return rc;
-            }
+            /* the regex is decoded once both maps are in hand */
+            *nodes = iptr[j].value.data.bo.bytes;
             /* mark that we got the map */
             *flags |= PMIX_HASH_NODE_MAP;
         } else if (PMIX_CHECK_KEY(&iptr[j], PMIX_MODEL_LIBRARY_NAME) ||
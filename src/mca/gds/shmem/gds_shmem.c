@@ -18,6 +18,7 @@
 #include "gds_shmem_utils.h"
 #include "gds_shmem_store.h"
 #include "gds_shmem_fetch.h"
+#include "gds_shmem_heap.h"
 
 #include "src/util/pmix_argv.h"
 #include "src/util/pmix_environ.h"
@@ -41,7 +42,6 @@
 // Some items for future consideration:
 // * Address FT case at some point. We need to have a broader conversion about
 //   how we go about doing this. Ralph has some ideas.
-// * Is it worth adding memory arena boundary checks to our TMA allocators?
 
 /**
  * Key names used to find shared-memory segment info.
@@ -52,6 +52,7 @@
 #define SHMEM_SEG_PATH_KEY "PMIX_GDS_SHMEM_SEG_PATH"
 #define SHMEM_SEG_SIZE_KEY "PMIX_GDS_SHMEM_SEG_SIZE"
 #define SHMEM_SEG_ADDR_KEY "PMIX_GDS_SHMEM_SEG_ADDR"
+#define SHMEM_SEG_XTID_KEY "PMIX_GDS_SHMEM_SEG_XTID"
 
 /**
  * Stores packed job statistics.
@@ -71,6 +72,7 @@ typedef struct {
     char *seg_path;
     size_t seg_size;
     size_t seg_addr;
+    size_t seg_xtid;
 } pmix_gds_shmem_unpacked_seg_blob_t;
 PMIX_CLASS_DECLARATION(pmix_gds_shmem_unpacked_seg_blob_t);
 
@@ -99,115 +101,6 @@ strtost(
     return PMIX_SUCCESS;
 }
 
-/**
- * Architecture-specific address alignment.
- */
-static inline void *
-addr_align(
-    void *base,
-    size_t size
-) {
-#if 0 // Helpful debug
-    PMIX_GDS_SHMEM_VVOUT("------------------------ADDRINN=%p,%zd", base, size);
-#endif
-    void *const res = (void *)(((uintptr_t)base + size + 7) & ~(uintptr_t)0x07);
-#if 0 // Helpful debug
-    // Make sure that it's 8-byte aligned.
-    assert ((uintptr_t)res % 8 == 0);
-    PMIX_GDS_SHMEM_VVOUT("------------------------ADDROUT=%p,%zd", res, size);
-#endif
-    return res;
-}
-
-static inline void *
-tma_malloc(
-    pmix_tma_t *tma,
-    size_t size
-) {
-    void *const current = *(tma->data_ptr);
-#if PMIX_ENABLE_DEBUG
-    memset(current, 0, size);
-#endif
-    *(tma->data_ptr) = addr_align(current, size);
-    return current;
-}
-
-static inline void *
-tma_calloc(
-    struct pmix_tma *tma,
-    size_t nmemb,
-    size_t size
-) {
-    const size_t real_size = nmemb * size;
-    void *const current = *(tma->data_ptr);
-    memset(current, 0, real_size);
-    *(tma->data_ptr) = addr_align(current, real_size);
-    return current;
-}
-
-static inline void *
-tma_realloc(
-    pmix_tma_t *tma,
-    void *ptr,
-    size_t size
-) {
-    PMIX_HIDE_UNUSED_PARAMS(tma, ptr, size);
-    // We don't support realloc.
-    assert(false);
-    return NULL;
-}
-
-static inline char *
-tma_strdup(
-    pmix_tma_t *tma,
-    const char *s
-) {
-    void *const current = *(tma->data_ptr);
-    const size_t size = strlen(s) + 1;
-    *(tma->data_ptr) = addr_align(current, size);
-    return (char *)memmove(current, s, size);
-}
-
-static inline void *
-tma_memmove(
-    struct pmix_tma *tma,
-    const void *src,
-    size_t size
-) {
-    void *const current = *(tma->data_ptr);
-    *(tma->data_ptr) = addr_align(current, size);
-    return memmove(current, src, size);
-}
-
-static inline void
-tma_free(
-    struct pmix_tma *tma,
-    void *ptr
-) {
-    PMIX_HIDE_UNUSED_PARAMS(tma, ptr);
-}
-
-static void
-tma_init_function_pointers(
-    pmix_tma_t *tma
-) {
-    tma->tma_malloc = tma_malloc;
-    tma->tma_calloc = tma_calloc;
-    tma->tma_realloc = tma_realloc;
-    tma->tma_strdup = tma_strdup;
-    tma->tma_memmove = tma_memmove;
-    tma->tma_free = tma_free;
-}
-
-static void
-tma_init(
-    pmix_tma_t *tma,
-    void *data_ptr
-) {
-    tma_init_function_pointers(tma);
-    tma->data_ptr = data_ptr;
-}
-
 static void
 unpacked_seg_blob_construct(
     pmix_gds_shmem_unpacked_seg_blob_t *ub
@@ -217,6 +110,7 @@ unpacked_seg_blob_construct(
     ub->seg_path = NULL;
     ub->seg_size = 0;
     ub->seg_addr = 0;
+    ub->seg_xtid = 0;
 }
 
 static void
@@ -305,6 +199,9 @@ job_construct(
     // Modex
     job->modex_shmem_status = 0;
     job->modex_shmem = PMIX_NEW(pmix_shmem_t);
+    job->modex_extents = PMIX_NEW(pmix_pointer_array_t);
+    pmix_pointer_array_init(job->modex_extents, 4, INT_MAX, 4);
+    job->modex_size_hint = 0;
     job->smmodex = NULL;
 }
 
@@ -314,7 +211,7 @@ emit_shmem_usage_stats(
     pmix_gds_shmem_job_shmem_id_t shmem_id
 ) {
     pmix_status_t rc = PMIX_SUCCESS;
-    pmix_tma_t *tma = NULL;
+    pmix_gds_shmem_heap_t *heap = NULL;
     const char *smname = NULL;
 
     pmix_shmem_t *shmem;
@@ -328,11 +225,11 @@ emit_shmem_usage_stats(
 
     switch (shmem_id) {
         case PMIX_GDS_SHMEM_JOB_ID:
-            tma = &job->smdata->tma;
+            heap = &job->smdata->heap;
             smname = "smdata";
             break;
         case PMIX_GDS_SHMEM_MODEX_ID:
-            tma = &job->smmodex->tma;
+            heap = &job->smmodex->heap;
             smname = "smmodex";
             break;
         case PMIX_GDS_SHMEM_INVALID_ID:
@@ -341,15 +238,50 @@ emit_shmem_usage_stats(
             return;
     }
 
-    const size_t shmem_size = shmem->size;
-    const size_t bytes_used = (size_t)((uintptr_t)*(tma->data_ptr)
-                            - (uintptr_t)shmem->base_address);
+    const pmix_gds_shmem_heap_stats_t *const stats = &heap->stats;
+    // Account for the space taken by the header at the segment's base.
+    const size_t header_size = (PMIX_GDS_SHMEM_JOB_ID == shmem_id) ?
+        sizeof(*job->smdata) : sizeof(*job->smmodex);
+    size_t shmem_size = shmem->size;
+    if (PMIX_GDS_SHMEM_MODEX_ID == shmem_id) {
+        for (int i = 0; i < job->modex_extents->size; ++i) {
+            pmix_shmem_t *xshmem = pmix_pointer_array_get_item(
+                job->modex_extents, i
+            );
+            if (NULL != xshmem) {
+                shmem_size += xshmem->size;
+            }
+        }
+    }
+    const size_t bytes_used = header_size + pmix_gds_shmem_heap_extent(heap);
+    const size_t bytes_peak = header_size + stats->bytes_peak;
     const float utilization = (bytes_used / (float)shmem_size) * 100.0;
+    const float peak_utilization = (bytes_peak / (float)shmem_size) * 100.0;
+    // External fragmentation: bytes sitting on free lists below the top.
+    const size_t extent = pmix_gds_shmem_heap_extent(heap);
+    const float ext_frag = (0 == extent) ? 0.0 :
+        (stats->bytes_free / (float)extent) * 100.0;
+    // Internal fragmentation: bytes lost to size-class rounding and headers.
+    const size_t waste = stats->bytes_allocated - stats->bytes_requested;
+    const float int_frag = (0 == stats->bytes_allocated) ? 0.0 :
+        (waste / (float)stats->bytes_allocated) * 100.0;
 
     PMIX_GDS_SHMEM_VOUT(
         "%s memory statistics: "
-        "segment size=%zd, bytes used=%zd, utilization=%.2f %%",
-        smname, shmem_size, bytes_used, utilization
+        "segments=%zd, segment size=%zd, bytes used=%zd, utilization=%.2f %%, "
+        "peak bytes used=%zd, peak utilization=%.2f %%",
+        smname, heap->nextents, shmem_size, bytes_used, utilization,
+        bytes_peak, peak_utilization
+    );
+    PMIX_GDS_SHMEM_VOUT(
+        "%s heap statistics: "
+        "allocs=%zd, frees=%zd, reallocs=%zd (in place=%zd), failed=%zd, "
+        "bytes requested=%zd, bytes allocated=%zd, bytes free=%zd, "
+        "external fragmentation=%.2f %%, internal fragmentation=%.2f %%",
+        smname, stats->nallocs, stats->nfrees, stats->nreallocs,
+        stats->nreallocs_inplace, stats->nfailed,
+        stats->bytes_requested, stats->bytes_allocated, stats->bytes_free,
+        ext_frag, int_frag
     );
 }
 
@@ -389,6 +321,14 @@ job_destruct(
         // Releases memory for the structures located in shared-memory.
         PMIX_RELEASE(shmem);
     }
+    // Release any segments chained to the modex segment.
+    for (int i = 0; i < job->modex_extents->size; ++i) {
+        pmix_shmem_t *xshmem = pmix_pointer_array_get_item(job->modex_extents, i);
+        if (NULL != xshmem) {
+            PMIX_RELEASE(xshmem);
+        }
+    }
+    PMIX_RELEASE(job->modex_extents);
 }
 
 PMIX_CLASS_INSTANCE(
@@ -470,13 +410,13 @@ job_smdata_construct(
     void *const baseaddr = job->shmem->base_address;
     job->smdata = baseaddr;
     memset(job->smdata, 0, sizeof(*job->smdata));
-    // Save the starting address for TMA memory allocations.
-    job->smdata->current_addr = baseaddr;
-    // Setup the TMA.
-    tma_init(&job->smdata->tma, &job->smdata->current_addr);
-    // Now we need to update the TMA's pointer to account for our using up some
-    // space for its header.
-    *(job->smdata->tma.data_ptr) = addr_align(baseaddr, sizeof(*job->smdata));
+    // Setup the heap and its TMA. The heap manages everything in the segment
+    // past the header we just placed at its base.
+    void *const heapaddr = (void *)((uintptr_t)baseaddr + sizeof(*job->smdata));
+    pmix_gds_shmem_heap_init(
+        &job->smdata->heap, &job->smdata->tma,
+        heapaddr, job->shmem->size - sizeof(*job->smdata)
+    );
     // We can now safely get our TMA.
     pmix_tma_t *const tma = &job->smdata->tma;
     // Now that we know the TMA, initialize smdata structures using it.
@@ -493,6 +433,13 @@ job_smdata_construct(
     return PMIX_SUCCESS;
 }
 
+static pmix_status_t
+modex_heap_grow(
+    pmix_gds_shmem_heap_t *heap,
+    size_t min_size,
+    void *ctx
+);
+
 static pmix_status_t
 modex_smdata_construct(
     pmix_gds_shmem_job_t *job,
@@ -504,13 +451,17 @@ modex_smdata_construct(
     void *const baseaddr = job->modex_shmem->base_address;
     job->smmodex = baseaddr;
     memset(job->smmodex, 0, sizeof(*job->smmodex));
-    // Save the starting address for TMA memory allocations.
-    job->smmodex->current_addr = baseaddr;
-    // Setup the TMA.
-    tma_init(&job->smmodex->tma, &job->smmodex->current_addr);
-    // Now we need to update the TMA's pointer to account for our using up some
-    // space for its header.
-    *(job->smmodex->tma.data_ptr) = addr_align(baseaddr, sizeof(*job->smmodex));
+    // Setup the heap and its TMA. The heap manages everything in the segment
+    // past the header we just placed at its base.
+    void *const heapaddr = (void *)((uintptr_t)baseaddr + sizeof(*job->smmodex));
+    pmix_gds_shmem_heap_init(
+        &job->smmodex->heap, &job->smmodex->tma,
+        heapaddr, job->modex_shmem->size - sizeof(*job->smmodex)
+    );
+    // Modex data can grow beyond our initial estimate, so chain additional
+    // segments as needed.
+    job->smmodex->heap.grow = modex_heap_grow;
+    job->smmodex->heap.grow_ctx = job;
     // We can now safely get our TMA.
     pmix_tma_t *const tma = &job->smmodex->tma;
     // Now that we know the TMA, initialize smdata structures using it.
@@ -646,24 +597,54 @@ get_shmem_backing_path(
 }
 
 /**
- * Attaches to the given shared-memory segment.
+ * Returns the requested extent of the given shared-memory segment, where
+ * extent 0 is the segment itself. Returns NULL if no such extent exists.
  */
-static pmix_status_t
-shmem_attach(
+static pmix_shmem_t *
+get_job_shmem_extent(
     pmix_gds_shmem_job_t *job,
     pmix_gds_shmem_job_shmem_id_t shmem_id,
-    uintptr_t req_addr
+    size_t xtid
 ) {
-    pmix_status_t rc = PMIX_SUCCESS;
+    if (0 == xtid) {
+        pmix_shmem_t *shmem = NULL;
+        (void)pmix_gds_shmem_get_job_shmem_by_id(job, shmem_id, &shmem);
+        return shmem;
+    }
+    if (PMIX_GDS_SHMEM_MODEX_ID != shmem_id) {
+        return NULL;
+    }
+    return pmix_pointer_array_get_item(job->modex_extents, (int)(xtid - 1));
+}
 
-    pmix_shmem_t *shmem;
-    rc = pmix_gds_shmem_get_job_shmem_by_id(
-        job, shmem_id, &shmem
-    );
-    if (PMIX_UNLIKELY(rc != PMIX_SUCCESS)) {
-        PMIX_ERROR_LOG(rc);
-        return rc;
+/**
+ * Returns the number of extents associated with the given shared-memory
+ * segment, including the segment itself.
+ */
+static size_t
+get_job_shmem_nextents(
+    pmix_gds_shmem_job_t *job,
+    pmix_gds_shmem_job_shmem_id_t shmem_id
+) {
+    size_t n = 1;
+    if (PMIX_GDS_SHMEM_MODEX_ID != shmem_id) {
+        return n;
     }
+    while (NULL != get_job_shmem_extent(job, shmem_id, n)) {
+        ++n;
+    }
+    return n;
+}
+
+/**
+ * Attaches to the given shared-memory segment at the requested address.
+ */
+static pmix_status_t
+shmem_attach_at(
+    pmix_shmem_t *shmem,
+    uintptr_t req_addr
+) {
+    pmix_status_t rc = PMIX_SUCCESS;
 
     uintptr_t mmap_addr = 0;
     rc = pmix_shmem_segment_attach(
@@ -682,16 +663,37 @@ shmem_attach(
         );
         rc = PMIX_ERROR;
         PMIX_ERROR_LOG(rc);
-        goto out;
+        (void)pmix_shmem_segment_detach(shmem);
+        return rc;
     }
     PMIX_GDS_SHMEM_VOUT(
         "%s: mmapd at address=0x%zx", __func__, (size_t)mmap_addr
     );
-out:
-    if (PMIX_SUCCESS != rc) {
-        (void)pmix_shmem_segment_detach(shmem);
+    return rc;
+}
+
+/**
+ * Attaches to the given shared-memory segment.
+ */
+static pmix_status_t
+shmem_attach(
+    pmix_gds_shmem_job_t *job,
+    pmix_gds_shmem_job_shmem_id_t shmem_id,
+    uintptr_t req_addr
+) {
+    pmix_status_t rc = PMIX_SUCCESS;
+
+    pmix_shmem_t *shmem;
+    rc = pmix_gds_shmem_get_job_shmem_by_id(
+        job, shmem_id, &shmem
+    );
+    if (PMIX_UNLIKELY(rc != PMIX_SUCCESS)) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
     }
-    else {
+
+    rc = shmem_attach_at(shmem, req_addr);
+    if (PMIX_SUCCESS == rc) {
         pmix_gds_shmem_set_status(
             job, shmem_id, PMIX_GDS_SHMEM_ATTACHED
         );
@@ -764,12 +766,53 @@ shmem_segment_attach_and_init(
 }
 
 /**
- * Create and attach to a shared-memory segment.
+ * Attaches to a segment chained to one of the job's shared-memory segments,
+ * unless we have already done so.
  */
 static pmix_status_t
-shmem_segment_create_and_attach(
+shmem_extent_attach_if_necessary(
     pmix_gds_shmem_job_t *job,
-    pmix_gds_shmem_job_shmem_id_t shmem_id,
+    pmix_gds_shmem_unpacked_seg_blob_t *seginfo
+) {
+    pmix_status_t rc = PMIX_SUCCESS;
+
+    if (PMIX_UNLIKELY(PMIX_GDS_SHMEM_MODEX_ID != seginfo->smid)) {
+        rc = PMIX_ERR_BAD_PARAM;
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    if (NULL != get_job_shmem_extent(job, seginfo->smid, seginfo->seg_xtid)) {
+        return rc;
+    }
+
+    pmix_shmem_t *shmem = PMIX_NEW(pmix_shmem_t);
+    const size_t buffmax = sizeof(shmem->backing_path);
+    pmix_string_copy(shmem->backing_path, seginfo->seg_path, buffmax);
+    shmem->size = seginfo->seg_size;
+
+    rc = shmem_attach_at(shmem, (uintptr_t)seginfo->seg_addr);
+    if (PMIX_UNLIKELY(PMIX_SUCCESS != rc)) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(shmem);
+        return rc;
+    }
+    rc = pmix_pointer_array_set_item(
+        job->modex_extents, (int)(seginfo->seg_xtid - 1), shmem
+    );
+    if (PMIX_UNLIKELY(PMIX_SUCCESS != rc)) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(shmem);
+    }
+    return rc;
+}
+
+/**
+ * Create a shared-memory segment and attach to it at a suitable address.
+ */
+static pmix_status_t
+shmem_create_and_attach(
+    pmix_gds_shmem_job_t *job,
+    pmix_shmem_t *shmem,
     const char *segment_name,
     size_t segment_size
 ) {
@@ -782,7 +825,7 @@ shmem_segment_create_and_attach(
         VMEM_HOLE_BIGGEST, &base_addr, real_segsize
     );
     if (PMIX_UNLIKELY(PMIX_SUCCESS != rc)) {
-        goto out;
+        return rc;
     }
     PMIX_GDS_SHMEM_VOUT(
         "%s:%s found vmhole at address=0x%zx",
@@ -791,29 +834,44 @@ shmem_segment_create_and_attach(
     // Find a unique path for the shared-memory backing file.
     const char *segment_path = get_shmem_backing_path(job, segment_name);
     if (PMIX_UNLIKELY(!segment_path)) {
-        rc = PMIX_ERROR;
-        goto out;
+        return PMIX_ERROR;
     }
     PMIX_GDS_SHMEM_VOUT(
         "%s: segment backing file path is %s (size=%zd B)",
         __func__, segment_path, real_segsize
     );
+    // Create a shared-memory segment backing store at the given path.
+    rc = pmix_shmem_segment_create(shmem, real_segsize, segment_path);
+    if (PMIX_UNLIKELY(PMIX_SUCCESS != rc)) {
+        return rc;
+    }
+    // Attach to the shared-memory segment.
+    return shmem_attach_at(shmem, (uintptr_t)base_addr);
+}
+
+/**
+ * Create and attach to a shared-memory segment.
+ */
+static pmix_status_t
+shmem_segment_create_and_attach(
+    pmix_gds_shmem_job_t *job,
+    pmix_gds_shmem_job_shmem_id_t shmem_id,
+    const char *segment_name,
+    size_t segment_size
+) {
+    pmix_status_t rc = PMIX_SUCCESS;
     // Get a handle to the appropriate shmem.
     pmix_shmem_t *shmem;
     rc = pmix_gds_shmem_get_job_shmem_by_id(job, shmem_id, &shmem);
     if (PMIX_UNLIKELY(rc != PMIX_SUCCESS)) {
         PMIX_ERROR_LOG(rc);
-        goto out;
-    }
-    // Create a shared-memory segment backing store at the given path.
-    rc = pmix_shmem_segment_create(shmem, real_segsize, segment_path);
-    if (PMIX_UNLIKELY(PMIX_SUCCESS != rc)) {
-        goto out;
+        return rc;
     }
-    // Attach to the shared-memory segment.
-    rc = shmem_attach(job, shmem_id, (uintptr_t)base_addr);
-out:
+    rc = shmem_create_and_attach(job, shmem, segment_name, segment_size);
     if (PMIX_SUCCESS == rc) {
+        pmix_gds_shmem_set_status(
+            job, shmem_id, PMIX_GDS_SHMEM_ATTACHED
+        );
         // I created it, so I must release it.
         pmix_gds_shmem_set_status(
             job, shmem_id, PMIX_GDS_SHMEM_RELEASE
@@ -822,6 +880,64 @@ out:
     return rc;
 }
 
+/**
+ * Heap growth callback for modex data: chains a new shared-memory segment to
+ * the modex segment. Clients learn about it the next time connection
+ * information is exchanged.
+ */
+static pmix_status_t
+modex_heap_grow(
+    pmix_gds_shmem_heap_t *heap,
+    size_t min_size,
+    void *ctx
+) {
+    pmix_status_t rc = PMIX_SUCCESS;
+    pmix_gds_shmem_job_t *const job = (pmix_gds_shmem_job_t *)ctx;
+
+    const size_t xtid = get_job_shmem_nextents(job, PMIX_GDS_SHMEM_MODEX_ID);
+    // Grow geometrically: each new extent is at least as large as all of the
+    // previous ones combined.
+    size_t seg_size = 0;
+    for (size_t i = 0; i < xtid; ++i) {
+        seg_size += get_job_shmem_extent(job, PMIX_GDS_SHMEM_MODEX_ID, i)->size;
+    }
+    if (seg_size < min_size) {
+        seg_size = min_size;
+    }
+
+    char *segment_name = NULL;
+    int nw = asprintf(&segment_name, "modexdata%zd", xtid);
+    if (PMIX_UNLIKELY(nw == -1)) {
+        rc = PMIX_ERR_NOMEM;
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
+    pmix_shmem_t *shmem = PMIX_NEW(pmix_shmem_t);
+    rc = shmem_create_and_attach(job, shmem, segment_name, seg_size);
+    free(segment_name);
+    if (PMIX_UNLIKELY(PMIX_SUCCESS != rc)) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(shmem);
+        return rc;
+    }
+    rc = pmix_pointer_array_set_item(
+        job->modex_extents, (int)(xtid - 1), shmem
+    );
+    if (PMIX_UNLIKELY(PMIX_SUCCESS != rc)) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(shmem);
+        return rc;
+    }
+    pmix_gds_shmem_heap_add_extent(heap, shmem->base_address, shmem->size);
+
+    PMIX_GDS_SHMEM_VOUT(
+        "%s: chained modex extent %zd (size=%zd B) for namespace=%s",
+        __func__, xtid, shmem->size, job->nspace_id
+    );
+    return rc;
+}
+
 static pmix_status_t
 module_init(
     pmix_info_t info[],
@@ -957,22 +1073,21 @@ static inline pmix_status_t
 pack_shmem_connection_info(
     pmix_gds_shmem_job_t *job,
     pmix_gds_shmem_job_shmem_id_t shmem_id,
+    size_t xtid,
     pmix_peer_t *peer,
     pmix_buffer_t *buffer
 ) {
     pmix_status_t rc = PMIX_SUCCESS;
 
     PMIX_GDS_SHMEM_VVOUT(
-        "%s:%s for peer (ID=%d) namespace=%s", __func__,
+        "%s:%s for peer (ID=%d) namespace=%s extent=%zd", __func__,
         PMIX_NAME_PRINT(&pmix_globals.myid),
-        peer->info->peerid, job->nspace_id
+        peer->info->peerid, job->nspace_id, xtid
     );
 
-    pmix_shmem_t *shmem;
-    rc = pmix_gds_shmem_get_job_shmem_by_id(
-        job, shmem_id, &shmem
-    );
-    if (PMIX_UNLIKELY(rc != PMIX_SUCCESS)) {
+    pmix_shmem_t *shmem = get_job_shmem_extent(job, shmem_id, xtid);
+    if (PMIX_UNLIKELY(NULL == shmem)) {
+        rc = PMIX_ERR_NOT_FOUND;
         PMIX_ERROR_LOG(rc);
         return rc;
     }
@@ -1008,6 +1123,23 @@ pack_shmem_connection_info(
             break;
         }
         PMIX_DESTRUCT(&kv);
+        // Pack the extent ID as string.
+        PMIX_CONSTRUCT(&kv, pmix_kval_t);
+        kv.key = strdup(SHMEM_SEG_XTID_KEY);
+        kv.value = (pmix_value_t *)calloc(1, sizeof(pmix_value_t));
+        kv.value->type = PMIX_STRING;
+        nw = asprintf(&kv.value->data.string, "%zd", xtid);
+        if (PMIX_UNLIKELY(nw == -1)) {
+            rc = PMIX_ERR_NOMEM;
+            PMIX_ERROR_LOG(rc);
+            break;
+        }
+        PMIX_BFROPS_PACK(rc, peer, buffer, &kv, 1, PMIX_KVAL);
+        if (PMIX_UNLIKELY(PMIX_SUCCESS != rc)) {
+            PMIX_ERROR_LOG(rc);
+            break;
+        }
+        PMIX_DESTRUCT(&kv);
         // Pack the backing file path.
         PMIX_CONSTRUCT(&kv, pmix_kval_t);
         kv.key = strdup(SHMEM_SEG_PATH_KEY);
@@ -1072,10 +1204,11 @@ vout_unpacked_seg_blob(
         "%s: "
         SHMEM_SEG_NSID_KEY "=%s "
         SHMEM_SEG_SMID_KEY "=%u "
+        SHMEM_SEG_XTID_KEY "=%zd "
         SHMEM_SEG_PATH_KEY "=%s "
         SHMEM_SEG_SIZE_KEY "=%zd "
         SHMEM_SEG_ADDR_KEY "=0x%zx",
-        called_by, usb->nsid, (unsigned)usb->smid,
+        called_by, usb->nsid, (unsigned)usb->smid, usb->seg_xtid,
         usb->seg_path, usb->seg_size, usb->seg_addr
     );
 }
@@ -1140,6 +1273,13 @@ unpack_shmem_connection_info(
             }
             usb->smid = (pmix_gds_shmem_job_shmem_id_t)st_shmem_id;
         }
+        else if (PMIX_CHECK_KEY(&kv, SHMEM_SEG_XTID_KEY)) {
+            rc = strtost(val, 10, &usb->seg_xtid);
+            if (PMIX_UNLIKELY(PMIX_SUCCESS != rc)) {
+                PMIX_ERROR_LOG(rc);
+                break;
+            }
+        }
         else if (PMIX_CHECK_KEY(&kv, SHMEM_SEG_PATH_KEY)) {
             int nw = asprintf(&usb->seg_path, "%s", val);
             if (PMIX_UNLIKELY(nw == -1)) {
@@ -1286,15 +1426,19 @@ pack_shmem_seg_blob(
         return rc;
     }
 
-    pmix_buffer_t buff;
-    do {
+    // Pack connection information for each of the segment's extents, so that
+    // clients can attach to any they haven't seen yet.
+    const size_t nextents = get_job_shmem_nextents(job, shmem_id);
+    for (size_t xtid = 0; xtid < nextents; ++xtid) {
+        pmix_buffer_t buff;
         PMIX_CONSTRUCT(&buff, pmix_buffer_t);
 
         rc = pack_shmem_connection_info(
-            job, shmem_id, peer, &buff
+            job, shmem_id, xtid, peer, &buff
         );
         if (PMIX_UNLIKELY(PMIX_SUCCESS != rc)) {
             PMIX_ERROR_LOG(rc);
+            PMIX_DESTRUCT(&buff);
             break;
         }
 
@@ -1312,9 +1456,11 @@ pack_shmem_seg_blob(
             PMIX_ERROR_LOG(rc);
         }
         PMIX_VALUE_DESTRUCT(&blob);
-    } while (false);
-    PMIX_DESTRUCT(&buff);
-
+        PMIX_DESTRUCT(&buff);
+        if (PMIX_UNLIKELY(PMIX_SUCCESS != rc)) {
+            break;
+        }
+    }
     return rc;
 }
 
@@ -1485,6 +1631,14 @@ unpack_shmem_seg_blob_and_attach_if_necessary(
             PMIX_ERROR_LOG(rc);
             break;
         }
+        // Chained extents are handled separately.
+        if (0 != usb.seg_xtid) {
+            rc = shmem_extent_attach_if_necessary(job, &usb);
+            if (PMIX_UNLIKELY(PMIX_SUCCESS != rc)) {
+                PMIX_ERROR_LOG(rc);
+            }
+            break;
+        }
         // Make sure we aren't already attached to the given shmem.
         if (pmix_gds_shmem_has_status(job, usb.smid, PMIX_GDS_SHMEM_ATTACHED)) {
             break;
@@ -1597,8 +1751,14 @@ server_store_modex(
         const size_t npeers = job->nspace->nprocs;
         // TODO(skg) We need to calculate this somehow.
         const size_t htsize = 256 * npeers;
-        // Estimated size required to store the unpacked modex data.
+        // Estimated size required to store the unpacked modex data. Prefer
+        // the host's estimate, if provided. Either way, the segment grows
+        // as needed, so this only needs to be a reasonable starting point.
         size_t seg_size = buff->bytes_used * npeers;
+        if (0 < job->modex_size_hint) {
+            seg_size = job->modex_size_hint;
+        }
+        seg_size += sizeof(*job->smmodex);
         seg_size += sizeof(pmix_hash_table_t);
         seg_size += htsize * pmix_hash_table_sizeof_hash_element();
         // Include some extra fluff that empirically seems reasonable.
@@ -1753,10 +1913,23 @@ client_recv_modex_complete(
     return rc;
 }
 
-static void set_size(struct pmix_namespace_t *ns, size_t memsize)
-{
-    PMIX_HIDE_UNUSED_PARAMS(ns, memsize);
-    return;
+static void
+set_size(
+    struct pmix_namespace_t *ns,
+    size_t memsize
+) {
+    PMIX_GDS_SHMEM_VOUT_HERE();
+
+    pmix_gds_shmem_job_t *job;
+    pmix_status_t rc = pmix_gds_shmem_get_job_tracker(
+        ((pmix_namespace_t *)(ns))->nspace, false, &job
+    );
+    if (PMIX_UNLIKELY(PMIX_SUCCESS != rc)) {
+        return;
+    }
+    // Only used to size the initial modex segment: the modex segment grows
+    // on demand, so this need not be exact.
+    job->modex_size_hint = memsize;
 }
 
 pmix_gds_base_module_t pmix_shmem_module = {
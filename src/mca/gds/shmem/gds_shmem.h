@@ -20,6 +20,8 @@
 #include "src/util/pmix_shmem.h"
 #include "src/mca/gds/base/base.h"
 
+#include "gds_shmem_heap.h"
+
 #ifdef HAVE_STDINT_h
 #include <stdint.h>
 #endif
@@ -129,8 +131,8 @@ PMIX_CLASS_DECLARATION(pmix_gds_shmem_session_t);
 typedef struct {
     /** Shared-memory allocator for data this structure. */
     pmix_tma_t tma;
-    /** Holds the current address of the shared-memory allocator. */
-    void *current_addr;
+    /** Heap backing the shared-memory allocator. */
+    pmix_gds_shmem_heap_t heap;
     /** Points to this job's session information. */
     pmix_gds_shmem_session_t *session;
     /** List containing job information. */
@@ -146,8 +148,8 @@ typedef struct {
 typedef struct {
     /** Shared-memory allocator for data this structure. */
     pmix_tma_t tma;
-    /** Holds the current address of the shared-memory allocator. */
-    void *current_addr;
+    /** Heap backing the shared-memory allocator. */
+    pmix_gds_shmem_heap_t heap;
     /** Stores static modex data. */
     pmix_hash_table_t *hashtab;
 } pmix_gds_shmem_shared_modex_data_t;
@@ -166,6 +168,13 @@ typedef struct {
     pmix_gds_shmem_status_t modex_shmem_status;
     /** Shared-memory object that maintains information for smmodex data. */
     pmix_shmem_t *modex_shmem;
+    /**
+     * Additional shared-memory segments (pmix_shmem_t *) chained to
+     * modex_shmem as its heap grows. Extent i + 1 is stored at index i.
+     */
+    pmix_pointer_array_t *modex_extents;
+    /** Modex segment size hint provided by the host, if any. */
+    size_t modex_size_hint;
     /** Points to shared job data located in a shared-memory segment. */
     pmix_gds_shmem_shared_job_data_t *smdata;
     /** Points to shared modex data located in a shared-memory segment. */
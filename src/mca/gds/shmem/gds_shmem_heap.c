@@ -0,0 +1,467 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * Copyright (c) 2022      Triad National Security, LLC. All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "gds_shmem_heap.h"
+
+#include <string.h>
+
+//
+// Notes for developers:
+// Each block is preceded by a header recording the block's usable size and
+// the number of bytes the caller asked for (zero when the block is free).
+// Free blocks store the offset of the next free block in their first word.
+// Blocks are never split or coalesced: a freed block returns to the free list
+// of its size class, unless it sits at the top of the heap, in which case the
+// high-water mark is simply lowered. When an optional growth callback is set,
+// the heap asks it for a new extent once the current one is exhausted.
+//
+
+/**
+ * Block header.
+ */
+typedef struct {
+    /** Usable size of the block in bytes. */
+    size_t size;
+    /** Bytes requested by the caller, or 0 if the block is free. */
+    size_t used;
+} heap_block_t;
+
+/**
+ * All blocks and payloads are aligned to this many bytes.
+ */
+#define HEAP_ALIGN ((size_t)16)
+
+/**
+ * Largest size class, in bytes.
+ */
+#define HEAP_MAX_CLASS_SIZE ((size_t)256 << 15)
+
+static inline size_t
+round_up(
+    size_t size
+) {
+    return (size + HEAP_ALIGN - 1) & ~(HEAP_ALIGN - 1);
+}
+
+/**
+ * Returns the usable size of the given size class.
+ */
+static inline size_t
+class_size(
+    int k
+) {
+    if (k < 8) {
+        return (size_t)(k + 1) * 16;
+    }
+    const int g = (k - 8) / 4;
+    const int sub = (k - 8) % 4;
+    return ((size_t)32 << g) * (size_t)(5 + sub);
+}
+
+/**
+ * Returns the size class serving the given request, or -1 if the request is
+ * larger than the largest size class.
+ */
+static inline int
+class_index(
+    size_t size
+) {
+    if (size <= 128) {
+        return (size == 0) ? 0 : (int)((size + 15) / 16) - 1;
+    }
+    if (size > HEAP_MAX_CLASS_SIZE) {
+        return -1;
+    }
+    int g = 0;
+    while (size > ((size_t)256 << g)) {
+        ++g;
+    }
+    const size_t step = (size_t)32 << g;
+    const size_t sub = (size - ((size_t)128 << g) + step - 1) / step - 1;
+    return 8 + 4 * g + (int)sub;
+}
+
+static inline heap_block_t *
+block_at(
+    pmix_gds_shmem_heap_t *heap,
+    size_t offset
+) {
+    return (heap_block_t *)((uintptr_t)heap + offset);
+}
+
+static inline size_t
+block_offset(
+    pmix_gds_shmem_heap_t *heap,
+    heap_block_t *block
+) {
+    return (size_t)((uintptr_t)block - (uintptr_t)heap);
+}
+
+static inline heap_block_t *
+block_of(
+    void *ptr
+) {
+    return (heap_block_t *)ptr - 1;
+}
+
+static inline void *
+block_payload(
+    heap_block_t *block
+) {
+    return (void *)(block + 1);
+}
+
+static inline size_t *
+block_next(
+    heap_block_t *block
+) {
+    return (size_t *)block_payload(block);
+}
+
+static inline size_t
+block_span(
+    heap_block_t *block
+) {
+    return sizeof(*block) + block->size;
+}
+
+static inline void
+update_peak(
+    pmix_gds_shmem_heap_t *heap
+) {
+    const size_t extent = pmix_gds_shmem_heap_extent(heap);
+    if (extent > heap->stats.bytes_peak) {
+        heap->stats.bytes_peak = extent;
+    }
+}
+
+/**
+ * Pops a block from the given free list.
+ */
+static inline heap_block_t *
+pop_free(
+    pmix_gds_shmem_heap_t *heap,
+    size_t *list
+) {
+    if (0 == *list) {
+        return NULL;
+    }
+    heap_block_t *const block = block_at(heap, *list);
+    *list = *block_next(block);
+    heap->stats.bytes_free -= block_span(block);
+    return block;
+}
+
+/**
+ * First-fit search of the large free list.
+ */
+static heap_block_t *
+pop_free_large(
+    pmix_gds_shmem_heap_t *heap,
+    size_t size
+) {
+    size_t *prev = &heap->free_large;
+    while (0 != *prev) {
+        heap_block_t *const block = block_at(heap, *prev);
+        if (block->size >= size) {
+            *prev = *block_next(block);
+            heap->stats.bytes_free -= block_span(block);
+            return block;
+        }
+        prev = block_next(block);
+    }
+    return NULL;
+}
+
+/**
+ * Carves a new block of the given usable size from the top of the heap.
+ */
+static heap_block_t *
+carve(
+    pmix_gds_shmem_heap_t *heap,
+    size_t size
+) {
+    const size_t span = sizeof(heap_block_t) + size;
+    if (pmix_gds_shmem_heap_avail(heap) < span) {
+        return NULL;
+    }
+    heap_block_t *const block = (heap_block_t *)heap->top;
+    block->size = size;
+    heap->top = (void *)((uintptr_t)heap->top + span);
+    update_peak(heap);
+    return block;
+}
+
+static void *
+heap_malloc(
+    pmix_gds_shmem_heap_t *heap,
+    size_t size
+) {
+    heap_block_t *block = NULL;
+    const int k = class_index(size);
+    const size_t bsize = (k < 0) ? round_up(size) : class_size(k);
+
+    if (k < 0) {
+        block = pop_free_large(heap, bsize);
+    }
+    else {
+        block = pop_free(heap, &heap->free_lists[k]);
+    }
+    if (NULL == block) {
+        block = carve(heap, bsize);
+    }
+    // Out of fresh space, so settle for a larger free block.
+    for (int i = k + 1; NULL == block && k >= 0 &&
+         i < PMIX_GDS_SHMEM_HEAP_NCLASSES; ++i) {
+        block = pop_free(heap, &heap->free_lists[i]);
+    }
+    if (NULL == block && k >= 0) {
+        block = pop_free_large(heap, bsize);
+    }
+    // Last resort: ask for another extent.
+    if (NULL == block && NULL != heap->grow) {
+        const size_t min_size = sizeof(heap_block_t) + bsize + HEAP_ALIGN;
+        if (PMIX_SUCCESS == heap->grow(heap, min_size, heap->grow_ctx)) {
+            block = carve(heap, bsize);
+        }
+    }
+    if (NULL == block) {
+        heap->stats.nfailed++;
+        return NULL;
+    }
+    // Zero-sized requests still occupy a block, so count them as one byte.
+    block->used = (0 == size) ? 1 : size;
+    heap->stats.nallocs++;
+    heap->stats.bytes_requested += block->used;
+    heap->stats.bytes_allocated += block_span(block);
+    return block_payload(block);
+}
+
+static void
+heap_free(
+    pmix_gds_shmem_heap_t *heap,
+    void *ptr
+) {
+    if (NULL == ptr) {
+        return;
+    }
+    heap_block_t *const block = block_of(ptr);
+
+    heap->stats.nfrees++;
+    heap->stats.bytes_requested -= block->used;
+    heap->stats.bytes_allocated -= block_span(block);
+    block->used = 0;
+    // If this is the last block, just give the space back.
+    if ((uintptr_t)block + block_span(block) == (uintptr_t)heap->top) {
+        heap->top = (void *)block;
+        return;
+    }
+    const int k = class_index(block->size);
+    size_t *list = (k < 0) ? &heap->free_large : &heap->free_lists[k];
+    // A block's size is always exactly that of its class, unless it lives on
+    // the large list. Blocks handed out from a larger class keep their size,
+    // so they go back to where they came from.
+    if (k >= 0 && class_size(k) != block->size) {
+        list = &heap->free_large;
+    }
+    *block_next(block) = *list;
+    *list = block_offset(heap, block);
+    heap->stats.bytes_free += block_span(block);
+}
+
+static void *
+heap_realloc(
+    pmix_gds_shmem_heap_t *heap,
+    void *ptr,
+    size_t size
+) {
+    if (NULL == ptr) {
+        return heap_malloc(heap, size);
+    }
+    if (0 == size) {
+        heap_free(heap, ptr);
+        return NULL;
+    }
+    heap_block_t *const block = block_of(ptr);
+
+    heap->stats.nreallocs++;
+    // Fits in the current block.
+    if (size <= block->size) {
+        heap->stats.bytes_requested += size;
+        heap->stats.bytes_requested -= block->used;
+        block->used = size;
+        heap->stats.nreallocs_inplace++;
+        return ptr;
+    }
+    // The last block can grow into the remaining space.
+    if ((uintptr_t)block + block_span(block) == (uintptr_t)heap->top) {
+        const int k = class_index(size);
+        const size_t bsize = (k < 0) ? round_up(size) : class_size(k);
+        const size_t grow = bsize - block->size;
+        if (pmix_gds_shmem_heap_avail(heap) >= grow) {
+            heap->top = (void *)((uintptr_t)heap->top + grow);
+            update_peak(heap);
+            heap->stats.bytes_allocated += grow;
+            heap->stats.bytes_requested += size;
+            heap->stats.bytes_requested -= block->used;
+            block->size = bsize;
+            block->used = size;
+            heap->stats.nreallocs_inplace++;
+            return ptr;
+        }
+    }
+    // Otherwise move it.
+    void *const nptr = heap_malloc(heap, size);
+    if (NULL == nptr) {
+        return NULL;
+    }
+    memcpy(nptr, ptr, block->used);
+    heap_free(heap, ptr);
+    return nptr;
+}
+
+static void *
+tma_malloc(
+    pmix_tma_t *tma,
+    size_t size
+) {
+    void *const ptr = heap_malloc(pmix_gds_shmem_heap_from_tma(tma), size);
+#if PMIX_ENABLE_DEBUG
+    if (NULL != ptr) {
+        memset(ptr, 0, size);
+    }
+#endif
+    return ptr;
+}
+
+static void *
+tma_calloc(
+    pmix_tma_t *tma,
+    size_t nmemb,
+    size_t size
+) {
+    const size_t real_size = nmemb * size;
+    void *const ptr = heap_malloc(pmix_gds_shmem_heap_from_tma(tma), real_size);
+    if (NULL != ptr) {
+        memset(ptr, 0, real_size);
+    }
+    return ptr;
+}
+
+static void *
+tma_realloc(
+    pmix_tma_t *tma,
+    void *ptr,
+    size_t size
+) {
+    return heap_realloc(pmix_gds_shmem_heap_from_tma(tma), ptr, size);
+}
+
+static char *
+tma_strdup(
+    pmix_tma_t *tma,
+    const char *s
+) {
+    const size_t size = strlen(s) + 1;
+    char *const ptr = heap_malloc(pmix_gds_shmem_heap_from_tma(tma), size);
+    if (NULL != ptr) {
+        memcpy(ptr, s, size);
+    }
+    return ptr;
+}
+
+static void *
+tma_memmove(
+    pmix_tma_t *tma,
+    const void *src,
+    size_t size
+) {
+    void *const ptr = heap_malloc(pmix_gds_shmem_heap_from_tma(tma), size);
+    if (NULL != ptr) {
+        memmove(ptr, src, size);
+    }
+    return ptr;
+}
+
+static void
+tma_free(
+    pmix_tma_t *tma,
+    void *ptr
+) {
+    heap_free(pmix_gds_shmem_heap_from_tma(tma), ptr);
+}
+
+void
+pmix_gds_shmem_heap_tma_init(
+    pmix_tma_t *tma
+) {
+    tma->tma_malloc = tma_malloc;
+    tma->tma_calloc = tma_calloc;
+    tma->tma_realloc = tma_realloc;
+    tma->tma_strdup = tma_strdup;
+    tma->tma_memmove = tma_memmove;
+    tma->tma_free = tma_free;
+}
+
+void
+pmix_gds_shmem_heap_init(
+    pmix_gds_shmem_heap_t *heap,
+    pmix_tma_t *tma,
+    void *start,
+    size_t size
+) {
+    memset(heap, 0, sizeof(*heap));
+    // Make sure the first block is properly aligned.
+    const uintptr_t astart = ((uintptr_t)start + HEAP_ALIGN - 1)
+                           & ~(uintptr_t)(HEAP_ALIGN - 1);
+    const uintptr_t end = (uintptr_t)start + size;
+    heap->start = (void *)astart;
+    heap->top = heap->start;
+    heap->end = (void *)((astart > end) ? astart : end);
+
+    heap->nextents = 1;
+
+    pmix_gds_shmem_heap_tma_init(tma);
+    tma->data_ptr = &heap->top;
+}
+
+void
+pmix_gds_shmem_heap_add_extent(
+    pmix_gds_shmem_heap_t *heap,
+    void *start,
+    size_t size
+) {
+    // Retire the current extent, keeping whatever is left of it around as a
+    // free block if it is big enough to be useful.
+    const size_t consumed = pmix_gds_shmem_heap_extent(heap) - heap->bytes_retired;
+    const size_t tail = pmix_gds_shmem_heap_avail(heap) & ~(HEAP_ALIGN - 1);
+    heap->bytes_retired += consumed;
+    if (tail >= sizeof(heap_block_t) + HEAP_ALIGN) {
+        heap_block_t *const block = (heap_block_t *)heap->top;
+        block->size = tail - sizeof(heap_block_t);
+        block->used = 0;
+        *block_next(block) = heap->free_large;
+        heap->free_large = block_offset(heap, block);
+        heap->stats.bytes_free += tail;
+        heap->bytes_retired += tail;
+    }
+
+    const uintptr_t astart = ((uintptr_t)start + HEAP_ALIGN - 1)
+                           & ~(uintptr_t)(HEAP_ALIGN - 1);
+    const uintptr_t end = (uintptr_t)start + size;
+    heap->start = (void *)astart;
+    heap->top = heap->start;
+    heap->end = (void *)((astart > end) ? astart : end);
+    heap->nextents++;
+}
+
+/*
+ * vim: ft=cpp ts=4 sts=4 sw=4 expandtab
+ */
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * Copyright (c) 2022      Triad National Security, LLC. All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#ifndef PMIX_GDS_SHMEM_HEAP_H
+#define PMIX_GDS_SHMEM_HEAP_H
+
+#include "pmix_config.h"
+
+#include "include/pmix_common.h"
+#include "src/class/pmix_object.h"
+
+#ifdef HAVE_STDINT_H
+#include <stdint.h>
+#endif
+
+BEGIN_C_DECLS
+
+/**
+ * Number of size classes maintained by the heap. Sizes up to 128 B are
+ * served in 16 B steps, after which each power of two is split into four
+ * classes. The largest class is 8 MiB; anything larger is kept on a
+ * separate first-fit list.
+ */
+#define PMIX_GDS_SHMEM_HEAP_NCLASSES (8 + 4 * 16)
+
+/**
+ * Heap usage statistics.
+ */
+typedef struct {
+    /** Number of successful allocations. */
+    size_t nallocs;
+    /** Number of frees. */
+    size_t nfrees;
+    /** Number of reallocations. */
+    size_t nreallocs;
+    /** Number of reallocations satisfied without moving the data. */
+    size_t nreallocs_inplace;
+    /** Number of allocations that could not be satisfied. */
+    size_t nfailed;
+    /** Live bytes requested by callers. */
+    size_t bytes_requested;
+    /** Live bytes held in allocated blocks, including block headers. */
+    size_t bytes_allocated;
+    /** Bytes held in blocks on the free lists, including block headers. */
+    size_t bytes_free;
+    /** Largest value of the heap's high-water mark, in bytes. */
+    size_t bytes_peak;
+} pmix_gds_shmem_heap_stats_t;
+
+struct pmix_gds_shmem_heap;
+
+/**
+ * Called when the heap cannot satisfy a request of min_size bytes from its
+ * current extent. Implementations are expected to provide more memory through
+ * pmix_gds_shmem_heap_add_extent() and return PMIX_SUCCESS if they did so.
+ */
+typedef pmix_status_t (*pmix_gds_shmem_heap_grow_fn_t)(
+    struct pmix_gds_shmem_heap *heap,
+    size_t min_size,
+    void *ctx
+);
+
+/**
+ * A heap living inside of a shared-memory segment. Blocks are linked
+ * through offsets relative to the heap itself so that free lists remain
+ * valid regardless of where a process maps the segment. A heap may span
+ * several extents (e.g., chained segments); blocks are carved from the most
+ * recently added one.
+ */
+typedef struct pmix_gds_shmem_heap {
+    /**
+     * Address of the first byte never handed out. This must remain the
+     * first member: the TMA's data_ptr points here.
+     */
+    void *top;
+    /** Address of the first byte of the current extent. */
+    void *start;
+    /** Address one past the last byte of the current extent. */
+    void *end;
+    /** Number of extents managed by the heap. */
+    size_t nextents;
+    /** Bytes consumed from extents that are no longer current. */
+    size_t bytes_retired;
+    /** Offsets of the first free block in each size class (0 if none). */
+    size_t free_lists[PMIX_GDS_SHMEM_HEAP_NCLASSES];
+    /** Offset of the first free block larger than the largest class. */
+    size_t free_large;
+    /** Usage statistics. */
+    pmix_gds_shmem_heap_stats_t stats;
+    /**
+     * Optional growth callback and its context. Note that these are only
+     * meaningful in the process that writes to the heap.
+     */
+    pmix_gds_shmem_heap_grow_fn_t grow;
+    void *grow_ctx;
+} pmix_gds_shmem_heap_t;
+
+/**
+ * Initializes a heap managing [start, start + size) and points the
+ * provided TMA at it.
+ */
+PMIX_EXPORT void
+pmix_gds_shmem_heap_init(
+    pmix_gds_shmem_heap_t *heap,
+    pmix_tma_t *tma,
+    void *start,
+    size_t size
+);
+
+/**
+ * Makes [start, start + size) the heap's current extent. Whatever space
+ * remained in the previous extent is placed on a free list.
+ */
+PMIX_EXPORT void
+pmix_gds_shmem_heap_add_extent(
+    pmix_gds_shmem_heap_t *heap,
+    void *start,
+    size_t size
+);
+
+/**
+ * Points the TMA's function pointers at the heap's implementation.
+ */
+PMIX_EXPORT void
+pmix_gds_shmem_heap_tma_init(
+    pmix_tma_t *tma
+);
+
+/**
+ * Returns the heap associated with the given TMA.
+ */
+static inline pmix_gds_shmem_heap_t *
+pmix_gds_shmem_heap_from_tma(
+    pmix_tma_t *tma
+) {
+    return (pmix_gds_shmem_heap_t *)tma->data_ptr;
+}
+
+/**
+ * Returns the number of bytes consumed across all of the heap's extents, up to
+ * the current high-water mark.
+ */
+static inline size_t
+pmix_gds_shmem_heap_extent(
+    pmix_gds_shmem_heap_t *heap
+) {
+    return heap->bytes_retired
+         + (size_t)((uintptr_t)heap->top - (uintptr_t)heap->start);
+}
+
+/**
+ * Returns the number of bytes that remain available past the heap's
+ * high-water mark in its current extent.
+ */
+static inline size_t
+pmix_gds_shmem_heap_avail(
+    pmix_gds_shmem_heap_t *heap
+) {
+    return (size_t)((uintptr_t)heap->end - (uintptr_t)heap->top);
+}
+
+END_C_DECLS
+
+#endif
+
+/*
+ * vim: ft=cpp ts=4 sts=4 sw=4 expandtab
+ */
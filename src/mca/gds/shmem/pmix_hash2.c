@@ -45,6 +45,7 @@
 #include "src/mca/bfrops/bfrops.h"
 #include "src/mca/bfrops/base/bfrop_base_tma.h"
 #include "src/util/pmix_error.h"
+#include "src/util/pmix_hash.h"
 #include "src/util/pmix_output.h"
 
 #ifdef HAVE_STRING_H
@@ -59,6 +60,8 @@ do {                                                                   \
         (d)->index = k;                                                \
         (d)->qualindex = UINT32_MAX;                                   \
         (d)->value = NULL;                                             \
+        (d)->storage = NULL;                                           \
+        (d)->next = NULL;                                              \
     }                                                                  \
 } while(0)
 
@@ -694,36 +697,10 @@ static pmix_proc_data2_t *lookup_proc(pmix_hash_table_t *jtable, uint32_t id, bo
 void pmix_hash2_register_key(uint32_t inid,
                             pmix_regattr_input_t *ptr)
 {
-    pmix_regattr_input_t *p = NULL;
-
-    if (UINT32_MAX == inid) {
-        /* store the pointer in the array */
-#if 0 // TODO(skg) Remove
-        pmix_pointer_array_set_item(&pmix_globals.keyindex, pmix_globals.next_keyid, ptr);
-#else
-        pmix_pointer_array_set_item((pmix_pointer_array_t *)&pmix_globals.keyindex, pmix_globals.next_keyid, ptr);
-#endif
-        ptr->index = pmix_globals.next_keyid;
-        pmix_globals.next_keyid += 1;
-        return;
-    }
-
-    /* check to see if this key was already registered */
-#if 0 // TODO(skg) Remove
-    p = pmix_pointer_array_get_item(&pmix_globals.keyindex, inid);
-#else
-    p = pmix_pointer_array_get_item((pmix_pointer_array_t *)&pmix_globals.keyindex, inid);
-#endif
-    if (NULL != p) {
-        /* already have this one */
-        return;
-    }
-    /* store the pointer in the table */
-#if 0 // TODO(skg) Remove
-    pmix_pointer_array_set_item(&pmix_globals.keyindex, inid, ptr);
-#else
-    pmix_pointer_array_set_item((pmix_pointer_array_t *)&pmix_globals.keyindex, inid, ptr);
-#endif
+    /* the key registry is global, so share it with the hash
+     * code - this keeps the keymap used for hashed lookup of
+     * unreserved keys in sync */
+    pmix_hash_register_key(inid, ptr);
 }
 
 // TODO(skg) We may have to modify the signature of this function. How will we
@@ -731,67 +708,7 @@ void pmix_hash2_register_key(uint32_t inid,
 pmix_regattr_input_t* pmix_hash2_lookup_key(uint32_t inid,
                                            const char *key)
 {
-    int id;
-    pmix_regattr_input_t *ptr = NULL;
-
-    if (UINT32_MAX == inid) {
-        if (NULL == key) {
-            /* they have to give us something! */
-            return NULL;
-        }
-        if (PMIX_CHECK_RESERVED_KEY(key)) {
-            /* reserved keys are in the front of the table */
-            for (id = 0; id < PMIX_INDEX_BOUNDARY; id++) {
-#if 0 // TODO(skg) Remove
-                ptr = pmix_pointer_array_get_item(&pmix_globals.keyindex, id);
-#else
-                ptr = pmix_pointer_array_get_item((pmix_pointer_array_t *)&pmix_globals.keyindex, id);
-#endif
-                if (NULL != ptr) {
-                    if (0 == strcmp(key, ptr->string)) {
-                        return ptr;
-                    }
-                }
-            }
-            /* reserved keys must already have been registered */
-            return NULL;
-        }
-        /* unreserved keys are at the back of the table */
-        for (id = PMIX_INDEX_BOUNDARY; id < pmix_globals.keyindex.size; id++) {
-#if 0 // TODO(skg) Remove
-            ptr = pmix_pointer_array_get_item(&pmix_globals.keyindex, id);
-#else
-            ptr = pmix_pointer_array_get_item((pmix_pointer_array_t *)&pmix_globals.keyindex, id);
-#endif
-            if (NULL != ptr) {
-                if (0 == strcmp(key, ptr->string)) {
-                    return ptr;
-                }
-            }
-        }
-        /* we didn't find it - register it */
-        ptr = (pmix_regattr_input_t*)pmix_malloc(sizeof(pmix_regattr_input_t));
-        ptr->name = strdup(key);
-        ptr->string = strdup(key);
-        ptr->type = PMIX_UNDEF; // we don't know what type the user will set
-        ptr->description = (char**)pmix_malloc(2 * sizeof(char*));
-        ptr->description[0] = strdup("USER DEFINED");
-        ptr->description[1] = NULL;
-        pmix_hash2_register_key(UINT32_MAX, ptr);
-        return ptr;
-    }
-
-    /* get the pointer from the table - if it is a reserved key, then
-     * it had to be registered at the beginning of time. If it is a
-     * non-reserved key, then it had to be registered or else the caller
-     * would not have an index to pass us. Thus, the pointer is either
-     * found or not - we don't register it if not found. */
-#if 0 // TODO(skg) Remove
-    ptr = pmix_pointer_array_get_item(&pmix_globals.keyindex, inid);
-#else
-    ptr = pmix_pointer_array_get_item((pmix_pointer_array_t *)&pmix_globals.keyindex, inid);
-#endif
-    return ptr;
+    return pmix_hash_lookup_key(inid, key);
 }
 
 static void erase_qualifiers(pmix_proc_data2_t *proc,
@@ -175,7 +175,7 @@ void pmix_pfexec_base_spawn_proc(int sd, short args, void *cbdata)
      * be communicated to the spawned job */
     rc = register_nspace(nspace, fcd);
     if (PMIX_SUCCESS != rc) {
-        pmix_list_remove_item(&pmix_globals.nspaces, &nptr->super);
+        pmix_server_nspace_remove(nptr);
         PMIX_RELEASE(nptr);
         goto complete;
     }
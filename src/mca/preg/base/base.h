@@ -80,6 +80,8 @@ PMIX_EXPORT pmix_status_t pmix_preg_base_generate_node_regex(const char *input,
 PMIX_EXPORT pmix_status_t pmix_preg_base_generate_ppn(const char *input, char **ppn);
 PMIX_EXPORT pmix_status_t pmix_preg_base_parse_nodes(const char *regexp, char ***names);
 PMIX_EXPORT pmix_status_t pmix_preg_base_parse_procs(const char *regexp, char ***procs);
+PMIX_EXPORT pmix_status_t pmix_preg_base_compile_map(const char *nodes, const char *procs,
+                                                    pmix_preg_map_t **map);
 PMIX_EXPORT pmix_status_t pmix_preg_base_copy(char **dest, size_t *len, const char *input);
 
 PMIX_EXPORT pmix_status_t pmix_preg_base_pack(pmix_buffer_t *buffer, const char *input);
@@ -88,6 +90,24 @@ PMIX_EXPORT pmix_status_t pmix_preg_base_unpack(pmix_buffer_t *buffer, char **re
 
 PMIX_EXPORT pmix_status_t pmix_preg_base_release(char *regexp);
 
+/* queries against a compiled map */
+PMIX_EXPORT pmix_status_t pmix_preg_base_map_add_node_range(pmix_preg_map_t *map,
+                                                            const char *prefix, int num_digits,
+                                                            const char *suffix,
+                                                            unsigned long start, uint32_t count);
+PMIX_EXPORT pmix_status_t pmix_preg_base_map_add_proc_range(pmix_preg_map_t *map, uint32_t nodeid,
+                                                            pmix_rank_t start, uint32_t count);
+PMIX_EXPORT pmix_status_t pmix_preg_base_map_complete(pmix_preg_map_t *map);
+PMIX_EXPORT pmix_status_t pmix_preg_base_map_hostname(const pmix_preg_map_t *map, uint32_t nodeid,
+                                                      char **hostname);
+PMIX_EXPORT pmix_status_t pmix_preg_base_map_locate(const pmix_preg_map_t *map, pmix_rank_t rank,
+                                                    uint32_t *nodeid, uint16_t *local_rank);
+PMIX_EXPORT pmix_status_t pmix_preg_base_map_local_procs(const pmix_preg_map_t *map,
+                                                         uint32_t nodeid, uint32_t *nlocal,
+                                                         pmix_rank_t *leader);
+PMIX_EXPORT pmix_status_t pmix_preg_base_map_local_peers(const pmix_preg_map_t *map,
+                                                         uint32_t nodeid, char **peers);
+
 END_C_DECLS
 
 #endif
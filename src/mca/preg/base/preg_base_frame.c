@@ -57,6 +57,7 @@ pmix_preg_module_t pmix_preg = {
     .generate_ppn = pmix_preg_base_generate_ppn,
     .parse_nodes = pmix_preg_base_parse_nodes,
     .parse_procs = pmix_preg_base_parse_procs,
+    .compile_map = pmix_preg_base_compile_map,
     .copy = pmix_preg_base_copy,
     .pack = pmix_preg_base_pack,
     .unpack = pmix_preg_base_unpack,
@@ -118,3 +119,43 @@ static void rvdes(pmix_regex_value_t *p)
     PMIX_LIST_DESTRUCT(&p->ranges);
 }
 PMIX_CLASS_INSTANCE(pmix_regex_value_t, pmix_list_item_t, rvcon, rvdes);
+
+static void mapcon(pmix_preg_map_t *p)
+{
+    p->nnodes = 0;
+    p->nprocs = 0;
+    p->nodes = NULL;
+    p->nnode_ranges = 0;
+    p->nodes_size = 0;
+    p->procs = NULL;
+    p->nproc_ranges = 0;
+    p->procs_size = 0;
+    p->node_first = NULL;
+    p->byrank = NULL;
+}
+static void mapdes(pmix_preg_map_t *p)
+{
+    size_t n;
+
+    for (n = 0; n < p->nnode_ranges; n++) {
+        if (NULL != p->nodes[n].prefix) {
+            free(p->nodes[n].prefix);
+        }
+        if (NULL != p->nodes[n].suffix) {
+            free(p->nodes[n].suffix);
+        }
+    }
+    if (NULL != p->nodes) {
+        free(p->nodes);
+    }
+    if (NULL != p->procs) {
+        free(p->procs);
+    }
+    if (NULL != p->node_first) {
+        free(p->node_first);
+    }
+    if (NULL != p->byrank) {
+        free(p->byrank);
+    }
+}
+PMIX_CLASS_INSTANCE(pmix_preg_map_t, pmix_object_t, mapcon, mapdes);
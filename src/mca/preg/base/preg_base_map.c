@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "src/include/pmix_config.h"
+#include "pmix_common.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "src/mca/preg/base/base.h"
+#include "src/util/pmix_error.h"
+
+/* make room for one more entry in a range table, doubling
+ * its size so that a regex with many ranges is compiled
+ * without reallocating for every one of them */
+static pmix_status_t grow_table(void **table, size_t *size, size_t used, size_t width)
+{
+    void *ptr;
+    size_t nsize;
+
+    if (used < *size) {
+        return PMIX_SUCCESS;
+    }
+    nsize = (0 == *size) ? 8 : 2 * *size;
+    ptr = realloc(*table, nsize * width);
+    if (NULL == ptr) {
+        return PMIX_ERR_NOMEM;
+    }
+    *table = ptr;
+    *size = nsize;
+    return PMIX_SUCCESS;
+}
+
+/* components build a map by adding the node ranges in nodeid
+ * order, followed by the proc ranges of each node in nodeid
+ * order, and then calling complete */
+pmix_status_t pmix_preg_base_map_add_node_range(pmix_preg_map_t *map,
+                                                const char *prefix, int num_digits,
+                                                const char *suffix,
+                                                unsigned long start, uint32_t count)
+{
+    pmix_preg_node_range_t *nr;
+    pmix_status_t rc;
+
+    if (0 == count) {
+        return PMIX_SUCCESS;
+    }
+    rc = grow_table((void **) &map->nodes, &map->nodes_size, map->nnode_ranges,
+                    sizeof(pmix_preg_node_range_t));
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    nr = &map->nodes[map->nnode_ranges];
+    nr->nodeid = map->nnodes;
+    nr->count = count;
+    nr->start = start;
+    nr->num_digits = num_digits;
+    nr->prefix = strdup(prefix);
+    nr->suffix = (NULL == suffix) ? NULL : strdup(suffix);
+    map->nnode_ranges++;
+    map->nnodes += count;
+    return PMIX_SUCCESS;
+}
+
+pmix_status_t pmix_preg_base_map_add_proc_range(pmix_preg_map_t *map, uint32_t nodeid,
+                                                pmix_rank_t start, uint32_t count)
+{
+    pmix_preg_proc_range_t *pr, *last = NULL;
+    pmix_status_t rc;
+
+    if (0 == count) {
+        return PMIX_SUCCESS;
+    }
+    if (0 < map->nproc_ranges) {
+        last = &map->procs[map->nproc_ranges - 1];
+        /* must be given in node order */
+        if (nodeid < last->nodeid) {
+            return PMIX_ERR_BAD_PARAM;
+        }
+    }
+    rc = grow_table((void **) &map->procs, &map->procs_size, map->nproc_ranges,
+                    sizeof(pmix_preg_proc_range_t));
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    if (NULL != last) {
+        last = &map->procs[map->nproc_ranges - 1];
+    }
+    pr = &map->procs[map->nproc_ranges];
+    pr->start = start;
+    pr->count = count;
+    pr->nodeid = nodeid;
+    /* local ranks are assigned in the order the procs
+     * are listed on the node */
+    if (NULL != last && last->nodeid == nodeid) {
+        pr->local_rank = last->local_rank + last->count;
+    } else {
+        pr->local_rank = 0;
+    }
+    map->nproc_ranges++;
+    map->nprocs += count;
+    return PMIX_SUCCESS;
+}
+
+static int rank_order(const void *a, const void *b)
+{
+    const pmix_preg_proc_range_t *ra = (const pmix_preg_proc_range_t *) a;
+    const pmix_preg_proc_range_t *rb = (const pmix_preg_proc_range_t *) b;
+
+    if (ra->start < rb->start) {
+        return -1;
+    }
+    if (ra->start > rb->start) {
+        return 1;
+    }
+    return 0;
+}
+
+pmix_status_t pmix_preg_base_map_complete(pmix_preg_map_t *map)
+{
+    size_t n, m;
+
+    map->node_first = (size_t *) malloc((map->nnodes + 1) * sizeof(size_t));
+    if (NULL == map->node_first) {
+        return PMIX_ERR_NOMEM;
+    }
+    m = 0;
+    for (n = 0; n <= map->nnodes; n++) {
+        map->node_first[n] = m;
+        while (m < map->nproc_ranges && map->procs[m].nodeid == n) {
+            m++;
+        }
+    }
+    if (m != map->nproc_ranges) {
+        /* procs were assigned to a node beyond the node map */
+        return PMIX_ERR_BAD_PARAM;
+    }
+
+    if (0 == map->nproc_ranges) {
+        return PMIX_SUCCESS;
+    }
+    map->byrank = (pmix_preg_proc_range_t *) malloc(map->nproc_ranges
+                                                    * sizeof(pmix_preg_proc_range_t));
+    if (NULL == map->byrank) {
+        return PMIX_ERR_NOMEM;
+    }
+    memcpy(map->byrank, map->procs, map->nproc_ranges * sizeof(pmix_preg_proc_range_t));
+    qsort(map->byrank, map->nproc_ranges, sizeof(pmix_preg_proc_range_t), rank_order);
+    /* a rank can only be on one node */
+    for (n = 1; n < map->nproc_ranges; n++) {
+        if (map->byrank[n - 1].start + map->byrank[n - 1].count > map->byrank[n].start) {
+            return PMIX_ERR_BAD_PARAM;
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+pmix_status_t pmix_preg_base_map_hostname(const pmix_preg_map_t *map, uint32_t nodeid,
+                                          char **hostname)
+{
+    size_t lo, hi, mid;
+    const pmix_preg_node_range_t *nr;
+
+    *hostname = NULL;
+    if (nodeid >= map->nnodes) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    /* find the last range starting at or below the nodeid */
+    lo = 0;
+    hi = map->nnode_ranges;
+    while (1 < hi - lo) {
+        mid = lo + (hi - lo) / 2;
+        if (map->nodes[mid].nodeid <= nodeid) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    nr = &map->nodes[lo];
+    if (0 > nr->num_digits) {
+        *hostname = strdup(nr->prefix);
+    } else if (0 > asprintf(hostname, "%s%0*lu%s", nr->prefix, nr->num_digits,
+                            nr->start + (nodeid - nr->nodeid),
+                            (NULL == nr->suffix) ? "" : nr->suffix)) {
+        *hostname = NULL;
+    }
+    if (NULL == *hostname) {
+        return PMIX_ERR_NOMEM;
+    }
+    return PMIX_SUCCESS;
+}
+
+pmix_status_t pmix_preg_base_map_locate(const pmix_preg_map_t *map, pmix_rank_t rank,
+                                        uint32_t *nodeid, uint16_t *local_rank)
+{
+    size_t lo, hi, mid;
+    const pmix_preg_proc_range_t *pr;
+
+    if (0 == map->nproc_ranges || rank < map->byrank[0].start) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    /* find the last range starting at or below the rank */
+    lo = 0;
+    hi = map->nproc_ranges;
+    while (1 < hi - lo) {
+        mid = lo + (hi - lo) / 2;
+        if (map->byrank[mid].start <= rank) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    pr = &map->byrank[lo];
+    if (rank - pr->start >= pr->count) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    if (NULL != nodeid) {
+        *nodeid = pr->nodeid;
+    }
+    if (NULL != local_rank) {
+        *local_rank = pr->local_rank + (rank - pr->start);
+    }
+    return PMIX_SUCCESS;
+}
+
+pmix_status_t pmix_preg_base_map_local_procs(const pmix_preg_map_t *map,
+                                             uint32_t nodeid, uint32_t *nlocal,
+                                             pmix_rank_t *leader)
+{
+    size_t n;
+
+    if (nodeid >= map->nnodes) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    *nlocal = 0;
+    for (n = map->node_first[nodeid]; n < map->node_first[nodeid + 1]; n++) {
+        *nlocal += map->procs[n].count;
+    }
+    if (NULL != leader) {
+        if (0 == *nlocal) {
+            *leader = PMIX_RANK_UNDEF;
+        } else {
+            *leader = map->procs[map->node_first[nodeid]].start;
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+pmix_status_t pmix_preg_base_map_local_peers(const pmix_preg_map_t *map,
+                                             uint32_t nodeid, char **peers)
+{
+    size_t n, len, used;
+    uint32_t nlocal, m;
+    char *str;
+    pmix_status_t rc;
+
+    *peers = NULL;
+    rc = pmix_preg_base_map_local_procs(map, nodeid, &nlocal, NULL);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    /* each rank takes at most 10 digits plus a separator */
+    len = (size_t) nlocal * 11 + 1;
+    str = (char *) malloc(len);
+    if (NULL == str) {
+        return PMIX_ERR_NOMEM;
+    }
+    str[0] = '\0';
+    used = 0;
+    for (n = map->node_first[nodeid]; n < map->node_first[nodeid + 1]; n++) {
+        for (m = 0; m < map->procs[n].count; m++) {
+            used += snprintf(str + used, len - used, "%s%u", (0 == used) ? "" : ",",
+                             map->procs[n].start + m);
+        }
+    }
+    *peers = str;
+    return PMIX_SUCCESS;
+}
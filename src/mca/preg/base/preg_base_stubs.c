@@ -100,6 +100,26 @@ pmix_status_t pmix_preg_base_parse_procs(const char *regexp, char ***procs)
     return PMIX_SUCCESS;
 }
 
+pmix_status_t pmix_preg_base_compile_map(const char *nodes, const char *procs,
+                                         pmix_preg_map_t **map)
+{
+    pmix_preg_base_active_module_t *active;
+
+    *map = NULL;
+
+    PMIX_LIST_FOREACH (active, &pmix_preg_globals.actives, pmix_preg_base_active_module_t) {
+        if (NULL != active->module->compile_map) {
+            if (PMIX_SUCCESS == active->module->compile_map(nodes, procs, map)) {
+                return PMIX_SUCCESS;
+            }
+        }
+    }
+
+    /* nobody could compile it - the caller will have to
+     * fall back to parsing the full lists */
+    return PMIX_ERR_NOT_SUPPORTED;
+}
+
 pmix_status_t pmix_preg_base_copy(char **dest, size_t *len, const char *input)
 {
     pmix_preg_base_active_module_t *active;
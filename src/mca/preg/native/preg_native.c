@@ -47,6 +47,7 @@ static pmix_status_t generate_node_regex(const char *input, char **regex);
 static pmix_status_t generate_ppn(const char *input, char **ppn);
 static pmix_status_t parse_nodes(const char *regexp, char ***names);
 static pmix_status_t parse_procs(const char *regexp, char ***procs);
+static pmix_status_t compile_map(const char *nodes, const char *procs, pmix_preg_map_t **map);
 static pmix_status_t copy(char **dest, size_t *len, const char *input);
 static pmix_status_t pack(pmix_buffer_t *buffer, const char *input);
 static pmix_status_t unpack(pmix_buffer_t *buffer, char **regex);
@@ -58,6 +59,7 @@ pmix_preg_module_t pmix_preg_native_module = {
     .generate_ppn = generate_ppn,
     .parse_nodes = parse_nodes,
     .parse_procs = parse_procs,
+    .compile_map = compile_map,
     .copy = copy,
     .pack = pack,
     .unpack = unpack,
@@ -65,11 +67,12 @@ pmix_preg_module_t pmix_preg_native_module = {
 };
 
 static pmix_status_t regex_parse_value_ranges(char *base, char *ranges, int num_digits,
-                                              char *suffix, char ***names);
+                                              char *suffix, char ***names, pmix_preg_map_t *map);
 static pmix_status_t regex_parse_value_range(char *base, char *range, int num_digits, char *suffix,
-                                             char ***names);
-static pmix_status_t pmix_regex_extract_nodes(char *regexp, char ***names);
+                                             char ***names, pmix_preg_map_t *map);
+static pmix_status_t pmix_regex_extract_nodes(char *regexp, char ***names, pmix_preg_map_t *map);
 static pmix_status_t pmix_regex_extract_ppn(char *regexp, char ***procs);
+static pmix_status_t pmix_regex_compile_ppn(char *regexp, pmix_preg_map_t *map);
 
 static pmix_status_t generate_node_regex(const char *input, char **regexp)
 {
@@ -469,7 +472,7 @@ static pmix_status_t parse_nodes(const char *regexp, char ***names)
 
     /* if it was done by PMIx, use that parser */
     if (0 == strcmp(tmp, "pmix")) {
-        if (PMIX_SUCCESS != (rc = pmix_regex_extract_nodes(ptr, names))) {
+        if (PMIX_SUCCESS != (rc = pmix_regex_extract_nodes(ptr, names, NULL))) {
             PMIX_ERROR_LOG(rc);
         }
     } else {
@@ -575,7 +578,7 @@ static pmix_status_t unpack(pmix_buffer_t *buffer, char **regex)
     return PMIX_SUCCESS;
 }
 
-static pmix_status_t pmix_regex_extract_nodes(char *regexp, char ***names)
+static pmix_status_t pmix_regex_extract_nodes(char *regexp, char ***names, pmix_preg_map_t *map)
 {
     int i, j, k, len;
     pmix_status_t ret;
@@ -586,7 +589,9 @@ static pmix_status_t pmix_regex_extract_nodes(char *regexp, char ***names)
     int num_digits;
 
     /* set the default */
-    *names = NULL;
+    if (NULL != names) {
+        *names = NULL;
+    }
 
     if (NULL == regexp) {
         return PMIX_SUCCESS;
@@ -679,7 +684,7 @@ static pmix_status_t pmix_regex_extract_nodes(char *regexp, char ***names)
                                  "regex:extract:nodes: parsing range %s %s %s", base, base + i,
                                  suffix);
 
-            ret = regex_parse_value_ranges(base, base + i, num_digits, suffix, names);
+            ret = regex_parse_value_ranges(base, base + i, num_digits, suffix, names, map);
             if (NULL != suffix) {
                 free(suffix);
             }
@@ -695,7 +700,12 @@ static pmix_status_t pmix_regex_extract_nodes(char *regexp, char ***names)
             }
         } else {
             /* If we didn't find a range, just add the value */
-            if (PMIX_SUCCESS != (ret = PMIx_Argv_append_nosize(names, base))) {
+            if (NULL != map) {
+                ret = pmix_preg_base_map_add_node_range(map, base, -1, NULL, 0, 1);
+            } else {
+                ret = PMIx_Argv_append_nosize(names, base);
+            }
+            if (PMIX_SUCCESS != ret) {
                 PMIX_ERROR_LOG(ret);
                 free(orig);
                 return ret;
@@ -720,9 +730,11 @@ static pmix_status_t pmix_regex_extract_nodes(char *regexp, char ***names)
  * @param *ranges  A pointer to a range. This can contain multiple ranges
  *                 (i.e. "1-3,10" or "5" or "9,0100-0130,250")
  * @param ***names An argv array to add the newly discovered values to
+ * @param *map     If not NULL, add the ranges to this map instead of
+ *                 expanding them into names
  */
 static pmix_status_t regex_parse_value_ranges(char *base, char *ranges, int num_digits,
-                                              char *suffix, char ***names)
+                                              char *suffix, char ***names, pmix_preg_map_t *map)
 {
     int i, len;
     pmix_status_t ret;
@@ -734,7 +746,7 @@ static pmix_status_t regex_parse_value_ranges(char *base, char *ranges, int num_
     for (orig = start = ranges, i = 0; i < len; ++i) {
         if (',' == ranges[i]) {
             ranges[i] = '\0';
-            ret = regex_parse_value_range(base, start, num_digits, suffix, names);
+            ret = regex_parse_value_range(base, start, num_digits, suffix, names, map);
             if (PMIX_SUCCESS != ret) {
                 PMIX_ERROR_LOG(ret);
                 return ret;
@@ -750,7 +762,7 @@ static pmix_status_t regex_parse_value_ranges(char *base, char *ranges, int num_
         pmix_output_verbose(1, pmix_preg_base_framework.framework_output,
                              "regex:parse:ranges: parse range %s (2)", start);
 
-        ret = regex_parse_value_range(base, start, num_digits, suffix, names);
+        ret = regex_parse_value_range(base, start, num_digits, suffix, names, map);
         if (PMIX_SUCCESS != ret) {
             PMIX_ERROR_LOG(ret);
             return ret;
@@ -768,9 +780,11 @@ static pmix_status_t regex_parse_value_ranges(char *base, char *ranges, int num_
  * @param base     The base text of the value name
  * @param *ranges  A pointer to a single range. (i.e. "1-3" or "5")
  * @param ***names An argv array to add the newly discovered values to
+ * @param *map     If not NULL, add the range to this map instead of
+ *                 expanding it into names
  */
 static pmix_status_t regex_parse_value_range(char *base, char *range, int num_digits, char *suffix,
-                                             char ***names)
+                                             char ***names, pmix_preg_map_t *map)
 {
     char *str, tmp[132];
     size_t i, k, start, end;
@@ -834,6 +848,14 @@ static pmix_status_t regex_parse_value_range(char *base, char *range, int num_di
         return PMIX_ERR_NOT_FOUND;
     }
 
+    if (NULL != map) {
+        if (end < start) {
+            return PMIX_SUCCESS;
+        }
+        return pmix_preg_base_map_add_node_range(map, base, num_digits, suffix, start,
+                                                 end - start + 1);
+    }
+
     /* Make strings for all values in the range */
 
     len = base_len + num_digits + 32;
@@ -920,6 +942,127 @@ static pmix_status_t pmix_regex_extract_ppn(char *regexp, char ***procs)
     return PMIX_SUCCESS;
 }
 
+static pmix_status_t pmix_regex_compile_ppn(char *regexp, pmix_preg_map_t *map)
+{
+    char **rngs, **nds, *t;
+    int i, j, start, end;
+    pmix_status_t rc = PMIX_SUCCESS;
+
+    /* split on semi-colons for nodes - each node is
+     * then a comma-separated list of ranks and ranges */
+    nds = PMIx_Argv_split(regexp, ';');
+    for (j = 0; NULL != nds[j] && PMIX_SUCCESS == rc; j++) {
+        rngs = PMIx_Argv_split(nds[j], ',');
+        for (i = 0; NULL != rngs[i]; i++) {
+            start = strtol(rngs[i], NULL, 10);
+            if (NULL == (t = strchr(rngs[i], '-'))) {
+                end = start;
+            } else {
+                end = strtol(t + 1, NULL, 10);
+            }
+            if (0 > start || end < start) {
+                rc = PMIX_ERR_BAD_PARAM;
+                break;
+            }
+            rc = pmix_preg_base_map_add_proc_range(map, j, start, end - start + 1);
+            if (PMIX_SUCCESS != rc) {
+                break;
+            }
+        }
+        PMIx_Argv_free(rngs);
+    }
+    PMIx_Argv_free(nds);
+    /* every node must have an entry */
+    if (PMIX_SUCCESS == rc && (uint32_t) j != map->nnodes) {
+        rc = PMIX_ERR_BAD_PARAM;
+    }
+    return rc;
+}
+
+/* split a tagged regex of the form "tag[body]" - returns a
+ * copy of the regex with the tag and body terminated. A list
+ * that was left as "raw:list" because the regex would have been
+ * longer is already in the form of a body, so take that too */
+static pmix_status_t split_regex(const char *regexp, char **copy, char **body)
+{
+    char *tmp, *ptr;
+    size_t len;
+
+    *copy = NULL;
+    if (0 == strncmp(regexp, "raw:", 4)) {
+        tmp = strdup(regexp);
+        if (NULL == tmp) {
+            return PMIX_ERR_NOMEM;
+        }
+        *copy = tmp;
+        *body = tmp + 4;
+        return PMIX_SUCCESS;
+    }
+    len = strlen(regexp);
+    if (0 == len || ']' != regexp[len - 1]) {
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+    tmp = strdup(regexp);
+    /* strip the trailing bracket */
+    tmp[len - 1] = '\0';
+    if (NULL == (ptr = strchr(tmp, '['))) {
+        free(tmp);
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+    *ptr = '\0';
+    /* if it wasn't done by PMIx, let someone else try */
+    if (0 != strcmp(tmp, "pmix")) {
+        free(tmp);
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+    *copy = tmp;
+    *body = ptr + 1;
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t compile_map(const char *nodes, const char *procs, pmix_preg_map_t **map)
+{
+    char *ncopy, *nbody, *pcopy, *pbody;
+    pmix_preg_map_t *mp;
+    pmix_status_t rc;
+
+    *map = NULL;
+
+    if (NULL == nodes || NULL == procs) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+    if (PMIX_SUCCESS != (rc = split_regex(nodes, &ncopy, &nbody))) {
+        return rc;
+    }
+    if (PMIX_SUCCESS != (rc = split_regex(procs, &pcopy, &pbody))) {
+        free(ncopy);
+        return rc;
+    }
+
+    mp = PMIX_NEW(pmix_preg_map_t);
+    rc = pmix_regex_extract_nodes(nbody, NULL, mp);
+    if (PMIX_SUCCESS == rc) {
+        rc = pmix_regex_compile_ppn(pbody, mp);
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = pmix_preg_base_map_complete(mp);
+    }
+    free(ncopy);
+    free(pcopy);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(mp);
+        return rc;
+    }
+
+    pmix_output_verbose(2, pmix_preg_base_framework.framework_output,
+                        "pmix:compile:map: %u nodes in %lu ranges, %u procs in %lu ranges",
+                        mp->nnodes, (unsigned long) mp->nnode_ranges, mp->nprocs,
+                        (unsigned long) mp->nproc_ranges);
+    *map = mp;
+    return PMIX_SUCCESS;
+}
+
 static pmix_status_t release(char *regexp)
 {
     if (NULL == regexp) {
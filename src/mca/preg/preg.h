@@ -76,6 +76,16 @@ typedef pmix_status_t (*pmix_preg_base_module_parse_nodes_fn_t)(const char *rege
 
 typedef pmix_status_t (*pmix_preg_base_module_parse_procs_fn_t)(const char *regexp, char ***procs);
 
+/* compile the node and proc regexs into a map that can be
+ * queried for a given node or rank without expanding either
+ * regex - see the pmix_preg_base_map functions for the queries.
+ * Return PMIX_ERR_TAKE_NEXT_OPTION if the regex wasn't generated
+ * by this component. The caller is responsible for releasing
+ * the returned map */
+typedef pmix_status_t (*pmix_preg_base_module_compile_map_fn_t)(const char *nodes,
+                                                                const char *procs,
+                                                                pmix_preg_map_t **map);
+
 typedef pmix_status_t (*pmix_preg_base_module_copy_fn_t)(char **dest, size_t *len,
                                                          const char *input);
 
@@ -94,6 +104,7 @@ typedef struct {
     pmix_preg_base_module_generate_ppn_fn_t generate_ppn;
     pmix_preg_base_module_parse_nodes_fn_t parse_nodes;
     pmix_preg_base_module_parse_procs_fn_t parse_procs;
+    pmix_preg_base_module_compile_map_fn_t compile_map;
     pmix_preg_base_module_copy_fn_t copy;
     pmix_preg_base_module_pack_fn_t pack;
     pmix_preg_base_module_unpack_fn_t unpack;
@@ -32,6 +32,7 @@
 
 #include "src/include/pmix_config.h"
 
+#include "pmix_common.h"
 #include "src/class/pmix_list.h"
 #include "src/class/pmix_object.h"
 
@@ -56,6 +57,46 @@ typedef struct {
 } pmix_regex_value_t;
 PMIX_EXPORT PMIX_CLASS_DECLARATION(pmix_regex_value_t);
 
+/* a run of consecutively numbered nodes. A negative num_digits
+ * indicates a singleton whose full name is the prefix */
+typedef struct {
+    uint32_t nodeid;
+    uint32_t count;
+    unsigned long start;
+    int num_digits;
+    char *prefix;
+    char *suffix;
+} pmix_preg_node_range_t;
+
+/* a run of consecutive ranks on the same node */
+typedef struct {
+    pmix_rank_t start;
+    uint32_t count;
+    uint32_t nodeid;
+    uint16_t local_rank;
+} pmix_preg_proc_range_t;
+
+/* a compiled node/proc map. The node and proc maps are held
+ * as the ranges found in the regex so that a lookup never
+ * needs to expand the full list of names or ranks. Proc ranges
+ * are stored in node order - the ranges for node N are those
+ * from node_first[N] up to node_first[N+1] - and byrank holds
+ * a copy of them sorted by starting rank */
+typedef struct {
+    pmix_object_t super;
+    uint32_t nnodes;
+    uint32_t nprocs;
+    pmix_preg_node_range_t *nodes;
+    size_t nnode_ranges;
+    size_t nodes_size;   // allocated entries in nodes
+    pmix_preg_proc_range_t *procs;
+    size_t nproc_ranges;
+    size_t procs_size;   // allocated entries in procs
+    size_t *node_first;
+    pmix_preg_proc_range_t *byrank;
+} pmix_preg_map_t;
+PMIX_EXPORT PMIX_CLASS_DECLARATION(pmix_preg_map_t);
+
 END_C_DECLS
 
 #endif /* PMIX_PREG_TYPES_H */
@@ -217,6 +217,12 @@ static pmix_status_t flex128_encode_int(pmix_data_type_t type, void *src, void *
 static pmix_status_t flex128_decode_int(pmix_data_type_t type, void *src, size_t src_len,
                                         void *dest, size_t *dst_size);
 
+static pmix_status_t flex128_encode_ints(pmix_data_type_t type, const void *src, size_t nvals,
+                                         void *dst, size_t *size);
+
+static pmix_status_t flex128_decode_ints(pmix_data_type_t type, void *src, size_t src_len,
+                                         void *dest, size_t nvals, size_t *src_used);
+
 static size_t flex_pack_integer(size_t val, uint8_t out_buf[FLEX_BASE7_MAX_BUF_SIZE]);
 
 static size_t flex_unpack_integer(const uint8_t in_buf[], size_t buf_size, size_t *out_val,
@@ -228,7 +234,9 @@ pmix_psquash_base_module_t pmix_flex128_module = {.name = "flex128",
                                                   .finalize = flex128_finalize,
                                                   .get_max_size = flex128_get_max_size,
                                                   .encode_int = flex128_encode_int,
-                                                  .decode_int = flex128_decode_int};
+                                                  .decode_int = flex128_decode_int,
+                                                  .encode_ints = flex128_encode_ints,
+                                                  .decode_ints = flex128_decode_ints};
 
 static pmix_status_t flex128_init(void)
 {
@@ -296,6 +304,129 @@ static pmix_status_t flex128_decode_int(pmix_data_type_t type, void *src, size_t
     return rc;
 }
 
+/**
+ * Encode an array of integers of the given C-type using the
+ * given conversion, writing single-byte values directly as they
+ * are by far the most common
+ */
+#define FLEX128_ENCODE_ARRAY(conv, type)                    \
+    do {                                                    \
+        for (i = 0; i < nvals; i++) {                       \
+            conv(type, s + i * sizeof(type), tmp);          \
+            if (PMIX_LIKELY(tmp <= FLEX_BASE7_MASK)) {      \
+                d[len++] = (uint8_t) tmp;                   \
+            } else {                                        \
+                len += flex_pack_integer(tmp, d + len);     \
+            }                                               \
+        }                                                   \
+    } while (0)
+
+/**
+ * Decode an array of integers of the given C-type using the
+ * given conversion, applying the same sanity checks to each
+ * value as flex128_decode_int and its callers
+ */
+#define FLEX128_DECODE_ARRAY(conv, type)                                        \
+    do {                                                                        \
+        for (i = 0; i < nvals; i++) {                                           \
+            if (PMIX_UNLIKELY(src_len <= off)) {                                \
+                return PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER;                 \
+            }                                                                   \
+            if (PMIX_LIKELY(!(s[off] & FLEX_BASE7_CONT_FLAG))) {                \
+                tmp = s[off++];                                                 \
+            } else {                                                            \
+                used = flex_unpack_integer(s + off, src_len - off, &tmp, &vsz); \
+                if (PMIX_UNLIKELY(sizeof(type) < vsz || sizeof(type) < used - 1)) { \
+                    PMIX_ERROR_LOG(PMIX_ERR_UNPACK_FAILURE);                    \
+                    return PMIX_ERR_UNPACK_FAILURE;                             \
+                }                                                               \
+                off += used;                                                    \
+            }                                                                   \
+            conv(type, tmp, d + i * sizeof(type));                              \
+        }                                                                       \
+    } while (0)
+
+static pmix_status_t flex128_encode_ints(pmix_data_type_t type, const void *src, size_t nvals,
+                                         void *dst, size_t *size)
+{
+    const uint8_t *s = (const uint8_t *) src;
+    uint8_t *d = (uint8_t *) dst;
+    size_t i, tmp, len = 0;
+
+    /* resolve the type once for the whole array */
+    switch (type) {
+    case PMIX_INT16:
+        FLEX128_ENCODE_ARRAY(FLEX128_PACK_CONVERT_SIGNED, int16_t);
+        break;
+    case PMIX_UINT16:
+        FLEX128_ENCODE_ARRAY(FLEX128_PACK_CONVERT_UNSIGNED, uint16_t);
+        break;
+    case PMIX_INT:
+    case PMIX_INT32:
+        FLEX128_ENCODE_ARRAY(FLEX128_PACK_CONVERT_SIGNED, int32_t);
+        break;
+    case PMIX_UINT:
+    case PMIX_UINT32:
+        FLEX128_ENCODE_ARRAY(FLEX128_PACK_CONVERT_UNSIGNED, uint32_t);
+        break;
+    case PMIX_INT64:
+        FLEX128_ENCODE_ARRAY(FLEX128_PACK_CONVERT_SIGNED, int64_t);
+        break;
+    case PMIX_SIZE:
+        FLEX128_ENCODE_ARRAY(FLEX128_PACK_CONVERT_UNSIGNED, size_t);
+        break;
+    case PMIX_UINT64:
+        FLEX128_ENCODE_ARRAY(FLEX128_PACK_CONVERT_UNSIGNED, uint64_t);
+        break;
+    default:
+        PMIX_ERROR_LOG(PMIX_ERR_BAD_PARAM);
+        return PMIX_ERR_BAD_PARAM;
+    }
+    *size = len;
+
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t flex128_decode_ints(pmix_data_type_t type, void *src, size_t src_len,
+                                         void *dest, size_t nvals, size_t *src_used)
+{
+    const uint8_t *s = (const uint8_t *) src;
+    uint8_t *d = (uint8_t *) dest;
+    size_t i, tmp, vsz, used, off = 0;
+
+    switch (type) {
+    case PMIX_INT16:
+        FLEX128_DECODE_ARRAY(FLEX128_UNPACK_CONVERT_SIGNED, int16_t);
+        break;
+    case PMIX_UINT16:
+        FLEX128_DECODE_ARRAY(FLEX128_UNPACK_CONVERT_UNSIGNED, uint16_t);
+        break;
+    case PMIX_INT:
+    case PMIX_INT32:
+        FLEX128_DECODE_ARRAY(FLEX128_UNPACK_CONVERT_SIGNED, int32_t);
+        break;
+    case PMIX_UINT:
+    case PMIX_UINT32:
+        FLEX128_DECODE_ARRAY(FLEX128_UNPACK_CONVERT_UNSIGNED, uint32_t);
+        break;
+    case PMIX_INT64:
+        FLEX128_DECODE_ARRAY(FLEX128_UNPACK_CONVERT_SIGNED, int64_t);
+        break;
+    case PMIX_SIZE:
+        FLEX128_DECODE_ARRAY(FLEX128_UNPACK_CONVERT_UNSIGNED, size_t);
+        break;
+    case PMIX_UINT64:
+        FLEX128_DECODE_ARRAY(FLEX128_UNPACK_CONVERT_UNSIGNED, uint64_t);
+        break;
+    default:
+        PMIX_ERROR_LOG(PMIX_ERR_BAD_PARAM);
+        return PMIX_ERR_BAD_PARAM;
+    }
+    *src_used = off;
+
+    return PMIX_SUCCESS;
+}
+
 /*
  * Typical representation of a number in computer systems is:
  * A[0]*B^0 + A[1]*B^1 + A[2]*B^2 + ... + A[n]*B^n
@@ -19,6 +19,7 @@
 #include "src/include/pmix_globals.h"
 #include "src/include/pmix_socket_errno.h"
 #include "src/util/pmix_argv.h"
+#include "src/util/pmix_bswap.h"
 #include "src/util/pmix_error.h"
 #include "src/util/pmix_output.h"
 
@@ -41,13 +42,21 @@ static pmix_status_t native_encode_int(pmix_data_type_t type, void *src, void *d
 static pmix_status_t native_decode_int(pmix_data_type_t type, void *src, size_t src_len, void *dest,
                                        size_t *dst_size);
 
+static pmix_status_t native_encode_ints(pmix_data_type_t type, const void *src, size_t nvals,
+                                        void *dst, size_t *size);
+
+static pmix_status_t native_decode_ints(pmix_data_type_t type, void *src, size_t src_len,
+                                        void *dest, size_t nvals, size_t *src_used);
+
 pmix_psquash_base_module_t pmix_psquash_native_module = {.name = "native",
                                                          .int_type_is_encoded = false,
                                                          .init = native_init,
                                                          .finalize = native_finalize,
                                                          .get_max_size = native_get_max_size,
                                                          .encode_int = native_encode_int,
-                                                         .decode_int = native_decode_int};
+                                                         .decode_int = native_decode_int,
+                                                         .encode_ints = native_encode_ints,
+                                                         .decode_ints = native_decode_ints};
 
 #define NATIVE_PACK_CONVERT(ret, type, val)  \
     do {                                     \
@@ -179,3 +188,66 @@ static pmix_status_t native_decode_int(pmix_data_type_t type, void *src, size_t
 
     return PMIX_SUCCESS;
 }
+
+/* the native representation is just the network byte order,
+ * so whole arrays are converted in one pass */
+static pmix_status_t native_convert_ints(size_t val_size, const void *src, size_t nvals, void *dst)
+{
+    switch (val_size) {
+    case 2:
+        pmix_bswap16_array(dst, src, nvals);
+        break;
+    case 4:
+        pmix_bswap32_array(dst, src, nvals);
+        break;
+    case 8:
+        pmix_bswap64_array(dst, src, nvals);
+        break;
+    default:
+        return PMIX_ERR_BAD_PARAM;
+    }
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t native_encode_ints(pmix_data_type_t type, const void *src, size_t nvals,
+                                        void *dst, size_t *size)
+{
+    pmix_status_t rc;
+    size_t val_size;
+
+    PMIX_SQUASH_TYPE_SIZEOF(rc, type, val_size);
+    if (PMIX_SUCCESS == rc) {
+        rc = native_convert_ints(val_size, src, nvals, dst);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    *size = nvals * val_size;
+
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t native_decode_ints(pmix_data_type_t type, void *src, size_t src_len,
+                                        void *dest, size_t nvals, size_t *src_used)
+{
+    pmix_status_t rc;
+    size_t val_size;
+
+    PMIX_SQUASH_TYPE_SIZEOF(rc, type, val_size);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    if (src_len < nvals * val_size) {
+        return PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER;
+    }
+    rc = native_convert_ints(val_size, src, nvals, dest);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    *src_used = nvals * val_size;
+
+    return PMIX_SUCCESS;
+}
@@ -77,6 +77,33 @@ typedef pmix_status_t (*pmix_psquash_encode_int_fn_t)(pmix_data_type_t type, voi
 typedef pmix_status_t (*pmix_psquash_decode_int_fn_t)(pmix_data_type_t type, void *src,
                                                       size_t src_len, void *dest, size_t *dst_len);
 
+/**
+ * Encode an array of basic integers into a contiguous destination buffer.
+ *
+ * type     - Type of the 'src' elements (PMIX_SIZE, PMIX_INT to PMIX_UINT64)
+ * src      - pointer to the array of integers
+ * nvals    - number of elements in the array
+ * dest     - pointer to buffer to store data - must have room for
+ *            nvals times the maximum size of the type
+ * dst_len  - pointer to the packed size of dest, in bytes
+ */
+typedef pmix_status_t (*pmix_psquash_encode_ints_fn_t)(pmix_data_type_t type, const void *src,
+                                                       size_t nvals, void *dest, size_t *dst_len);
+
+/**
+ * Decode a contiguous buffer into an array of basic integers.
+ *
+ * type     - Type of the 'dest' elements (PMIX_SIZE, PMIX_INT to PMIX_UINT64)
+ * src      - pointer to buffer where data was stored
+ * src_len  - length, in bytes, of the src buffer
+ * dest     - pointer to the array of integers
+ * nvals    - number of elements to decode
+ * src_used - pointer to the number of bytes of src that were consumed
+ */
+typedef pmix_status_t (*pmix_psquash_decode_ints_fn_t)(pmix_data_type_t type, void *src,
+                                                       size_t src_len, void *dest, size_t nvals,
+                                                       size_t *src_used);
+
 /**
  * Base structure for a PSQUASH module
  */
@@ -95,6 +122,11 @@ typedef struct {
     /** Integer compression */
     pmix_psquash_encode_int_fn_t encode_int;
     pmix_psquash_decode_int_fn_t decode_int;
+
+    /** Array compression - optional, callers fall back to
+     * the single-value functions if these are NULL */
+    pmix_psquash_encode_ints_fn_t encode_ints;
+    pmix_psquash_decode_ints_fn_t decode_ints;
 } pmix_psquash_base_module_t;
 
 /**
@@ -33,6 +33,9 @@
 #ifdef HAVE_STRING_H
 #    include <string.h>
 #endif
+#ifdef HAVE_SYS_UIO_H
+#    include <sys/uio.h>
+#endif
 
 #include "src/class/pmix_pointer_array.h"
 #include "src/mca/base/pmix_mca_base_framework.h"
@@ -40,6 +43,7 @@
 
 #include "src/include/pmix_globals.h"
 #include "src/mca/ptl/base/ptl_base_handshake.h"
+#include "src/util/pmix_shmem.h"
 #include "src/mca/ptl/ptl.h"
 
 BEGIN_C_DECLS
@@ -56,6 +60,88 @@ PMIX_EXPORT extern pmix_mca_base_framework_t pmix_ptl_base_framework;
  */
 PMIX_EXPORT pmix_status_t pmix_ptl_base_select(void);
 
+/* statistics on the vectored send path */
+typedef struct {
+    size_t nwrites;      // number of writev calls that sent data
+    size_t nmsgs;        // number of messages completely sent
+    size_t nbytes;       // number of bytes sent
+    size_t nsaved;       // writev calls avoided by coalescing messages
+    size_t max_bytes;    // largest number of bytes sent by a single writev
+} pmix_ptl_base_send_stats_t;
+
+/* size classes of the receive payload pool - payloads are rounded
+ * up to a power of two between the min and max sizes. Larger
+ * payloads are allocated and freed directly */
+#define PMIX_PTL_RBUF_MIN_SIZE   64
+#define PMIX_PTL_RBUF_MAX_SIZE   65536
+#define PMIX_PTL_RBUF_NCLASSES   11
+#define PMIX_PTL_RBUF_MAX_CACHED 32 // max free blocks kept per class
+
+/* size of the per-peer staging buffer used to speculatively read
+ * a message header along with small message bodies */
+#define PMIX_PTL_RECV_STAGE_SIZE 4096
+
+typedef struct {
+    void *free[PMIX_PTL_RBUF_NCLASSES]; // free list of each size class
+    int ncached[PMIX_PTL_RBUF_NCLASSES];
+    size_t nhits;      // requests satisfied from a free list
+    size_t nmisses;    // requests that required an allocation
+    size_t noversize;  // requests too large to be pooled
+} pmix_ptl_base_rbuf_pool_t;
+
+/* Shared-memory message rings. A client and its local server may
+ * agree during the connection handshake to exchange messages through
+ * a pair of single-producer/single-consumer byte rings placed in a
+ * segment created by the server. Messages keep their usual header
+ * framing - the rings simply replace the socket as the byte stream,
+ * so partial writes and reads are resumed exactly as before. Once the
+ * rings are in use, the socket only carries single-byte "doorbells"
+ * that wake a peer which has gone idle (or is waiting for room in a
+ * full ring), and continues to report loss of the connection */
+#define PMIX_PTL_RING_REQUEST   "pmix.ptl.ring" // (bool) client asks for the rings
+#define PMIX_PTL_RING_ACK       0x80000000 // set in the client index when the server will offer rings
+#define PMIX_PTL_RING_MAGIC     0x50524e47 // "PRNG"
+#define PMIX_PTL_RING_VERSION   1
+#define PMIX_PTL_RING_MIN_SIZE  4096
+#define PMIX_PTL_RING_CACHELINE 64
+
+/* control block of one ring - the indices only ever increase and
+ * are masked to locate the data. Each is on its own cache line so
+ * the two sides don't contend for it */
+typedef struct {
+    volatile uint64_t head; // written by the consumer
+    char pad0[PMIX_PTL_RING_CACHELINE - sizeof(uint64_t)];
+    volatile uint64_t tail; // written by the producer
+    char pad1[PMIX_PTL_RING_CACHELINE - sizeof(uint64_t)];
+    volatile uint32_t sleeping; // consumer must be woken for new data
+    volatile uint32_t waiting;  // producer must be woken when space frees
+    char pad2[PMIX_PTL_RING_CACHELINE - 2 * sizeof(uint32_t)];
+} pmix_ptl_ring_ctl_t;
+
+/* layout of the start of the segment - the ring data follows */
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t size; // bytes of data in each ring
+    char pad[PMIX_PTL_RING_CACHELINE - 2 * sizeof(uint32_t) - sizeof(uint64_t)];
+    pmix_ptl_ring_ctl_t c2s; // client-to-server ring
+    pmix_ptl_ring_ctl_t s2c; // server-to-client ring
+} pmix_ptl_ring_hdr_t;
+
+typedef struct pmix_ptl_ring_t {
+    pmix_object_t super;
+    pmix_shmem_t *shmem;
+    bool unlinked;            // the backing file has been removed
+    pmix_peer_t *peer;        // owner - its socket carries the doorbells
+    pmix_ptl_ring_ctl_t *in;  // ring we consume
+    pmix_ptl_ring_ctl_t *out; // ring we produce
+    char *indata;
+    char *outdata;
+    uint64_t mask;            // ring size - 1
+    size_t nbells;            // doorbells we have rung
+} pmix_ptl_ring_t;
+PMIX_CLASS_DECLARATION(pmix_ptl_ring_t);
+
 /* framework globals */
 struct pmix_ptl_base_t {
     bool initialized;
@@ -102,6 +188,10 @@ struct pmix_ptl_base_t {
     int wait_to_connect;
     int handshake_wait_time;
     int handshake_max_retries;
+    size_t max_coalesce_bytes;  // max bytes to gather from queued msgs into one write
+    pmix_ptl_base_send_stats_t send_stats;
+    pmix_ptl_base_rbuf_pool_t rbuf_pool;
+    size_t ring_size;           // bytes per shared-memory ring offered to clients (0 => none)
 };
 typedef struct pmix_ptl_base_t pmix_ptl_base_t;
 
@@ -138,6 +228,18 @@ PMIX_EXPORT pmix_status_t pmix_base_write_rndz_file(char *filename, char *uri, b
 PMIX_EXPORT pmix_status_t pmix_ptl_base_check_server_uris(pmix_peer_t *peer, char **evar);
 PMIX_EXPORT pmix_status_t pmix_ptl_base_check_directives(pmix_info_t *info, size_t ninfo);
 PMIX_EXPORT pmix_status_t pmix_ptl_base_setup_fork(const pmix_proc_t *proc, char ***env);
+PMIX_EXPORT char *pmix_ptl_base_rbuf_get(size_t size);
+PMIX_EXPORT void pmix_ptl_base_rbuf_put(char *data, size_t size);
+PMIX_EXPORT void pmix_ptl_base_rbuf_finalize(void);
+PMIX_EXPORT bool pmix_ptl_base_ring_wanted(void);
+PMIX_EXPORT pmix_status_t pmix_ptl_base_ring_offer(pmix_peer_t *peer);
+PMIX_EXPORT pmix_status_t pmix_ptl_base_ring_accept(pmix_peer_t *peer);
+PMIX_EXPORT ssize_t pmix_ptl_base_ring_writev(pmix_ptl_ring_t *ring, const struct iovec *iov,
+                                              int iovcnt);
+PMIX_EXPORT size_t pmix_ptl_base_ring_read(pmix_ptl_ring_t *ring, char *buf, size_t size);
+PMIX_EXPORT bool pmix_ptl_base_ring_pending(pmix_ptl_ring_t *ring);
+PMIX_EXPORT bool pmix_ptl_base_ring_sleep(pmix_ptl_ring_t *ring);
+PMIX_EXPORT pmix_status_t pmix_ptl_base_ring_clear_bells(pmix_ptl_ring_t *ring);
 PMIX_EXPORT void pmix_ptl_base_send_handler(int sd, short flags, void *cbdata);
 PMIX_EXPORT void pmix_ptl_base_recv_handler(int sd, short flags, void *cbdata);
 PMIX_EXPORT void pmix_ptl_base_process_msg(int fd, short flags, void *cbdata);
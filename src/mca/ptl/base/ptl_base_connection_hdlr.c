@@ -50,6 +50,7 @@ static void process_cbfunc(int sd, short args, void *cbdata);
 static void cnct_cbfunc(pmix_status_t status, pmix_proc_t *proc, void *cbdata);
 static void _check_cached_events(pmix_peer_t *peer);
 static pmix_status_t process_tool_request(pmix_pending_connection_t *pnd, char *mg, size_t cnt);
+static bool ring_requested(pmix_peer_t *peer, char *mg, size_t cnt);
 
 void pmix_ptl_base_connection_handler(int sd, short args, void *cbdata)
 {
@@ -67,6 +68,7 @@ void pmix_ptl_base_connection_handler(int sd, short args, void *cbdata)
     pmix_info_t ginfo;
     pmix_byte_object_t cred;
     uint8_t major, minor, release;
+    bool ring;
 
     /* acquire the object */
     PMIX_ACQUIRE_OBJECT(pnd);
@@ -389,14 +391,32 @@ void pmix_ptl_base_connection_handler(int sd, short args, void *cbdata)
         goto error;
     }
 
-    /* send the client's array index */
-    u32 = htonl(peer->index);
+    /* send the client's array index - if they asked for shared-memory
+     * rings and we are configured to offer them, flag that we will
+     * follow with the details. Clients only wait for the details when
+     * the flag is set, so servers that ignore the request (including
+     * older ones) remain compatible */
+    ring = (0 < pmix_ptl_base.ring_size && NULL != blob && ring_requested(peer, blob, len));
+    u32 = (uint32_t) peer->index;
+    if (ring) {
+        u32 |= PMIX_PTL_RING_ACK;
+    }
+    u32 = htonl(u32);
     if (PMIX_SUCCESS
         != (rc = pmix_ptl_base_send_blocking(pnd->sd, (char *) &u32, sizeof(uint32_t)))) {
         PMIX_ERROR_LOG(rc);
         goto error;
     }
 
+    /* if they asked for shared-memory rings, set them up */
+    if (ring) {
+        rc = pmix_ptl_base_ring_offer(peer);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            goto error;
+        }
+    }
+
     pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                         "connect-ack from client completed");
 
@@ -646,7 +666,7 @@ error:
     CLOSE_THE_SOCKET(pnd->sd);
     PMIX_RELEASE(pnd);
     PMIX_RELEASE(peer);
-    pmix_list_remove_item(&pmix_globals.nspaces, &nptr->super);
+    pmix_server_nspace_remove(nptr);
     PMIX_RELEASE(nptr); // will release the info object
     PMIX_RELEASE(cd);
     if (NULL != req) {
@@ -677,6 +697,39 @@ static void cnct_cbfunc(pmix_status_t status, pmix_proc_t *proc, void *cbdata)
     PMIX_THREADSHIFT(cd, process_cbfunc);
 }
 
+/* see if a client included a request for shared-memory
+ * rings in the info it passed with its connection */
+static bool ring_requested(pmix_peer_t *peer, char *mg, size_t cnt)
+{
+    pmix_buffer_t buf;
+    pmix_info_t *info = NULL;
+    pmix_status_t rc;
+    size_t n, ninfo;
+    int32_t foo;
+    bool want = false;
+
+    PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+    PMIX_LOAD_BUFFER_NON_DESTRUCT(peer, &buf, mg, cnt); // allocates no memory
+    foo = 1;
+    PMIX_BFROPS_UNPACK(rc, peer, &buf, &ninfo, &foo, PMIX_SIZE);
+    if (PMIX_SUCCESS != rc || 0 == ninfo) {
+        return false;
+    }
+    PMIX_INFO_CREATE(info, ninfo);
+    foo = (int32_t) ninfo;
+    PMIX_BFROPS_UNPACK(rc, peer, &buf, info, &foo, PMIX_INFO);
+    if (PMIX_SUCCESS == rc) {
+        for (n = 0; n < ninfo; n++) {
+            if (PMIX_CHECK_KEY(&info[n], PMIX_PTL_RING_REQUEST)) {
+                want = PMIX_INFO_TRUE(&info[n]);
+                break;
+            }
+        }
+    }
+    PMIX_INFO_FREE(info, ninfo);
+    return want;
+}
+
 static pmix_status_t process_tool_request(pmix_pending_connection_t *pnd,
                                           char *mg, size_t cnt)
 {
@@ -850,9 +903,8 @@ static pmix_status_t process_tool_request(pmix_pending_connection_t *pnd,
 
 static void _check_cached_events(pmix_peer_t *peer)
 {
-    pmix_notify_caddy_t *cd;
-    int i;
-    size_t n;
+    pmix_notify_caddy_t *cd, *next;
+    size_t n, nreplayed = 0;
     pmix_range_trkr_t rngtrk;
     pmix_buffer_t *relay;
     pmix_proc_t proc;
@@ -862,11 +914,7 @@ static void _check_cached_events(pmix_peer_t *peer)
 
     PMIX_LOAD_PROCID(&proc, peer->info->pname.nspace, peer->info->pname.rank);
 
-    for (i = 0; i < pmix_globals.max_events; i++) {
-        pmix_hotel_knock(&pmix_globals.notifications, i, (void **) &cd);
-        if (NULL == cd) {
-            continue;
-        }
+    PMIX_NOTIFY_CACHE_FOREACH (cd, next) {
         /* check the range */
         if (NULL == cd->targets) {
             rngtrk.procs = &cd->source;
@@ -891,7 +939,7 @@ static void _check_cached_events(pmix_peer_t *peer)
                     /* if this is the last one, then evict this event
                      * from the cache */
                     if (0 == cd->nleft) {
-                        pmix_hotel_checkout(&pmix_globals.notifications, cd->room);
+                        pmix_notify_event_uncache(cd);
                         found = true; // mark that we should release cd
                     }
                     break;
@@ -947,8 +995,10 @@ static void _check_cached_events(pmix_peer_t *peer)
         if (PMIX_SUCCESS != ret) {
             PMIX_RELEASE(relay);
         }
+        ++nreplayed;
         if (found) {
             PMIX_RELEASE(cd);
         }
     }
+    pmix_notify_event_replayed(nreplayed);
 }
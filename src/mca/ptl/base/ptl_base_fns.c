@@ -56,7 +56,9 @@ static char *pmix_getline(FILE *fp);
 pmix_status_t pmix_ptl_base_set_peer(pmix_peer_t *peer, char *evar)
 {
     pmix_status_t rc;
-    char *vrs;
+    char *vrs, *mode, **avail;
+    bool found = false;
+    int n;
 
     vrs = getenv("PMIX_VERSION");
 
@@ -67,7 +69,28 @@ pmix_status_t pmix_ptl_base_set_peer(pmix_peer_t *peer, char *evar)
 
         pmix_output_verbose(2, pmix_ptl_base_framework.framework_output, "V41 SERVER DETECTED");
 
-        /* must use the latest bfrops module */
+        /* a server of our own release shares our dictionary, so
+         * we can exchange reserved keys by index if it offers the
+         * v5 module */
+        if (NULL != vrs && 0 == strcmp(vrs, PMIX_VERSION)
+            && NULL != (mode = getenv("PMIX_BFROPS_MODE"))) {
+            avail = PMIx_Argv_split(mode, ',');
+            for (n = 0; NULL != avail[n]; n++) {
+                if (0 == strcmp(avail[n], "v5")) {
+                    found = true;
+                    break;
+                }
+            }
+            PMIx_Argv_free(avail);
+        }
+        if (found) {
+            PMIX_BFROPS_SET_MODULE(rc, pmix_globals.mypeer, peer, "v5");
+            if (PMIX_SUCCESS == rc) {
+                return rc;
+            }
+        }
+
+        /* otherwise use the latest bfrops module */
         PMIX_BFROPS_SET_MODULE(rc, pmix_globals.mypeer, peer, NULL);
         return rc;
     }
@@ -218,11 +241,19 @@ pmix_status_t pmix_ptl_base_check_directives(pmix_info_t *info, size_t ninfo)
 
 pmix_status_t pmix_ptl_base_setup_fork(const pmix_proc_t *proc, char ***env)
 {
+    char *tmp;
     PMIX_HIDE_UNUSED_PARAMS(proc);
 
     PMIx_Setenv("PMIX_SERVER_TMPDIR", pmix_ptl_base.session_tmpdir, true, env);
     PMIx_Setenv("PMIX_SYSTEM_TMPDIR", pmix_ptl_base.system_tmpdir, true, env);
 
+    /* let the client know it can ask for shared-memory rings */
+    if (0 < pmix_ptl_base.ring_size) {
+        pmix_asprintf(&tmp, "%lu", (unsigned long) pmix_ptl_base.ring_size);
+        PMIx_Setenv("PMIX_PTL_RING_SIZE", tmp, true, env);
+        free(tmp);
+    }
+
     return PMIX_SUCCESS;
 }
 
@@ -989,6 +1020,7 @@ void pmix_ptl_base_setup_socket(pmix_peer_t *peer)
 pmix_status_t pmix_ptl_base_client_handshake(pmix_peer_t *peer, pmix_status_t reply)
 {
     pmix_status_t rc;
+    uint32_t u32;
 
     /* see if they want us to do the handshake */
     if (PMIX_ERR_READY_FOR_HANDSHAKE == reply) {
@@ -1003,7 +1035,14 @@ pmix_status_t pmix_ptl_base_client_handshake(pmix_peer_t *peer, pmix_status_t re
                         "pmix: RECV CONNECT CONFIRMATION");
 
     /* receive our index into the peer's client array */
-    PMIX_PTL_RECV_U32(peer->sd, pmix_globals.pindex);
+    PMIX_PTL_RECV_U32(peer->sd, u32);
+    pmix_globals.pindex = (int) (u32 & ~PMIX_PTL_RING_ACK);
+
+    /* if we asked for shared-memory rings and the server flagged
+     * that it understood, it will tell us where to find them */
+    if (pmix_ptl_base_ring_wanted() && (u32 & PMIX_PTL_RING_ACK)) {
+        return pmix_ptl_base_ring_accept(peer);
+    }
     return PMIX_SUCCESS;
 }
 
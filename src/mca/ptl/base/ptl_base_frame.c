@@ -106,7 +106,11 @@ pmix_ptl_base_t pmix_ptl_base = {
     .max_retries = 0,
     .wait_to_connect = 0,
     .handshake_wait_time = 0,
-    .handshake_max_retries = 0
+    .handshake_max_retries = 0,
+    .max_coalesce_bytes = 262144,
+    .send_stats = {0, 0, 0, 0, 0},
+    .rbuf_pool = {{NULL}, {0}, 0, 0, 0},
+    .ring_size = 0
 };
 int pmix_ptl_base_output = -1;
 pmix_ptl_module_t pmix_ptl = {
@@ -219,6 +223,21 @@ static int pmix_ptl_register(pmix_mca_base_register_flag_t flags)
     (void) pmix_mca_base_var_register_synonym(idx, "pmix", "ptl", "tcp", "handshake_max_retries",
                                               PMIX_MCA_BASE_VAR_SYN_FLAG_DEPRECATED);
 
+    (void) pmix_mca_base_var_register("pmix", "ptl", "base", "max_coalesce_bytes",
+                                      "Max number of bytes from queued messages to gather "
+                                      "into a single write to a peer (0 => send each "
+                                      "message with its own write)",
+                                      PMIX_MCA_BASE_VAR_TYPE_SIZE_T,
+                                      &pmix_ptl_base.max_coalesce_bytes);
+
+    (void) pmix_mca_base_var_register("pmix", "ptl", "base", "ring_size",
+                                      "Size in bytes of each of the pair of shared-memory "
+                                      "rings offered to local clients for exchanging "
+                                      "messages with this server, rounded up to a power "
+                                      "of two (0 => clients use the socket alone)",
+                                      PMIX_MCA_BASE_VAR_TYPE_SIZE_T,
+                                      &pmix_ptl_base.ring_size);
+
     idx = pmix_mca_base_var_register("pmix", "ptl", "base", "report_uri",
                                      "Output URI [- => stdout, + => stderr, or filename]",
                                      PMIX_MCA_BASE_VAR_TYPE_STRING,
@@ -239,6 +258,19 @@ static pmix_status_t pmix_ptl_close(void)
     pmix_ptl_base.initialized = false;
     pmix_ptl_base.selected = false;
 
+    if (0 < pmix_ptl_base.send_stats.nwrites) {
+        pmix_output_verbose(1, pmix_ptl_base_framework.framework_output,
+                            "ptl:base send stats: %lu msgs %lu bytes in %lu writes "
+                            "(%lu writes saved, avg %lu bytes/write, max %lu bytes/write)",
+                            (unsigned long) pmix_ptl_base.send_stats.nmsgs,
+                            (unsigned long) pmix_ptl_base.send_stats.nbytes,
+                            (unsigned long) pmix_ptl_base.send_stats.nwrites,
+                            (unsigned long) pmix_ptl_base.send_stats.nsaved,
+                            (unsigned long) (pmix_ptl_base.send_stats.nbytes
+                                             / pmix_ptl_base.send_stats.nwrites),
+                            (unsigned long) pmix_ptl_base.send_stats.max_bytes);
+    }
+
     /* ensure the listen thread has been shut down */
     pmix_ptl_base_stop_listening();
 
@@ -254,6 +286,7 @@ static pmix_status_t pmix_ptl_close(void)
     /* the component will cleanup when closed */
     PMIX_LIST_DESTRUCT(&pmix_ptl_base.posted_recvs);
     PMIX_LIST_DESTRUCT(&pmix_ptl_base.unexpected_msgs);
+    pmix_ptl_base_rbuf_finalize();
     PMIX_DESTRUCT(&pmix_ptl_base.listener);
 
     if (NULL != pmix_ptl_base.scheduler_filename) {
@@ -448,6 +481,9 @@ static void rcon(pmix_ptl_recv_t *p)
 }
 static void rdes(pmix_ptl_recv_t *p)
 {
+    if (NULL != p->data) {
+        pmix_ptl_base_rbuf_put(p->data, p->hdr.nbytes);
+    }
     if (NULL != p->peer) {
         PMIX_RELEASE(p->peer);
     }
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "src/include/pmix_config.h"
+
+#include <stdlib.h>
+
+#include "src/include/pmix_globals.h"
+#include "src/util/pmix_output.h"
+
+#include "src/mca/ptl/base/base.h"
+
+/* Pool of receive payload buffers.
+ *
+ * Payloads up to PMIX_PTL_RBUF_MAX_SIZE are rounded up to a power of
+ * two and recycled through a free list for that size class. The blocks
+ * are plain malloc'd memory, so a consumer that takes ownership of a
+ * payload (e.g., by unloading the buffer it was delivered in) can
+ * simply free it - it just won't be recycled.
+ *
+ * All receive processing takes place in the PMIx progress thread, so
+ * the pool is not protected by a lock. */
+
+static int rbuf_class(size_t size)
+{
+    int cls = 0;
+    size_t csize = PMIX_PTL_RBUF_MIN_SIZE;
+
+    while (csize < size) {
+        csize <<= 1;
+        ++cls;
+    }
+    return cls;
+}
+
+char *pmix_ptl_base_rbuf_get(size_t size)
+{
+    pmix_ptl_base_rbuf_pool_t *pool = &pmix_ptl_base.rbuf_pool;
+    void *ptr;
+    int cls;
+
+    if (PMIX_PTL_RBUF_MAX_SIZE < size) {
+        pool->noversize++;
+        return (char *) malloc(size);
+    }
+    cls = rbuf_class(size);
+    if (NULL != pool->free[cls]) {
+        ptr = pool->free[cls];
+        pool->free[cls] = *(void **) ptr;
+        pool->ncached[cls]--;
+        pool->nhits++;
+        return (char *) ptr;
+    }
+    pool->nmisses++;
+    return (char *) malloc(PMIX_PTL_RBUF_MIN_SIZE << cls);
+}
+
+void pmix_ptl_base_rbuf_put(char *data, size_t size)
+{
+    pmix_ptl_base_rbuf_pool_t *pool = &pmix_ptl_base.rbuf_pool;
+    int cls;
+
+    if (NULL == data) {
+        return;
+    }
+    if (PMIX_PTL_RBUF_MAX_SIZE < size) {
+        free(data);
+        return;
+    }
+    cls = rbuf_class(size);
+    if (PMIX_PTL_RBUF_MAX_CACHED <= pool->ncached[cls]) {
+        free(data);
+        return;
+    }
+    *(void **) data = pool->free[cls];
+    pool->free[cls] = data;
+    pool->ncached[cls]++;
+}
+
+void pmix_ptl_base_rbuf_finalize(void)
+{
+    pmix_ptl_base_rbuf_pool_t *pool = &pmix_ptl_base.rbuf_pool;
+    void *ptr;
+    int cls;
+
+    if (0 < pool->nhits + pool->nmisses + pool->noversize) {
+        pmix_output_verbose(1, pmix_ptl_base_framework.framework_output,
+                            "ptl:base recv buffer pool: %lu hits %lu misses %lu oversize",
+                            (unsigned long) pool->nhits, (unsigned long) pool->nmisses,
+                            (unsigned long) pool->noversize);
+    }
+    for (cls = 0; cls < PMIX_PTL_RBUF_NCLASSES; cls++) {
+        while (NULL != pool->free[cls]) {
+            ptr = pool->free[cls];
+            pool->free[cls] = *(void **) ptr;
+            free(ptr);
+        }
+        pool->ncached[cls] = 0;
+    }
+}
@@ -0,0 +1,439 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "src/include/pmix_config.h"
+
+#include "src/include/pmix_socket_errno.h"
+#include "src/include/pmix_stdint.h"
+
+#include <stdlib.h>
+#ifdef HAVE_STRING_H
+#    include <string.h>
+#endif
+#ifdef HAVE_UNISTD_H
+#    include <unistd.h>
+#endif
+
+#include "src/include/pmix_atomic.h"
+#include "src/include/pmix_globals.h"
+#include "src/util/pmix_error.h"
+#include "src/util/pmix_output.h"
+#include "src/util/pmix_printf.h"
+#include "src/util/pmix_string_copy.h"
+
+#include "src/mca/ptl/base/base.h"
+
+/* Shared-memory message rings.
+ *
+ * Each ring is a single-producer/single-consumer byte stream. The
+ * producer copies data in at the tail and the consumer copies it out
+ * at the head - neither side ever blocks on the other, and a write or
+ * read that can only be partially completed simply reports how far it
+ * got so that the regular send/recv state machines can resume later.
+ *
+ * Wakeups use the same Dekker-style handshake in both directions: a
+ * side that is about to go idle raises its flag, issues a full barrier,
+ * and then checks the ring one last time; the other side updates the
+ * ring, issues a full barrier, and rings the doorbell (a single byte on
+ * the socket) only if it sees the flag. Thus a doorbell is only paid for
+ * when the peer is actually idle, and a burst of messages costs at most
+ * one. Everything here runs in the PMIx progress thread of each process. */
+
+static void rcon(pmix_ptl_ring_t *p)
+{
+    p->shmem = NULL;
+    p->unlinked = false;
+    p->peer = NULL;
+    p->in = NULL;
+    p->out = NULL;
+    p->indata = NULL;
+    p->outdata = NULL;
+    p->mask = 0;
+    p->nbells = 0;
+}
+static void rdes(pmix_ptl_ring_t *p)
+{
+    if (NULL != p->shmem) {
+        if (p->unlinked) {
+            /* don't let the shmem destructor unlink a path
+             * that may since have been reused */
+            p->shmem->backing_path[0] = '\0';
+        }
+        PMIX_RELEASE(p->shmem);
+    }
+    pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                        "ptl:base:ring released after %lu doorbells", (unsigned long) p->nbells);
+}
+PMIX_CLASS_INSTANCE(pmix_ptl_ring_t, pmix_object_t, rcon, rdes);
+
+static void ring_unlink(pmix_ptl_ring_t *ring)
+{
+    if (!ring->unlinked) {
+        (void) pmix_shmem_segment_unlink(ring->shmem);
+        ring->unlinked = true;
+    }
+}
+
+static void ring_bell(pmix_ptl_ring_t *ring)
+{
+    char bell = 1;
+    ssize_t rc;
+
+    if (NULL == ring->peer || ring->peer->sd < 0) {
+        return;
+    }
+    do {
+        rc = write(ring->peer->sd, &bell, 1);
+    } while (rc < 0 && EINTR == pmix_socket_errno);
+    /* if the socket is full, then the peer has doorbells it
+     * has yet to read - those will wake it just as well. Any
+     * other error will be seen by the recv side */
+    if (1 == rc) {
+        ring->nbells++;
+    }
+}
+
+/* point the local view of the rings at the segment - the
+ * client produces on c2s and consumes on s2c */
+static void ring_map(pmix_ptl_ring_t *ring, bool server)
+{
+    pmix_ptl_ring_hdr_t *hdr = (pmix_ptl_ring_hdr_t *) ring->shmem->base_address;
+    char *data = (char *) ring->shmem->base_address + sizeof(pmix_ptl_ring_hdr_t);
+
+    ring->mask = hdr->size - 1;
+    if (server) {
+        ring->in = &hdr->c2s;
+        ring->indata = data;
+        ring->out = &hdr->s2c;
+        ring->outdata = data + hdr->size;
+    } else {
+        ring->in = &hdr->s2c;
+        ring->indata = data + hdr->size;
+        ring->out = &hdr->c2s;
+        ring->outdata = data;
+    }
+}
+
+bool pmix_ptl_base_ring_wanted(void)
+{
+    /* our server advertises in our environment that it
+     * is able to provide the rings */
+    return (NULL != getenv("PMIX_PTL_RING_SIZE"));
+}
+
+/* Called by the server during the connection handshake of a client
+ * that asked for the rings. The socket is still in blocking mode. We
+ * always reply so the client isn't left waiting - a non-success status
+ * tells it to continue over the socket alone */
+pmix_status_t pmix_ptl_base_ring_offer(pmix_peer_t *peer)
+{
+    pmix_ptl_ring_t *ring = NULL;
+    pmix_ptl_ring_hdr_t *hdr;
+    pmix_status_t rc, reply;
+    uintptr_t base;
+    uint64_t size = 0;
+    uint32_t u32, len = 0;
+    char *path = NULL;
+
+    if (0 == pmix_ptl_base.ring_size || NULL == pmix_ptl_base.session_tmpdir) {
+        reply = PMIX_ERR_NOT_SUPPORTED;
+        goto respond;
+    }
+    size = PMIX_PTL_RING_MIN_SIZE;
+    while (size < pmix_ptl_base.ring_size && size < UINT32_MAX / 2) {
+        size <<= 1;
+    }
+    if (0 > pmix_asprintf(&path, "%s/pmix.ring.%lu.%d", pmix_ptl_base.session_tmpdir,
+                          (unsigned long) getpid(), peer->index)) {
+        reply = PMIX_ERR_NOMEM;
+        goto respond;
+    }
+    len = strlen(path) + 1;
+    if (PMIX_PATH_MAX < len) {
+        reply = PMIX_ERR_BAD_PARAM;
+        goto respond;
+    }
+
+    ring = PMIX_NEW(pmix_ptl_ring_t);
+    ring->shmem = PMIX_NEW(pmix_shmem_t);
+    reply = pmix_shmem_segment_create(ring->shmem, sizeof(pmix_ptl_ring_hdr_t) + 2 * size, path);
+    if (PMIX_SUCCESS != reply) {
+        goto respond;
+    }
+    reply = pmix_shmem_segment_attach(ring->shmem, NULL, &base);
+    if (PMIX_SUCCESS != reply) {
+        goto respond;
+    }
+    hdr = (pmix_ptl_ring_hdr_t *) ring->shmem->base_address;
+    memset(hdr, 0, sizeof(pmix_ptl_ring_hdr_t));
+    hdr->magic = PMIX_PTL_RING_MAGIC;
+    hdr->version = PMIX_PTL_RING_VERSION;
+    hdr->size = size;
+    /* neither side is draining yet, so both want a doorbell */
+    hdr->c2s.sleeping = 1;
+    hdr->s2c.sleeping = 1;
+    ring_map(ring, true);
+    ring->peer = peer;
+
+respond:
+    u32 = htonl(reply);
+    rc = pmix_ptl_base_send_blocking(peer->sd, (char *) &u32, sizeof(uint32_t));
+    if (PMIX_SUCCESS == rc && PMIX_SUCCESS == reply) {
+        u32 = htonl((uint32_t) size);
+        rc = pmix_ptl_base_send_blocking(peer->sd, (char *) &u32, sizeof(uint32_t));
+        if (PMIX_SUCCESS == rc) {
+            u32 = htonl(len);
+            rc = pmix_ptl_base_send_blocking(peer->sd, (char *) &u32, sizeof(uint32_t));
+        }
+        if (PMIX_SUCCESS == rc) {
+            rc = pmix_ptl_base_send_blocking(peer->sd, path, len);
+        }
+        if (PMIX_SUCCESS == rc) {
+            /* find out if they were able to attach */
+            rc = pmix_ptl_base_recv_blocking(peer->sd, (char *) &u32, sizeof(uint32_t));
+            reply = ntohl(u32);
+        }
+    }
+    if (NULL != ring) {
+        /* the client is either attached or never will be */
+        if (NULL != ring->shmem && '\0' != ring->shmem->backing_path[0]) {
+            ring_unlink(ring);
+        }
+        if (PMIX_SUCCESS == rc && PMIX_SUCCESS == reply) {
+            peer->ring = ring;
+        } else {
+            PMIX_RELEASE(ring);
+        }
+    }
+    if (NULL != path) {
+        free(path);
+    }
+    pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                        "ptl:base:ring offer to client %s:%u: %s",
+                        peer->info->pname.nspace, peer->info->pname.rank,
+                        (NULL == peer->ring) ? "declined" : "accepted");
+    return rc;
+}
+
+/* Called by a client that asked for the rings once it has received
+ * its index from the server. Failure to attach is not fatal - we just
+ * tell the server and keep using the socket */
+pmix_status_t pmix_ptl_base_ring_accept(pmix_peer_t *peer)
+{
+    pmix_ptl_ring_t *ring;
+    pmix_ptl_ring_hdr_t *hdr;
+    pmix_status_t rc, reply;
+    uintptr_t base;
+    uint32_t u32, size, len;
+    char path[PMIX_PATH_MAX];
+
+    PMIX_PTL_RECV_U32(peer->sd, reply);
+    if (PMIX_SUCCESS != reply) {
+        pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                            "ptl:base:ring server declined: %s", PMIx_Error_string(reply));
+        return PMIX_SUCCESS;
+    }
+    PMIX_PTL_RECV_U32(peer->sd, size);
+    PMIX_PTL_RECV_U32(peer->sd, len);
+    if (0 == len || PMIX_PATH_MAX < len) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+    rc = pmix_ptl_base_recv_blocking(peer->sd, path, len);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    path[len - 1] = '\0';
+
+    ring = PMIX_NEW(pmix_ptl_ring_t);
+    ring->shmem = PMIX_NEW(pmix_shmem_t);
+    /* the server owns the backing file */
+    ring->unlinked = true;
+    ring->shmem->size = sizeof(pmix_ptl_ring_hdr_t) + 2 * (size_t) size;
+    pmix_string_copy(ring->shmem->backing_path, path, PMIX_PATH_MAX);
+    reply = pmix_shmem_segment_attach(ring->shmem, NULL, &base);
+    if (PMIX_SUCCESS == reply) {
+        hdr = (pmix_ptl_ring_hdr_t *) ring->shmem->base_address;
+        if (PMIX_PTL_RING_MAGIC != hdr->magic || PMIX_PTL_RING_VERSION != hdr->version
+            || size != hdr->size || 0 != (size & (size - 1))) {
+            reply = PMIX_ERR_NOT_SUPPORTED;
+        }
+    }
+
+    u32 = htonl(reply);
+    rc = pmix_ptl_base_send_blocking(peer->sd, (char *) &u32, sizeof(uint32_t));
+    if (PMIX_SUCCESS != rc || PMIX_SUCCESS != reply) {
+        PMIX_RELEASE(ring);
+        return rc;
+    }
+    ring_map(ring, false);
+    ring->peer = peer;
+    peer->ring = ring;
+    pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                        "ptl:base:ring attached %lu byte rings at %s",
+                        (unsigned long) size, path);
+    return PMIX_SUCCESS;
+}
+
+/* copy as much of the iovec array into our outbound ring as will
+ * fit, with the semantics of writev on a non-blocking socket */
+ssize_t pmix_ptl_base_ring_writev(pmix_ptl_ring_t *ring, const struct iovec *iov, int iovcnt)
+{
+    pmix_ptl_ring_ctl_t *r = ring->out;
+    uint64_t head, tail, space, off;
+    size_t n, chunk, ioff = 0, done = 0;
+    int i = 0;
+
+    tail = r->tail;
+    while (i < iovcnt) {
+        if (ioff == iov[i].iov_len) {
+            ++i;
+            ioff = 0;
+            continue;
+        }
+        head = r->head;
+        /* don't overwrite space the consumer is still reading */
+        pmix_atomic_rmb();
+        space = (ring->mask + 1) - (tail - head);
+        if (0 == space) {
+            /* ask to be woken once room is made - and look once
+             * more in case it was made while we were asking */
+            r->waiting = 1;
+            pmix_atomic_mb();
+            if (head != r->head) {
+                r->waiting = 0;
+                continue;
+            }
+            break;
+        }
+        n = iov[i].iov_len - ioff;
+        if (space < n) {
+            n = space;
+        }
+        off = tail & ring->mask;
+        chunk = ring->mask + 1 - off;
+        if (n < chunk) {
+            chunk = n;
+        }
+        memcpy(ring->outdata + off, (char *) iov[i].iov_base + ioff, chunk);
+        if (chunk < n) {
+            memcpy(ring->outdata, (char *) iov[i].iov_base + ioff + chunk, n - chunk);
+        }
+        tail += n;
+        ioff += n;
+        done += n;
+    }
+
+    if (0 == done) {
+        if (i < iovcnt) {
+            errno = EAGAIN;
+            return -1;
+        }
+        return 0;
+    }
+    /* publish the data, then wake the consumer if it went idle */
+    pmix_atomic_wmb();
+    r->tail = tail;
+    pmix_atomic_mb();
+    if (r->sleeping) {
+        r->sleeping = 0;
+        ring_bell(ring);
+    }
+    return done;
+}
+
+/* copy up to size bytes out of our inbound ring, returning
+ * the number of bytes copied */
+size_t pmix_ptl_base_ring_read(pmix_ptl_ring_t *ring, char *buf, size_t size)
+{
+    pmix_ptl_ring_ctl_t *r = ring->in;
+    uint64_t head, tail, off;
+    size_t n, chunk;
+
+    head = r->head;
+    tail = r->tail;
+    /* don't read the data before seeing the tail that published it */
+    pmix_atomic_rmb();
+    n = tail - head;
+    if (size < n) {
+        n = size;
+    }
+    if (0 == n) {
+        return 0;
+    }
+    off = head & ring->mask;
+    chunk = ring->mask + 1 - off;
+    if (n < chunk) {
+        chunk = n;
+    }
+    memcpy(buf, ring->indata + off, chunk);
+    if (chunk < n) {
+        memcpy(buf + chunk, ring->indata, n - chunk);
+    }
+    /* release the space, then wake the producer if it is waiting for it */
+    pmix_atomic_wmb();
+    r->head = head + n;
+    pmix_atomic_mb();
+    if (r->waiting) {
+        r->waiting = 0;
+        ring_bell(ring);
+    }
+    return n;
+}
+
+bool pmix_ptl_base_ring_pending(pmix_ptl_ring_t *ring)
+{
+    return (ring->in->tail != ring->in->head);
+}
+
+/* returns true if we may go idle - i.e., the producer has been told to
+ * ring the doorbell for anything it writes from here on - or false if
+ * there is more data to read */
+bool pmix_ptl_base_ring_sleep(pmix_ptl_ring_t *ring)
+{
+    if (pmix_ptl_base_ring_pending(ring)) {
+        return false;
+    }
+    ring->in->sleeping = 1;
+    pmix_atomic_mb();
+    if (pmix_ptl_base_ring_pending(ring)) {
+        ring->in->sleeping = 0;
+        return false;
+    }
+    return true;
+}
+
+/* the socket became readable - swallow the doorbells and mark
+ * ourselves as draining so the producer needn't ring again */
+pmix_status_t pmix_ptl_base_ring_clear_bells(pmix_ptl_ring_t *ring)
+{
+    char bells[64];
+    ssize_t rc;
+
+    ring->in->sleeping = 0;
+    while (1) {
+        rc = read(ring->peer->sd, bells, sizeof(bells));
+        if (0 < rc) {
+            continue;
+        }
+        if (0 == rc) {
+            /* the remote peer closed the connection */
+            return PMIX_ERR_UNREACH;
+        }
+        if (EINTR == pmix_socket_errno) {
+            continue;
+        }
+        if (EAGAIN == pmix_socket_errno || EWOULDBLOCK == pmix_socket_errno) {
+            return PMIX_SUCCESS;
+        }
+        pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                            "ptl:base:ring doorbell read failed: %s (%d)",
+                            strerror(pmix_socket_errno), pmix_socket_errno);
+        return PMIX_ERR_UNREACH;
+    }
+}
@@ -23,6 +23,7 @@
 #    include <string.h>
 #endif
 #include <fcntl.h>
+#include <limits.h>
 #ifdef HAVE_UNISTD_H
 #    include <unistd.h>
 #endif
@@ -50,6 +51,13 @@
 
 #include "src/mca/ptl/base/base.h"
 
+/* max number of iovecs gathered into a single writev */
+#if defined(IOV_MAX) && IOV_MAX < 128
+#    define PMIX_PTL_SEND_MAX_IOV IOV_MAX
+#else
+#    define PMIX_PTL_SEND_MAX_IOV 128
+#endif
+
 static void _notify_complete(pmix_status_t status, void *cbdata)
 {
     (void) status;
@@ -158,8 +166,7 @@ static void lost_connection(pmix_peer_t *peer)
                                                        trk->ninfo, NULL, 0,
                                                        trk->modexcbfunc, trk);
                         if (PMIX_SUCCESS != rc) {
-                            pmix_list_remove_item(&pmix_server_globals.collectives,
-                                                  &trk->super);
+                            pmix_server_trk_remove(trk);
                             PMIX_RELEASE(trk);
                         }
                     } else if (PMIX_CONNECTNB_CMD == trk->type) {
@@ -167,8 +174,7 @@ static void lost_connection(pmix_peer_t *peer)
                         rc = pmix_host_server.connect(trk->pcs, trk->npcs, trk->info,
                                                       trk->ninfo, trk->op_cbfunc, trk);
                         if (PMIX_SUCCESS != rc) {
-                            pmix_list_remove_item(&pmix_server_globals.collectives,
-                                                  &trk->super);
+                            pmix_server_trk_remove(trk);
                             PMIX_RELEASE(trk);
                         }
                     } else if (PMIX_DISCONNECTNB_CMD == trk->type) {
@@ -176,8 +182,7 @@ static void lost_connection(pmix_peer_t *peer)
                         rc = pmix_host_server.disconnect(trk->pcs, trk->npcs, trk->info,
                                                          trk->ninfo, trk->op_cbfunc, trk);
                         if (PMIX_SUCCESS != rc) {
-                            pmix_list_remove_item(&pmix_server_globals.collectives,
-                                                  &trk->super);
+                            pmix_server_trk_remove(trk);
                             PMIX_RELEASE(trk);
                         }
                     }
@@ -250,31 +255,107 @@ static void lost_connection(pmix_peer_t *peer)
     }
 }
 
-static pmix_status_t send_msg(int sd, pmix_ptl_send_t *msg)
+/* add the unsent portion of a message to an iovec array,
+ * returning the number of bytes added */
+static size_t add_msg_iov(pmix_ptl_send_t *msg, struct iovec *iov, int *iov_count)
 {
-    struct iovec iov[2];
-    int iov_count;
-    ssize_t remain = msg->sdbytes, rc;
-
-    iov[0].iov_base = msg->sdptr;
-    iov[0].iov_len = msg->sdbytes;
-    if (!msg->hdr_sent && NULL != msg->data) {
-        iov[1].iov_base = msg->data->base_ptr;
-        iov[1].iov_len = ntohl(msg->hdr.nbytes);
-        remain += ntohl(msg->hdr.nbytes);
-        iov_count = 2;
-    } else {
-        iov_count = 1;
+    size_t nbytes = 0;
+
+    if (0 < msg->sdbytes) {
+        iov[*iov_count].iov_base = msg->sdptr;
+        iov[*iov_count].iov_len = msg->sdbytes;
+        ++(*iov_count);
+        nbytes += msg->sdbytes;
     }
-retry:
-    rc = writev(sd, iov, iov_count);
-    if (PMIX_LIKELY(rc == remain)) {
-        /* we successfully sent the header and the msg data if any */
+    if (!msg->hdr_sent && NULL != msg->data && 0 < ntohl(msg->hdr.nbytes)) {
+        iov[*iov_count].iov_base = msg->data->base_ptr;
+        iov[*iov_count].iov_len = ntohl(msg->hdr.nbytes);
+        ++(*iov_count);
+        nbytes += ntohl(msg->hdr.nbytes);
+    }
+    return nbytes;
+}
+
+/* account for nbytes of a message having been written, updating
+ * its resume state. Returns true if the message is complete */
+static bool consume_msg(pmix_ptl_send_t *msg, size_t *nbytes)
+{
+    if (!msg->hdr_sent) {
+        if (*nbytes < msg->sdbytes) {
+            /* partial write of the header */
+            msg->sdptr = (char *) msg->sdptr + *nbytes;
+            msg->sdbytes -= *nbytes;
+            *nbytes = 0;
+            return false;
+        }
+        /* header was fully written - move on to the msg data */
+        *nbytes -= msg->sdbytes;
         msg->hdr_sent = true;
-        msg->sdbytes = 0;
-        msg->sdptr = (char *) iov[iov_count - 1].iov_base + iov[iov_count - 1].iov_len;
-        return PMIX_SUCCESS;
-    } else if (rc < 0) {
+        if (NULL != msg->data) {
+            msg->sdptr = msg->data->base_ptr;
+            msg->sdbytes = ntohl(msg->hdr.nbytes);
+        } else {
+            msg->sdbytes = 0;
+        }
+    }
+    if (*nbytes < msg->sdbytes) {
+        /* partial write of the msg data */
+        msg->sdptr = (char *) msg->sdptr + *nbytes;
+        msg->sdbytes -= *nbytes;
+        *nbytes = 0;
+        return false;
+    }
+    *nbytes -= msg->sdbytes;
+    msg->sdptr = (char *) msg->sdptr + msg->sdbytes;
+    msg->sdbytes = 0;
+    return true;
+}
+
+/* send the on-deck message for this peer. Any messages queued behind
+ * it are gathered into the same writev, up to the iovec limit and the
+ * coalescing byte budget, so that a burst of small messages costs a
+ * single syscall. Completed messages are released and the next one in
+ * the queue is moved on deck. On return, peer->send_msg is either NULL
+ * (everything that was gathered has been sent) or the message that
+ * was only partially written and must be resumed */
+static pmix_status_t send_msg(pmix_peer_t *peer)
+{
+    struct iovec iov[PMIX_PTL_SEND_MAX_IOV];
+    pmix_ptl_send_t *msg, *nxt;
+    int iov_count = 0, nmsgs = 1, ncomplete = 0;
+    size_t total, nbytes;
+    ssize_t rc;
+
+    msg = peer->send_msg;
+    total = add_msg_iov(msg, iov, &iov_count);
+
+    /* gather whatever else is waiting */
+    if (0 < pmix_ptl_base.max_coalesce_bytes) {
+        nxt = (pmix_ptl_send_t *) pmix_list_get_first(&peer->send_queue);
+        while (nxt != (pmix_ptl_send_t *) pmix_list_get_end(&peer->send_queue)) {
+            if (PMIX_PTL_SEND_MAX_IOV < iov_count + 2) {
+                break;
+            }
+            nbytes = sizeof(pmix_ptl_hdr_t);
+            if (NULL != nxt->data) {
+                nbytes += ntohl(nxt->hdr.nbytes);
+            }
+            if (pmix_ptl_base.max_coalesce_bytes < total + nbytes) {
+                break;
+            }
+            total += add_msg_iov(nxt, iov, &iov_count);
+            ++nmsgs;
+            nxt = (pmix_ptl_send_t *) pmix_list_get_next(&nxt->super);
+        }
+    }
+
+retry:
+    if (NULL != peer->ring) {
+        rc = pmix_ptl_base_ring_writev(peer->ring, iov, iov_count);
+    } else {
+        rc = writev(peer->sd, iov, iov_count);
+    }
+    if (rc < 0) {
         if (pmix_socket_errno == EINTR) {
             goto retry;
         } else if (pmix_socket_errno == EAGAIN) {
@@ -292,34 +373,44 @@ retry:
         } else {
             /* we hit an error and cannot progress this message */
             pmix_output(0, "pmix_ptl_base: send_msg: write failed: %s (%d) [sd = %d]",
-                        strerror(pmix_socket_errno), pmix_socket_errno, sd);
+                        strerror(pmix_socket_errno), pmix_socket_errno, peer->sd);
             return PMIX_ERR_UNREACH;
         }
-    } else {
-        /* short writev. This usually means the kernel buffer is full,
-         * so there is no point for retrying at that time.
-         * simply update the msg and return with PMIX_ERR_RESOURCE_BUSY */
-        if ((size_t) rc < msg->sdbytes) {
-            /* partial write of the header or the msg data */
-            msg->sdptr = (char *) msg->sdptr + rc;
-            msg->sdbytes -= rc;
-        } else {
-            /* header was fully written, but only a part of the msg data was written */
-            msg->hdr_sent = true;
-            rc -= msg->sdbytes;
-            if (NULL != msg->data) {
-                /* technically, this should never happen as iov_count
-                 * would be 1 for a zero-byte message, and so we cannot
-                 * have a case where we write the header and part of the
-                 * msg. However, code checkers don't know that and are
-                 * fooled by our earlier check for NULL, and so
-                 * we silence their warnings by using this check */
-                msg->sdptr = (char *) msg->data->base_ptr + rc;
-            }
-            msg->sdbytes = ntohl(msg->hdr.nbytes) - rc;
+    }
+
+    if (0 < rc) {
+        pmix_ptl_base.send_stats.nwrites++;
+        pmix_ptl_base.send_stats.nbytes += rc;
+        if (pmix_ptl_base.send_stats.max_bytes < (size_t) rc) {
+            pmix_ptl_base.send_stats.max_bytes = rc;
+        }
+    }
+
+    /* walk the gathered messages and account for what was written. The
+     * on-deck message is never in the queue - the others are moved out
+     * of it as they are reached */
+    nbytes = rc;
+    while (consume_msg(msg, &nbytes)) {
+        PMIX_RELEASE(msg);
+        ++ncomplete;
+        if (ncomplete == nmsgs) {
+            msg = NULL;
+            break;
         }
+        msg = (pmix_ptl_send_t *) pmix_list_remove_first(&peer->send_queue);
+    }
+    peer->send_msg = msg;
+    pmix_ptl_base.send_stats.nmsgs += ncomplete;
+    if (1 < ncomplete) {
+        pmix_ptl_base.send_stats.nsaved += ncomplete - 1;
+    }
+
+    if (NULL != msg) {
+        /* short writev. This usually means the kernel buffer is full,
+         * so there is no point for retrying at that time */
         return PMIX_ERR_RESOURCE_BUSY;
     }
+    return PMIX_SUCCESS;
 }
 
 static pmix_status_t read_bytes(int sd, char **buf, size_t *remain)
@@ -373,6 +464,70 @@ exit:
     return ret;
 }
 
+/* read the next *remain bytes from the peer. If we share rings with
+ * the peer, the bytes come from there instead of the socket. Anything
+ * left in the
+ * peer's staging buffer by an earlier read is consumed first. When
+ * only a small number of bytes are needed, we speculatively read as
+ * much as the staging buffer holds - this brings in the header and
+ * body of a small message (and possibly the start of the next one)
+ * with a single syscall. Large reads go directly to the destination */
+static pmix_status_t recv_bytes(pmix_peer_t *peer, char **buf, size_t *remain)
+{
+    size_t n;
+    ssize_t rc;
+
+    if (NULL != peer->ring) {
+        n = pmix_ptl_base_ring_read(peer->ring, *buf, *remain);
+        *buf += n;
+        *remain -= n;
+        return (0 == *remain) ? PMIX_SUCCESS : PMIX_ERR_RESOURCE_BUSY;
+    }
+
+    while (0 < *remain) {
+        if (peer->rstage_off < peer->rstage_len) {
+            n = peer->rstage_len - peer->rstage_off;
+            if (*remain < n) {
+                n = *remain;
+            }
+            memcpy(*buf, peer->rstage + peer->rstage_off, n);
+            peer->rstage_off += n;
+            *buf += n;
+            *remain -= n;
+            continue;
+        }
+        if (PMIX_PTL_RECV_STAGE_SIZE <= *remain) {
+            return read_bytes(peer->sd, buf, remain);
+        }
+        if (NULL == peer->rstage) {
+            peer->rstage = (char *) malloc(PMIX_PTL_RECV_STAGE_SIZE);
+            if (NULL == peer->rstage) {
+                return read_bytes(peer->sd, buf, remain);
+            }
+        }
+        rc = read(peer->sd, peer->rstage, PMIX_PTL_RECV_STAGE_SIZE);
+        if (rc < 0) {
+            if (pmix_socket_errno == EINTR) {
+                continue;
+            } else if (pmix_socket_errno == EAGAIN) {
+                return PMIX_ERR_RESOURCE_BUSY;
+            } else if (pmix_socket_errno == EWOULDBLOCK) {
+                return PMIX_ERR_WOULD_BLOCK;
+            }
+            pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                                "pmix_ptl_base_msg_recv: read failed: %s (%d)",
+                                strerror(pmix_socket_errno), pmix_socket_errno);
+            return PMIX_ERR_UNREACH;
+        } else if (0 == rc) {
+            /* the remote peer closed the connection */
+            return PMIX_ERR_UNREACH;
+        }
+        peer->rstage_off = 0;
+        peer->rstage_len = rc;
+    }
+    return PMIX_SUCCESS;
+}
+
 /*
  * A file descriptor is available/ready for send. Check the state
  * of the socket and take the appropriate action.
@@ -397,16 +552,21 @@ void pmix_ptl_base_send_handler(int sd, short flags, void *cbdata)
         pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                             "ptl:base:send_handler SENDING MSG TO %s TAG %u",
                             PMIX_PNAME_PRINT(&peer->info->pname), ntohl(msg->hdr.tag));
-        if (PMIX_SUCCESS == (rc = send_msg(peer->sd, msg))) {
-            // message is complete
+        if (PMIX_SUCCESS == (rc = send_msg(peer))) {
+            // the message - and any that were sent along with it - is complete
             pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                                 "ptl:base:send_handler MSG SENT");
-            PMIX_RELEASE(msg);
-            peer->send_msg = NULL;
         } else if (PMIX_ERR_RESOURCE_BUSY == rc || PMIX_ERR_WOULD_BLOCK == rc) {
             /* exit this event and let the event lib progress */
             pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                                 "ptl:base:send_handler RES BUSY OR WOULD BLOCK");
+            if (NULL != peer->ring && peer->send_ev_active) {
+                /* the ring is full - the socket will stay writable, so
+                 * wait for the peer to ring the doorbell once it has
+                 * made room instead */
+                pmix_event_del(&peer->send_event);
+                peer->send_ev_active = false;
+            }
             /* ensure we post the modified peer object before another thread
              * picks it back up */
             PMIX_POST_OBJECT(peer);
@@ -417,7 +577,7 @@ void pmix_ptl_base_send_handler(int sd, short flags, void *cbdata)
             // report the error
             pmix_event_del(&peer->send_event);
             peer->send_ev_active = false;
-            PMIX_RELEASE(msg);
+            PMIX_RELEASE(peer->send_msg);
             peer->send_msg = NULL;
             lost_connection(peer);
             /* ensure we post the modified peer object before another thread
@@ -455,9 +615,6 @@ void pmix_ptl_base_recv_handler(int sd, short flags, void *cbdata)
     pmix_status_t rc;
     pmix_peer_t *peer = (pmix_peer_t *) cbdata;
     pmix_ptl_recv_t *msg = NULL;
-    pmix_ptl_hdr_t hdr;
-    size_t nbytes;
-    char *ptr;
     PMIX_HIDE_UNUSED_PARAMS(flags);
 
     /* acquire the object */
@@ -472,109 +629,131 @@ void pmix_ptl_base_recv_handler(int sd, short flags, void *cbdata)
     if (NULL == peer) {
         return;
     }
-    /* allocate a new message and setup for recv */
-    if (NULL == peer->recv_msg) {
-        pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
-                            "ptl:base:recv:handler allocate new recv msg");
-        peer->recv_msg = PMIX_NEW(pmix_ptl_recv_t);
-        if (NULL == peer->recv_msg) {
-            pmix_output(0, "sptl:base:recv_handler: unable to allocate recv message\n");
+
+    if (NULL != peer->ring) {
+        /* the socket only carries doorbells - the peer either wrote
+         * to our inbound ring or made room in our outbound one */
+        if (PMIX_SUCCESS != pmix_ptl_base_ring_clear_bells(peer->ring)) {
             goto err_close;
         }
-        PMIX_RETAIN(peer);
-        peer->recv_msg->peer = peer; // provide a handle back to the peer object
-        /* start by reading the header */
-        peer->recv_msg->rdptr = (char *) &peer->recv_msg->hdr;
-        peer->recv_msg->rdbytes = sizeof(pmix_ptl_hdr_t);
-    }
-    msg = peer->recv_msg;
-    msg->sd = sd;
-    /* if the header hasn't been completely read, read it */
-    if (!msg->hdr_recvd) {
-        pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
-                            "ptl:base:recv:handler read hdr on socket %d", peer->sd);
-        nbytes = sizeof(pmix_ptl_hdr_t);
-        ptr = (char *) &hdr;
-        if (PMIX_SUCCESS == (rc = read_bytes(peer->sd, &ptr, &nbytes))) {
-            /* completed reading the header */
-            peer->recv_msg->hdr_recvd = true;
-            /* convert the hdr to host format */
-            peer->recv_msg->hdr.pindex = ntohl(hdr.pindex);
-            peer->recv_msg->hdr.tag = ntohl(hdr.tag);
-            peer->recv_msg->hdr.nbytes = ntohl(hdr.nbytes);
+        if (NULL != peer->send_msg && !peer->send_ev_active) {
+            peer->send_ev_active = true;
+            PMIX_POST_OBJECT(peer);
+            pmix_event_add(&peer->send_event, 0);
+        }
+    }
+
+    /* a speculative read may have brought in more than one message,
+     * and the socket won't signal us again for data we have already
+     * read - so keep going until the staging buffer is drained. Likewise,
+     * the peer won't ring again until we have gone idle on the ring */
+    do {
+        /* allocate a new message and setup for recv */
+        if (NULL == peer->recv_msg) {
+            pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                                "ptl:base:recv:handler allocate new recv msg");
+            peer->recv_msg = PMIX_NEW(pmix_ptl_recv_t);
+            if (NULL == peer->recv_msg) {
+                pmix_output(0, "sptl:base:recv_handler: unable to allocate recv message\n");
+                goto err_close;
+            }
+            PMIX_RETAIN(peer);
+            peer->recv_msg->peer = peer; // provide a handle back to the peer object
+            /* start by reading the header */
+            peer->recv_msg->rdptr = (char *) &peer->recv_msg->hdr;
+            peer->recv_msg->rdbytes = sizeof(pmix_ptl_hdr_t);
+        }
+        msg = peer->recv_msg;
+        msg->sd = sd;
+        /* if the header hasn't been completely read, read it */
+        if (!msg->hdr_recvd) {
             pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
-                                "%s RECVD MSG FROM %s FOR TAG %d SIZE %d",
-                                PMIX_NAME_PRINT(&pmix_globals.myid),
-                                PMIX_PNAME_PRINT(&peer->info->pname), (int) peer->recv_msg->hdr.tag,
-                                (int) peer->recv_msg->hdr.nbytes);
-            /* if this is a zero-byte message, then we are done */
-            if (0 == peer->recv_msg->hdr.nbytes) {
+                                "ptl:base:recv:handler read hdr on socket %d", peer->sd);
+            if (PMIX_SUCCESS == (rc = recv_bytes(peer, &msg->rdptr, &msg->rdbytes))) {
+                /* completed reading the header */
+                msg->hdr_recvd = true;
+                /* convert the hdr to host format */
+                msg->hdr.pindex = ntohl(msg->hdr.pindex);
+                msg->hdr.tag = ntohl(msg->hdr.tag);
+                msg->hdr.nbytes = ntohl(msg->hdr.nbytes);
                 pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
-                                    "%s RECVD ZERO-BYTE MESSAGE FROM %s for tag %d",
+                                    "%s RECVD MSG FROM %s FOR TAG %d SIZE %d",
                                     PMIX_NAME_PRINT(&pmix_globals.myid),
-                                    PMIX_PNAME_PRINT(&peer->info->pname), peer->recv_msg->hdr.tag);
-                peer->recv_msg->data = NULL; // make sure
-                peer->recv_msg->rdptr = NULL;
-                peer->recv_msg->rdbytes = 0;
-                /* post it for delivery */
-                PMIX_ACTIVATE_POST_MSG(peer->recv_msg);
-                peer->recv_msg = NULL;
-                PMIX_POST_OBJECT(peer);
-                return;
-            } else {
+                                    PMIX_PNAME_PRINT(&peer->info->pname), (int) msg->hdr.tag,
+                                    (int) msg->hdr.nbytes);
+                /* if this is a zero-byte message, then we are done */
+                if (0 == msg->hdr.nbytes) {
+                    pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                                        "%s RECVD ZERO-BYTE MESSAGE FROM %s for tag %d",
+                                        PMIX_NAME_PRINT(&pmix_globals.myid),
+                                        PMIX_PNAME_PRINT(&peer->info->pname), msg->hdr.tag);
+                    msg->data = NULL; // make sure
+                    msg->rdptr = NULL;
+                    msg->rdbytes = 0;
+                    /* post it for delivery */
+                    PMIX_ACTIVATE_POST_MSG(msg);
+                    peer->recv_msg = NULL;
+                    continue;
+                }
                 pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                                     "ptl:base:recv:handler allocate data region of size %lu",
-                                    (unsigned long) peer->recv_msg->hdr.nbytes);
+                                    (unsigned long) msg->hdr.nbytes);
                 /* allocate the data region */
                 if (0 < pmix_ptl_base.max_msg_size &&
-                    pmix_ptl_base.max_msg_size < peer->recv_msg->hdr.nbytes) {
+                    pmix_ptl_base.max_msg_size < msg->hdr.nbytes) {
                     pmix_show_help("help-pmix-runtime.txt", "ptl:msg_size", true,
-                                   (unsigned long) peer->recv_msg->hdr.nbytes,
+                                   (unsigned long) msg->hdr.nbytes,
                                    (unsigned long) pmix_ptl_base.max_msg_size);
                     goto err_close;
                 }
-                peer->recv_msg->data = (char *) malloc(peer->recv_msg->hdr.nbytes);
-                memset(peer->recv_msg->data, 0, peer->recv_msg->hdr.nbytes);
+                msg->data = pmix_ptl_base_rbuf_get(msg->hdr.nbytes);
+                if (NULL == msg->data) {
+                    pmix_output(0, "sptl:base:recv_handler: unable to allocate recv data\n");
+                    goto err_close;
+                }
                 /* point to it */
-                peer->recv_msg->rdptr = peer->recv_msg->data;
-                peer->recv_msg->rdbytes = peer->recv_msg->hdr.nbytes;
+                msg->rdptr = msg->data;
+                msg->rdbytes = msg->hdr.nbytes;
+                /* fall thru and attempt to read the data */
+            } else if (PMIX_ERR_RESOURCE_BUSY == rc || PMIX_ERR_WOULD_BLOCK == rc) {
+                if (NULL != peer->ring && !pmix_ptl_base_ring_sleep(peer->ring)) {
+                    /* more arrived while we were going idle */
+                    continue;
+                }
+                /* exit this event and let the event lib progress */
+                PMIX_POST_OBJECT(peer);
+                return;
+            } else {
+                /* the remote peer closed the connection - report that condition
+                 * and let the caller know
+                 */
+                pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                                    "%s ptl:base:msg_recv: peer %s closed connection",
+                                    PMIX_NAME_PRINT(&pmix_globals.myid),
+                                    PMIX_PNAME_PRINT(&peer->info->pname));
+                goto err_close;
             }
-            /* fall thru and attempt to read the data */
-        } else if (PMIX_ERR_RESOURCE_BUSY == rc || PMIX_ERR_WOULD_BLOCK == rc) {
-            /* exit this event and let the event lib progress */
-            return;
-        } else {
-            /* the remote peer closed the connection - report that condition
-             * and let the caller know
-             */
-            pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
-                                "%s ptl:base:msg_recv: peer %s closed connection",
-                                PMIX_NAME_PRINT(&pmix_globals.myid),
-                                PMIX_PNAME_PRINT(&peer->info->pname));
-            goto err_close;
         }
-    }
 
-    if (peer->recv_msg->hdr_recvd) {
         /* continue to read the data block - we start from
          * wherever we left off, which could be at the
          * beginning or somewhere in the message
          */
-        if (PMIX_SUCCESS == (rc = read_bytes(peer->sd, &msg->rdptr, &msg->rdbytes))) {
+        if (PMIX_SUCCESS == (rc = recv_bytes(peer, &msg->rdptr, &msg->rdbytes))) {
             /* we recvd all of the message */
             pmix_output_verbose(
                 2, pmix_ptl_base_framework.framework_output,
                 "%s:%d RECVD COMPLETE MESSAGE FROM SERVER OF %d BYTES FOR TAG %d ON PEER SOCKET %d",
-                pmix_globals.myid.nspace, pmix_globals.myid.rank, (int) peer->recv_msg->hdr.nbytes,
-                peer->recv_msg->hdr.tag, peer->sd);
+                pmix_globals.myid.nspace, pmix_globals.myid.rank, (int) msg->hdr.nbytes,
+                msg->hdr.tag, peer->sd);
             /* post it for delivery */
-            PMIX_ACTIVATE_POST_MSG(peer->recv_msg);
+            PMIX_ACTIVATE_POST_MSG(msg);
             peer->recv_msg = NULL;
-            /* ensure we post the modified peer object before another thread
-             * picks it back up */
-            PMIX_POST_OBJECT(peer);
-            return;
         } else if (PMIX_ERR_RESOURCE_BUSY == rc || PMIX_ERR_WOULD_BLOCK == rc) {
+            if (NULL != peer->ring && !pmix_ptl_base_ring_sleep(peer->ring)) {
+                /* more arrived while we were going idle */
+                continue;
+            }
             /* exit this event and let the event lib progress */
             /* ensure we post the modified peer object before another thread
              * picks it back up */
@@ -590,8 +769,12 @@ void pmix_ptl_base_recv_handler(int sd, short flags, void *cbdata)
                                 peer->nptr->nspace, peer->info->pname.rank);
             goto err_close;
         }
-    }
-    /* success */
+    } while (peer->rstage_off < peer->rstage_len
+             || (NULL != peer->ring && !pmix_ptl_base_ring_sleep(peer->ring)));
+
+    /* ensure we post the modified peer object before another thread
+     * picks it back up */
+    PMIX_POST_OBJECT(peer);
     return;
 
 err_close:
@@ -608,17 +791,45 @@ err_close:
         PMIX_RELEASE(peer->recv_msg);
         peer->recv_msg = NULL;
     }
+    /* anything left in the staging buffer is now meaningless */
+    peer->rstage_off = 0;
+    peer->rstage_len = 0;
     lost_connection(peer);
     /* ensure we post the modified peer object before another thread
      * picks it back up */
     PMIX_POST_OBJECT(peer);
 }
 
+/* push a message sent to ourselves straight to the matching code.
+ * The receive side hands the data back to the recv buffer pool, so
+ * it has to be copied into a block from the pool - the buffer's own
+ * storage was sized by the buffer and not by the pool */
+static void send_to_self(pmix_peer_t *peer, pmix_ptl_tag_t tag, pmix_buffer_t *buf)
+{
+    pmix_ptl_recv_t *msg;
+
+    msg = PMIX_NEW(pmix_ptl_recv_t);
+    PMIX_RETAIN(peer);
+    msg->peer = peer;
+    msg->hdr.pindex = pmix_globals.pindex;
+    msg->hdr.tag = tag;
+    if (NULL != buf && 0 < buf->bytes_used) {
+        msg->data = pmix_ptl_base_rbuf_get(buf->bytes_used);
+        if (NULL == msg->data) {
+            pmix_output(0, "ptl:base:send: unable to allocate data for a send to self\n");
+            PMIX_RELEASE(msg);
+            return;
+        }
+        memcpy(msg->data, buf->base_ptr, buf->bytes_used);
+        msg->hdr.nbytes = buf->bytes_used;
+    }
+    PMIX_ACTIVATE_POST_MSG(msg);
+}
+
 void pmix_ptl_base_send(int sd, short args, void *cbdata)
 {
     pmix_ptl_queue_t *queue = (pmix_ptl_queue_t *) cbdata;
     pmix_ptl_send_t *snd;
-    pmix_ptl_recv_t *msg;
     PMIX_HIDE_UNUSED_PARAMS(sd, args);
 
     /* acquire the object */
@@ -646,20 +857,8 @@ void pmix_ptl_base_send(int sd, short args, void *cbdata)
 
     /* is this a send to myself? */
     if (queue->peer == pmix_globals.mypeer) {
-        /* just push it to the matching code */
-        msg = PMIX_NEW(pmix_ptl_recv_t);
-        PMIX_RETAIN(queue->peer);
-        msg->peer = queue->peer;
-        msg->hdr.pindex = pmix_globals.pindex;
-        msg->hdr.tag = queue->tag;
-        if (NULL != queue->buf) {
-            msg->hdr.nbytes = (queue->buf)->bytes_used;
-            msg->data = (queue->buf)->base_ptr;
-            (queue->buf)->base_ptr = NULL;
-            (queue->buf)->bytes_used = 0;
-            PMIX_RELEASE(queue->buf);
-        }
-        PMIX_ACTIVATE_POST_MSG(msg);
+        send_to_self(queue->peer, queue->tag, queue->buf);
+        PMIX_RELEASE(queue->buf);
         PMIX_RELEASE(queue);
         return;
     }
@@ -707,7 +906,6 @@ void pmix_ptl_base_send_recv(int fd, short args, void *cbdata)
     pmix_ptl_posted_recv_t *req;
     pmix_ptl_send_t *snd;
     uint32_t tag;
-    pmix_ptl_recv_t *msg;
     PMIX_HIDE_UNUSED_PARAMS(fd, args);
 
     /* acquire the object */
@@ -757,17 +955,8 @@ void pmix_ptl_base_send_recv(int fd, short args, void *cbdata)
 
     /* is this a send to myself? */
     if (ms->peer == pmix_globals.mypeer) {
-        /* just push it to the matching code */
-        msg = PMIX_NEW(pmix_ptl_recv_t);
-        PMIX_RETAIN(ms->peer);
-        msg->peer = ms->peer;
-        msg->hdr.pindex = pmix_globals.pindex;
-        msg->hdr.tag = tag;
-        msg->hdr.nbytes = ms->bfr->bytes_used;
-        msg->data = ms->bfr->base_ptr;
-        ms->bfr->base_ptr = NULL;
-        ms->bfr->bytes_used = 0;
-        PMIX_ACTIVATE_POST_MSG(msg);
+        send_to_self(ms->peer, tag, ms->bfr);
+        PMIX_RELEASE(ms->bfr);
         PMIX_RELEASE(ms);
         return;
     }
@@ -805,6 +994,8 @@ void pmix_ptl_base_process_msg(int fd, short flags, void *cbdata)
     pmix_ptl_recv_t *msg = (pmix_ptl_recv_t *) cbdata;
     pmix_ptl_posted_recv_t *rcv;
     pmix_buffer_t buf;
+    char *data;
+    size_t nbytes;
     PMIX_HIDE_UNUSED_PARAMS(fd, flags);
 
     /* acquire the object */
@@ -824,6 +1015,8 @@ void pmix_ptl_base_process_msg(int fd, short flags, void *cbdata)
             if (NULL != rcv->cbfunc) {
                 /* construct and load the buffer */
                 PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+                data = msg->data;
+                nbytes = msg->hdr.nbytes;
                 if (NULL != msg->data) {
                     PMIX_LOAD_BUFFER(msg->peer, &buf, msg->data, msg->hdr.nbytes);
                 } else {
@@ -840,7 +1033,12 @@ void pmix_ptl_base_process_msg(int fd, short flags, void *cbdata)
                 pmix_output_verbose(5, pmix_ptl_base_framework.framework_output,
                                     "%s:%d CALLBACK COMPLETE", pmix_globals.myid.nspace,
                                     pmix_globals.myid.rank);
-                PMIX_DESTRUCT(&buf); // free's the msg data
+                /* recycle the msg data unless the callback took it */
+                if (NULL != data && buf.base_ptr == data) {
+                    pmix_ptl_base_rbuf_put(data, nbytes);
+                    buf.base_ptr = NULL;
+                }
+                PMIX_DESTRUCT(&buf);
             }
             /* done with the recv if it is a dynamic tag */
             if (PMIX_PTL_TAG_DYNAMIC <= rcv->tag && UINT_MAX != rcv->tag) {
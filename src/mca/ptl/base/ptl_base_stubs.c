@@ -104,6 +104,7 @@ void pmix_ptl_base_post_recv(int fd, short args, void *cbdata)
     pmix_ptl_posted_recv_t *req = (pmix_ptl_posted_recv_t *) cbdata;
     pmix_ptl_recv_t *msg, *nmsg;
     pmix_buffer_t buf;
+    char *data;
 
     pmix_output_verbose(5, pmix_ptl_base_framework.framework_output, "posting recv on tag %d",
                         req->tag);
@@ -124,9 +125,15 @@ void pmix_ptl_base_post_recv(int fd, short args, void *cbdata)
                     buf.unpack_ptr = buf.base_ptr;
                     buf.pack_ptr = ((char *) buf.base_ptr) + buf.bytes_used;
                 }
+                data = msg->data;
                 msg->data = NULL; // protect the data region
                 req->cbfunc(msg->peer, &msg->hdr, &buf, req->cbdata);
-                PMIX_DESTRUCT(&buf); // free's the msg data
+                /* recycle the msg data unless the callback took it */
+                if (NULL != data && buf.base_ptr == data) {
+                    pmix_ptl_base_rbuf_put(data, msg->hdr.nbytes);
+                    buf.base_ptr = NULL;
+                }
+                PMIX_DESTRUCT(&buf);
             }
             pmix_list_remove_item(&pmix_ptl_base.unexpected_msgs, &msg->super);
             PMIX_RELEASE(msg);
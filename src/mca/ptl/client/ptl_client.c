@@ -86,6 +86,8 @@ static pmix_status_t connect_to_peer(struct pmix_peer_t *pr, pmix_info_t *info,
     pmix_data_array_t darray;
     pmix_list_t connections;
     pmix_connection_t *cn;
+    pmix_info_t rinfo;
+    bool ring;
 
     pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                         "ptl:tcp: connecting to server");
@@ -203,7 +205,15 @@ static pmix_status_t connect_to_peer(struct pmix_peer_t *pr, pmix_info_t *info,
     pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                         "ptl:tcp:client attempt connect to %s:%u at %s", nspace, rank, suri);
 
-    rc = pmix_ptl_base_make_connection(peer, suri, NULL, 0);
+    /* ask for shared-memory rings if our server can provide them */
+    ring = pmix_ptl_base_ring_wanted();
+    if (ring) {
+        PMIX_INFO_LOAD(&rinfo, PMIX_PTL_RING_REQUEST, &ring, PMIX_BOOL);
+        rc = pmix_ptl_base_make_connection(peer, suri, &rinfo, 1);
+        PMIX_INFO_DESTRUCT(&rinfo);
+    } else {
+        rc = pmix_ptl_base_make_connection(peer, suri, NULL, 0);
+    }
     if (PMIX_SUCCESS != rc) {
         free(nspace);
         free(suri);
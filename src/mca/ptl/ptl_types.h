@@ -200,6 +200,7 @@ typedef uint32_t pmix_ptl_tag_t;
 #define PMIX_PTL_TAG_NOTIFY    0
 #define PMIX_PTL_TAG_HEARTBEAT 1
 #define PMIX_PTL_TAG_IOF       2
+#define PMIX_PTL_TAG_PREFETCH  3
 
 /* define the start of dynamic tags that are
  * assigned for send/recv operations */
@@ -60,7 +60,7 @@ extern bool pmix_init_called;
 void pmix_rte_finalize(void)
 {
     int i;
-    pmix_notify_caddy_t *cd;
+    pmix_notify_caddy_t *cd, *nxt;
     pmix_iof_req_t *req;
     pmix_regattr_input_t *p;
 
@@ -68,6 +68,16 @@ void pmix_rte_finalize(void)
         return;
     }
 
+    if (0 < pmix_globals.notify_cache.stats.ncached) {
+        pmix_notify_cache_stats_t *st = &pmix_globals.notify_cache.stats;
+        pmix_output_verbose(1, pmix_globals.debug_output,
+                            "notification cache stats: %lu cached %lu evicted %lu expired "
+                            "- %lu of %lu lookups hit (%lu replayed)",
+                            (unsigned long) st->ncached, (unsigned long) st->nevicted,
+                            (unsigned long) st->nexpired, (unsigned long) st->nhits,
+                            (unsigned long) st->nlookups, (unsigned long) st->nreplayed);
+    }
+
     /* release the attribute support trackers */
     pmix_release_registered_attrs();
 
@@ -122,12 +132,11 @@ void pmix_rte_finalize(void)
     PMIX_DESTRUCT(&pmix_globals.events);
     PMIX_LIST_DESTRUCT(&pmix_globals.cached_events);
     /* clear any notifications */
-    for (i = 0; i < pmix_globals.max_events; i++) {
-        pmix_hotel_checkout_and_return_occupant(&pmix_globals.notifications, i, (void **) &cd);
-        if (NULL != cd) {
-            PMIX_RELEASE(cd);
-        }
+    PMIX_NOTIFY_CACHE_FOREACH (cd, nxt) {
+        pmix_notify_event_uncache(cd);
+        PMIX_RELEASE(cd);
     }
+    PMIX_DESTRUCT(&pmix_globals.notify_cache.bycode);
     PMIX_DESTRUCT(&pmix_globals.notifications);
     for (i = 0; i < pmix_globals.iof_requests.size; i++) {
         req = (pmix_iof_req_t *) pmix_pointer_array_get_item(&pmix_globals.iof_requests, i);
@@ -142,6 +151,8 @@ void pmix_rte_finalize(void)
         pmix_globals.hostname = NULL;
     }
     PMIX_LIST_DESTRUCT(&pmix_globals.nspaces);
+    /* the keymap only references entries owned by the keyindex */
+    PMIX_DESTRUCT(&pmix_globals.keymap);
     for (i=0; i < pmix_globals.keyindex.size; i++) {
         p = (pmix_regattr_input_t*)pmix_pointer_array_get_item(&pmix_globals.keyindex, i);
         if (NULL != p) {
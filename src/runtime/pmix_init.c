@@ -102,12 +102,19 @@ PMIX_EXPORT pmix_globals_t pmix_globals = {
     .max_events = INT_MAX,
     .event_eviction_time = 0,
     .notifications = PMIX_HOTEL_STATIC_INIT,
+    .notify_cache = {
+        .oldest = NULL,
+        .newest = NULL,
+        .bycode = PMIX_HASH_TABLE_STATIC_INIT,
+        .stats = {0, 0, 0, 0, 0, 0}
+    },
     .pushstdin = false,
     .stdin_targets = PMIX_LIST_STATIC_INIT,
     .tag_output = false,
     .xml_output = false,
     .timestamp_output = false,
     .output_limit = SIZE_MAX,
+    .iof_splice = false,
     .nspaces = PMIX_LIST_STATIC_INIT,
     .topology = {NULL, NULL},
     .cpuset = {NULL, NULL},
@@ -115,6 +122,7 @@ PMIX_EXPORT pmix_globals_t pmix_globals = {
     .external_progress = false,
     .iof_flags = PMIX_IOF_FLAGS_STATIC_INIT,
     .keyindex = PMIX_POINTER_ARRAY_STATIC_INIT,
+    .keymap = PMIX_HASH_TABLE_STATIC_INIT,
     .next_keyid = PMIX_INDEX_BOUNDARY
 };
 
@@ -123,6 +131,10 @@ static void _notification_eviction_cbfunc(struct pmix_hotel_t *hotel, int room_n
     pmix_notify_caddy_t *cache = (pmix_notify_caddy_t *) occupant;
     PMIX_HIDE_UNUSED_PARAMS(hotel, room_num);
 
+    /* the hotel has already checked it out */
+    cache->room = -1;
+    pmix_notify_event_unlink(cache);
+    pmix_globals.notify_cache.stats.nexpired++;
     PMIX_RELEASE(cache);
 }
 
@@ -312,9 +324,13 @@ int pmix_rte_init(uint32_t type, pmix_info_t info[], size_t ninfo, pmix_ptl_cbfu
     PMIX_CONSTRUCT(&pmix_globals.notifications, pmix_hotel_t);
     ret = pmix_hotel_init(&pmix_globals.notifications, pmix_globals.max_events, pmix_globals.evbase,
                           pmix_globals.event_eviction_time, _notification_eviction_cbfunc);
+    PMIX_CONSTRUCT(&pmix_globals.notify_cache.bycode, pmix_hash_table_t);
+    pmix_hash_table_init(&pmix_globals.notify_cache.bycode, 64);
     PMIX_CONSTRUCT(&pmix_globals.nspaces, pmix_list_t);
     PMIX_CONSTRUCT(&pmix_globals.keyindex, pmix_pointer_array_t);
     pmix_pointer_array_init(&pmix_globals.keyindex, 1024, INT_MAX, 128);
+    PMIX_CONSTRUCT(&pmix_globals.keymap, pmix_hash_table_t);
+    pmix_hash_table_init(&pmix_globals.keymap, 256);
     /* need to hold off checking the hotel init return code
      * until after we construct all the globals so they can
      * correctly finalize */
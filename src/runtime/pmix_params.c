@@ -212,6 +212,22 @@ pmix_status_t pmix_register_params(void)
         PMIX_MCA_BASE_VAR_TYPE_BOOL,
         &pmix_server_globals.fence_localonly_opt);
 
+    pmix_server_globals.dmdx_batch_window = 1000;
+    (void) pmix_mca_base_var_register(
+        "pmix", "pmix", "server", "dmodex_batch_window",
+        "Time in usec to collect direct modex requests for remote procs before passing them "
+        "to a host that supports batched requests - zero requests each proc immediately "
+        "(default: 1000)",
+        PMIX_MCA_BASE_VAR_TYPE_INT,
+        &pmix_server_globals.dmdx_batch_window);
+
+    pmix_server_globals.dmdx_batch_max = 4096;
+    (void) pmix_mca_base_var_register(
+        "pmix", "pmix", "server", "dmodex_batch_max",
+        "Maximum number of procs in a batched direct modex request (default: 4096)",
+        PMIX_MCA_BASE_VAR_TYPE_INT,
+        &pmix_server_globals.dmdx_batch_max);
+
     /* check for maximum number of pending output messages */
     pmix_globals.output_limit = (size_t) INT_MAX;
     (void) pmix_mca_base_var_register("pmix", "iof", NULL, "output_limit",
@@ -219,6 +235,14 @@ pmix_status_t pmix_register_params(void)
                                       PMIX_MCA_BASE_VAR_TYPE_SIZE_T,
                                       &pmix_globals.output_limit);
 
+    /* whether to splice child output directly into file sinks */
+    pmix_globals.iof_splice = false;
+    (void) pmix_mca_base_var_register("pmix", "iof", NULL, "splice",
+                                      "Move child output directly from its pipe into undecorated "
+                                      "output files using splice(), where supported (default: false)",
+                                      PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                      &pmix_globals.iof_splice);
+
     pmix_globals.xml_output = false;
     (void) pmix_mca_base_var_register("pmix", "iof", NULL, "xml_output",
                                       "Display all output in XML format (default: false)",
@@ -101,6 +101,10 @@ pmix_server_globals_t pmix_server_globals = {
     .tmpdir = NULL,
     .system_tmpdir = NULL,
     .fence_localonly_opt = false,
+    .dmdx_ev_active = false,
+    .dmdx_npending = 0,
+    .dmdx_batch_window = 0,
+    .dmdx_batch_max = 0,
     .get_output = -1,
     .get_verbose = 0,
     .connect_output = -1,
@@ -407,11 +411,25 @@ pmix_status_t pmix_server_initialize(void)
     PMIX_CONSTRUCT(&pmix_server_globals.clients, pmix_pointer_array_t);
     pmix_pointer_array_init(&pmix_server_globals.clients, 1, INT_MAX, 1);
     PMIX_CONSTRUCT(&pmix_server_globals.nspaces, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_server_globals.nsindex, pmix_hash_table_t);
+    pmix_hash_table_init(&pmix_server_globals.nsindex, 64);
     PMIX_CONSTRUCT(&pmix_server_globals.collectives, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_server_globals.trk_sigs, pmix_hash_table_t);
+    pmix_hash_table_init(&pmix_server_globals.trk_sigs, 256);
+    PMIX_CONSTRUCT(&pmix_server_globals.trk_ids, pmix_hash_table_t);
+    pmix_hash_table_init(&pmix_server_globals.trk_ids, 256);
     PMIX_CONSTRUCT(&pmix_server_globals.remote_pnd, pmix_list_t);
     PMIX_CONSTRUCT(&pmix_server_globals.local_reqs, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_server_globals.dmdx_index, pmix_hash_table_t);
+    pmix_hash_table_init(&pmix_server_globals.dmdx_index, 256);
+    pmix_server_globals.dmdx_ev_active = false;
+    pmix_server_globals.dmdx_npending = 0;
     PMIX_CONSTRUCT(&pmix_server_globals.gdata, pmix_list_t);
     PMIX_CONSTRUCT(&pmix_server_globals.events, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_server_globals.evindex, pmix_hash_table_t);
+    pmix_hash_table_init(&pmix_server_globals.evindex, 64);
+    PMIX_CONSTRUCT(&pmix_server_globals.evnotified, pmix_bitmap_t);
+    pmix_bitmap_init(&pmix_server_globals.evnotified, 64);
     PMIX_CONSTRUCT(&pmix_server_globals.groups, pmix_list_t);
     PMIX_CONSTRUCT(&pmix_server_globals.iof, pmix_list_t);
     PMIX_CONSTRUCT(&pmix_server_globals.iof_residuals, pmix_list_t);
@@ -522,7 +540,9 @@ static pmix_server_module_t myhostserver = {
     .push_stdin = NULL,
     .group = NULL,
     .fabric = NULL,
-    .client_connected2 = NULL
+    .client_connected2 = NULL,
+    .session_control = NULL,
+    .direct_modex_batch = NULL
 };
 
 PMIX_EXPORT pmix_status_t PMIx_server_init(pmix_server_module_t *module, pmix_info_t info[],
@@ -1014,10 +1034,20 @@ PMIX_EXPORT pmix_status_t PMIx_server_finalize(void)
     }
     PMIX_DESTRUCT(&pmix_server_globals.clients);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.collectives);
+    PMIX_DESTRUCT(&pmix_server_globals.trk_sigs);
+    PMIX_DESTRUCT(&pmix_server_globals.trk_ids);
+    PMIX_DESTRUCT(&pmix_server_globals.nsindex);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.remote_pnd);
+    if (pmix_server_globals.dmdx_ev_active) {
+        pmix_event_del(&pmix_server_globals.dmdx_ev);
+        pmix_server_globals.dmdx_ev_active = false;
+    }
     PMIX_LIST_DESTRUCT(&pmix_server_globals.local_reqs);
+    PMIX_DESTRUCT(&pmix_server_globals.dmdx_index);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.gdata);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.events);
+    PMIX_DESTRUCT(&pmix_server_globals.evindex);
+    PMIX_DESTRUCT(&pmix_server_globals.evnotified);
     PMIX_LIST_FOREACH (ns, &pmix_globals.nspaces, pmix_namespace_t) {
         /* ensure that we do the specified cleanup - if this is an
          * abnormal termination, then the nspace object may not be
@@ -1311,7 +1341,7 @@ void pmix_server_purge_events(pmix_peer_t *peer, pmix_proc_t *proc)
     pmix_peer_events_info_t *prev, *pnext;
     pmix_iof_req_t *req;
     int i;
-    pmix_notify_caddy_t *ncd;
+    pmix_notify_caddy_t *ncd, *nnext;
     size_t n, m, p, ntgs;
     pmix_proc_t *tgs, *tgt;
     pmix_dmdx_local_t *dlcd, *dnxt;
@@ -1326,7 +1356,7 @@ void pmix_server_purge_events(pmix_peer_t *peer, pmix_proc_t *proc)
                 pmix_list_remove_item(&reginfo->peers, &prev->super);
                 PMIX_RELEASE(prev);
                 if (0 == pmix_list_get_size(&reginfo->peers)) {
-                    pmix_list_remove_item(&pmix_server_globals.events, &reginfo->super);
+                    pmix_server_event_remove(reginfo);
                     PMIX_RELEASE(reginfo);
                     break;
                 }
@@ -1365,7 +1395,7 @@ void pmix_server_purge_events(pmix_peer_t *peer, pmix_proc_t *proc)
              && PMIX_CHECK_NAMES(&peer->info->pname, &dlcd->proc))
             || (NULL != proc && PMIX_CHECK_PROCID(proc, &dlcd->proc))) {
             /* cleanup this request */
-            pmix_list_remove_item(&pmix_server_globals.local_reqs, &dlcd->super);
+            pmix_server_dmdx_remove(dlcd);
             /* we can release the dlcd item here because we are not
              * releasing the tracker held by the host - we are only
              * releasing one item on that tracker */
@@ -1374,9 +1404,8 @@ void pmix_server_purge_events(pmix_peer_t *peer, pmix_proc_t *proc)
     }
 
     /* purge this client from any cached notifications */
-    for (i = 0; i < pmix_globals.max_events; i++) {
-        pmix_hotel_knock(&pmix_globals.notifications, i, (void **) &ncd);
-        if (NULL != ncd && NULL != ncd->targets && 0 < ncd->ntargets) {
+    PMIX_NOTIFY_CACHE_FOREACH (ncd, nnext) {
+        if (NULL != ncd->targets && 0 < ncd->ntargets) {
             tgt = NULL;
             for (n = 0; n < ncd->ntargets; n++) {
                 if ((NULL != peer && NULL != peer->info
@@ -1390,7 +1419,7 @@ void pmix_server_purge_events(pmix_peer_t *peer, pmix_proc_t *proc)
                 /* if this client was the only target, then just
                  * evict the notification */
                 if (1 == ncd->ntargets) {
-                    pmix_hotel_checkout(&pmix_globals.notifications, i);
+                    pmix_notify_event_uncache(ncd);
                     PMIX_RELEASE(ncd);
                 } else if (PMIX_RANK_WILDCARD == tgt->rank && NULL != proc
                            && PMIX_RANK_WILDCARD == proc->rank) {
@@ -1455,7 +1484,7 @@ static void _deregister_nspace(int sd, short args, void *cbdata)
             /* perform any nspace-level epilog */
             pmix_execute_epilog(&tmp->epilog);
             /* remove and release it */
-            pmix_list_remove_item(&pmix_globals.nspaces, &tmp->super);
+            pmix_server_nspace_remove(tmp);
             PMIX_RELEASE(tmp);
             break;
         }
@@ -1860,7 +1889,7 @@ void pmix_server_execute_collective(int sd, short args, void *cbdata)
     } else {
         /* unknown type */
         PMIX_ERROR_LOG(PMIX_ERR_NOT_FOUND);
-        pmix_list_remove_item(&pmix_server_globals.collectives, &trk->super);
+        pmix_server_trk_remove(trk);
         PMIX_RELEASE(trk);
     }
     PMIX_RELEASE(tcd);
@@ -2229,6 +2258,10 @@ PMIX_EXPORT pmix_status_t PMIx_server_setup_fork(const pmix_proc_t *proc, char *
     }
     /* pass our available gds modules */
     PMIx_Setenv("PMIX_GDS_MODULE", gds_mode, true, env);
+    /* pass our available bfrops modules */
+    if (NULL != bfrops_mode) {
+        PMIx_Setenv("PMIX_BFROPS_MODE", bfrops_mode, true, env);
+    }
 
     /* get any PTL contribution such as tmpdir settings for session files */
     if (PMIX_SUCCESS != (rc = pmix_ptl_base_setup_fork(proc, env))) {
@@ -3533,7 +3566,7 @@ cleanup:
     xfer.bytes_used = 0;
     PMIX_DESTRUCT(&xfer);
 
-    pmix_list_remove_item(&pmix_server_globals.collectives, &tracker->super);
+    pmix_server_trk_remove(tracker);
     PMIX_RELEASE(tracker);
     PMIX_LIST_DESTRUCT(&nslist);
 
@@ -3812,7 +3845,7 @@ cleanup:
     if (NULL != nspaces) {
         PMIx_Argv_free(nspaces);
     }
-    pmix_list_remove_item(&pmix_server_globals.collectives, &tracker->super);
+    pmix_server_trk_remove(tracker);
     PMIX_RELEASE(tracker);
 
     /* we are done */
@@ -3890,7 +3923,7 @@ static void _discnct(int sd, short args, void *cbdata)
 cleanup:
     /* cleanup the tracker -- the host RM is responsible for
      * telling us when to remove the nspace from our data */
-    pmix_list_remove_item(&pmix_server_globals.collectives, &tracker->super);
+    pmix_server_trk_remove(tracker);
     PMIX_RELEASE(tracker);
 
     /* we are done */
@@ -4926,6 +4959,15 @@ static pmix_status_t server_switchyard(pmix_peer_t *peer, uint32_t tag, pmix_buf
         return rc;
     }
 
+    if (PMIX_PREFETCH_CMD == cmd) {
+        PMIX_GDS_CADDY(cd, peer, tag);
+        /* the data is streamed back to the requestor, so the
+         * only reply on this tag is the returned status */
+        rc = pmix_server_prefetch(cd, buf);
+        PMIX_RELEASE(cd);
+        return rc;
+    }
+
     return PMIX_ERR_NOT_SUPPORTED;
 }
 
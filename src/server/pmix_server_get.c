@@ -70,6 +70,8 @@ typedef struct {
     pmix_dmdx_local_t *lcd;
     pmix_release_cbfunc_t relcbfunc;
     void *cbdata;
+    pmix_proc_t proc;                // proc being returned in a batched reply
+    struct pmix_dmdx_batch_t *batch; // batch this reply belongs to, if any
 } pmix_dmdx_reply_caddy_t;
 static void dcd_con(pmix_dmdx_reply_caddy_t *p)
 {
@@ -78,9 +80,47 @@ static void dcd_con(pmix_dmdx_reply_caddy_t *p)
     p->lcd = NULL;
     p->relcbfunc = NULL;
     p->cbdata = NULL;
+    p->batch = NULL;
 }
 PMIX_CLASS_INSTANCE(pmix_dmdx_reply_caddy_t, pmix_object_t, dcd_con, NULL);
 
+/* tracks a batched direct modex request passed to the host -
+ * each local tracker in the batch is retained until the host
+ * returns the data for its proc */
+typedef struct pmix_dmdx_batch_t {
+    pmix_object_t super;
+    pmix_proc_t *procs;
+    pmix_dmdx_local_t **lcds;
+    size_t nprocs;
+    size_t nreplies;
+    size_t hint; // where to start looking for the next reply
+} pmix_dmdx_batch_t;
+static void dbcon(pmix_dmdx_batch_t *p)
+{
+    p->procs = NULL;
+    p->lcds = NULL;
+    p->nprocs = 0;
+    p->nreplies = 0;
+    p->hint = 0;
+}
+static void dbdes(pmix_dmdx_batch_t *p)
+{
+    size_t n;
+
+    if (NULL != p->lcds) {
+        for (n = 0; n < p->nprocs; n++) {
+            if (NULL != p->lcds[n]) {
+                PMIX_RELEASE(p->lcds[n]);
+            }
+        }
+        free(p->lcds);
+    }
+    if (NULL != p->procs) {
+        PMIX_PROC_FREE(p->procs, p->nprocs);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_dmdx_batch_t, pmix_object_t, dbcon, dbdes);
+
 static void dmdx_cbfunc(pmix_status_t status, const char *data, size_t ndata, void *cbdata,
                         pmix_release_cbfunc_t relfn, void *relcbdata);
 static pmix_status_t _satisfy_request(pmix_namespace_t *nptr, pmix_rank_t rank,
@@ -92,6 +132,7 @@ static pmix_status_t create_local_tracker(char nspace[], pmix_rank_t rank, pmix_
 static pmix_status_t get_job_data(char *nspace, pmix_server_caddy_t *cd,
                                   char *key, pmix_buffer_t *pbkt);
 static void get_timeout(int sd, short args, void *cbdata);
+static pmix_status_t request_remote_data(pmix_dmdx_local_t *lcd);
 
 /* declare a function whose sole purpose is to
  * free data that we provided to our host server
@@ -518,7 +559,7 @@ request:
     /* this isn't a local client of ours, so we need to ask the host
      * resource manager server to please get the info for us from
      * whomever is hosting the target process */
-    if (NULL != pmix_host_server.direct_modex) {
+    if (NULL != pmix_host_server.direct_modex || NULL != pmix_host_server.direct_modex_batch) {
         if (NULL != key) {
             sz = cd->ninfo;
             PMIX_INFO_CREATE(info, sz + 1);
@@ -531,18 +572,27 @@ request:
             }
             cd->info = info;
             cd->ninfo = sz + 1;
+            /* the tracker carries the directives passed to the host */
+            if (NULL != lcd->info) {
+                PMIX_INFO_FREE(lcd->info, lcd->ninfo);
+            }
+            lcd->ninfo = cd->ninfo;
+            PMIX_INFO_CREATE(lcd->info, lcd->ninfo);
+            for (n = 0; n < lcd->ninfo; n++) {
+                PMIX_INFO_XFER(&lcd->info[n], &cd->info[n]);
+            }
         }
-        rc = pmix_host_server.direct_modex(&lcd->proc, cd->info, cd->ninfo, dmdx_cbfunc, lcd);
+        rc = request_remote_data(lcd);
         if (PMIX_SUCCESS != rc) {
             /* may have a function entry but not support the request */
-            pmix_list_remove_item(&pmix_server_globals.local_reqs, &lcd->super);
+            pmix_server_dmdx_remove(lcd);
             PMIX_RELEASE(lcd);
         }
     } else {
         pmix_output_verbose(2, pmix_server_globals.get_output, "%s:%d NO SERVER SUPPORT",
                             pmix_globals.myid.nspace, pmix_globals.myid.rank);
         /* if we don't have direct modex feature, just respond with "not found" */
-        pmix_list_remove_item(&pmix_server_globals.local_reqs, &lcd->super);
+        pmix_server_dmdx_remove(lcd);
         PMIX_RELEASE(lcd);
         rc = PMIX_ERR_NOT_FOUND;
     }
@@ -550,11 +600,181 @@ request:
     return rc;
 }
 
+/* tracks the request for one proc of a client's prefetch - the
+ * data is streamed back to the client on the prefetch tag as soon
+ * as we have it */
+typedef struct {
+    pmix_server_caddy_t super;
+    uint32_t id;
+    pmix_proc_t proc;
+} pmix_prefetch_caddy_t;
+static PMIX_CLASS_INSTANCE(pmix_prefetch_caddy_t, pmix_server_caddy_t, NULL, NULL);
+
+static void prefetch_cbfunc(pmix_status_t status, const char *data, size_t ndata, void *cbdata,
+                            pmix_release_cbfunc_t release_fn, void *release_cbdata)
+{
+    pmix_prefetch_caddy_t *pcd = (pmix_prefetch_caddy_t *) cbdata;
+    pmix_peer_t *peer = pcd->super.peer;
+    pmix_buffer_t *reply, buf;
+    pmix_status_t rc;
+
+    pmix_output_verbose(2, pmix_server_globals.get_output,
+                        "%s prefetch %u returning %d bytes for %s to %s",
+                        PMIX_NAME_PRINT(&pmix_globals.myid), pcd->id, (int) ndata,
+                        PMIX_NAME_PRINT(&pcd->proc), PMIX_PNAME_PRINT(&peer->info->pname));
+
+    reply = PMIX_NEW(pmix_buffer_t);
+    PMIX_BFROPS_PACK(rc, peer, reply, &pcd->id, 1, PMIX_UINT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    PMIX_BFROPS_PACK(rc, peer, reply, &pcd->proc, 1, PMIX_PROC);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    PMIX_BFROPS_PACK(rc, peer, reply, &status, 1, PMIX_STATUS);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    /* the blob is in the same form as the reply to a get */
+    if (0 < ndata) {
+        PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+        PMIX_LOAD_BUFFER(peer, &buf, data, ndata);
+        PMIX_BFROPS_COPY_PAYLOAD(rc, peer, reply, &buf);
+        buf.base_ptr = NULL;
+        buf.bytes_used = 0;
+        PMIX_DESTRUCT(&buf);
+    }
+    PMIX_SERVER_QUEUE_REPLY(rc, peer, PMIX_PTL_TAG_PREFETCH, reply);
+
+cleanup:
+    if (PMIX_SUCCESS != rc) {
+        PMIX_RELEASE(reply);
+    }
+    if (NULL != release_fn) {
+        release_fn(release_cbdata);
+    }
+    PMIX_RELEASE(pcd);
+}
+
+/* a client is asking for the data of a set of procs in a single
+ * message. Treat it as a separate get for each proc, sharing the
+ * trackers (and host requests) of any gets already in progress */
+pmix_status_t pmix_server_prefetch(pmix_server_caddy_t *cd, pmix_buffer_t *buf)
+{
+    pmix_prefetch_caddy_t *pcd;
+    pmix_buffer_t req;
+    pmix_proc_t *procs = NULL;
+    pmix_info_t *info = NULL;
+    size_t nprocs, ninfo = 0, n;
+    uint32_t id;
+    int32_t cnt;
+    char *nspace;
+    pmix_status_t rc;
+
+    /* unpack the entire request before acting on any of it
+     * so the client gets all of the data or an error */
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, cd->peer, buf, &id, &cnt, PMIX_UINT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, cd->peer, buf, &nprocs, &cnt, PMIX_SIZE);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    if (0 == nprocs) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+    PMIX_PROC_CREATE(procs, nprocs);
+    if (NULL == procs) {
+        return PMIX_ERR_NOMEM;
+    }
+    cnt = nprocs;
+    PMIX_BFROPS_UNPACK(rc, cd->peer, buf, procs, &cnt, PMIX_PROC);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, cd->peer, buf, &ninfo, &cnt, PMIX_SIZE);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    if (0 < ninfo) {
+        PMIX_INFO_CREATE(info, ninfo);
+        cnt = ninfo;
+        PMIX_BFROPS_UNPACK(rc, cd->peer, buf, info, &cnt, PMIX_INFO);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            goto cleanup;
+        }
+    }
+
+    pmix_output_verbose(2, pmix_server_globals.get_output,
+                        "%s recvd PREFETCH %u OF %lu PROCS FROM %s",
+                        PMIX_NAME_PRINT(&pmix_globals.myid), id, (unsigned long) nprocs,
+                        PMIX_PNAME_PRINT(&cd->peer->info->pname));
+
+    for (n = 0; n < nprocs; n++) {
+        pcd = PMIX_NEW(pmix_prefetch_caddy_t);
+        pcd->super.hdr.tag = PMIX_PTL_TAG_PREFETCH;
+        PMIX_RETAIN(cd->peer);
+        pcd->super.peer = cd->peer;
+        pcd->id = id;
+        PMIX_LOAD_PROCID(&pcd->proc, procs[n].nspace, procs[n].rank);
+
+        /* present it to the get code in the form of a get request */
+        PMIX_CONSTRUCT(&req, pmix_buffer_t);
+        nspace = procs[n].nspace;
+        PMIX_BFROPS_PACK(rc, cd->peer, &req, &nspace, 1, PMIX_STRING);
+        if (PMIX_SUCCESS == rc) {
+            PMIX_BFROPS_PACK(rc, cd->peer, &req, &procs[n].rank, 1, PMIX_PROC_RANK);
+        }
+        if (PMIX_SUCCESS == rc) {
+            PMIX_BFROPS_PACK(rc, cd->peer, &req, &ninfo, 1, PMIX_SIZE);
+        }
+        if (PMIX_SUCCESS == rc && 0 < ninfo) {
+            PMIX_BFROPS_PACK(rc, cd->peer, &req, info, ninfo, PMIX_INFO);
+        }
+        if (PMIX_SUCCESS == rc) {
+            rc = pmix_server_get(&req, prefetch_cbfunc, pcd);
+            if (PMIX_OPERATION_SUCCEEDED == rc) {
+                /* nothing to fetch - the host keeps the data of
+                 * local procs current - so answer the client now */
+                prefetch_cbfunc(PMIX_SUCCESS, NULL, 0, pcd, NULL, NULL);
+                rc = PMIX_SUCCESS;
+            }
+        }
+        PMIX_DESTRUCT(&req);
+        if (PMIX_SUCCESS != rc) {
+            /* let the client know we could not get this one */
+            prefetch_cbfunc(rc, NULL, 0, pcd, NULL, NULL);
+        }
+    }
+    /* have the switchyard acknowledge the request */
+    rc = PMIX_OPERATION_SUCCEEDED;
+
+cleanup:
+    PMIX_PROC_FREE(procs, nprocs);
+    if (NULL != info) {
+        PMIX_INFO_FREE(info, ninfo);
+    }
+    return rc;
+}
+
 static pmix_status_t create_local_tracker(char nspace[], pmix_rank_t rank, pmix_info_t info[],
                                           size_t ninfo, pmix_modex_cbfunc_t cbfunc, void *cbdata,
                                           pmix_dmdx_local_t **ld, pmix_dmdx_request_t **rq)
 {
-    pmix_dmdx_local_t *lcd, *cd;
+    pmix_dmdx_local_t *lcd;
     pmix_dmdx_request_t *req;
     pmix_status_t rc;
     size_t n;
@@ -565,14 +785,7 @@ static pmix_status_t create_local_tracker(char nspace[], pmix_rank_t rank, pmix_
 
     /* see if we already have an existing request for data
      * from this namespace/rank */
-    lcd = NULL;
-    PMIX_LIST_FOREACH (cd, &pmix_server_globals.local_reqs, pmix_dmdx_local_t) {
-        if (!PMIX_CHECK_NSPACE(nspace, cd->proc.nspace) || rank != cd->proc.rank) {
-            continue;
-        }
-        lcd = cd;
-        break;
-    }
+    lcd = pmix_server_dmdx_lookup(nspace, rank);
     if (NULL != lcd) {
         /* we already have a request, so just track that someone
          * else wants data from the same target */
@@ -594,7 +807,11 @@ static pmix_status_t create_local_tracker(char nspace[], pmix_rank_t rank, pmix_
             PMIX_INFO_XFER(&lcd->info[n], &info[n]);
         }
     }
-    pmix_list_append(&pmix_server_globals.local_reqs, &lcd->super);
+    rc = pmix_server_dmdx_add(lcd);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_RELEASE(lcd);
+        return rc;
+    }
     rc = PMIX_ERR_NOT_FOUND; // indicates that we created a new request tracker
 
 complete:
@@ -648,10 +865,7 @@ void pmix_pending_nspace_requests(pmix_namespace_t *nptr)
         /* if not found - this is remote process and we need to send
          * corresponding direct modex request */
         if (!found) {
-            rc = PMIX_ERR_NOT_SUPPORTED;
-            if (NULL != pmix_host_server.direct_modex) {
-                rc = pmix_host_server.direct_modex(&cd->proc, cd->info, cd->ninfo, dmdx_cbfunc, cd);
-            }
+            rc = request_remote_data(cd);
             if (PMIX_SUCCESS != rc) {
                 pmix_dmdx_request_t *req, *req_next;
                 PMIX_LIST_FOREACH_SAFE (req, req_next, &cd->loc_reqs, pmix_dmdx_request_t) {
@@ -659,7 +873,7 @@ void pmix_pending_nspace_requests(pmix_namespace_t *nptr)
                     pmix_list_remove_item(&cd->loc_reqs, &req->super);
                     PMIX_RELEASE(req);
                 }
-                pmix_list_remove_item(&pmix_server_globals.local_reqs, &cd->super);
+                pmix_server_dmdx_remove(cd);
                 PMIX_RELEASE(cd);
             }
         }
@@ -875,7 +1089,7 @@ pmix_status_t pmix_pending_resolve(pmix_namespace_t *nptr,
                                    pmix_scope_t scope,
                                    pmix_dmdx_local_t *lcd)
 {
-    pmix_dmdx_local_t *cd, *ptr;
+    pmix_dmdx_local_t *ptr;
     pmix_dmdx_request_t *req, *rnext;
     pmix_server_caddy_t scd;
 
@@ -883,13 +1097,7 @@ pmix_status_t pmix_pending_resolve(pmix_namespace_t *nptr,
     if (NULL == lcd) {
         ptr = NULL;
         if (NULL != nptr) {
-            PMIX_LIST_FOREACH (cd, &pmix_server_globals.local_reqs, pmix_dmdx_local_t) {
-                if (!PMIX_CHECK_NSPACE(nptr->nspace, cd->proc.nspace) || rank != cd->proc.rank) {
-                    continue;
-                }
-                ptr = cd;
-                break;
-            }
+            ptr = pmix_server_dmdx_lookup(nptr->nspace, rank);
         }
         if (NULL == ptr) {
             return PMIX_SUCCESS;
@@ -934,7 +1142,7 @@ pmix_status_t pmix_pending_resolve(pmix_namespace_t *nptr,
 
 cleanup:
     /* remove all requests to this rank and cleanup the corresponding structure */
-    pmix_list_remove_item(&pmix_server_globals.local_reqs, &ptr->super);
+    pmix_server_dmdx_remove(ptr);
     /* the dmdx request is linked back to its local request for ease
      * of lookup upon return from the server. However, this means that
      * the refcount of the local request has been increased by the number
@@ -1163,6 +1371,216 @@ static void dmdx_cbfunc(pmix_status_t status, const char *data, size_t ndata, vo
     PMIX_THREADSHIFT(caddy, _process_dmdx_reply);
 }
 
+/* process a reply for one of the procs in a batched request */
+static void _process_batch_reply(int sd, short args, void *cbdata)
+{
+    pmix_dmdx_reply_caddy_t *caddy = (pmix_dmdx_reply_caddy_t *) cbdata;
+    pmix_dmdx_batch_t *batch = caddy->batch;
+    pmix_dmdx_local_t *lcd = NULL;
+    size_t n, m;
+
+    PMIX_ACQUIRE_OBJECT(caddy);
+
+    /* hosts typically return the procs in the order we gave
+     * them, so start looking where the last reply was found */
+    for (m = 0; m < batch->nprocs; m++) {
+        n = (batch->hint + m) % batch->nprocs;
+        if (NULL != batch->lcds[n] && PMIX_CHECK_PROCID(&caddy->proc, &batch->procs[n])) {
+            lcd = batch->lcds[n];
+            batch->lcds[n] = NULL;
+            batch->hint = n + 1;
+            break;
+        }
+    }
+
+    if (NULL == lcd) {
+        /* not a proc we asked about, or a duplicate reply */
+        PMIX_ERROR_LOG(PMIX_ERR_NOT_FOUND);
+        if (NULL != caddy->relcbfunc) {
+            caddy->relcbfunc(caddy->cbdata);
+        }
+        PMIX_RELEASE(caddy);
+        return;
+    }
+
+    if (pmix_server_dmdx_lookup(lcd->proc.nspace, lcd->proc.rank) == lcd) {
+        caddy->lcd = lcd;
+        _process_dmdx_reply(sd, args, caddy);
+    } else {
+        /* the request was resolved while we waited - e.g., the
+         * requesting procs all terminated */
+        if (NULL != caddy->relcbfunc) {
+            caddy->relcbfunc(caddy->cbdata);
+        }
+        PMIX_RELEASE(caddy);
+    }
+    PMIX_RELEASE(lcd);
+
+    ++batch->nreplies;
+    if (batch->nreplies == batch->nprocs) {
+        PMIX_RELEASE(batch);
+    }
+}
+
+/* this is the callback function that the host RM server will call
+ * once for each proc in a batched request */
+static void dmdx_batch_cbfunc(pmix_status_t status, const pmix_proc_t *proc, const char *data,
+                              size_t ndata, void *cbdata, pmix_release_cbfunc_t release_fn,
+                              void *release_cbdata)
+{
+    pmix_dmdx_reply_caddy_t *caddy;
+
+    caddy = PMIX_NEW(pmix_dmdx_reply_caddy_t);
+    caddy->status = status;
+    caddy->relcbfunc = release_fn;
+    caddy->cbdata = release_cbdata;
+    caddy->data = data;
+    caddy->ndata = ndata;
+    PMIX_LOAD_PROCID(&caddy->proc, proc->nspace, proc->rank);
+    caddy->batch = (pmix_dmdx_batch_t *) cbdata;
+    pmix_output_verbose(2, pmix_server_globals.get_output,
+                        "[%s:%d] queue batched dmdx reply for %s:%u",
+                        __FILE__, __LINE__, proc->nspace, proc->rank);
+    PMIX_THREADSHIFT(caddy, _process_batch_reply);
+}
+
+/* two pending requests can share a batch if they target the
+ * same nspace and carry the same directives */
+static bool dmdx_batch_match(pmix_dmdx_local_t *a, pmix_dmdx_local_t *b)
+{
+    size_t n;
+
+    if (!PMIX_CHECK_NSPACE(a->proc.nspace, b->proc.nspace) || a->ninfo != b->ninfo) {
+        return false;
+    }
+    for (n = 0; n < a->ninfo; n++) {
+        if (!PMIX_CHECK_KEY(&a->info[n], b->info[n].key) ||
+            PMIX_EQUAL != PMIx_Value_compare(&a->info[n].value, &b->info[n].value)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* pass the pending direct modex requests up to the host, grouping
+ * them into as few batched requests as possible */
+static void flush_dmdx_batch(int sd, short args, void *cbdata)
+{
+    pmix_dmdx_local_t *cd, *first;
+    pmix_dmdx_batch_t *batch;
+    pmix_status_t rc;
+    size_t n, max;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args, cbdata);
+
+    pmix_server_globals.dmdx_ev_active = false;
+
+    while (0 < pmix_server_globals.dmdx_npending) {
+        max = pmix_server_globals.dmdx_npending;
+        if (0 < pmix_server_globals.dmdx_batch_max
+            && (size_t) pmix_server_globals.dmdx_batch_max < max) {
+            max = pmix_server_globals.dmdx_batch_max;
+        }
+        batch = PMIX_NEW(pmix_dmdx_batch_t);
+        PMIX_PROC_CREATE(batch->procs, max);
+        batch->lcds = (pmix_dmdx_local_t **) calloc(max, sizeof(pmix_dmdx_local_t *));
+        first = NULL;
+        PMIX_LIST_FOREACH (cd, &pmix_server_globals.local_reqs, pmix_dmdx_local_t) {
+            if (!cd->pending) {
+                continue;
+            }
+            if (NULL == first) {
+                first = cd;
+            } else if (!dmdx_batch_match(first, cd)) {
+                continue;
+            }
+            cd->pending = false;
+            --pmix_server_globals.dmdx_npending;
+            PMIX_LOAD_PROCID(&batch->procs[batch->nprocs], cd->proc.nspace, cd->proc.rank);
+            PMIX_RETAIN(cd);
+            batch->lcds[batch->nprocs] = cd;
+            ++batch->nprocs;
+            if (max == batch->nprocs) {
+                break;
+            }
+        }
+        if (NULL == first) {
+            /* should never happen */
+            PMIX_ERROR_LOG(PMIX_ERR_NOT_FOUND);
+            pmix_server_globals.dmdx_npending = 0;
+            PMIX_RELEASE(batch);
+            break;
+        }
+
+        pmix_output_verbose(2, pmix_server_globals.get_output,
+                            "%s:%d REQUESTING BATCH OF %lu PROCS FROM NSPACE %s",
+                            pmix_globals.myid.nspace, pmix_globals.myid.rank,
+                            (unsigned long) batch->nprocs, first->proc.nspace);
+        rc = pmix_host_server.direct_modex_batch(batch->procs, batch->nprocs,
+                                                 first->info, first->ninfo,
+                                                 dmdx_batch_cbfunc, batch);
+        if (PMIX_SUCCESS == rc) {
+            continue;
+        }
+
+        /* the host declined the batch - fall back to
+         * requesting each proc individually */
+        for (n = 0; n < batch->nprocs; n++) {
+            cd = batch->lcds[n];
+            rc = PMIX_ERR_NOT_SUPPORTED;
+            if (NULL != pmix_host_server.direct_modex) {
+                rc = pmix_host_server.direct_modex(&cd->proc, cd->info, cd->ninfo,
+                                                   dmdx_cbfunc, cd);
+            }
+            if (PMIX_SUCCESS != rc) {
+                pmix_pending_resolve(NULL, cd->proc.rank, PMIX_ERR_NOT_FOUND, PMIX_REMOTE, cd);
+            }
+        }
+        PMIX_RELEASE(batch);
+    }
+}
+
+/* ask the host for the data of a remote proc. If the host supports
+ * batched requests, then hold the request for a short window so it
+ * can be combined with others */
+static pmix_status_t request_remote_data(pmix_dmdx_local_t *lcd)
+{
+    struct timeval tv;
+
+    if (NULL == pmix_host_server.direct_modex_batch || 0 >= pmix_server_globals.dmdx_batch_window) {
+        if (NULL == pmix_host_server.direct_modex) {
+            return PMIX_ERR_NOT_SUPPORTED;
+        }
+        return pmix_host_server.direct_modex(&lcd->proc, lcd->info, lcd->ninfo, dmdx_cbfunc, lcd);
+    }
+
+    if (!lcd->pending) {
+        lcd->pending = true;
+        ++pmix_server_globals.dmdx_npending;
+    }
+    if (0 < pmix_server_globals.dmdx_batch_max
+        && (size_t) pmix_server_globals.dmdx_batch_max <= pmix_server_globals.dmdx_npending) {
+        /* we have a full batch - no need to wait. We still pass it
+         * up from the event loop as our caller may be walking the
+         * list of pending requests */
+        if (pmix_server_globals.dmdx_ev_active) {
+            pmix_event_del(&pmix_server_globals.dmdx_ev);
+        }
+        tv.tv_sec = 0;
+        tv.tv_usec = 0;
+    } else if (pmix_server_globals.dmdx_ev_active) {
+        /* the window is already open */
+        return PMIX_SUCCESS;
+    } else {
+        tv.tv_sec = pmix_server_globals.dmdx_batch_window / 1000000;
+        tv.tv_usec = pmix_server_globals.dmdx_batch_window % 1000000;
+    }
+    pmix_event_evtimer_set(pmix_globals.evbase, &pmix_server_globals.dmdx_ev,
+                           flush_dmdx_batch, NULL);
+    pmix_event_evtimer_add(&pmix_server_globals.dmdx_ev, &tv);
+    pmix_server_globals.dmdx_ev_active = true;
+    return PMIX_SUCCESS;
+}
+
 static void get_timeout(int sd, short args, void *cbdata)
 {
     pmix_dmdx_request_t *req = (pmix_dmdx_request_t *) cbdata;
@@ -122,7 +122,9 @@ pmix_server_module_t pmix_host_server = {
     .push_stdin = NULL,
     .group = NULL,
     .fabric = NULL,
-    .client_connected2 = NULL
+    .client_connected2 = NULL,
+    .session_control = NULL,
+    .direct_modex_batch = NULL
 };
 
 pmix_status_t pmix_server_abort(pmix_peer_t *peer, pmix_buffer_t *buf,
@@ -335,6 +337,282 @@ pmix_status_t pmix_server_commit(pmix_peer_t *peer, pmix_buffer_t *buf)
     return rc;
 }
 
+/* active trackers are indexed by their operation ID (if they have
+ * one) and by a signature computed over the type of collective and
+ * the set of participants. The signature does not depend on the
+ * order in which the participants were given, so the same set of
+ * procs always lands in the same bucket. Trackers whose signatures
+ * collide are chained together in order of creation */
+static int trk_proc_cmp(const void *a, const void *b)
+{
+    const pmix_proc_t *p1 = (const pmix_proc_t *) a;
+    const pmix_proc_t *p2 = (const pmix_proc_t *) b;
+    int rc;
+
+    rc = strcmp(p1->nspace, p2->nspace);
+    if (0 != rc) {
+        return rc;
+    }
+    if (p1->rank < p2->rank) {
+        return -1;
+    }
+    return (p1->rank > p2->rank) ? 1 : 0;
+}
+
+static inline uint64_t trk_mix(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+static uint64_t trk_signature(pmix_proc_t *procs, size_t nprocs, pmix_cmd_t type)
+{
+    uint64_t h, sum = 0;
+    const char *c;
+    size_t i;
+
+    /* hash each proc on its own and add the results - addition
+     * commutes, so the order of the procs doesn't matter */
+    for (i = 0; i < nprocs; i++) {
+        h = 0xcbf29ce484222325ULL;
+        for (c = procs[i].nspace; '\0' != *c; c++) {
+            h ^= (uint8_t) *c;
+            h *= 0x100000001b3ULL;
+        }
+        sum += trk_mix(h ^ (uint64_t) procs[i].rank);
+    }
+    return trk_mix(sum ^ ((uint64_t) type << 32) ^ (uint64_t) nprocs);
+}
+
+static pmix_status_t trk_index(pmix_server_trkr_t *trk)
+{
+    pmix_server_trkr_t *t;
+    void *ptr;
+    int rc;
+
+    /* keep a sorted copy of the participants so we can confirm
+     * a match without an exhaustive search */
+    PMIX_PROC_CREATE(trk->spcs, trk->npcs);
+    if (NULL == trk->spcs) {
+        return PMIX_ERR_NOMEM;
+    }
+    memcpy(trk->spcs, trk->pcs, trk->npcs * sizeof(pmix_proc_t));
+    qsort(trk->spcs, trk->npcs, sizeof(pmix_proc_t), trk_proc_cmp);
+
+    trk->sig = trk_signature(trk->pcs, trk->npcs, trk->type);
+    trk->signext = NULL;
+    rc = pmix_hash_table_get_value_uint64(&pmix_server_globals.trk_sigs, trk->sig, &ptr);
+    if (PMIX_SUCCESS == rc && NULL != ptr) {
+        t = (pmix_server_trkr_t *) ptr;
+        while (NULL != t->signext) {
+            t = t->signext;
+        }
+        t->signext = trk;
+    } else {
+        rc = pmix_hash_table_set_value_uint64(&pmix_server_globals.trk_sigs, trk->sig, trk);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+    }
+
+    if (NULL != trk->id) {
+        rc = pmix_hash_table_set_value_ptr(&pmix_server_globals.trk_ids, trk->id,
+                                           strlen(trk->id), trk);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+static void trk_unindex(pmix_server_trkr_t *trk)
+{
+    pmix_server_trkr_t *t, *prev;
+    void *ptr;
+    int rc;
+
+    if (NULL != trk->spcs) {
+        rc = pmix_hash_table_get_value_uint64(&pmix_server_globals.trk_sigs, trk->sig, &ptr);
+        if (PMIX_SUCCESS == rc) {
+            prev = NULL;
+            for (t = (pmix_server_trkr_t *) ptr; NULL != t; prev = t, t = t->signext) {
+                if (t != trk) {
+                    continue;
+                }
+                if (NULL != prev) {
+                    prev->signext = trk->signext;
+                } else if (NULL != trk->signext) {
+                    pmix_hash_table_set_value_uint64(&pmix_server_globals.trk_sigs,
+                                                     trk->sig, trk->signext);
+                } else {
+                    pmix_hash_table_remove_value_uint64(&pmix_server_globals.trk_sigs, trk->sig);
+                }
+                break;
+            }
+        }
+        trk->signext = NULL;
+    }
+
+    if (NULL != trk->id) {
+        rc = pmix_hash_table_get_value_ptr(&pmix_server_globals.trk_ids, trk->id,
+                                           strlen(trk->id), &ptr);
+        if (PMIX_SUCCESS == rc && ptr == (void *) trk) {
+            pmix_hash_table_remove_value_ptr(&pmix_server_globals.trk_ids, trk->id,
+                                             strlen(trk->id));
+        }
+    }
+}
+
+void pmix_server_trk_remove(pmix_server_trkr_t *trk)
+{
+    pmix_list_remove_item(&pmix_server_globals.collectives, &trk->super);
+    trk_unindex(trk);
+}
+
+/* the registered events are indexed by status code so that
+ * a notification can go directly to the registrations that
+ * match it instead of checking every registration we hold */
+pmix_regevents_info_t *pmix_server_event_lookup(pmix_status_t code)
+{
+    void *ptr;
+    int rc;
+
+    rc = pmix_hash_table_get_value_uint64(&pmix_server_globals.evindex,
+                                          (uint64_t) (uint32_t) code, &ptr);
+    if (PMIX_SUCCESS != rc) {
+        return NULL;
+    }
+    return (pmix_regevents_info_t *) ptr;
+}
+
+pmix_status_t pmix_server_event_add(pmix_regevents_info_t *reginfo)
+{
+    int rc;
+
+    rc = pmix_hash_table_set_value_uint64(&pmix_server_globals.evindex,
+                                          (uint64_t) (uint32_t) reginfo->code, reginfo);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    pmix_list_append(&pmix_server_globals.events, &reginfo->super);
+    return PMIX_SUCCESS;
+}
+
+void pmix_server_event_remove(pmix_regevents_info_t *reginfo)
+{
+    if (pmix_server_event_lookup(reginfo->code) == reginfo) {
+        pmix_hash_table_remove_value_uint64(&pmix_server_globals.evindex,
+                                            (uint64_t) (uint32_t) reginfo->code);
+    }
+    pmix_list_remove_item(&pmix_server_globals.events, &reginfo->super);
+}
+
+/* nspaces are added to the global list from a number of places,
+ * so the index is populated on first lookup. Anyone removing an
+ * nspace from the list must do so here so the index remains valid */
+pmix_namespace_t *pmix_server_nspace_lookup(const char *nspace)
+{
+    pmix_namespace_t *nptr;
+    size_t len;
+    void *ptr;
+    int rc;
+
+    if (NULL == nspace) {
+        return NULL;
+    }
+    len = strnlen(nspace, PMIX_MAX_NSLEN);
+    rc = pmix_hash_table_get_value_ptr(&pmix_server_globals.nsindex, nspace, len, &ptr);
+    if (PMIX_SUCCESS == rc) {
+        return (pmix_namespace_t *) ptr;
+    }
+    PMIX_LIST_FOREACH (nptr, &pmix_globals.nspaces, pmix_namespace_t) {
+        if (PMIX_CHECK_NSPACE(nptr->nspace, nspace)) {
+            pmix_hash_table_set_value_ptr(&pmix_server_globals.nsindex, nspace, len, nptr);
+            return nptr;
+        }
+    }
+    return NULL;
+}
+
+void pmix_server_nspace_remove(pmix_namespace_t *nptr)
+{
+    size_t len;
+    void *ptr;
+    int rc;
+
+    if (NULL != nptr->nspace) {
+        len = strnlen(nptr->nspace, PMIX_MAX_NSLEN);
+        rc = pmix_hash_table_get_value_ptr(&pmix_server_globals.nsindex, nptr->nspace, len, &ptr);
+        if (PMIX_SUCCESS == rc && ptr == (void *) nptr) {
+            pmix_hash_table_remove_value_ptr(&pmix_server_globals.nsindex, nptr->nspace, len);
+        }
+    }
+    pmix_list_remove_item(&pmix_globals.nspaces, &nptr->super);
+}
+
+/* pending direct modex requests are indexed by the proc whose
+ * data is being requested so that a new request (or the arrival
+ * of the data) can find its tracker without walking the list */
+static size_t dmdx_key(const char *nspace, pmix_rank_t rank, char *key)
+{
+    size_t len;
+
+    len = strnlen(nspace, PMIX_MAX_NSLEN);
+    memcpy(key, nspace, len);
+    memcpy(key + len, &rank, sizeof(pmix_rank_t));
+    return len + sizeof(pmix_rank_t);
+}
+
+pmix_dmdx_local_t *pmix_server_dmdx_lookup(const char *nspace, pmix_rank_t rank)
+{
+    char key[PMIX_MAX_NSLEN + sizeof(pmix_rank_t)];
+    size_t len;
+    void *ptr;
+    int rc;
+
+    len = dmdx_key(nspace, rank, key);
+    rc = pmix_hash_table_get_value_ptr(&pmix_server_globals.dmdx_index, key, len, &ptr);
+    if (PMIX_SUCCESS != rc) {
+        return NULL;
+    }
+    return (pmix_dmdx_local_t *) ptr;
+}
+
+pmix_status_t pmix_server_dmdx_add(pmix_dmdx_local_t *lcd)
+{
+    char key[PMIX_MAX_NSLEN + sizeof(pmix_rank_t)];
+    size_t len;
+    int rc;
+
+    len = dmdx_key(lcd->proc.nspace, lcd->proc.rank, key);
+    rc = pmix_hash_table_set_value_ptr(&pmix_server_globals.dmdx_index, key, len, lcd);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    pmix_list_append(&pmix_server_globals.local_reqs, &lcd->super);
+    return PMIX_SUCCESS;
+}
+
+void pmix_server_dmdx_remove(pmix_dmdx_local_t *lcd)
+{
+    char key[PMIX_MAX_NSLEN + sizeof(pmix_rank_t)];
+    size_t len;
+
+    if (pmix_server_dmdx_lookup(lcd->proc.nspace, lcd->proc.rank) == lcd) {
+        len = dmdx_key(lcd->proc.nspace, lcd->proc.rank, key);
+        pmix_hash_table_remove_value_ptr(&pmix_server_globals.dmdx_index, key, len);
+    }
+    if (lcd->pending) {
+        lcd->pending = false;
+        --pmix_server_globals.dmdx_npending;
+    }
+    pmix_list_remove_item(&pmix_server_globals.local_reqs, &lcd->super);
+}
+
 /* get an existing object for tracking LOCAL participation in a collective
  * operation such as "fence". The only way this function can be
  * called is if at least one local client process is participating
@@ -355,8 +633,9 @@ static pmix_server_trkr_t *get_tracker(char *id, pmix_proc_t *procs,
                                        size_t nprocs, pmix_cmd_t type)
 {
     pmix_server_trkr_t *trk;
-    size_t i, j;
-    size_t matches;
+    size_t i;
+    void *ptr;
+    int rc;
 
     pmix_output_verbose(5, pmix_server_globals.fence_output,
                         "get_tracker called with %d procs",
@@ -368,44 +647,43 @@ static pmix_server_trkr_t *get_tracker(char *id, pmix_proc_t *procs,
         return NULL;
     }
 
-    /* there is no shortcut way to search the trackers - all
-     * we can do is perform a brute-force search. Fortunately,
-     * it is highly unlikely that there will be more than one
-     * or two active at a time, and they are most likely to
-     * involve only a single proc with WILDCARD rank - so this
-     * shouldn't take long */
-    PMIX_LIST_FOREACH (trk, &pmix_server_globals.collectives, pmix_server_trkr_t) {
-        /* Collective operation if unique identified by
-         * the set of participating processes and the type of collective,
-         * or by the operation ID
-         */
-        if (NULL != id) {
-            if (NULL != trk->id && 0 == strcmp(id, trk->id)) {
-                return trk;
-            }
-        } else {
-            if (nprocs != trk->npcs) {
-                continue;
-            }
-            if (type != trk->type) {
-                continue;
-            }
-            matches = 0;
-            for (i = 0; i < nprocs; i++) {
-                /* the procs may be in different order, so we have
-                 * to do an exhaustive search */
-                for (j = 0; j < trk->npcs; j++) {
-                    if (0 == strcmp(procs[i].nspace, trk->pcs[j].nspace)
-                        && procs[i].rank == trk->pcs[j].rank) {
-                        ++matches;
-                        break;
-                    }
-                }
-            }
-            if (trk->npcs == matches) {
-                return trk;
+    /* Collective operation if unique identified by
+     * the set of participating processes and the type of collective,
+     * or by the operation ID
+     */
+    if (NULL != id) {
+        rc = pmix_hash_table_get_value_ptr(&pmix_server_globals.trk_ids, id,
+                                           strlen(id), &ptr);
+        if (PMIX_SUCCESS == rc) {
+            return (pmix_server_trkr_t *) ptr;
+        }
+        return NULL;
+    }
+
+    rc = pmix_hash_table_get_value_uint64(&pmix_server_globals.trk_sigs,
+                                          trk_signature(procs, nprocs, type), &ptr);
+    if (PMIX_SUCCESS != rc) {
+        return NULL;
+    }
+    /* walk the (almost always single-entry) chain and confirm the
+     * match - the procs may be in different order, so look each
+     * one up in the sorted copy held by the tracker */
+    for (trk = (pmix_server_trkr_t *) ptr; NULL != trk; trk = trk->signext) {
+        if (nprocs != trk->npcs) {
+            continue;
+        }
+        if (type != trk->type) {
+            continue;
+        }
+        for (i = 0; i < nprocs; i++) {
+            if (NULL == bsearch(&procs[i], trk->spcs, trk->npcs,
+                                sizeof(pmix_proc_t), trk_proc_cmp)) {
+                break;
             }
         }
+        if (i == nprocs) {
+            return trk;
+        }
     }
     /* No tracker was found */
     return NULL;
@@ -608,6 +886,12 @@ static pmix_server_trkr_t *new_tracker(char *id, pmix_proc_t *procs,
     if (all_def) {
         trk->def_complete = true;
     }
+    if (PMIX_SUCCESS != trk_index(trk)) {
+        PMIX_ERROR_LOG(PMIX_ERR_NOMEM);
+        trk_unindex(trk);
+        PMIX_RELEASE(trk);
+        return NULL;
+    }
     pmix_list_append(&pmix_server_globals.collectives, &trk->super);
     return trk;
 }
@@ -628,9 +912,9 @@ static void fence_timeout(int sd, short args, void *cbdata)
     PMIX_RELEASE(trk);
 }
 
-static pmix_status_t _collect_data(pmix_server_trkr_t *trk,
-                                   pmix_buffer_t *buf,
-                                   size_t *size)
+pmix_status_t pmix_server_collect_data(pmix_server_trkr_t *trk,
+                                       pmix_buffer_t *buf,
+                                       size_t *size)
 {
     pmix_buffer_t bucket, *pbkt = NULL;
     pmix_cb_t cb;
@@ -645,33 +929,26 @@ static pmix_status_t _collect_data(pmix_server_trkr_t *trk,
     pmix_list_t rank_blobs;
     rank_blob_t *blob;
     uint32_t kmap_size;
-    int key_idx;
+    uint32_t key_idx;
     size_t sz;
 
     /* key names map, the position of the key name
      * in the array determines the unique key index */
-    char **kmap = NULL;
-    int i;
+    pmix_gds_modex_kmap_t kmap;
     pmix_gds_modex_blob_info_t blob_info_byte = 0;
     pmix_gds_modex_key_fmt_t kmap_type = PMIX_MODEX_KEY_INVALID;
 
     PMIX_CONSTRUCT(&bucket, pmix_buffer_t);
+    PMIX_CONSTRUCT(&kmap, pmix_gds_modex_kmap_t);
 
     if (PMIX_COLLECT_YES == trk->collect_type) {
        pmix_output_verbose(2, pmix_server_globals.fence_output,
                            "fence - assembling data");
 
-        /* Evaluate key names sizes and their count to select
-         * a format to store key names:
-         * - keymap: use key-map in blob header for key-name resolve
-         *   from idx: key names stored as indexes (avoid key duplication)
-         * - regular: key-names stored as is */
+        /* Collect the unique key names and their counts so we can
+         * select a format to store key names - see
+         * pmix_gds_base_modex_kmap_select for details */
         if (PMIX_MODEX_KEY_INVALID == kmap_type) {
-            size_t key_fmt_size[PMIX_MODEX_KEY_MAX] = {0};
-            pmix_value_array_t *key_count_array = PMIX_NEW(pmix_value_array_t);
-            uint32_t *key_count = NULL;
-
-            pmix_value_array_init(key_count_array, sizeof(uint32_t));
             *size = 0;
 
             PMIX_LIST_FOREACH (scd, &trk->local_cbs, pmix_server_caddy_t) {
@@ -683,49 +960,28 @@ static pmix_status_t _collect_data(pmix_server_trkr_t *trk,
                 cb.copy = true;
                 PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
                 if (PMIX_SUCCESS == rc) {
+                    /* ranks generally post the same keys, so size
+                     * the map from the first contribution we see */
+                    rc = pmix_gds_base_modex_kmap_init(&kmap, pmix_list_get_size(&cb.kvs));
+                    if (PMIX_SUCCESS != rc) {
+                        PMIX_ERROR_LOG(rc);
+                        PMIX_DESTRUCT(&cb);
+                        goto cleanup;
+                    }
                     PMIX_LIST_FOREACH (kv, &cb.kvs, pmix_kval_t) {
-                        rc = pmix_argv_append_unique_idx(&key_idx, &kmap, kv->key);
-                        if (pmix_value_array_get_size(key_count_array) < (size_t)(key_idx + 1)) {
-                            size_t new_size;
-                            size_t old_size = pmix_value_array_get_size(key_count_array);
-
-                            pmix_value_array_set_size(key_count_array, key_idx + 1);
-                            new_size = pmix_value_array_get_size(key_count_array);
-                            key_count = PMIX_VALUE_ARRAY_GET_BASE(key_count_array, uint32_t);
-                            memset(key_count + old_size, 0,
-                                   sizeof(uint32_t) * (new_size - old_size));
+                        rc = pmix_gds_base_modex_kmap_add(&kmap, kv->key, &key_idx);
+                        if (PMIX_SUCCESS != rc) {
+                            PMIX_ERROR_LOG(rc);
+                            PMIX_DESTRUCT(&cb);
+                            goto cleanup;
                         }
-                        key_count = PMIX_VALUE_ARRAY_GET_BASE(key_count_array, uint32_t);
-                        key_count[key_idx]++;
                     }
                 }
                 PMIX_DESTRUCT(&cb);
             }
-            for (i = 0; i < PMIx_Argv_count(kmap); i++) {
-                pmix_buffer_t tmp;
-                size_t kname_size;
-                size_t kidx_size;
-
-                PMIX_CONSTRUCT(&tmp, pmix_buffer_t);
-                PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &tmp, &kmap[i], 1, PMIX_STRING);
-                kname_size = tmp.bytes_used;
-                PMIX_DESTRUCT(&tmp);
-                PMIX_CONSTRUCT(&tmp, pmix_buffer_t);
-                PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &tmp, &i, 1, PMIX_UINT32);
-                kidx_size = tmp.bytes_used;
-                PMIX_DESTRUCT(&tmp);
-
-                /* calculate the key names sizes */
-                key_fmt_size[PMIX_MODEX_KEY_NATIVE_FMT] = kname_size * key_count[i];
-                key_fmt_size[PMIX_MODEX_KEY_KEYMAP_FMT] = kname_size + key_count[i] * kidx_size;
-            }
-            PMIX_RELEASE(key_count_array);
 
             /* select the most efficient key-name pack format */
-            kmap_type = key_fmt_size[PMIX_MODEX_KEY_NATIVE_FMT]
-                                > key_fmt_size[PMIX_MODEX_KEY_KEYMAP_FMT]
-                            ? PMIX_MODEX_KEY_KEYMAP_FMT
-                            : PMIX_MODEX_KEY_NATIVE_FMT;
+            kmap_type = pmix_gds_base_modex_kmap_select(&kmap);
             pmix_output_verbose(5, pmix_server_globals.fence_output, "key packing type %s",
                                 kmap_type == PMIX_MODEX_KEY_KEYMAP_FMT ? "kmap" : "native");
         }
@@ -834,10 +1090,10 @@ static pmix_status_t _collect_data(pmix_server_trkr_t *trk,
             /* pack node part of modex to `bucket` */
             /* pack the key names map for the remote server can
              * use it to match key names by index */
-            kmap_size = PMIx_Argv_count(kmap);
+            kmap_size = kmap.nkeys;
             if (0 < kmap_size) {
                 PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &bucket, &kmap_size, 1, PMIX_UINT32);
-                PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &bucket, kmap, kmap_size, PMIX_STRING);
+                PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &bucket, kmap.keys, kmap_size, PMIX_STRING);
             }
         }
         /* pack the collected blobs of processes */
@@ -883,7 +1139,7 @@ static pmix_status_t _collect_data(pmix_server_trkr_t *trk,
 
 cleanup:
     PMIX_DESTRUCT(&bucket);
-    PMIx_Argv_free(kmap);
+    PMIX_DESTRUCT(&kmap);
     return rc;
 }
 
@@ -1155,7 +1411,7 @@ pmix_status_t pmix_server_fence(pmix_server_caddy_t *cd, pmix_buffer_t *buf,
          * or global distribution */
 
         PMIX_CONSTRUCT(&bucket, pmix_buffer_t);
-        if (PMIX_SUCCESS != (rc = _collect_data(trk, &bucket, &size))) {
+        if (PMIX_SUCCESS != (rc = pmix_server_collect_data(trk, &bucket, &size))) {
             PMIX_ERROR_LOG(rc);
             PMIX_DESTRUCT(&bucket);
             /* clear the caddy from this tracker so it can be
@@ -2126,138 +2382,165 @@ cleanup:
     return rc;
 }
 
-static void _check_cached_events(int sd, short args, void *cbdata)
+/* replay a cached notification to a peer that just registered
+ * for it. Returns PMIX_ERR_TAKE_NEXT_OPTION if the notification
+ * is not for them */
+static pmix_status_t replay_cached_event(pmix_setup_caddy_t *scd, pmix_notify_caddy_t *cd)
 {
-    pmix_setup_caddy_t *scd = (pmix_setup_caddy_t *) cbdata;
-    pmix_notify_caddy_t *cd;
     pmix_range_trkr_t rngtrk;
     pmix_proc_t proc;
-    int i;
-    size_t k, n;
+    size_t n;
     bool found, matched;
     pmix_buffer_t *relay;
-    pmix_status_t ret = PMIX_SUCCESS;
+    pmix_status_t ret;
     pmix_cmd_t cmd = PMIX_NOTIFY_CMD;
 
-    PMIX_HIDE_UNUSED_PARAMS(sd, args);
-
-    /* check if any matching notifications have been cached */
-    rngtrk.procs = NULL;
-    rngtrk.nprocs = 0;
-    for (i = 0; i < pmix_globals.max_events; i++) {
-        pmix_hotel_knock(&pmix_globals.notifications, i, (void **) &cd);
-        if (NULL == cd) {
-            continue;
-        }
-        found = false;
-        if (NULL == scd->codes) {
-            if (!cd->nondefault) {
-                /* they registered a default event handler - always matches */
-                found = true;
+    /* check if the affected procs (if given) match those they
+     * wanted to know about */
+    if (!pmix_notify_check_affected(cd->affected, cd->naffected, scd->procs, scd->nprocs)) {
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+    /* check the range */
+    if (NULL == cd->targets) {
+        rngtrk.procs = &cd->source;
+        rngtrk.nprocs = 1;
+    } else {
+        rngtrk.procs = cd->targets;
+        rngtrk.nprocs = cd->ntargets;
+    }
+    rngtrk.range = cd->range;
+    PMIX_LOAD_PROCID(&proc, scd->peer->info->pname.nspace, scd->peer->info->pname.rank);
+    if (!pmix_notify_check_range(&rngtrk, &proc)) {
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+    /* if we were given specific targets, check if this is one */
+    found = false;
+    if (NULL != cd->targets) {
+        matched = false;
+        for (n = 0; n < cd->ntargets; n++) {
+            /* if the source of the event is the same peer just registered, then ignore it
+             * as the event notification system will have already locally
+             * processed it */
+            if (PMIX_CHECK_NAMES(&cd->source, &scd->peer->info->pname)) {
+                continue;
             }
-        } else {
-            for (k = 0; k < scd->ncodes; k++) {
-                if (scd->codes[k] == cd->status) {
-                    found = true;
-                    break;
+            if (PMIX_CHECK_NAMES(&scd->peer->info->pname, &cd->targets[n])) {
+                matched = true;
+                /* track the number of targets we have left to notify */
+                --cd->nleft;
+                /* if this is the last one, then evict this event
+                 * from the cache */
+                if (0 == cd->nleft) {
+                    pmix_notify_event_uncache(cd);
+                    found = true; // mark that we should release cd
                 }
+                break;
             }
         }
-        if (!found) {
-            continue;
-        }
-        /* check if the affected procs (if given) match those they
-         * wanted to know about */
-        if (!pmix_notify_check_affected(cd->affected, cd->naffected, scd->procs, scd->nprocs)) {
-            continue;
+        if (!matched) {
+            /* do not notify this one */
+            return PMIX_ERR_TAKE_NEXT_OPTION;
         }
-        /* check the range */
-        if (NULL == cd->targets) {
-            rngtrk.procs = &cd->source;
-            rngtrk.nprocs = 1;
-        } else {
-            rngtrk.procs = cd->targets;
-            rngtrk.nprocs = cd->ntargets;
+    }
+
+    /* all matches - notify */
+    relay = PMIX_NEW(pmix_buffer_t);
+    if (NULL == relay) {
+        /* nothing we can do */
+        PMIX_ERROR_LOG(PMIX_ERR_NOMEM);
+        return PMIX_ERR_NOMEM;
+    }
+    /* pack the info data stored in the event */
+    PMIX_BFROPS_PACK(ret, scd->peer, relay, &cmd, 1, PMIX_COMMAND);
+    if (PMIX_SUCCESS != ret) {
+        PMIX_ERROR_LOG(ret);
+        PMIX_RELEASE(relay);
+        return ret;
+    }
+    PMIX_BFROPS_PACK(ret, scd->peer, relay, &cd->status, 1, PMIX_STATUS);
+    if (PMIX_SUCCESS != ret) {
+        PMIX_ERROR_LOG(ret);
+        PMIX_RELEASE(relay);
+        return ret;
+    }
+    PMIX_BFROPS_PACK(ret, scd->peer, relay, &cd->source, 1, PMIX_PROC);
+    if (PMIX_SUCCESS != ret) {
+        PMIX_ERROR_LOG(ret);
+        PMIX_RELEASE(relay);
+        return ret;
+    }
+    PMIX_BFROPS_PACK(ret, scd->peer, relay, &cd->ninfo, 1, PMIX_SIZE);
+    if (PMIX_SUCCESS != ret) {
+        PMIX_ERROR_LOG(ret);
+        PMIX_RELEASE(relay);
+        return ret;
+    }
+    if (0 < cd->ninfo) {
+        PMIX_BFROPS_PACK(ret, scd->peer, relay, cd->info, cd->ninfo, PMIX_INFO);
+        if (PMIX_SUCCESS != ret) {
+            PMIX_ERROR_LOG(ret);
+            PMIX_RELEASE(relay);
+            return ret;
         }
-        rngtrk.range = cd->range;
-        PMIX_LOAD_PROCID(&proc, scd->peer->info->pname.nspace, scd->peer->info->pname.rank);
-        if (!pmix_notify_check_range(&rngtrk, &proc)) {
-            continue;
+    }
+    PMIX_SERVER_QUEUE_REPLY(ret, scd->peer, 0, relay);
+    if (PMIX_SUCCESS != ret) {
+        PMIX_RELEASE(relay);
+    }
+    if (found) {
+        PMIX_RELEASE(cd);
+    }
+    return PMIX_SUCCESS;
+}
+
+static void _check_cached_events(int sd, short args, void *cbdata)
+{
+    pmix_setup_caddy_t *scd = (pmix_setup_caddy_t *) cbdata;
+    pmix_notify_caddy_t *cd, *next;
+    size_t k, n, nreplayed = 0;
+    pmix_status_t rc, ret = PMIX_SUCCESS;
+
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    /* check if any matching notifications have been cached */
+    if (NULL == scd->codes) {
+        /* they registered a default event handler - matches
+         * everything not restricted to non-default handlers */
+        PMIX_NOTIFY_CACHE_FOREACH (cd, next) {
+            if (cd->nondefault) {
+                continue;
+            }
+            rc = replay_cached_event(scd, cd);
+            if (PMIX_SUCCESS == rc) {
+                ++nreplayed;
+            } else if (PMIX_ERR_TAKE_NEXT_OPTION != rc) {
+                ret = rc;
+                break;
+            }
         }
-        /* if we were given specific targets, check if this is one */
-        found = false;
-        if (NULL != cd->targets) {
-            matched = false;
-            for (n = 0; n < cd->ntargets; n++) {
-                /* if the source of the event is the same peer just registered, then ignore it
-                 * as the event notification system will have already locally
-                 * processed it */
-                if (PMIX_CHECK_NAMES(&cd->source, &scd->peer->info->pname)) {
-                    continue;
-                }
-                if (PMIX_CHECK_NAMES(&scd->peer->info->pname, &cd->targets[n])) {
-                    matched = true;
-                    /* track the number of targets we have left to notify */
-                    --cd->nleft;
-                    /* if this is the last one, then evict this event
-                     * from the cache */
-                    if (0 == cd->nleft) {
-                        pmix_hotel_checkout(&pmix_globals.notifications, cd->room);
-                        found = true; // mark that we should release cd
-                    }
+    } else {
+        for (k = 0; k < scd->ncodes && PMIX_SUCCESS == ret; k++) {
+            /* only look at each code once */
+            for (n = 0; n < k; n++) {
+                if (scd->codes[n] == scd->codes[k]) {
                     break;
                 }
             }
-            if (!matched) {
-                /* do not notify this one */
+            if (n < k) {
                 continue;
             }
-        }
-
-        /* all matches - notify */
-        relay = PMIX_NEW(pmix_buffer_t);
-        if (NULL == relay) {
-            /* nothing we can do */
-            PMIX_ERROR_LOG(PMIX_ERR_NOMEM);
-            ret = PMIX_ERR_NOMEM;
-            break;
-        }
-        /* pack the info data stored in the event */
-        PMIX_BFROPS_PACK(ret, scd->peer, relay, &cmd, 1, PMIX_COMMAND);
-        if (PMIX_SUCCESS != ret) {
-            PMIX_ERROR_LOG(ret);
-            break;
-        }
-        PMIX_BFROPS_PACK(ret, scd->peer, relay, &cd->status, 1, PMIX_STATUS);
-        if (PMIX_SUCCESS != ret) {
-            PMIX_ERROR_LOG(ret);
-            break;
-        }
-        PMIX_BFROPS_PACK(ret, scd->peer, relay, &cd->source, 1, PMIX_PROC);
-        if (PMIX_SUCCESS != ret) {
-            PMIX_ERROR_LOG(ret);
-            break;
-        }
-        PMIX_BFROPS_PACK(ret, scd->peer, relay, &cd->ninfo, 1, PMIX_SIZE);
-        if (PMIX_SUCCESS != ret) {
-            PMIX_ERROR_LOG(ret);
-            break;
-        }
-        if (0 < cd->ninfo) {
-            PMIX_BFROPS_PACK(ret, scd->peer, relay, cd->info, cd->ninfo, PMIX_INFO);
-            if (PMIX_SUCCESS != ret) {
-                PMIX_ERROR_LOG(ret);
-                break;
+            PMIX_NOTIFY_CACHE_FOREACH_CODE (cd, next, scd->codes[k]) {
+                rc = replay_cached_event(scd, cd);
+                if (PMIX_SUCCESS == rc) {
+                    ++nreplayed;
+                } else if (PMIX_ERR_TAKE_NEXT_OPTION != rc) {
+                    ret = rc;
+                    break;
+                }
             }
         }
-        PMIX_SERVER_QUEUE_REPLY(ret, scd->peer, 0, relay);
-        if (PMIX_SUCCESS != ret) {
-            PMIX_RELEASE(relay);
-        }
-        if (found) {
-            PMIX_RELEASE(cd);
-        }
     }
+    pmix_notify_event_replayed(nreplayed);
     /* release the caddy */
     if (NULL != scd->codes) {
         free(scd->codes);
@@ -2309,7 +2592,6 @@ pmix_status_t pmix_server_register_events(pmix_peer_t *peer, pmix_buffer_t *buf,
     pmix_peer_events_info_t *prev = NULL;
     pmix_setup_caddy_t *scd;
     bool enviro_events = false;
-    bool found;
     pmix_proc_t *affected = NULL;
     size_t naffected = 0;
 
@@ -2404,24 +2686,22 @@ pmix_status_t pmix_server_register_events(pmix_peer_t *peer, pmix_buffer_t *buf,
      * default event handler. In that case, check only for default
      * handlers and add this request to it, if not already present */
     if (0 == ncodes) {
-        PMIX_LIST_FOREACH (reginfo, &pmix_server_globals.events, pmix_regevents_info_t) {
-            if (PMIX_MAX_ERR_CONSTANT == reginfo->code) {
-                /* both are default handlers */
-                prev = PMIX_NEW(pmix_peer_events_info_t);
-                if (NULL == prev) {
-                    rc = PMIX_ERR_NOMEM;
-                    goto cleanup;
-                }
-                PMIX_RETAIN(peer);
-                prev->peer = peer;
-                if (NULL != affected) {
-                    PMIX_PROC_CREATE(prev->affected, naffected);
-                    prev->naffected = naffected;
-                    memcpy(prev->affected, affected, naffected * sizeof(pmix_proc_t));
-                }
-                pmix_list_append(&reginfo->peers, &prev->super);
-                break;
+        reginfo = pmix_server_event_lookup(PMIX_MAX_ERR_CONSTANT);
+        if (NULL != reginfo) {
+            /* both are default handlers */
+            prev = PMIX_NEW(pmix_peer_events_info_t);
+            if (NULL == prev) {
+                rc = PMIX_ERR_NOMEM;
+                goto cleanup;
             }
+            PMIX_RETAIN(peer);
+            prev->peer = peer;
+            if (NULL != affected) {
+                PMIX_PROC_CREATE(prev->affected, naffected);
+                prev->naffected = naffected;
+                memcpy(prev->affected, affected, naffected * sizeof(pmix_proc_t));
+            }
+            pmix_list_append(&reginfo->peers, &prev->super);
         }
         rc = PMIX_OPERATION_SUCCEEDED;
         goto cleanup;
@@ -2430,16 +2710,8 @@ pmix_status_t pmix_server_register_events(pmix_peer_t *peer, pmix_buffer_t *buf,
     /* store the event registration info so we can call the registered
      * client when the server notifies the event */
     for (n = 0; n < ncodes; n++) {
-        found = false;
-        PMIX_LIST_FOREACH (reginfo, &pmix_server_globals.events, pmix_regevents_info_t) {
-            if (PMIX_MAX_ERR_CONSTANT == reginfo->code) {
-                continue;
-            } else if (codes[n] == reginfo->code) {
-                found = true;
-                break;
-            }
-        }
-        if (found) {
+        reginfo = pmix_server_event_lookup(codes[n]);
+        if (NULL != reginfo) {
             /* found it - add this request */
             prev = PMIX_NEW(pmix_peer_events_info_t);
             if (NULL == prev) {
@@ -2463,7 +2735,11 @@ pmix_status_t pmix_server_register_events(pmix_peer_t *peer, pmix_buffer_t *buf,
                 goto cleanup;
             }
             rptr->code = codes[n];
-            pmix_list_append(&pmix_server_globals.events, &rptr->super);
+            rc = pmix_server_event_add(rptr);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_RELEASE(rptr);
+                goto cleanup;
+            }
             prev = PMIX_NEW(pmix_peer_events_info_t);
             if (NULL == prev) {
                 rc = PMIX_ERR_NOMEM;
@@ -2583,7 +2859,6 @@ void pmix_server_deregister_events(pmix_peer_t *peer, pmix_buffer_t *buf)
     int32_t cnt;
     pmix_status_t rc, code;
     pmix_regevents_info_t *reginfo = NULL;
-    pmix_regevents_info_t *reginfo_next;
     pmix_peer_events_info_t *prev;
 
     pmix_output_verbose(2, pmix_server_globals.event_output,
@@ -2595,25 +2870,23 @@ void pmix_server_deregister_events(pmix_peer_t *peer, pmix_buffer_t *buf)
     cnt = 1;
     PMIX_BFROPS_UNPACK(rc, peer, buf, &code, &cnt, PMIX_STATUS);
     while (PMIX_SUCCESS == rc) {
-        PMIX_LIST_FOREACH_SAFE (reginfo, reginfo_next, &pmix_server_globals.events,
-                                pmix_regevents_info_t) {
-            if (code == reginfo->code) {
-                /* found it - remove this peer from the list */
-                PMIX_LIST_FOREACH (prev, &reginfo->peers, pmix_peer_events_info_t) {
-                    if (prev->peer == peer) {
-                        /* found it */
-                        pmix_list_remove_item(&reginfo->peers, &prev->super);
-                        PMIX_RELEASE(prev);
-                        break;
-                    }
-                }
-                /* if all of the peers for this code are now gone, then remove it */
-                if (0 == pmix_list_get_size(&reginfo->peers)) {
-                    pmix_list_remove_item(&pmix_server_globals.events, &reginfo->super);
-                    /* if this was registered with the host, then deregister it */
-                    PMIX_RELEASE(reginfo);
+        reginfo = pmix_server_event_lookup(code);
+        if (NULL != reginfo) {
+            /* found it - remove this peer from the list */
+            PMIX_LIST_FOREACH (prev, &reginfo->peers, pmix_peer_events_info_t) {
+                if (prev->peer == peer) {
+                    /* found it */
+                    pmix_list_remove_item(&reginfo->peers, &prev->super);
+                    PMIX_RELEASE(prev);
+                    break;
                 }
             }
+            /* if all of the peers for this code are now gone, then remove it */
+            if (0 == pmix_list_get_size(&reginfo->peers)) {
+                pmix_server_event_remove(reginfo);
+                /* if this was registered with the host, then deregister it */
+                PMIX_RELEASE(reginfo);
+            }
         }
         cnt = 1;
         PMIX_BFROPS_UNPACK(rc, peer, buf, &code, &cnt, PMIX_STATUS);
@@ -4070,7 +4343,7 @@ release:
     }
 
     /* remove the tracker from the list */
-    pmix_list_remove_item(&pmix_server_globals.collectives, &trk->super);
+    pmix_server_trk_remove(trk);
     PMIX_RELEASE(trk);
 
     /* we are done */
@@ -4168,7 +4441,7 @@ static void grp_timeout(int sd, short args, void *cbdata)
         PMIX_RELEASE(psav);
     }
     /* remove the tracker from the list */
-    pmix_list_remove_item(&pmix_server_globals.collectives, &trk->super);
+    pmix_server_trk_remove(trk);
     PMIX_RELEASE(trk);
 }
 
@@ -4498,7 +4771,7 @@ pmix_status_t pmix_server_grpconstruct(pmix_server_caddy_t *cd, pmix_buffer_t *b
                     return PMIX_SUCCESS;
                 }
                 /* remove the tracker from the list */
-                pmix_list_remove_item(&pmix_server_globals.collectives, &trk->super);
+                pmix_server_trk_remove(trk);
                 PMIX_RELEASE(trk);
                 return rc;
             }
@@ -4520,7 +4793,7 @@ pmix_status_t pmix_server_grpconstruct(pmix_server_caddy_t *cd, pmix_buffer_t *b
     /* check if our host supports group operations */
     if (NULL == pmix_host_server.group) {
         /* cannot support it */
-        pmix_list_remove_item(&pmix_server_globals.collectives, &trk->super);
+        pmix_server_trk_remove(trk);
         PMIX_RELEASE(trk);
         return PMIX_ERR_NOT_SUPPORTED;
     }
@@ -4532,10 +4805,10 @@ pmix_status_t pmix_server_grpconstruct(pmix_server_caddy_t *cd, pmix_buffer_t *b
         0 < pmix_list_get_size(&trk->grpinfo)) {
         /* collect any remote contributions provided by group members */
         PMIX_CONSTRUCT(&bucket, pmix_buffer_t);
-        rc = _collect_data(trk, &bucket, &size);
+        rc = pmix_server_collect_data(trk, &bucket, &size);
         if (PMIX_SUCCESS != rc) {
             /* remove the tracker from the list */
-            pmix_list_remove_item(&pmix_server_globals.collectives, &trk->super);
+            pmix_server_trk_remove(trk);
             PMIX_RELEASE(trk);
             PMIX_DESTRUCT(&bucket);
             return rc;
@@ -4616,7 +4889,7 @@ pmix_status_t pmix_server_grpconstruct(pmix_server_caddy_t *cd, pmix_buffer_t *b
             return PMIX_SUCCESS;
         }
         /* remove the tracker from the list */
-        pmix_list_remove_item(&pmix_server_globals.collectives, &trk->super);
+        pmix_server_trk_remove(trk);
         PMIX_RELEASE(trk);
         return rc;
     }
@@ -4856,7 +5129,7 @@ pmix_status_t pmix_server_grpdestruct(pmix_server_caddy_t *cd, pmix_buffer_t *bu
                     return PMIX_SUCCESS;
                 }
                 /* remove the tracker from the list */
-                pmix_list_remove_item(&pmix_server_globals.collectives, &trk->super);
+                pmix_server_trk_remove(trk);
                 PMIX_RELEASE(trk);
                 return rc;
             }
@@ -4874,7 +5147,7 @@ pmix_status_t pmix_server_grpdestruct(pmix_server_caddy_t *cd, pmix_buffer_t *bu
      * supports group operations */
     if (NULL == pmix_host_server.group) {
         /* cannot support it */
-        pmix_list_remove_item(&pmix_server_globals.collectives, &trk->super);
+        pmix_server_trk_remove(trk);
         PMIX_RELEASE(trk);
         return PMIX_ERR_NOT_SUPPORTED;
     }
@@ -4889,7 +5162,7 @@ pmix_status_t pmix_server_grpdestruct(pmix_server_caddy_t *cd, pmix_buffer_t *bu
             return PMIX_SUCCESS;
         }
         /* remove the tracker from the list */
-        pmix_list_remove_item(&pmix_server_globals.collectives, &trk->super);
+        pmix_server_trk_remove(trk);
         PMIX_RELEASE(trk);
         return rc;
     }
@@ -5218,6 +5491,9 @@ static void tcon(pmix_server_trkr_t *t)
     t->pname.rank = PMIX_RANK_UNDEF;
     t->pcs = NULL;
     t->npcs = 0;
+    t->spcs = NULL;
+    t->sig = 0;
+    t->signext = NULL;
     PMIX_CONSTRUCT(&t->nslist, pmix_list_t);
     PMIX_CONSTRUCT_LOCK(&t->lock);
     t->def_complete = false;
@@ -5243,6 +5519,9 @@ static void tdes(pmix_server_trkr_t *t)
     if (NULL != t->pcs) {
         free(t->pcs);
     }
+    if (NULL != t->spcs) {
+        free(t->spcs);
+    }
     PMIX_LIST_DESTRUCT(&t->local_cbs);
     if (NULL != t->info) {
         PMIX_INFO_FREE(t->info, t->ninfo);
@@ -5371,6 +5650,7 @@ static void lmcon(pmix_dmdx_local_t *p)
     PMIX_CONSTRUCT(&p->loc_reqs, pmix_list_t);
     p->info = NULL;
     p->ninfo = 0;
+    p->pending = false;
 }
 static void lmdes(pmix_dmdx_local_t *p)
 {
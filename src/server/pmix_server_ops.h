@@ -25,6 +25,7 @@
 #include "src/include/pmix_types.h"
 
 #include "include/pmix_server.h"
+#include "src/class/pmix_bitmap.h"
 #include "src/class/pmix_hotel.h"
 #include "src/include/pmix_globals.h"
 #include "src/threads/pmix_threads.h"
@@ -114,6 +115,7 @@ typedef struct {
                           // all local ranks that are interested in this namespace-rank
     pmix_info_t *info;    // array of info structs for this request
     size_t ninfo;         // number of info structs
+    bool pending;         // awaiting a batched request to the host
 } pmix_dmdx_local_t;
 PMIX_CLASS_DECLARATION(pmix_dmdx_local_t);
 
@@ -180,14 +182,25 @@ PMIX_CLASS_DECLARATION(pmix_pset_t);
 
 typedef struct {
     pmix_list_t nspaces;          // list of pmix_nspace_t for the nspaces we know about
+    pmix_hash_table_t nsindex;    // entries of pmix_globals.nspaces indexed by name
     pmix_pointer_array_t clients; // array of pmix_peer_t local clients
     pmix_list_t collectives;      // list of active pmix_server_trkr_t
+    pmix_hash_table_t trk_sigs;   // active trackers indexed by signature
+    pmix_hash_table_t trk_ids;    // active trackers indexed by operation ID
     pmix_list_t remote_pnd; // list of pmix_dmdx_remote_t awaiting arrival of data fror servicing
                             // remote req's
     pmix_list_t local_reqs;     // list of pmix_dmdx_local_t awaiting arrival of data from local neighbours
+    pmix_hash_table_t dmdx_index;   // entries of local_reqs indexed by proc
+    pmix_event_t dmdx_ev;           // window for batching direct modex requests
+    bool dmdx_ev_active;
+    size_t dmdx_npending;           // number of local_reqs awaiting a batched request
+    int dmdx_batch_window;          // usec to collect direct modex requests before passing them up
+    int dmdx_batch_max;             // max number of procs in a batched request
     pmix_list_t gdata;  // cache of data given to me for passing to all clients
     char **genvars;     // argv array of envars given to me for passing to all clients
     pmix_list_t events; // list of pmix_regevents_info_t registered events
+    pmix_hash_table_t evindex;  // registered events indexed by status code
+    pmix_bitmap_t evnotified;   // peerids already notified of the event being delivered
     pmix_list_t groups; // list of pmix_group_t group memberships
     char **failedgrps;    // group IDs that failed to construct
     pmix_list_t iof;    // IO to be forwarded to clients
@@ -249,6 +262,22 @@ typedef struct {
     } while (0)
 
 PMIX_EXPORT bool pmix_server_trk_update(pmix_server_trkr_t *trk);
+PMIX_EXPORT void pmix_server_trk_remove(pmix_server_trkr_t *trk);
+/* assemble the local contributions of a fence - exported so
+ * the assembly can be exercised outside of a collective */
+PMIX_EXPORT pmix_status_t pmix_server_collect_data(pmix_server_trkr_t *trk,
+                                                   pmix_buffer_t *buf, size_t *size);
+
+PMIX_EXPORT pmix_regevents_info_t *pmix_server_event_lookup(pmix_status_t code);
+PMIX_EXPORT pmix_status_t pmix_server_event_add(pmix_regevents_info_t *reginfo);
+PMIX_EXPORT void pmix_server_event_remove(pmix_regevents_info_t *reginfo);
+
+PMIX_EXPORT pmix_namespace_t *pmix_server_nspace_lookup(const char *nspace);
+PMIX_EXPORT void pmix_server_nspace_remove(pmix_namespace_t *nptr);
+
+PMIX_EXPORT pmix_dmdx_local_t *pmix_server_dmdx_lookup(const char *nspace, pmix_rank_t rank);
+PMIX_EXPORT pmix_status_t pmix_server_dmdx_add(pmix_dmdx_local_t *lcd);
+PMIX_EXPORT void pmix_server_dmdx_remove(pmix_dmdx_local_t *lcd);
 
 PMIX_EXPORT void pmix_pending_nspace_requests(pmix_namespace_t *nptr);
 PMIX_EXPORT pmix_status_t pmix_pending_resolve(pmix_namespace_t *nptr, pmix_rank_t rank,
@@ -267,6 +296,8 @@ PMIX_EXPORT pmix_status_t pmix_server_fence(pmix_server_caddy_t *cd, pmix_buffer
 PMIX_EXPORT pmix_status_t pmix_server_get(pmix_buffer_t *buf, pmix_modex_cbfunc_t cbfunc,
                                           void *cbdata);
 
+PMIX_EXPORT pmix_status_t pmix_server_prefetch(pmix_server_caddy_t *cd, pmix_buffer_t *buf);
+
 PMIX_EXPORT pmix_status_t pmix_server_publish(pmix_peer_t *peer, pmix_buffer_t *buf,
                                               pmix_op_cbfunc_t cbfunc, void *cbdata);
 
@@ -640,11 +640,19 @@ PMIX_EXPORT int PMIx_tool_init(pmix_proc_t *proc, pmix_info_t info[], size_t nin
     rcv->cbfunc = tool_iof_handler;
     /* add it to the end of the list of recvs */
     pmix_list_append(&pmix_ptl_base.posted_recvs, &rcv->super);
+    /* setup the recv for streamed prefetch data */
+    rcv = PMIX_NEW(pmix_ptl_posted_recv_t);
+    rcv->tag = PMIX_PTL_TAG_PREFETCH;
+    rcv->cbfunc = pmix_client_prefetch_recv;
+    pmix_list_append(&pmix_ptl_base.posted_recvs, &rcv->super);
     /* default tools to outputting their IOF */
     pmix_globals.iof_flags.local_output = outputio;
 
     /* setup the globals */
     PMIX_CONSTRUCT(&pmix_client_globals.pending_requests, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_client_globals.prefetches, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_client_globals.prefetch_index, pmix_hash_table_t);
+    pmix_hash_table_init(&pmix_client_globals.prefetch_index, 256);
     PMIX_CONSTRUCT(&pmix_client_globals.peers, pmix_pointer_array_t);
     pmix_pointer_array_init(&pmix_client_globals.peers, 1, INT_MAX, 1);
     pmix_client_globals.myserver = PMIX_NEW(pmix_peer_t);
@@ -1514,6 +1522,8 @@ PMIX_EXPORT pmix_status_t PMIx_tool_finalize(void)
 
     PMIX_RELEASE(pmix_client_globals.myserver);
     PMIX_LIST_DESTRUCT(&pmix_client_globals.pending_requests);
+    PMIX_LIST_DESTRUCT(&pmix_client_globals.prefetches);
+    PMIX_DESTRUCT(&pmix_client_globals.prefetch_index);
     for (n = 0; n < pmix_client_globals.peers.size; n++) {
         if (NULL
             != (peer = (pmix_peer_t *) pmix_pointer_array_get_item(&pmix_client_globals.peers,
@@ -1535,10 +1545,20 @@ PMIX_EXPORT pmix_status_t PMIx_tool_finalize(void)
     (void) pmix_mca_base_framework_close(&pmix_pnet_base_framework);
     PMIX_DESTRUCT(&pmix_server_globals.clients);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.collectives);
+    PMIX_DESTRUCT(&pmix_server_globals.trk_sigs);
+    PMIX_DESTRUCT(&pmix_server_globals.trk_ids);
+    PMIX_DESTRUCT(&pmix_server_globals.nsindex);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.remote_pnd);
+    if (pmix_server_globals.dmdx_ev_active) {
+        pmix_event_del(&pmix_server_globals.dmdx_ev);
+        pmix_server_globals.dmdx_ev_active = false;
+    }
     PMIX_LIST_DESTRUCT(&pmix_server_globals.local_reqs);
+    PMIX_DESTRUCT(&pmix_server_globals.dmdx_index);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.gdata);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.events);
+    PMIX_DESTRUCT(&pmix_server_globals.evindex);
+    PMIX_DESTRUCT(&pmix_server_globals.evnotified);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.iof);
 
     (void) pmix_mca_base_framework_close(&pmix_pfexec_base_framework);
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "src/include/pmix_config.h"
+
+#include <string.h>
+#ifdef HAVE_ARPA_INET_H
+#    include <arpa/inet.h>
+#endif
+
+#include "src/include/pmix_prefetch.h"
+#include "src/include/pmix_types.h"
+#include "src/util/pmix_bswap.h"
+
+/* the vector kernels rely on the compiler letting us build individual
+ * functions for instruction sets beyond the baseline of the target, and
+ * on being able to ask the processor which of them it supports */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) \
+    && (defined(__clang__) || 4 < __GNUC__ || (4 == __GNUC__ && 9 <= __GNUC_MINOR__))
+#    define PMIX_BSWAP_X86 1
+#    include <immintrin.h>
+#else
+#    define PMIX_BSWAP_X86 0
+#endif
+
+typedef void (*pmix_bswap_fn_t)(void *dst, const void *src, size_t n);
+
+typedef struct {
+    const char *name;
+    pmix_bswap_fn_t swap16;
+    pmix_bswap_fn_t swap32;
+    pmix_bswap_fn_t swap64;
+} pmix_bswap_kernels_t;
+
+/* network order is the host order - 64-bit values are left alone
+ * by pmix_hton64 in the absence of byteswap support as well */
+static void copy_array(void *dst, const void *src, size_t len)
+{
+    if (dst != src) {
+        memmove(dst, src, len);
+    }
+}
+
+static void copy16(void *dst, const void *src, size_t n)
+{
+    copy_array(dst, src, n * sizeof(uint16_t));
+}
+
+static void copy32(void *dst, const void *src, size_t n)
+{
+    copy_array(dst, src, n * sizeof(uint32_t));
+}
+
+static void copy64(void *dst, const void *src, size_t n)
+{
+    copy_array(dst, src, n * sizeof(uint64_t));
+}
+
+static void scalar16(void *dst, const void *src, size_t n)
+{
+    const char *s = (const char *) src;
+    char *d = (char *) dst;
+    uint16_t tmp;
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        memcpy(&tmp, s + i * sizeof(tmp), sizeof(tmp));
+        tmp = pmix_htons(tmp);
+        memcpy(d + i * sizeof(tmp), &tmp, sizeof(tmp));
+    }
+}
+
+static void scalar32(void *dst, const void *src, size_t n)
+{
+    const char *s = (const char *) src;
+    char *d = (char *) dst;
+    uint32_t tmp;
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        memcpy(&tmp, s + i * sizeof(tmp), sizeof(tmp));
+        tmp = htonl(tmp);
+        memcpy(d + i * sizeof(tmp), &tmp, sizeof(tmp));
+    }
+}
+
+static void scalar64(void *dst, const void *src, size_t n)
+{
+    const char *s = (const char *) src;
+    char *d = (char *) dst;
+    uint64_t tmp;
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        memcpy(&tmp, s + i * sizeof(tmp), sizeof(tmp));
+        tmp = pmix_hton64(tmp);
+        memcpy(d + i * sizeof(tmp), &tmp, sizeof(tmp));
+    }
+}
+
+#if PMIX_BSWAP_X86
+
+/* byte shuffles that reverse each 2, 4 or 8-byte element of a
+ * 16-byte lane - the 256-bit shuffle applies them per lane */
+#    define PMIX_BSWAP16_MASK _mm_set_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1)
+#    define PMIX_BSWAP32_MASK _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3)
+#    define PMIX_BSWAP64_MASK _mm_set_epi8(8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7)
+
+#    define PMIX_BSWAP_SSSE3(name, width, mask, tail)                                          \
+        __attribute__((target("ssse3"))) static void name(void *dst, const void *src, size_t n) \
+        {                                                                                      \
+            const __m128i m = mask;                                                            \
+            const char *s = (const char *) src;                                                \
+            char *d = (char *) dst;                                                            \
+            size_t i, per = 16 / (width);                                                      \
+            __m128i v;                                                                         \
+                                                                                               \
+            for (i = 0; i + per <= n; i += per) {                                              \
+                v = _mm_loadu_si128((const __m128i *) (s + i * (width)));                      \
+                _mm_storeu_si128((__m128i *) (d + i * (width)), _mm_shuffle_epi8(v, m));       \
+            }                                                                                  \
+            tail(d + i * (width), s + i * (width), n - i);                                     \
+        }
+
+#    define PMIX_BSWAP_AVX2(name, width, mask, tail)                                          \
+        __attribute__((target("avx2"))) static void name(void *dst, const void *src, size_t n) \
+        {                                                                                     \
+            const __m256i m = _mm256_inserti128_si256(_mm256_castsi128_si256(mask), mask, 1); \
+            const char *s = (const char *) src;                                               \
+            char *d = (char *) dst;                                                           \
+            size_t i, per = 32 / (width);                                                     \
+            __m256i v;                                                                        \
+                                                                                              \
+            for (i = 0; i + per <= n; i += per) {                                             \
+                v = _mm256_loadu_si256((const __m256i *) (s + i * (width)));                  \
+                _mm256_storeu_si256((__m256i *) (d + i * (width)), _mm256_shuffle_epi8(v, m)); \
+            }                                                                                 \
+            tail(d + i * (width), s + i * (width), n - i);                                    \
+        }
+
+PMIX_BSWAP_SSSE3(ssse3_16, 2, PMIX_BSWAP16_MASK, scalar16)
+PMIX_BSWAP_SSSE3(ssse3_32, 4, PMIX_BSWAP32_MASK, scalar32)
+PMIX_BSWAP_SSSE3(ssse3_64, 8, PMIX_BSWAP64_MASK, scalar64)
+PMIX_BSWAP_AVX2(avx2_16, 2, PMIX_BSWAP16_MASK, ssse3_16)
+PMIX_BSWAP_AVX2(avx2_32, 4, PMIX_BSWAP32_MASK, ssse3_32)
+PMIX_BSWAP_AVX2(avx2_64, 8, PMIX_BSWAP64_MASK, ssse3_64)
+
+#endif
+
+static const pmix_bswap_kernels_t copy_kernels = {"none", copy16, copy32, copy64};
+static const pmix_bswap_kernels_t scalar_kernels = {"scalar", scalar16, scalar32, scalar64};
+#if PMIX_BSWAP_X86
+static const pmix_bswap_kernels_t ssse3_kernels = {"ssse3", ssse3_16, ssse3_32, ssse3_64};
+static const pmix_bswap_kernels_t avx2_kernels = {"avx2", avx2_16, avx2_32, avx2_64};
+#endif
+
+static const pmix_bswap_kernels_t *kernels = NULL;
+
+const char *pmix_bswap_select(bool simd)
+{
+    if (htonl(1) == 1) {
+        kernels = &copy_kernels;
+        return kernels->name;
+    }
+    kernels = &scalar_kernels;
+#if PMIX_BSWAP_X86
+    if (simd) {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            kernels = &avx2_kernels;
+        } else if (__builtin_cpu_supports("ssse3")) {
+            kernels = &ssse3_kernels;
+        }
+    }
+#else
+    PMIX_HIDE_UNUSED_PARAMS(simd);
+#endif
+    return kernels->name;
+}
+
+/* the selection is idempotent, so racing threads that
+ * both find it missing will simply agree on the result */
+static inline const pmix_bswap_kernels_t *get_kernels(void)
+{
+    if (PMIX_UNLIKELY(NULL == kernels)) {
+        (void) pmix_bswap_select(true);
+    }
+    return kernels;
+}
+
+void pmix_bswap16_array(void *dst, const void *src, size_t n)
+{
+    get_kernels()->swap16(dst, src, n);
+}
+
+void pmix_bswap32_array(void *dst, const void *src, size_t n)
+{
+    get_kernels()->swap32(dst, src, n);
+}
+
+void pmix_bswap64_array(void *dst, const void *src, size_t n)
+{
+#ifndef HAVE_UNIX_BYTESWAP
+    /* pmix_hton64 leaves 64-bit values alone here */
+    copy64(dst, src, n);
+#else
+    get_kernels()->swap64(dst, src, n);
+#endif
+}
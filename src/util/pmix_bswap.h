@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/* @file */
+
+#ifndef PMIX_UTIL_BSWAP_H
+#define PMIX_UTIL_BSWAP_H
+
+#include "src/include/pmix_config.h"
+
+#include <stdbool.h>
+#ifdef HAVE_SYS_TYPES_H
+#    include <sys/types.h>
+#endif
+
+#include "pmix_common.h"
+
+BEGIN_C_DECLS
+
+/**
+ * Convert arrays of integers between host and network byte order.
+ *
+ * Each function converts n elements from src into dst, which may be
+ * the same address but must not otherwise overlap. Neither pointer
+ * need be aligned. The conversion is its own inverse, so the same
+ * functions serve for both packing and unpacking, and the result is
+ * always identical to applying pmix_htons, htonl or pmix_hton64 to
+ * each element in turn.
+ *
+ * The kernels are chosen at runtime the first time any of them is
+ * used, preferring the widest vector instructions the processor
+ * supports and falling back to a portable scalar loop.
+ */
+PMIX_EXPORT void pmix_bswap16_array(void *dst, const void *src, size_t n);
+PMIX_EXPORT void pmix_bswap32_array(void *dst, const void *src, size_t n);
+PMIX_EXPORT void pmix_bswap64_array(void *dst, const void *src, size_t n);
+
+/**
+ * (Re)select the kernels, permitting the use of vector instructions
+ * only if simd is true, and return the name of the selection. This
+ * is not thread safe and is only intended for testing
+ */
+PMIX_EXPORT const char *pmix_bswap_select(bool simd);
+
+END_C_DECLS
+
+#endif /* PMIX_UTIL_BSWAP_H */
@@ -51,6 +51,10 @@ typedef struct {
      received from this process */
     pmix_pointer_array_t data;
     pmix_pointer_array_t quals;
+    /* index of key id -> first pmix_dstor_t stored for
+     * that key, with the remainder chained through the
+     * dstor's "next" field */
+    pmix_hash_table_t keys;
 } pmix_proc_data_t;
 static void pdcon(pmix_proc_data_t *p)
 {
@@ -58,6 +62,8 @@ static void pdcon(pmix_proc_data_t *p)
     pmix_pointer_array_init(&p->data, 128, INT_MAX, 128);
     PMIX_CONSTRUCT(&p->quals, pmix_pointer_array_t);
     pmix_pointer_array_init(&p->quals, 1, INT_MAX, 1);
+    PMIX_CONSTRUCT(&p->keys, pmix_hash_table_t);
+    pmix_hash_table_init(&p->keys, 32);
 }
 static void pddes(pmix_proc_data_t *p)
 {
@@ -67,6 +73,8 @@ static void pddes(pmix_proc_data_t *p)
     pmix_qual_t *q;
     pmix_data_array_t *darray;
 
+    /* the index doesn't own the entries */
+    PMIX_DESTRUCT(&p->keys);
     for (n=0; n < p->data.size; n++) {
         d = (pmix_dstor_t*)pmix_pointer_array_get_item(&p->data, n);
         if (NULL != d) {
@@ -98,8 +106,30 @@ static pmix_dstor_t *lookup_keyval(pmix_proc_data_t *proc, uint32_t kid,
 static pmix_proc_data_t *lookup_proc(pmix_hash_table_t *jtable, uint32_t id, bool create);
 static void erase_qualifiers(pmix_proc_data_t *proc,
                              uint32_t index);
+static void index_keyval(pmix_proc_data_t *proc, pmix_dstor_t *d);
+static void unindex_keyval(pmix_proc_data_t *proc, pmix_dstor_t *d);
 
 
+/* take a value for storage - borrowed data is kept as it
+ * is, along with a reference to the storage it lives in */
+static pmix_status_t store_value(pmix_dstor_t *hv, pmix_kval_t *kin)
+{
+    pmix_status_t rc;
+
+    if (NULL != kin->storage) {
+        hv->value = (pmix_value_t *) malloc(sizeof(pmix_value_t));
+        if (NULL == hv->value) {
+            return PMIX_ERR_NOMEM;
+        }
+        memcpy(hv->value, kin->value, sizeof(pmix_value_t));
+        PMIX_RETAIN(kin->storage);
+        hv->storage = kin->storage;
+        return PMIX_SUCCESS;
+    }
+    PMIX_BFROPS_COPY(rc, pmix_globals.mypeer, (void **)&hv->value, kin->value, PMIX_VALUE);
+    return rc;
+}
+
 pmix_status_t pmix_hash_store(pmix_hash_table_t *table,
                               pmix_rank_t rank, pmix_kval_t *kin,
                               pmix_info_t *qualifiers, size_t nquals)
@@ -168,10 +198,9 @@ pmix_status_t pmix_hash_store(pmix_hash_table_t *table,
                             PMIX_NAME_PRINT(&pmix_globals.myid), tmp);
                 free(tmp);
             }
-            PMIX_VALUE_RELEASE(hv->value);
         }
-        /* eventually, we want to eliminate this copy */
-        PMIX_BFROPS_COPY(rc, pmix_globals.mypeer, (void **)&hv->value, kin->value, PMIX_VALUE);
+        PMIX_DSTOR_VALUE_RELEASE(hv);
+        rc = store_value(hv, kin);
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
             return rc;
@@ -210,7 +239,7 @@ pmix_status_t pmix_hash_store(pmix_hash_table_t *table,
                         PMIX_DSTOR_RELEASE(hv);
                         return PMIX_ERR_BAD_PARAM;
                     }
-                    qarray[n].index = p->index;
+                    qarray[m].index = p->index;
                     PMIX_BFROPS_COPY(rc, pmix_globals.mypeer, (void **)&qarray[m].value, &qualifiers[n].value, PMIX_VALUE);
                     if (PMIX_SUCCESS != rc) {
                         PMIX_ERROR_LOG(rc);
@@ -224,8 +253,7 @@ pmix_status_t pmix_hash_store(pmix_hash_table_t *table,
         }
     }
 
-    /* eventually, we want to eliminate this copy */
-    PMIX_BFROPS_COPY(rc, pmix_globals.mypeer, (void **)&hv->value, kin->value, PMIX_VALUE);
+    rc = store_value(hv, kin);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         if (UINT32_MAX != hv->qualindex) {
@@ -245,6 +273,7 @@ pmix_status_t pmix_hash_store(pmix_hash_table_t *table,
         free(v);
     }
     pmix_pointer_array_add(&proc_data->data, hv);
+    index_keyval(proc_data, hv);
     return PMIX_SUCCESS;
 }
 
@@ -442,9 +471,8 @@ pmix_status_t pmix_hash_remove_data(pmix_hash_table_t *table,
                     for (n=0; n < proc_data->data.size; n++) {
                         d = (pmix_dstor_t*)pmix_pointer_array_get_item(&proc_data->data, n);
                         if (NULL != d && kid == d->index) {
-                            if (NULL != d->value) {
-                                PMIX_VALUE_RELEASE(d->value);
-                            }
+                            unindex_keyval(proc_data, d);
+                            PMIX_DSTOR_VALUE_RELEASE(d);
                             if (UINT32_MAX != d->qualindex) {
                                 erase_qualifiers(proc_data, d->qualindex);
                             }
@@ -472,9 +500,7 @@ pmix_status_t pmix_hash_remove_data(pmix_hash_table_t *table,
         for (n=0; n < proc_data->data.size; n++) {
             d = (pmix_dstor_t*)pmix_pointer_array_get_item(&proc_data->data, n);
             if (NULL != d) {
-                if (NULL != d->value) {
-                    PMIX_VALUE_RELEASE(d->value);
-                }
+                PMIX_DSTOR_VALUE_RELEASE(d);
                 if (UINT32_MAX != d->qualindex) {
                     erase_qualifiers(proc_data, d->qualindex);
                 }
@@ -493,9 +519,8 @@ pmix_status_t pmix_hash_remove_data(pmix_hash_table_t *table,
     for (n=0; n < proc_data->data.size; n++) {
         d = (pmix_dstor_t*)pmix_pointer_array_get_item(&proc_data->data, n);
         if (NULL != d && kid == d->index) {
-            if (NULL != d->value) {
-                PMIX_VALUE_RELEASE(d->value);
-            }
+            unindex_keyval(proc_data, d);
+            PMIX_DSTOR_VALUE_RELEASE(d);
             if (UINT32_MAX != d->qualindex) {
                 erase_qualifiers(proc_data, d->qualindex);
             }
@@ -509,19 +534,16 @@ pmix_status_t pmix_hash_remove_data(pmix_hash_table_t *table,
 }
 
 /**
- * Find data for a given key in a given pmix_list_t.
+ * Find data for a given key in the given proc's data
  */
 static pmix_dstor_t *lookup_keyval(pmix_proc_data_t *proc_data, uint32_t kid,
                                    pmix_info_t *qualifiers, size_t nquals)
 {
-    pmix_dstor_t *d;
+    pmix_dstor_t *d = NULL;
     pmix_data_array_t *darray;
     pmix_qual_t *qarray;
     pmix_regattr_input_t *p;
     size_t m, numquals = 0, nq, nfound;
-    int n;
-
-    p = pmix_hash_lookup_key(kid, NULL);
 
     if (NULL != qualifiers) {
         /* count the qualifiers */
@@ -533,53 +555,50 @@ static pmix_dstor_t *lookup_keyval(pmix_proc_data_t *proc_data, uint32_t kid,
         }
     }
 
-    for (n=0; n < proc_data->data.size; n++) {
-        d = (pmix_dstor_t*)pmix_pointer_array_get_item(&proc_data->data, n);
-        if (NULL == d) {
-            continue;
-        }
-        if (kid == d->index) {
-            if (0 < numquals) {
-                if (UINT32_MAX == d->qualindex) {
+    /* the index provides every entry stored against this key,
+     * so we only need to check their qualifiers */
+    pmix_hash_table_get_value_uint32(&proc_data->keys, kid, (void**)&d);
+    for (; NULL != d; d = d->next) {
+        if (0 < numquals) {
+            if (UINT32_MAX == d->qualindex) {
+                continue;
+            }
+            darray = (pmix_data_array_t*)pmix_pointer_array_get_item(&proc_data->quals, d->qualindex);
+            qarray = (pmix_qual_t*)darray->array;
+            nfound = 0;
+            /* check the qualifiers */
+            for (m=0; m < nquals; m++) {
+                /* if this isn't marked as a qualifier, skip it */
+                if (!PMIX_INFO_IS_QUALIFIER(&qualifiers[m])) {
                     continue;
                 }
-                darray = (pmix_data_array_t*)pmix_pointer_array_get_item(&proc_data->quals, d->qualindex);
-                qarray = (pmix_qual_t*)darray->array;
-                nfound = 0;
-                /* check the qualifiers */
-                for (m=0; m < nquals; m++) {
-                    /* if this isn't marked as a qualifier, skip it */
-                    if (!PMIX_INFO_IS_QUALIFIER(&qualifiers[m])) {
-                        continue;
-                    }
-                    p = pmix_hash_lookup_key(UINT32_MAX, qualifiers[m].key);
-                    if (NULL == p) {
-                        /* we don't know this key */
-                        return NULL;
-                    }
-                    for (nq=0; nq < darray->size; nq++) {
-                        /* see if the keys match */
-                        if (qarray[nq].index == p->index) {
-                            /* if the values don't match, then we reject
-                             * this entry */
-                            if (PMIX_EQUAL == PMIx_Value_compare(&qualifiers[m].value, qarray[nq].value)) {
-                                /* match! */
-                                ++nfound;
-                                break;
-                            }
+                p = pmix_hash_lookup_key(UINT32_MAX, qualifiers[m].key);
+                if (NULL == p) {
+                    /* we don't know this key */
+                    return NULL;
+                }
+                for (nq=0; nq < darray->size; nq++) {
+                    /* see if the keys match */
+                    if (qarray[nq].index == p->index) {
+                        /* if the values don't match, then we reject
+                         * this entry */
+                        if (PMIX_EQUAL == PMIx_Value_compare(&qualifiers[m].value, qarray[nq].value)) {
+                            /* match! */
+                            ++nfound;
+                            break;
                         }
                     }
                 }
-                /* did we get a complete match? */
-                if (nfound == numquals) {
-                    return d;
-                }
-            } else {
-                /* if the stored key is also "unqualified",
-                 * then return it */
-                if (UINT32_MAX == d->qualindex) {
-                    return d;
-                }
+            }
+            /* did we get a complete match? */
+            if (nfound == numquals) {
+                return d;
+            }
+        } else {
+            /* if the stored key is also "unqualified",
+             * then return it */
+            if (UINT32_MAX == d->qualindex) {
+                return d;
             }
         }
     }
@@ -587,6 +606,43 @@ static pmix_dstor_t *lookup_keyval(pmix_proc_data_t *proc_data, uint32_t kid,
     return NULL;
 }
 
+/* add an entry to the key index - entries for the same
+ * key are kept in the order in which they were stored */
+static void index_keyval(pmix_proc_data_t *proc, pmix_dstor_t *d)
+{
+    pmix_dstor_t *head = NULL, *tail;
+
+    d->next = NULL;
+    pmix_hash_table_get_value_uint32(&proc->keys, d->index, (void**)&head);
+    if (NULL == head) {
+        pmix_hash_table_set_value_uint32(&proc->keys, d->index, d);
+        return;
+    }
+    for (tail = head; NULL != tail->next; tail = tail->next);
+    tail->next = d;
+}
+
+static void unindex_keyval(pmix_proc_data_t *proc, pmix_dstor_t *d)
+{
+    pmix_dstor_t *head = NULL, *prev;
+
+    pmix_hash_table_get_value_uint32(&proc->keys, d->index, (void**)&head);
+    if (head == d) {
+        if (NULL == d->next) {
+            pmix_hash_table_remove_value_uint32(&proc->keys, d->index);
+        } else {
+            pmix_hash_table_set_value_uint32(&proc->keys, d->index, d->next);
+        }
+        return;
+    }
+    for (prev = head; NULL != prev; prev = prev->next) {
+        if (prev->next == d) {
+            prev->next = d->next;
+            return;
+        }
+    }
+}
+
 /**
  * Find proc_data_t container associated with given
  * pmix_identifier_t.
@@ -618,6 +674,11 @@ void pmix_hash_register_key(uint32_t inid,
         pmix_pointer_array_set_item(&pmix_globals.keyindex, pmix_globals.next_keyid, ptr);
         ptr->index = pmix_globals.next_keyid;
         pmix_globals.next_keyid += 1;
+        /* and track it in the keymap so the string can be found */
+        if (0 < pmix_globals.keymap.ht_capacity) {
+            pmix_hash_table_set_value_ptr(&pmix_globals.keymap, ptr->string,
+                                          strlen(ptr->string), ptr);
+        }
         return;
     }
 
@@ -631,10 +692,48 @@ void pmix_hash_register_key(uint32_t inid,
     pmix_pointer_array_set_item(&pmix_globals.keyindex, inid, ptr);
 }
 
+static pmix_regattr_input_t* scan_keys(int start, int end, const char *key)
+{
+    int id;
+    pmix_regattr_input_t *ptr;
+
+    for (id = start; id < end; id++) {
+        ptr = pmix_pointer_array_get_item(&pmix_globals.keyindex, id);
+        if (NULL != ptr) {
+            if (0 == strcmp(key, ptr->string)) {
+                return ptr;
+            }
+        }
+    }
+    return NULL;
+}
+
+static pmix_regattr_input_t* lookup_reserved(const char *key)
+{
+    uint32_t h, slot;
+    int32_t d;
+    pmix_regattr_input_t *ptr;
+
+    /* the perfect hash gives us the only possible candidate */
+    PMIX_HASH_FNV1A(key, 0, h);
+    d = pmix_dictionary_phash_displace[h % PMIX_DICTIONARY_PHASH_SIZE];
+    if (d < 0) {
+        slot = (uint32_t)(-d - 1);
+    } else {
+        PMIX_HASH_FNV1A(key, d, h);
+        slot = h % PMIX_DICTIONARY_PHASH_SIZE;
+    }
+    ptr = pmix_pointer_array_get_item(&pmix_globals.keyindex,
+                                      pmix_dictionary_phash_index[slot]);
+    if (NULL != ptr && 0 == strcmp(key, ptr->string)) {
+        return ptr;
+    }
+    return NULL;
+}
+
 pmix_regattr_input_t* pmix_hash_lookup_key(uint32_t inid,
                                            const char *key)
 {
-    int id;
     pmix_regattr_input_t *ptr = NULL;
 
     if (UINT32_MAX == inid) {
@@ -643,25 +742,22 @@ pmix_regattr_input_t* pmix_hash_lookup_key(uint32_t inid,
             return NULL;
         }
         if (PMIX_CHECK_RESERVED_KEY(key)) {
-            /* reserved keys are in the front of the table */
-            for (id = 0; id < PMIX_INDEX_BOUNDARY; id++) {
-                ptr = pmix_pointer_array_get_item(&pmix_globals.keyindex, id);
-                if (NULL != ptr) {
-                    if (0 == strcmp(key, ptr->string)) {
-                        return ptr;
-                    }
-                }
-            }
-            /* reserved keys must already have been registered */
-            return NULL;
+            /* reserved keys are in the front of the table and
+             * must already have been registered */
+            return lookup_reserved(key);
         }
         /* unreserved keys are at the back of the table */
-        for (id = PMIX_INDEX_BOUNDARY; id < pmix_globals.keyindex.size; id++) {
-            ptr = pmix_pointer_array_get_item(&pmix_globals.keyindex, id);
+        if (0 < pmix_globals.keymap.ht_capacity) {
+            if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&pmix_globals.keymap, key,
+                                                              strlen(key), (void**)&ptr)) {
+                return ptr;
+            }
+        } else {
+            /* the keymap has not been setup yet, so we have
+             * to search the table */
+            ptr = scan_keys(PMIX_INDEX_BOUNDARY, pmix_globals.keyindex.size, key);
             if (NULL != ptr) {
-                if (0 == strcmp(key, ptr->string)) {
-                    return ptr;
-                }
+                return ptr;
             }
         }
         /* we didn't find it - register it */
@@ -0,0 +1,409 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measure the cost of packing and unpacking representative
+ * workloads - info arrays, values, procs, apps and the key-value
+ * pairs of a modex blob - through every available bfrops module.
+ * Each round trip is checked against the original so that the
+ * program also serves as a regression test of the wire formats.
+ * Times are in ns per operation and sizes in packed bytes per
+ * operation, where an operation is one call packing the full
+ * workload
+ *
+ * Usage: bfrops_bench [iterations] [module,...]
+ */
+
+#include "src/include/pmix_config.h"
+#include "include/pmix_server.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "src/include/pmix_globals.h"
+#include "src/mca/bfrops/base/base.h"
+#include "src/util/pmix_argv.h"
+#include "src/util/pmix_output.h"
+
+#include "perf_common.h"
+
+#define NINFO 12
+#define NVALS 8
+#define NPROCS 64
+#define NAPPS 2
+#define NKVALS 16
+#define BLOBSIZE 512
+
+static const char *allmodules[] = {"v12", "v20", "v21", "v3", "v4", "v41", "v5", NULL};
+
+typedef struct {
+    const char *name;
+    pmix_data_type_t type;
+    void *src;
+    int32_t nvals;
+    size_t width;
+    bool (*check)(void *src, void *dst, int32_t n);
+    void (*release)(void *dst, int32_t n);
+} workload_t;
+
+/* the info and value checks compare only what every module carries */
+static bool check_info(void *src, void *dst, int32_t n)
+{
+    pmix_info_t *s = (pmix_info_t *) src, *d = (pmix_info_t *) dst;
+    int32_t i;
+
+    for (i = 0; i < n; i++) {
+        if (!PMIX_CHECK_KEY(&d[i], s[i].key) || s[i].value.type != d[i].value.type) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void release_info(void *dst, int32_t n)
+{
+    pmix_info_t *d = (pmix_info_t *) dst;
+    int32_t i;
+
+    for (i = 0; i < n; i++) {
+        PMIX_INFO_DESTRUCT(&d[i]);
+    }
+}
+
+static bool check_value(void *src, void *dst, int32_t n)
+{
+    pmix_value_t *s = (pmix_value_t *) src, *d = (pmix_value_t *) dst;
+    int32_t i;
+
+    for (i = 0; i < n; i++) {
+        if (s[i].type != d[i].type) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void release_value(void *dst, int32_t n)
+{
+    pmix_value_t *d = (pmix_value_t *) dst;
+    int32_t i;
+
+    for (i = 0; i < n; i++) {
+        PMIX_VALUE_DESTRUCT(&d[i]);
+    }
+}
+
+static bool check_proc(void *src, void *dst, int32_t n)
+{
+    pmix_proc_t *s = (pmix_proc_t *) src, *d = (pmix_proc_t *) dst;
+    int32_t i;
+
+    for (i = 0; i < n; i++) {
+        if (!PMIX_CHECK_PROCID(&s[i], &d[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void release_proc(void *dst, int32_t n)
+{
+    PMIX_HIDE_UNUSED_PARAMS(dst, n);
+}
+
+static bool check_app(void *src, void *dst, int32_t n)
+{
+    pmix_app_t *s = (pmix_app_t *) src, *d = (pmix_app_t *) dst;
+    int32_t i;
+
+    for (i = 0; i < n; i++) {
+        if (NULL == d[i].cmd || 0 != strcmp(s[i].cmd, d[i].cmd)
+            || s[i].maxprocs != d[i].maxprocs || s[i].ninfo != d[i].ninfo
+            || PMIx_Argv_count(s[i].argv) != PMIx_Argv_count(d[i].argv)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void release_app(void *dst, int32_t n)
+{
+    pmix_app_t *d = (pmix_app_t *) dst;
+    int32_t i;
+
+    for (i = 0; i < n; i++) {
+        PMIX_APP_DESTRUCT(&d[i]);
+    }
+}
+
+static bool check_kval(void *src, void *dst, int32_t n)
+{
+    pmix_kval_t *s = (pmix_kval_t *) src, *d = (pmix_kval_t *) dst;
+    int32_t i;
+
+    for (i = 0; i < n; i++) {
+        if (NULL == d[i].key || 0 != strcmp(s[i].key, d[i].key) || NULL == d[i].value
+            || PMIX_EQUAL != PMIx_Value_compare(s[i].value, d[i].value)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void release_kval(void *dst, int32_t n)
+{
+    pmix_kval_t *d = (pmix_kval_t *) dst;
+    int32_t i;
+
+    for (i = 0; i < n; i++) {
+        PMIX_DESTRUCT(&d[i]);
+    }
+}
+
+/* the directives and attributes typical of a get or fence */
+static pmix_info_t *build_info(void)
+{
+    pmix_info_t *info;
+    uint32_t u32 = 1024;
+    uint64_t u64 = 1ULL << 40;
+    size_t sz = 4096;
+    int i32 = -17;
+    bool flag = true;
+
+    PMIX_INFO_CREATE(info, NINFO);
+    PMIX_INFO_LOAD(&info[0], PMIX_COLLECT_DATA, &flag, PMIX_BOOL);
+    PMIX_INFO_LOAD(&info[1], PMIX_TIMEOUT, &i32, PMIX_INT);
+    PMIX_INFO_LOAD(&info[2], PMIX_IMMEDIATE, &flag, PMIX_BOOL);
+    PMIX_INFO_LOAD(&info[3], PMIX_HOSTNAME, "node0042.cluster.example.org", PMIX_STRING);
+    PMIX_INFO_LOAD(&info[4], PMIX_LOCAL_SIZE, &u32, PMIX_UINT32);
+    PMIX_INFO_LOAD(&info[5], PMIX_JOB_SIZE, &u32, PMIX_UINT32);
+    PMIX_INFO_LOAD(&info[6], PMIX_NSPACE, "prterun-node0042-12345@1", PMIX_STRING);
+    PMIX_INFO_LOAD(&info[7], PMIX_AVAIL_PHYS_MEMORY, &u64, PMIX_UINT64);
+    PMIX_INFO_LOAD(&info[8], PMIX_MAX_PROCS, &sz, PMIX_SIZE);
+    PMIX_INFO_LOAD(&info[9], "app.user.key", "user-provided value", PMIX_STRING);
+    PMIX_INFO_LOAD(&info[10], PMIX_OPTIONAL, &flag, PMIX_BOOL);
+    PMIX_INFO_LOAD(&info[11], PMIX_TMPDIR, "/tmp/prte.node0042.1000/dvm.12345", PMIX_STRING);
+    return info;
+}
+
+static pmix_value_t *build_values(void)
+{
+    pmix_value_t *vals;
+    uint32_t u32 = 7;
+    uint64_t u64 = 123456789;
+    double d = 3.14159;
+    bool flag = false;
+    int n;
+
+    vals = (pmix_value_t *) calloc(NVALS, sizeof(pmix_value_t));
+    for (n = 0; n < NVALS; n += 4) {
+        PMIX_VALUE_LOAD(&vals[n], "tcp://10.0.0.42:51234", PMIX_STRING);
+        PMIX_VALUE_LOAD(&vals[n + 1], &u32, PMIX_UINT32);
+        PMIX_VALUE_LOAD(&vals[n + 2], (0 == n) ? (void *) &u64 : (void *) &d,
+                        (0 == n) ? PMIX_UINT64 : PMIX_DOUBLE);
+        PMIX_VALUE_LOAD(&vals[n + 3], &flag, PMIX_BOOL);
+    }
+    return vals;
+}
+
+static pmix_proc_t *build_procs(void)
+{
+    pmix_proc_t *procs;
+    int n;
+
+    PMIX_PROC_CREATE(procs, NPROCS);
+    for (n = 0; n < NPROCS; n++) {
+        PMIX_LOAD_PROCID(&procs[n], "prterun-node0042-12345@1", n);
+    }
+    return procs;
+}
+
+static pmix_app_t *build_apps(void)
+{
+    pmix_app_t *apps;
+    int n;
+
+    PMIX_APP_CREATE(apps, NAPPS);
+    for (n = 0; n < NAPPS; n++) {
+        apps[n].cmd = strdup("/usr/local/bin/solver");
+        PMIx_Argv_append_nosize(&apps[n].argv, "solver");
+        PMIx_Argv_append_nosize(&apps[n].argv, "--input");
+        PMIx_Argv_append_nosize(&apps[n].argv, "/scratch/case42/mesh.h5");
+        PMIx_Argv_append_nosize(&apps[n].env, "OMP_NUM_THREADS=4");
+        PMIx_Argv_append_nosize(&apps[n].env, "PATH=/usr/local/bin:/usr/bin:/bin");
+        apps[n].cwd = strdup("/scratch/case42");
+        apps[n].maxprocs = 16;
+        PMIX_INFO_CREATE(apps[n].info, 2);
+        apps[n].ninfo = 2;
+        PMIX_INFO_LOAD(&apps[n].info[0], PMIX_WDIR, "/scratch/case42", PMIX_STRING);
+        PMIX_INFO_LOAD(&apps[n].info[1], PMIX_PREFIX, "/usr/local", PMIX_STRING);
+    }
+    return apps;
+}
+
+/* the endpoint and fabric entries a process commits to the modex */
+static pmix_kval_t *build_kvals(void)
+{
+    pmix_kval_t *kvals;
+    pmix_byte_object_t bo;
+    char key[PMIX_MAX_KEYLEN];
+    uint32_t u32;
+    int n;
+
+    kvals = (pmix_kval_t *) calloc(NKVALS, sizeof(pmix_kval_t));
+    bo.bytes = (char *) malloc(BLOBSIZE);
+    bo.size = BLOBSIZE;
+    for (n = 0; n < BLOBSIZE; n++) {
+        bo.bytes[n] = (char) (n * 7);
+    }
+    for (n = 0; n < NKVALS; n++) {
+        PMIX_CONSTRUCT(&kvals[n], pmix_kval_t);
+        snprintf(key, sizeof(key), "btl.tcp.%d", n);
+        kvals[n].key = strdup(key);
+        PMIX_VALUE_CREATE(kvals[n].value, 1);
+        switch (n % 3) {
+        case 0:
+            PMIX_VALUE_LOAD(kvals[n].value, &bo, PMIX_BYTE_OBJECT);
+            break;
+        case 1:
+            PMIX_VALUE_LOAD(kvals[n].value, "fe80::21e:67ff:fe0d:42", PMIX_STRING);
+            break;
+        default:
+            u32 = n;
+            PMIX_VALUE_LOAD(kvals[n].value, &u32, PMIX_UINT32);
+            break;
+        }
+    }
+    free(bo.bytes);
+    return kvals;
+}
+
+static bool selected(char **modules, const char *name)
+{
+    int n;
+
+    if (NULL == modules) {
+        return true;
+    }
+    for (n = 0; NULL != modules[n]; n++) {
+        if (0 == strcmp(modules[n], name)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static pmix_status_t run(pmix_bfrops_module_t *bfrops, workload_t *w, int iters, double *nsop,
+                         size_t *bytes)
+{
+    struct timespec start, end;
+    pmix_buffer_t buf;
+    pmix_status_t rc;
+    int32_t cnt;
+    void *dst;
+    int i;
+
+    dst = calloc(w->nvals, w->width);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (i = 0; i < iters; i++) {
+        PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+        buf.type = pmix_bfrops_globals.default_type;
+        rc = bfrops->pack(&buf, w->src, w->nvals, w->type);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_DESTRUCT(&buf);
+            free(dst);
+            return rc;
+        }
+        *bytes = buf.bytes_used;
+        cnt = w->nvals;
+        rc = bfrops->unpack(&buf, dst, &cnt, w->type);
+        if (PMIX_SUCCESS != rc || cnt != w->nvals || !w->check(w->src, dst, cnt)) {
+            PMIX_DESTRUCT(&buf);
+            free(dst);
+            return (PMIX_SUCCESS == rc) ? PMIX_ERR_UNPACK_FAILURE : rc;
+        }
+        w->release(dst, cnt);
+        memset(dst, 0, w->nvals * w->width);
+        PMIX_DESTRUCT(&buf);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    *nsop = perf_elapsed(&start, &end) / iters;
+    free(dst);
+    return PMIX_SUCCESS;
+}
+
+int main(int argc, char **argv)
+{
+    pmix_bfrops_module_t *bfrops;
+    pmix_status_t rc;
+    char **modules = NULL;
+    int iters = 1000, m, w, failed = 0;
+    double nsop;
+    size_t bytes;
+    workload_t work[] = {
+        {"info", PMIX_INFO, NULL, NINFO, sizeof(pmix_info_t), check_info, release_info},
+        {"value", PMIX_VALUE, NULL, NVALS, sizeof(pmix_value_t), check_value, release_value},
+        {"proc", PMIX_PROC, NULL, NPROCS, sizeof(pmix_proc_t), check_proc, release_proc},
+        {"app", PMIX_APP, NULL, NAPPS, sizeof(pmix_app_t), check_app, release_app},
+        {"modex", PMIX_KVAL, NULL, NKVALS, sizeof(pmix_kval_t), check_kval, release_kval},
+        {NULL, PMIX_UNDEF, NULL, 0, 0, NULL, NULL}};
+
+    if (1 < argc) {
+        iters = strtol(argv[1], NULL, 10);
+    }
+    if (2 < argc) {
+        modules = PMIx_Argv_split(argv[2], ',');
+    }
+
+    if (PMIX_SUCCESS != (rc = perf_server_init(NULL))) {
+        exit(rc);
+    }
+
+    work[0].src = build_info();
+    work[1].src = build_values();
+    work[2].src = build_procs();
+    work[3].src = build_apps();
+    work[4].src = build_kvals();
+
+    fprintf(stdout, "%-6s %-8s %12s %10s\n", "module", "workload", "ns/op", "bytes/op");
+    for (m = 0; NULL != allmodules[m]; m++) {
+        if (!selected(modules, allmodules[m])) {
+            continue;
+        }
+        bfrops = pmix_bfrops_base_assign_module(allmodules[m]);
+        if (NULL == bfrops) {
+            /* not built in this installation */
+            continue;
+        }
+        for (w = 0; NULL != work[w].name; w++) {
+            rc = run(bfrops, &work[w], iters, &nsop, &bytes);
+            if (PMIX_SUCCESS != rc) {
+                fprintf(stdout, "%-6s %-8s FAILED: %s\n", allmodules[m], work[w].name,
+                        PMIx_Error_string(rc));
+                ++failed;
+                continue;
+            }
+            fprintf(stdout, "%-6s %-8s %12.1f %10lu\n", allmodules[m], work[w].name, nsop,
+                    (unsigned long) bytes);
+        }
+    }
+
+    PMIX_INFO_FREE(work[0].src, NINFO);
+    release_value(work[1].src, NVALS);
+    free(work[1].src);
+    PMIX_PROC_FREE(work[2].src, NPROCS);
+    PMIX_APP_FREE(work[3].src, NAPPS);
+    release_kval(work[4].src, NKVALS);
+    free(work[4].src);
+    if (NULL != modules) {
+        PMIx_Argv_free(modules);
+    }
+    perf_server_finalize();
+    return failed;
+}
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Feed arbitrary bytes to the bfrops unpack functions. The first
+ * byte of an input selects the module and the second the type to
+ * unpack - the remainder is loaded into a buffer and unpacked one
+ * value at a time until the buffer is exhausted or an error is
+ * returned. Any crash, hang or sanitizer report is a bug.
+ *
+ * LLVMFuzzerTestOneInput is the libFuzzer entry point. Building with
+ * PMIX_FUZZER defined omits main so that the file can be linked with
+ * -fsanitize=fuzzer. Otherwise main runs each file named on the
+ * command line through the entry point, or random inputs when none
+ * are given.
+ *
+ * Usage: bfrops_fuzz [file ...]
+ */
+
+#include "src/include/pmix_config.h"
+#include "include/pmix_server.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "src/include/pmix_globals.h"
+#include "src/mca/bfrops/base/base.h"
+#include "src/util/pmix_output.h"
+
+#include "perf_common.h"
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+static const char *modules[] = {"v12", "v20", "v21", "v3", "v4", "v41", "v5"};
+#define NMODULES (sizeof(modules) / sizeof(modules[0]))
+
+/* the types that arrive from peers */
+static const struct {
+    pmix_data_type_t type;
+    size_t width;
+} types[] = {{PMIX_INFO, sizeof(pmix_info_t)},
+             {PMIX_VALUE, sizeof(pmix_value_t)},
+             {PMIX_PROC, sizeof(pmix_proc_t)},
+             {PMIX_APP, sizeof(pmix_app_t)},
+             {PMIX_KVAL, sizeof(pmix_kval_t)},
+             {PMIX_PDATA, sizeof(pmix_pdata_t)},
+             {PMIX_STRING, sizeof(char *)},
+             {PMIX_BYTE_OBJECT, sizeof(pmix_byte_object_t)},
+             {PMIX_DATA_ARRAY, sizeof(pmix_data_array_t)},
+             {PMIX_PROC_INFO, sizeof(pmix_proc_info_t)},
+             {PMIX_QUERY, sizeof(pmix_query_t)},
+             {PMIX_ENVAR, sizeof(pmix_envar_t)},
+             {PMIX_STATUS, sizeof(pmix_status_t)},
+             {PMIX_UINT32, sizeof(uint32_t)},
+             {PMIX_SIZE, sizeof(size_t)}};
+#define NTYPES (sizeof(types) / sizeof(types[0]))
+
+static bool initialized = false;
+
+static void release(pmix_data_type_t type, void *dst)
+{
+    switch (type) {
+    case PMIX_INFO:
+        PMIX_INFO_DESTRUCT((pmix_info_t *) dst);
+        break;
+    case PMIX_VALUE:
+        PMIX_VALUE_DESTRUCT((pmix_value_t *) dst);
+        break;
+    case PMIX_APP:
+        PMIX_APP_DESTRUCT((pmix_app_t *) dst);
+        break;
+    case PMIX_KVAL:
+        PMIX_DESTRUCT((pmix_kval_t *) dst);
+        break;
+    case PMIX_PDATA:
+        PMIX_PDATA_DESTRUCT((pmix_pdata_t *) dst);
+        break;
+    case PMIX_STRING:
+        free(*(char **) dst);
+        break;
+    case PMIX_BYTE_OBJECT:
+        PMIX_BYTE_OBJECT_DESTRUCT((pmix_byte_object_t *) dst);
+        break;
+    case PMIX_DATA_ARRAY:
+        PMIX_DATA_ARRAY_DESTRUCT((pmix_data_array_t *) dst);
+        break;
+    case PMIX_PROC_INFO:
+        PMIX_PROC_INFO_DESTRUCT((pmix_proc_info_t *) dst);
+        break;
+    case PMIX_QUERY:
+        PMIX_QUERY_DESTRUCT((pmix_query_t *) dst);
+        break;
+    case PMIX_ENVAR:
+        PMIX_ENVAR_DESTRUCT((pmix_envar_t *) dst);
+        break;
+    default:
+        break;
+    }
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    pmix_bfrops_module_t *bfrops;
+    pmix_buffer_t buf;
+    pmix_data_type_t type;
+    pmix_status_t rc;
+    int32_t cnt;
+    char *payload;
+    void *dst;
+
+    if (!initialized) {
+        if (PMIX_SUCCESS != perf_server_init(NULL)) {
+            abort();
+        }
+        initialized = true;
+    }
+    if (3 > size) {
+        return 0;
+    }
+    bfrops = pmix_bfrops_base_assign_module(modules[data[0] % NMODULES]);
+    if (NULL == bfrops) {
+        return 0;
+    }
+    type = types[data[1] % NTYPES].type;
+    dst = malloc(types[data[1] % NTYPES].width);
+
+    /* the buffer takes ownership of the payload */
+    size -= 2;
+    payload = (char *) malloc(size);
+    memcpy(payload, data + 2, size);
+    PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+    buf.type = pmix_bfrops_globals.default_type;
+    buf.base_ptr = payload;
+    buf.unpack_ptr = payload;
+    buf.bytes_allocated = size;
+    buf.bytes_used = size;
+    buf.pack_ptr = payload + size;
+
+    do {
+        memset(dst, 0, types[data[1] % NTYPES].width);
+        cnt = 1;
+        rc = bfrops->unpack(&buf, dst, &cnt, type);
+        if (PMIX_SUCCESS == rc) {
+            release(type, dst);
+        }
+    } while (PMIX_SUCCESS == rc);
+
+    free(dst);
+    PMIX_DESTRUCT(&buf);
+    return 0;
+}
+
+#ifndef PMIX_FUZZER
+static void run_file(const char *path)
+{
+    FILE *fp;
+    uint8_t *data;
+    long len;
+
+    if (NULL == (fp = fopen(path, "rb"))) {
+        pmix_output(0, "cannot open %s", path);
+        exit(1);
+    }
+    fseek(fp, 0, SEEK_END);
+    len = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    data = (uint8_t *) malloc(len + 1);
+    if (len != (long) fread(data, 1, len, fp)) {
+        pmix_output(0, "cannot read %s", path);
+        exit(1);
+    }
+    fclose(fp);
+    (void) LLVMFuzzerTestOneInput(data, len);
+    free(data);
+}
+
+int main(int argc, char **argv)
+{
+    uint8_t data[256];
+    size_t len, n;
+    int i;
+
+    if (1 < argc) {
+        for (i = 1; i < argc; i++) {
+            run_file(argv[i]);
+        }
+    } else {
+        /* random inputs are mostly rejected early, but small
+         * lengths and counts do get through to the decoders */
+        srand(42);
+        for (i = 0; i < 100000; i++) {
+            len = 3 + rand() % (sizeof(data) - 3);
+            for (n = 0; n < len; n++) {
+                data[n] = (uint8_t) ((0 == rand() % 4) ? rand() % 8 : rand());
+            }
+            (void) LLVMFuzzerTestOneInput(data, len);
+        }
+    }
+    if (initialized) {
+        perf_server_finalize();
+    }
+    return 0;
+}
+#endif
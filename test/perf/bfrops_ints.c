@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measure the throughput of converting arrays of 16, 32 and 64-bit
+ * integers to and from network byte order with the portable scalar
+ * kernels and with those selected for this processor, followed by
+ * that of packing and unpacking the same arrays with the active
+ * bfrops module. All rates are in GB/s of native integer data
+ *
+ * Usage: bfrops_ints [nvals] [iterations]
+ */
+
+#include "src/include/pmix_config.h"
+#include "include/pmix_server.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "src/include/pmix_globals.h"
+#include "src/util/pmix_bswap.h"
+#include "src/util/pmix_output.h"
+
+#include "perf_common.h"
+
+typedef void (*swap_fn_t)(void *dst, const void *src, size_t n);
+
+static double swap_rate(swap_fn_t fn, void *dst, const void *src, size_t n, size_t width,
+                        int iters)
+{
+    struct timespec start, end;
+    int i;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (i = 0; i < iters; i++) {
+        fn(dst, src, n);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    /* bytes per nanosecond is GB/s */
+    return (double) (n * width) * iters / perf_elapsed(&start, &end);
+}
+
+static void pack_rate(pmix_data_type_t type, void *src, void *dst, size_t n, size_t width,
+                      int iters, double *prate, double *urate)
+{
+    struct timespec start, end;
+    pmix_data_buffer_t buf;
+    pmix_status_t rc;
+    int32_t cnt;
+    double tpack = 0.0, tunpack = 0.0;
+    int i;
+
+    for (i = 0; i < iters; i++) {
+        PMIX_DATA_BUFFER_CONSTRUCT(&buf);
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        rc = PMIx_Data_pack(NULL, &buf, src, n, type);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        tpack += perf_elapsed(&start, &end);
+        if (PMIX_SUCCESS != rc) {
+            pmix_output(0, "pack failed: %s", PMIx_Error_string(rc));
+            exit(rc);
+        }
+        cnt = n;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        rc = PMIx_Data_unpack(NULL, &buf, dst, &cnt, type);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        tunpack += perf_elapsed(&start, &end);
+        if (PMIX_SUCCESS != rc || (size_t) cnt != n || 0 != memcmp(src, dst, n * width)) {
+            pmix_output(0, "unpack failed: %s", PMIx_Error_string(rc));
+            exit(1);
+        }
+        PMIX_DATA_BUFFER_DESTRUCT(&buf);
+    }
+    *prate = (double) (n * width) * iters / tpack;
+    *urate = (double) (n * width) * iters / tunpack;
+}
+
+int main(int argc, char **argv)
+{
+    pmix_status_t rc;
+    size_t nvals = 65536, n;
+    int iters = 1000, t;
+    char *src, *dst;
+    const char *simd;
+    double scalar, fast, prate, urate;
+    struct {
+        const char *name;
+        pmix_data_type_t type;
+        size_t width;
+        swap_fn_t fn;
+    } types[] = {{"int16", PMIX_UINT16, 2, pmix_bswap16_array},
+                 {"int32", PMIX_UINT32, 4, pmix_bswap32_array},
+                 {"int64", PMIX_UINT64, 8, pmix_bswap64_array}};
+
+    if (1 < argc) {
+        nvals = strtoul(argv[1], NULL, 10);
+    }
+    if (2 < argc) {
+        iters = strtol(argv[2], NULL, 10);
+    }
+
+    if (PMIX_SUCCESS != (rc = perf_server_init(NULL))) {
+        exit(rc);
+    }
+
+    /* a spread of small and large values so that variable-length
+     * encodings see a realistic mix of sizes */
+    src = (char *) malloc(nvals * sizeof(uint64_t));
+    dst = (char *) malloc(nvals * sizeof(uint64_t));
+    for (n = 0; n < nvals * sizeof(uint64_t); n++) {
+        src[n] = (0 == n % 3) ? (char) rand() : 0;
+    }
+
+    fprintf(stdout, "%lu values  bfrops %s\n", (unsigned long) nvals,
+            pmix_globals.mypeer->nptr->compat.bfrops->version);
+    for (t = 0; t < 3; t++) {
+        (void) pmix_bswap_select(false);
+        scalar = swap_rate(types[t].fn, dst, src, nvals, types[t].width, iters);
+        simd = pmix_bswap_select(true);
+        fast = swap_rate(types[t].fn, dst, src, nvals, types[t].width, iters);
+        pack_rate(types[t].type, src, dst, nvals, types[t].width, iters, &prate, &urate);
+        fprintf(stdout, "%s  scalar %7.2f GB/s  %s %7.2f GB/s  pack %7.2f GB/s  unpack %7.2f GB/s\n",
+                types[t].name, scalar, simd, fast, prate, urate);
+    }
+
+    free(src);
+    free(dst);
+    perf_server_finalize();
+    return 0;
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measure the cost of caching an event notification once the
+ * cache is full - so that every insertion requires the oldest
+ * occupant to be evicted - and of finding the cached events for
+ * a status code on behalf of a new registration, as a function
+ * of the size of the cache
+ *
+ * Usage: event_cache [maxevents] [iterations] [ncodes]
+ */
+
+#include "src/include/pmix_config.h"
+#include "include/pmix_server.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "src/include/pmix_globals.h"
+#include "src/util/pmix_output.h"
+
+#include "perf_common.h"
+
+typedef struct {
+    int iters;
+    int ncodes;
+    double tinsert;
+    double tlookup;
+    size_t nfound;
+} cache_t;
+
+static pmix_notify_caddy_t *make_event(int n, int ncodes)
+{
+    pmix_notify_caddy_t *cd;
+
+    cd = PMIX_NEW(pmix_notify_caddy_t);
+    cd->status = PMIX_EXTERNAL_ERR_BASE - (n % ncodes);
+    PMIX_LOAD_PROCID(&cd->source, "bench.cache", n);
+    cd->range = PMIX_RANGE_SESSION;
+    return cd;
+}
+
+/* fill the cache, then time insertions that each force an
+ * eviction, followed by lookups of each code - executed in
+ * the progress thread */
+static void run(int sd, short args, void *cbdata)
+{
+    pmix_cb_t *cb = (pmix_cb_t *) cbdata;
+    cache_t *c = (cache_t *) cb->cbdata;
+    struct timespec start, end;
+    pmix_notify_caddy_t *cd, *nxt;
+    int n;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    for (n = 0; n < pmix_globals.max_events; n++) {
+        pmix_notify_event_cache(make_event(n, c->ncodes));
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (n = 0; n < c->iters; n++) {
+        pmix_notify_event_cache(make_event(n, c->ncodes));
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    c->tinsert = perf_elapsed(&start, &end) / (double) c->iters;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (n = 0; n < c->iters; n++) {
+        PMIX_NOTIFY_CACHE_FOREACH_CODE (cd, nxt, PMIX_EXTERNAL_ERR_BASE - (n % c->ncodes)) {
+            c->nfound++;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    c->tlookup = perf_elapsed(&start, &end) / (double) c->iters;
+
+    PMIX_NOTIFY_CACHE_FOREACH (cd, nxt) {
+        pmix_notify_event_uncache(cd);
+        PMIX_RELEASE(cd);
+    }
+    PMIX_WAKEUP_THREAD(&cb->lock);
+}
+
+int main(int argc, char **argv)
+{
+    pmix_status_t rc;
+    pmix_cb_t cb;
+    cache_t c;
+    char *maxevents = "4096";
+
+    memset(&c, 0, sizeof(c));
+    c.iters = 100000;
+    c.ncodes = 16;
+    if (1 < argc) {
+        maxevents = argv[1];
+    }
+    if (2 < argc) {
+        c.iters = strtol(argv[2], NULL, 10);
+    }
+    if (3 < argc) {
+        c.ncodes = strtol(argv[3], NULL, 10);
+    }
+    setenv("PMIX_MCA_pmix_max_events", maxevents, 1);
+
+    if (PMIX_SUCCESS != (rc = perf_server_init(NULL))) {
+        exit(rc);
+    }
+
+    PMIX_CONSTRUCT(&cb, pmix_cb_t);
+    cb.cbdata = &c;
+    PMIX_THREADSHIFT(&cb, run);
+    PMIX_WAIT_THREAD(&cb.lock);
+    PMIX_DESTRUCT(&cb);
+
+    fprintf(stdout, "events %6d  codes %4d  insert+evict %8.3f us  lookup %8.3f us (%lu events/lookup)\n",
+            pmix_globals.max_events, c.ncodes, c.tinsert / 1000.0, c.tlookup / 1000.0,
+            (unsigned long) (c.nfound / c.iters));
+    fprintf(stdout, "cached %lu  evicted %lu  expired %lu\n",
+            (unsigned long) pmix_globals.notify_cache.stats.ncached,
+            (unsigned long) pmix_globals.notify_cache.stats.nevicted,
+            (unsigned long) pmix_globals.notify_cache.stats.nexpired);
+
+    perf_server_finalize();
+    return 0;
+}
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measure the latency of fanning an event out to the local peers
+ * that registered for it, as a function of the number of peers. The
+ * peers are not connected, so the messages remain on their send
+ * queues - this isolates the cost borne by the server's progress
+ * thread from that of the transport. The number of distinct payloads
+ * queued across the peers is also reported, which should be one
+ * when all peers share a bfrops module. The peers are also registered
+ * for a number of unrelated codes, which should not affect the cost
+ * of delivering the event
+ *
+ * Usage: event_fanout [maxpeers] [iterations] [othercodes]
+ */
+
+#include "src/include/pmix_config.h"
+#include "include/pmix_server.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "src/include/pmix_globals.h"
+#include "src/server/pmix_server_ops.h"
+#include "src/util/pmix_output.h"
+
+#include "perf_common.h"
+
+static int nother = 16;
+
+typedef struct {
+    int npeers;
+    pmix_peer_t **peers;
+    pmix_regevents_info_t **regs;
+    size_t nmsgs;
+    size_t npayloads;
+    pmix_lock_t lock;
+} fanout_t;
+
+/* register npeers unconnected peers for the event, and for
+ * nother unrelated codes - executed in the progress thread */
+static void setup(int sd, short args, void *cbdata)
+{
+    pmix_cb_t *cb = (pmix_cb_t *) cbdata;
+    fanout_t *f = (fanout_t *) cb->cbdata;
+    pmix_peer_events_info_t *prev;
+    pmix_peer_t *peer;
+    int n, m;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    f->peers = (pmix_peer_t **) malloc(f->npeers * sizeof(pmix_peer_t *));
+    for (n = 0; n < f->npeers; n++) {
+        peer = PMIX_NEW(pmix_peer_t);
+        peer->info = PMIX_NEW(pmix_rank_info_t);
+        peer->info->pname.nspace = strdup("bench.fanout");
+        peer->info->pname.rank = n;
+        PMIX_RETAIN(pmix_globals.mypeer->nptr);
+        peer->nptr = pmix_globals.mypeer->nptr;
+        peer->index = pmix_pointer_array_add(&pmix_server_globals.clients, peer);
+        peer->info->peerid = peer->index;
+        f->peers[n] = peer;
+    }
+    f->regs = (pmix_regevents_info_t **) malloc((nother + 1) * sizeof(pmix_regevents_info_t *));
+    for (m = 0; m <= nother; m++) {
+        f->regs[m] = PMIX_NEW(pmix_regevents_info_t);
+        /* the event of interest is registered last */
+        f->regs[m]->code = (m == nother) ? PMIX_ERR_PROC_ABORTED : PMIX_EXTERNAL_ERR_BASE - m;
+        for (n = 0; n < f->npeers; n++) {
+            prev = PMIX_NEW(pmix_peer_events_info_t);
+            PMIX_RETAIN(f->peers[n]);
+            prev->peer = f->peers[n];
+            pmix_list_append(&f->regs[m]->peers, &prev->super);
+        }
+        pmix_server_event_add(f->regs[m]);
+    }
+    PMIX_WAKEUP_THREAD(&cb->lock);
+}
+
+static void teardown(int sd, short args, void *cbdata)
+{
+    pmix_cb_t *cb = (pmix_cb_t *) cbdata;
+    fanout_t *f = (fanout_t *) cb->cbdata;
+    int n, m;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    for (m = 0; m <= nother; m++) {
+        pmix_server_event_remove(f->regs[m]);
+        PMIX_RELEASE(f->regs[m]);
+    }
+    free(f->regs);
+    for (n = 0; n < f->npeers; n++) {
+        pmix_pointer_array_set_item(&pmix_server_globals.clients, f->peers[n]->index, NULL);
+        PMIX_RELEASE(f->peers[n]);
+    }
+    free(f->peers);
+    PMIX_WAKEUP_THREAD(&cb->lock);
+}
+
+/* the event has been fanned out - drain the send queues, counting
+ * the messages and the distinct payloads they carry. Executed in
+ * the progress thread */
+static void notify_complete(pmix_status_t status, void *cbdata)
+{
+    fanout_t *f = (fanout_t *) cbdata;
+    pmix_ptl_send_t *snd;
+    pmix_buffer_t *last = NULL;
+    int n;
+    PMIX_HIDE_UNUSED_PARAMS(status);
+
+    for (n = 0; n < f->npeers; n++) {
+        snd = f->peers[n]->send_msg;
+        f->peers[n]->send_msg = NULL;
+        while (NULL != snd) {
+            f->nmsgs++;
+            if (snd->data != last) {
+                f->npayloads++;
+                last = snd->data;
+            }
+            PMIX_RELEASE(snd);
+            snd = (pmix_ptl_send_t *) pmix_list_remove_first(&f->peers[n]->send_queue);
+        }
+    }
+    PMIX_WAKEUP_THREAD(&f->lock);
+}
+
+static void run(int npeers, int iters)
+{
+    struct timespec start, end;
+    pmix_proc_t source;
+    pmix_info_t info[3];
+    pmix_cb_t cb, cb2;
+    fanout_t f;
+    bool flag = true;
+    double tns;
+    int i;
+
+    memset(&f, 0, sizeof(f));
+    f.npeers = npeers;
+    PMIX_CONSTRUCT(&cb, pmix_cb_t);
+    cb.cbdata = &f;
+    PMIX_THREADSHIFT(&cb, setup);
+    PMIX_WAIT_THREAD(&cb.lock);
+
+    PMIX_LOAD_PROCID(&source, "bench.source", 0);
+    PMIX_INFO_LOAD(&info[0], PMIX_EVENT_DO_NOT_CACHE, &flag, PMIX_BOOL);
+    PMIX_INFO_LOAD(&info[1], PMIX_EVENT_AFFECTED_PROC, &source, PMIX_PROC);
+    PMIX_INFO_LOAD(&info[2], PMIX_EVENT_TEXT_MESSAGE, "process aborted by benchmark",
+                   PMIX_STRING);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (i = 0; i < iters; i++) {
+        PMIX_CONSTRUCT_LOCK(&f.lock);
+        PMIx_Notify_event(PMIX_ERR_PROC_ABORTED, &source, PMIX_RANGE_LOCAL, info, 3,
+                          notify_complete, &f);
+        PMIX_WAIT_THREAD(&f.lock);
+        PMIX_DESTRUCT_LOCK(&f.lock);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    tns = perf_elapsed(&start, &end) / (double) iters;
+
+    fprintf(stdout, "peers %6d  %10.1f us/event  %8.3f us/peer  msgs/event %6lu  payloads/event %4lu\n",
+            npeers, tns / 1000.0, tns / (1000.0 * npeers),
+            (unsigned long) (f.nmsgs / iters), (unsigned long) (f.npayloads / iters));
+
+    PMIX_INFO_DESTRUCT(&info[0]);
+    PMIX_INFO_DESTRUCT(&info[1]);
+    PMIX_INFO_DESTRUCT(&info[2]);
+    PMIX_CONSTRUCT(&cb2, pmix_cb_t);
+    cb2.cbdata = &f;
+    PMIX_THREADSHIFT(&cb2, teardown);
+    PMIX_WAIT_THREAD(&cb2.lock);
+    PMIX_DESTRUCT(&cb2);
+    PMIX_DESTRUCT(&cb);
+}
+
+int main(int argc, char **argv)
+{
+    pmix_status_t rc;
+    int maxpeers = 1024, iters = 100;
+    int npeers;
+
+    if (1 < argc) {
+        maxpeers = strtol(argv[1], NULL, 10);
+    }
+    if (2 < argc) {
+        iters = strtol(argv[2], NULL, 10);
+    }
+    if (3 < argc) {
+        nother = strtol(argv[3], NULL, 10);
+    }
+
+    if (PMIX_SUCCESS != (rc = perf_server_init(NULL))) {
+        exit(rc);
+    }
+
+    for (npeers = 1; npeers <= maxpeers; npeers *= 2) {
+        run(npeers, iters);
+    }
+
+    perf_server_finalize();
+    return 0;
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measure the local assembly of a fence blob - collecting the
+ * unique key names of every local rank, selecting the key format,
+ * and packing each rank's contribution - as a function of the
+ * number of local ranks and keys per rank. The contributions are
+ * stored in the server's GDS and assembled by the same function
+ * the server calls when a fence completes locally
+ *
+ * Usage: fence_assembly [maxranks] [maxkeys] [iterations]
+ */
+
+#include "src/include/pmix_config.h"
+#include "include/pmix_server.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "src/include/pmix_globals.h"
+#include "src/mca/gds/gds.h"
+#include "src/server/pmix_server_ops.h"
+#include "src/util/pmix_output.h"
+#include "src/util/pmix_printf.h"
+
+#include "perf_common.h"
+
+typedef struct {
+    int nranks;
+    int nkeys;
+    int iters;
+    pmix_status_t status;
+    size_t size;
+    double tns;
+} fence_t;
+
+/* store the contributions of nranks local procs of a fresh
+ * nspace, each posting the same nkeys keys, and build the
+ * tracker of a fence across them */
+static pmix_server_trkr_t *setup(int nranks, int nkeys)
+{
+    pmix_server_trkr_t *trk;
+    pmix_server_caddy_t *scd;
+    pmix_nspace_caddy_t *nm;
+    pmix_peer_t *peer;
+    pmix_proc_t proc;
+    pmix_kval_t *kv;
+    pmix_status_t rc;
+    int r, k;
+
+    trk = PMIX_NEW(pmix_server_trkr_t);
+    trk->collect_type = PMIX_COLLECT_YES;
+    nm = PMIX_NEW(pmix_nspace_caddy_t);
+    nm->ns = PMIX_NEW(pmix_namespace_t);
+    pmix_asprintf(&nm->ns->nspace, "bench.fence.%d.%d", nranks, nkeys);
+    pmix_list_append(&trk->nslist, &nm->super);
+
+    for (r = 0; r < nranks; r++) {
+        PMIX_LOAD_PROCID(&proc, nm->ns->nspace, r);
+        for (k = 0; k < nkeys; k++) {
+            kv = PMIX_NEW(pmix_kval_t);
+            pmix_asprintf(&kv->key, "bench.fence.key.%d", k);
+            PMIX_VALUE_CREATE(kv->value, 1);
+            kv->value->type = PMIX_UINT32;
+            kv->value->data.uint32 = (uint32_t) (r * nkeys + k);
+            PMIX_GDS_STORE_KV(rc, pmix_globals.mypeer, &proc, PMIX_REMOTE, kv);
+            PMIX_RELEASE(kv);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+                PMIX_RELEASE(trk);
+                return NULL;
+            }
+        }
+
+        peer = PMIX_NEW(pmix_peer_t);
+        peer->info = PMIX_NEW(pmix_rank_info_t);
+        peer->info->pname.nspace = strdup(nm->ns->nspace);
+        peer->info->pname.rank = r;
+        scd = PMIX_NEW(pmix_server_caddy_t);
+        scd->peer = peer;
+        pmix_list_append(&trk->local_cbs, &scd->super);
+    }
+    trk->nlocal = nranks;
+    trk->local_cnt = nranks;
+    return trk;
+}
+
+/* executed in the progress thread, as is the assembly
+ * performed when a fence completes */
+static void run(int sd, short args, void *cbdata)
+{
+    pmix_cb_t *cb = (pmix_cb_t *) cbdata;
+    fence_t *f = (fence_t *) cb->cbdata;
+    struct timespec start, end;
+    pmix_server_trkr_t *trk;
+    pmix_buffer_t bucket;
+    size_t size;
+    int i;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    trk = setup(f->nranks, f->nkeys);
+    if (NULL == trk) {
+        f->status = PMIX_ERR_NOMEM;
+        PMIX_WAKEUP_THREAD(&cb->lock);
+        return;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (i = 0; i < f->iters; i++) {
+        PMIX_CONSTRUCT(&bucket, pmix_buffer_t);
+        f->status = pmix_server_collect_data(trk, &bucket, &size);
+        f->size = bucket.bytes_used;
+        PMIX_DESTRUCT(&bucket);
+        if (PMIX_SUCCESS != f->status) {
+            break;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    f->tns = perf_elapsed(&start, &end) / (double) f->iters;
+
+    PMIX_RELEASE(trk);
+    PMIX_WAKEUP_THREAD(&cb->lock);
+}
+
+int main(int argc, char **argv)
+{
+    pmix_status_t rc;
+    pmix_cb_t cb;
+    fence_t f;
+    int maxranks = 128, maxkeys = 256, iters = 10;
+    int nranks, nkeys;
+
+    if (1 < argc) {
+        maxranks = strtol(argv[1], NULL, 10);
+    }
+    if (2 < argc) {
+        maxkeys = strtol(argv[2], NULL, 10);
+    }
+    if (3 < argc) {
+        iters = strtol(argv[3], NULL, 10);
+    }
+
+    if (PMIX_SUCCESS != (rc = perf_server_init(NULL))) {
+        exit(rc);
+    }
+
+    for (nranks = 1; nranks <= maxranks; nranks *= 2) {
+        for (nkeys = 4; nkeys <= maxkeys; nkeys *= 4) {
+            memset(&f, 0, sizeof(f));
+            f.nranks = nranks;
+            f.nkeys = nkeys;
+            f.iters = iters;
+            PMIX_CONSTRUCT(&cb, pmix_cb_t);
+            cb.cbdata = &f;
+            PMIX_THREADSHIFT(&cb, run);
+            PMIX_WAIT_THREAD(&cb.lock);
+            PMIX_DESTRUCT(&cb);
+            if (PMIX_SUCCESS != f.status) {
+                pmix_output(0, "fence assembly failed: %s", PMIx_Error_string(f.status));
+                perf_server_finalize();
+                exit(1);
+            }
+            fprintf(stdout, "ranks %5d  keys/rank %5d  assemble %10.1f us  blob %10lu bytes\n",
+                    nranks, nkeys, f.tns / 1000.0, (unsigned long) f.size);
+        }
+    }
+
+    perf_server_finalize();
+    return 0;
+}
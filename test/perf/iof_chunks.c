@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Feed a child's stdout pipe through the local IOF read handler into
+ * an output file and check that the file holds exactly what was
+ * written. The output mixes short writes, which leave most of a read
+ * chunk empty, with bursts that fill the largest reads, and is run
+ * once with the lines of each chunk shared by the file sink and once
+ * with the data spliced straight from the pipe into the file, where
+ * splice() is available.
+ *
+ * Usage: iof_chunks [nbursts]
+ */
+
+#include "src/include/pmix_config.h"
+#include "include/pmix_server.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "src/client/pmix_client_ops.h"
+#include "src/common/pmix_iof.h"
+#include "src/include/pmix_globals.h"
+#include "src/mca/pfexec/base/base.h"
+#include "src/util/pmix_output.h"
+#include "src/util/pmix_printf.h"
+
+#include "perf_common.h"
+
+typedef struct {
+    const char *dir;
+    const char *nspace;
+    bool splice;
+    int fd;
+    pmix_namespace_t *nptr;
+    pmix_pfexec_child_t *child;
+    bool done;
+    bool nosplice;
+} iofrun_t;
+
+/* executed in the progress thread - attach the read end of the
+ * pipe to the handler, just as pfexec does for a child */
+static void setup(int sd, short args, void *cbdata)
+{
+    pmix_cb_t *cb = (pmix_cb_t *) cbdata;
+    iofrun_t *run = (iofrun_t *) cb->cbdata;
+    pmix_pfexec_child_t *child;
+    pmix_namespace_t *nptr;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    pmix_globals.iof_splice = run->splice;
+
+    nptr = PMIX_NEW(pmix_namespace_t);
+    nptr->nspace = strdup(run->nspace);
+    nptr->nprocs = 1;
+    nptr->iof_flags.set = true;
+    nptr->iof_flags.directory = strdup(run->dir);
+    nptr->iof_flags.local_output = true;
+    nptr->iof_flags.local_output_given = true;
+    nptr->iof_flags.nocopy = true;
+    pmix_list_append(&pmix_globals.nspaces, &nptr->super);
+    run->nptr = nptr;
+
+    child = PMIX_NEW(pmix_pfexec_child_t);
+    PMIX_LOAD_PROCID(&child->proc, run->nspace, 0);
+    PMIX_IOF_READ_EVENT_LOCAL(&child->stdoutev, run->fd, pmix_iof_read_local_handler, false);
+    PMIX_LOAD_PROCID(&child->stdoutev->name, child->proc.nspace, child->proc.rank);
+    child->stdoutev->childproc = (void *) child;
+    child->stdoutev->channel = PMIX_FWD_STDOUT_CHANNEL;
+    run->child = child;
+    PMIX_IOF_READ_ACTIVATE(child->stdoutev);
+
+    PMIX_WAKEUP_THREAD(&cb->lock);
+}
+
+/* the handler stops reading at EOF - after that, everything
+ * it passed to the sink must have been written */
+static void check(int sd, short args, void *cbdata)
+{
+    pmix_cb_t *cb = (pmix_cb_t *) cbdata;
+    iofrun_t *run = (iofrun_t *) cb->cbdata;
+    pmix_iof_sink_t *sink;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    run->done = !run->child->stdoutev->active;
+    PMIX_LIST_FOREACH (sink, &run->nptr->sinks, pmix_iof_sink_t) {
+        if (sink->wev.pending || !pmix_list_is_empty(&sink->wev.outputs)) {
+            run->done = false;
+        }
+    }
+    PMIX_WAKEUP_THREAD(&cb->lock);
+}
+
+static void teardown(int sd, short args, void *cbdata)
+{
+    pmix_cb_t *cb = (pmix_cb_t *) cbdata;
+    iofrun_t *run = (iofrun_t *) cb->cbdata;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    run->nosplice = run->child->stdoutev->nosplice;
+    pmix_list_remove_item(&pmix_globals.nspaces, &run->nptr->super);
+    PMIX_RELEASE(run->nptr);
+    PMIX_RELEASE(run->child);
+    pmix_globals.iof_splice = false;
+    PMIX_WAKEUP_THREAD(&cb->lock);
+}
+
+static void shift(iofrun_t *run, void (*fn)(int sd, short args, void *cbdata))
+{
+    pmix_cb_t cb;
+
+    PMIX_CONSTRUCT(&cb, pmix_cb_t);
+    cb.cbdata = run;
+    PMIX_THREADSHIFT(&cb, fn);
+    PMIX_WAIT_THREAD(&cb.lock);
+    PMIX_DESTRUCT(&cb);
+}
+
+static bool write_all(int fd, const char *data, size_t size)
+{
+    ssize_t rc;
+
+    while (0 < size) {
+        rc = write(fd, data, size);
+        if (rc < 0) {
+            return false;
+        }
+        data += rc;
+        size -= rc;
+    }
+    return true;
+}
+
+/* write the stream, returning a copy of everything written */
+static char *produce(int fd, int nbursts, size_t *size)
+{
+    size_t len, burst = 4 * PMIX_IOF_READ_MAX;
+    char *expected, *line;
+    int i, j;
+
+    expected = (char *) malloc(nbursts * (64 * 40 + burst));
+    *size = 0;
+    for (i = 0; i < nbursts; i++) {
+        /* short writes, each read on its own */
+        for (j = 0; j < 64; j++) {
+            line = expected + *size;
+            len = snprintf(line, 40, "burst %d line %d\n", i, j);
+            if (!write_all(fd, line, len)) {
+                free(expected);
+                return NULL;
+            }
+            *size += len;
+            if (0 == j % 8) {
+                usleep(1000);
+            }
+        }
+        /* then a burst that fills the largest reads */
+        line = expected + *size;
+        for (len = 0; len < burst; len++) {
+            line[len] = (0 == (len + 1) % 80) ? '\n' : (char) ('a' + (len + i) % 26);
+        }
+        line[burst - 1] = '\n';
+        if (!write_all(fd, line, burst)) {
+            free(expected);
+            return NULL;
+        }
+        *size += burst;
+    }
+    return expected;
+}
+
+static char *slurp(const char *path, size_t *size)
+{
+    FILE *fp;
+    char *data;
+    long len;
+
+    if (NULL == (fp = fopen(path, "r"))) {
+        return NULL;
+    }
+    fseek(fp, 0, SEEK_END);
+    len = ftell(fp);
+    rewind(fp);
+    data = (char *) malloc(len + 1);
+    *size = fread(data, 1, len, fp);
+    fclose(fp);
+    return data;
+}
+
+static int run_one(bool splice, int nbursts)
+{
+    char template[] = "/tmp/iof_chunks.XXXXXX";
+    char *dir, *path, *expected, *actual;
+    size_t esize, asize = 0;
+    int fds[2], n, ret = 0;
+    iofrun_t run;
+
+    if (NULL == (dir = mkdtemp(template))) {
+        perror("mkdtemp");
+        return 1;
+    }
+    if (0 > pipe(fds)) {
+        perror("pipe");
+        rmdir(dir);
+        return 1;
+    }
+
+    memset(&run, 0, sizeof(run));
+    run.dir = dir;
+    run.nspace = splice ? "iof.chunks.splice" : "iof.chunks.shared";
+    run.splice = splice;
+    run.fd = fds[0];
+    shift(&run, setup);
+
+    expected = produce(fds[1], nbursts, &esize);
+    close(fds[1]);
+    if (NULL == expected) {
+        perror("write");
+        ret = 1;
+    }
+
+    /* allow up to a minute for the data to drain */
+    for (n = 0; n < 60000; n++) {
+        shift(&run, check);
+        if (run.done) {
+            break;
+        }
+        usleep(1000);
+    }
+    if (!run.done) {
+        fprintf(stderr, "%s: output did not drain\n", run.nspace);
+        ret = 1;
+    }
+    shift(&run, teardown);
+
+    pmix_asprintf(&path, "%s/%s/rank.0/stdout", dir, run.nspace);
+    actual = slurp(path, &asize);
+    if (NULL != expected) {
+        if (NULL == actual) {
+            fprintf(stderr, "%s: no output file %s\n", run.nspace, path);
+            ret = 1;
+        } else if (asize != esize || 0 != memcmp(expected, actual, esize)) {
+            fprintf(stderr, "%s: output differs - wrote %lu bytes, file holds %lu\n", run.nspace,
+                    (unsigned long) esize, (unsigned long) asize);
+            ret = 1;
+        }
+    }
+    fprintf(stdout, "%-20s %10lu bytes  %s\n", run.nspace, (unsigned long) asize,
+            (0 != ret) ? "FAILED" : (splice && !run.nosplice) ? "ok (spliced)" : "ok");
+
+    unlink(path);
+    free(path);
+    pmix_asprintf(&path, "%s/%s/rank.0", dir, run.nspace);
+    rmdir(path);
+    free(path);
+    pmix_asprintf(&path, "%s/%s", dir, run.nspace);
+    rmdir(path);
+    free(path);
+    rmdir(dir);
+    free(expected);
+    free(actual);
+    return ret;
+}
+
+int main(int argc, char **argv)
+{
+    pmix_status_t rc;
+    int nbursts = 8, ret;
+
+    if (1 < argc) {
+        nbursts = strtol(argv[1], NULL, 10);
+    }
+
+    if (PMIX_SUCCESS != (rc = perf_server_init(NULL))) {
+        exit(rc);
+    }
+
+    ret = run_one(false, nbursts);
+#if defined(HAVE_SPLICE)
+    ret |= run_one(true, nbursts);
+#endif
+
+    perf_server_finalize();
+    return ret;
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Compare the hashed key lookup in pmix_hash_lookup_key against
+ * the linear scan of the key index that it replaced
+ *
+ * Usage: keylookup [nuserkeys] [iterations]
+ */
+
+#include "src/include/pmix_config.h"
+#include "include/pmix_server.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "src/include/pmix_dictionary.h"
+#include "src/include/pmix_globals.h"
+#include "src/util/pmix_hash.h"
+#include "src/util/pmix_output.h"
+#include "src/util/pmix_printf.h"
+
+#include "perf_common.h"
+
+/* the original search: walk the reserved range for reserved
+ * keys and the remainder of the index for everything else */
+static pmix_regattr_input_t *scan_lookup(const char *key)
+{
+    int id, start, end;
+    pmix_regattr_input_t *ptr;
+
+    if (PMIX_CHECK_RESERVED_KEY(key)) {
+        start = 0;
+        end = PMIX_INDEX_BOUNDARY;
+    } else {
+        start = PMIX_INDEX_BOUNDARY;
+        end = pmix_globals.keyindex.size;
+    }
+    for (id = start; id < end; id++) {
+        ptr = pmix_pointer_array_get_item(&pmix_globals.keyindex, id);
+        if (NULL != ptr && 0 == strcmp(key, ptr->string)) {
+            return ptr;
+        }
+    }
+    return NULL;
+}
+
+static void run(const char *label, char **keys, int nkeys, int iters)
+{
+    struct timespec start, end;
+    pmix_regattr_input_t *p, *q;
+    double thash, tscan;
+    int n, i, errs = 0;
+
+    /* make sure both methods agree */
+    for (n = 0; n < nkeys; n++) {
+        p = pmix_hash_lookup_key(UINT32_MAX, keys[n]);
+        q = scan_lookup(keys[n]);
+        if (p != q) {
+            ++errs;
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (i = 0; i < iters; i++) {
+        for (n = 0; n < nkeys; n++) {
+            p = pmix_hash_lookup_key(UINT32_MAX, keys[n]);
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    thash = perf_elapsed(&start, &end) / ((double) iters * nkeys);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (i = 0; i < iters; i++) {
+        for (n = 0; n < nkeys; n++) {
+            p = scan_lookup(keys[n]);
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    tscan = perf_elapsed(&start, &end) / ((double) iters * nkeys);
+
+    fprintf(stdout, "%-10s keys %6d  hashed %8.1f ns/op  scan %10.1f ns/op  speedup %6.1fx%s\n",
+            label, nkeys, thash, tscan, tscan / thash,
+            (0 == errs) ? "" : "  MISMATCH");
+}
+
+int main(int argc, char **argv)
+{
+    pmix_status_t rc;
+    int nuser = 256, iters = 1000, nres, n;
+    char **reserved, **user;
+
+    if (1 < argc) {
+        nuser = strtol(argv[1], NULL, 10);
+    }
+    if (2 < argc) {
+        iters = strtol(argv[2], NULL, 10);
+    }
+
+    if (PMIX_SUCCESS != (rc = perf_server_init(NULL))) {
+        exit(rc);
+    }
+
+    /* collect the reserved keys */
+    for (nres = 0; UINT32_MAX != pmix_dictionary[nres].index; nres++);
+    reserved = (char **) malloc(nres * sizeof(char *));
+    for (n = 0; n < nres; n++) {
+        reserved[n] = (char *) pmix_dictionary[n].string;
+    }
+
+    /* register some user-defined keys */
+    user = (char **) malloc(nuser * sizeof(char *));
+    for (n = 0; n < nuser; n++) {
+        pmix_asprintf(&user[n], "user.key.%d", n);
+        (void) pmix_hash_lookup_key(UINT32_MAX, user[n]);
+    }
+
+    run("reserved", reserved, nres, iters);
+    run("user", user, nuser, iters);
+
+    for (n = 0; n < nuser; n++) {
+        free(user[n]);
+    }
+    free(user);
+    free(reserved);
+
+    perf_server_finalize();
+    return 0;
+}
@@ -0,0 +1,657 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measure the server and client hot paths on a single node with no
+ * resource manager. The program starts as a PMIx server with a
+ * minimal host module, registers one namespace and launches that
+ * many copies of itself as its clients. Every request travels the
+ * local socket to the server's message handler and switchyard just
+ * as it would under a real launcher.
+ *
+ * Each client times put/commit, get through the server, get from
+ * its own cache, fence with and without data collection, event
+ * notifications and IOF forwarded by the server. Notifications and
+ * IOF chunks are stamped by the server when it sends them so the
+ * client can measure their delivery latency. Rank 0 reports the
+ * rate of each operation and the 50th, 90th and 99th percentile
+ * and maximum latencies in microseconds
+ *
+ * Usage: loopback [nclients] [iterations]
+ *
+ * If LOOPBACK_RING is set to "on" or "off" in the environment, each
+ * client also verifies that its connection to the server did or did
+ * not negotiate the shared-memory rings. The run is abandoned if it
+ * has not completed within LOOPBACK_TIMEOUT seconds (default 300)
+ */
+
+#include "src/include/pmix_config.h"
+#include "include/pmix_server.h"
+#include "include/pmix_tool.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "src/client/pmix_client_ops.h"
+#include "src/include/pmix_globals.h"
+#include "src/threads/pmix_threads.h"
+#include "src/util/pmix_argv.h"
+#include "src/util/pmix_output.h"
+
+#include "perf_common.h"
+
+#define LOOPBACK_EVENT (PMIX_EXTERNAL_ERR_BASE - 42)
+#define LOOPBACK_PHASE "loopback.phase"
+#define LOOPBACK_STAMP "loopback.stamp"
+
+extern char **environ;
+
+/****    SERVER    ****/
+
+static pmix_status_t finalized(const pmix_proc_t *proc, void *server_object,
+                               pmix_op_cbfunc_t cbfunc, void *cbdata);
+static pmix_status_t fencenb_fn(const pmix_proc_t procs[], size_t nprocs, const pmix_info_t info[],
+                                size_t ninfo, char *data, size_t ndata, pmix_modex_cbfunc_t cbfunc,
+                                void *cbdata);
+
+static pmix_server_module_t mymodule = {
+    .client_finalized = finalized,
+    .fence_nb = fencenb_fn
+};
+
+/* the server's main thread generates the notifications and IOF
+ * when asked to by a fence, so that the library's progress thread
+ * is never blocked by the harness */
+static struct {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    int nfinalized;
+    char *phase;
+    char *data;
+    size_t ndata;
+    pmix_modex_cbfunc_t cbfunc;
+    void *cbdata;
+} srv = {PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, 0, NULL, NULL, 0, NULL, NULL};
+
+static pmix_status_t finalized(const pmix_proc_t *proc, void *server_object,
+                               pmix_op_cbfunc_t cbfunc, void *cbdata)
+{
+    PMIX_HIDE_UNUSED_PARAMS(proc, server_object);
+
+    pthread_mutex_lock(&srv.lock);
+    ++srv.nfinalized;
+    pthread_cond_signal(&srv.cond);
+    pthread_mutex_unlock(&srv.lock);
+    if (NULL != cbfunc) {
+        cbfunc(PMIX_SUCCESS, cbdata);
+    }
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t fencenb_fn(const pmix_proc_t procs[], size_t nprocs, const pmix_info_t info[],
+                                size_t ninfo, char *data, size_t ndata, pmix_modex_cbfunc_t cbfunc,
+                                void *cbdata)
+{
+    size_t n;
+    PMIX_HIDE_UNUSED_PARAMS(procs, nprocs);
+
+    for (n = 0; n < ninfo; n++) {
+        if (PMIX_CHECK_KEY(&info[n], LOOPBACK_PHASE)) {
+            pthread_mutex_lock(&srv.lock);
+            srv.phase = strdup(info[n].value.data.string);
+            srv.data = data;
+            srv.ndata = ndata;
+            srv.cbfunc = cbfunc;
+            srv.cbdata = cbdata;
+            pthread_cond_signal(&srv.cond);
+            pthread_mutex_unlock(&srv.lock);
+            return PMIX_SUCCESS;
+        }
+    }
+    /* all participants are local, so their contributions
+     * are the complete result */
+    cbfunc(PMIX_SUCCESS, data, ndata, cbdata, NULL, NULL);
+    return PMIX_SUCCESS;
+}
+
+static void opcbfunc(pmix_status_t status, void *cbdata)
+{
+    pmix_lock_t *lock = (pmix_lock_t *) cbdata;
+
+    lock->status = status;
+    PMIX_WAKEUP_THREAD(lock);
+}
+
+static void register_nspace(const char *nspace, int nprocs)
+{
+    pmix_info_t *info, *iptr;
+    pmix_data_array_t *darray;
+    pmix_lock_t lock;
+    char *regex, *ppn, *ranks, tmp[16], **agg = NULL;
+    uint32_t u32 = nprocs, nodeid = 0;
+    uint16_t u16;
+    pmix_rank_t rank;
+    size_t ninfo;
+    int n;
+
+    /* everything on one node */
+    PMIx_generate_regex(pmix_globals.hostname, &regex);
+    for (n = 0; n < nprocs; n++) {
+        snprintf(tmp, sizeof(tmp), "%d", n);
+        PMIx_Argv_append_nosize(&agg, tmp);
+    }
+    ranks = PMIx_Argv_join(agg, ',');
+    PMIx_Argv_free(agg);
+    PMIx_generate_ppn(ranks, &ppn);
+    free(ranks);
+
+    ninfo = 6 + nprocs;
+    PMIX_INFO_CREATE(info, ninfo);
+    PMIX_INFO_LOAD(&info[0], PMIX_NODE_MAP, regex, PMIX_REGEX);
+    PMIX_INFO_LOAD(&info[1], PMIX_PROC_MAP, ppn, PMIX_REGEX);
+    PMIX_INFO_LOAD(&info[2], PMIX_JOB_SIZE, &u32, PMIX_UINT32);
+    PMIX_INFO_LOAD(&info[3], PMIX_UNIV_SIZE, &u32, PMIX_UINT32);
+    PMIX_INFO_LOAD(&info[4], PMIX_LOCAL_SIZE, &u32, PMIX_UINT32);
+    PMIX_INFO_LOAD(&info[5], PMIX_HOSTNAME, pmix_globals.hostname, PMIX_STRING);
+    free(regex);
+    free(ppn);
+    for (n = 0; n < nprocs; n++) {
+        PMIX_DATA_ARRAY_CREATE(darray, 5, PMIX_INFO);
+        iptr = (pmix_info_t *) darray->array;
+        rank = n;
+        PMIX_INFO_LOAD(&iptr[0], PMIX_RANK, &rank, PMIX_PROC_RANK);
+        u16 = n;
+        PMIX_INFO_LOAD(&iptr[1], PMIX_LOCAL_RANK, &u16, PMIX_UINT16);
+        PMIX_INFO_LOAD(&iptr[2], PMIX_NODE_RANK, &u16, PMIX_UINT16);
+        PMIX_INFO_LOAD(&iptr[3], PMIX_NODEID, &nodeid, PMIX_UINT32);
+        PMIX_INFO_LOAD(&iptr[4], PMIX_HOSTNAME, pmix_globals.hostname, PMIX_STRING);
+        PMIX_INFO_LOAD(&info[6 + n], PMIX_PROC_DATA, darray, PMIX_DATA_ARRAY);
+        PMIX_DATA_ARRAY_FREE(darray);
+    }
+
+    PMIX_CONSTRUCT_LOCK(&lock);
+    if (PMIX_SUCCESS == PMIx_server_register_nspace(nspace, nprocs, info, ninfo, opcbfunc, &lock)) {
+        PMIX_WAIT_THREAD(&lock);
+    }
+    PMIX_DESTRUCT_LOCK(&lock);
+    PMIX_INFO_FREE(info, ninfo);
+}
+
+static void stamp_event(void)
+{
+    pmix_info_t info[2];
+    uint64_t stamp;
+    bool flag = true;
+
+    stamp = perf_now();
+    PMIX_INFO_LOAD(&info[0], LOOPBACK_STAMP, &stamp, PMIX_UINT64);
+    PMIX_INFO_LOAD(&info[1], PMIX_EVENT_NON_DEFAULT, &flag, PMIX_BOOL);
+    (void) PMIx_Notify_event(LOOPBACK_EVENT, NULL, PMIX_RANGE_LOCAL, info, 2, NULL, NULL);
+}
+
+static void stamp_iof(pmix_proc_t *source)
+{
+    pmix_byte_object_t bo;
+    char line[32];
+
+    snprintf(line, sizeof(line), "%llu\n", (unsigned long long) perf_now());
+    bo.bytes = line;
+    bo.size = strlen(line);
+    (void) PMIx_server_IOF_deliver(source, PMIX_FWD_STDOUT_CHANNEL, &bo, NULL, 0, NULL, NULL);
+}
+
+/* wait for a client to exit, killing it if it has not done
+ * so by the deadline. Returns true if it exited cleanly */
+static bool reap(pid_t pid, time_t deadline)
+{
+    pid_t rc;
+    int status;
+
+    while (0 == (rc = waitpid(pid, &status, WNOHANG)) || (0 > rc && EINTR == errno)) {
+        if (deadline <= time(NULL)) {
+            kill(pid, SIGKILL);
+            (void) waitpid(pid, &status, 0);
+            return false;
+        }
+        usleep(10000);
+    }
+    return (pid == rc && WIFEXITED(status) && 0 == WEXITSTATUS(status));
+}
+
+static int run_server(const char *exe, int nprocs, int iters, int timeout)
+{
+    pmix_proc_t proc, source;
+    pmix_lock_t lock;
+    pmix_status_t rc;
+    struct timespec ts;
+    char **env, *argv[4], iterstr[16];
+    pid_t *pids, pid;
+    time_t deadline;
+    int n, status, nexited = 0, exit_code = 0;
+
+    /* the deadline bounds the wait for the clients - the alarm is
+     * a last resort should the server itself stop making progress */
+    deadline = time(NULL) + timeout;
+    alarm(timeout + 30);
+    if (PMIX_SUCCESS != (rc = perf_server_init(&mymodule))) {
+        return rc;
+    }
+
+    PMIX_LOAD_PROCID(&proc, "loopback", 0);
+    PMIX_LOAD_PROCID(&source, "loopback", 0);
+    register_nspace(proc.nspace, nprocs);
+
+    snprintf(iterstr, sizeof(iterstr), "%d", iters);
+    argv[0] = (char *) exe;
+    argv[1] = "0";
+    argv[2] = iterstr;
+    argv[3] = NULL;
+    pids = (pid_t *) calloc(nprocs, sizeof(pid_t));
+    for (n = 0; n < nprocs; n++) {
+        proc.rank = n;
+        PMIX_CONSTRUCT_LOCK(&lock);
+        rc = PMIx_server_register_client(&proc, geteuid(), getegid(), NULL, opcbfunc, &lock);
+        if (PMIX_SUCCESS == rc) {
+            PMIX_WAIT_THREAD(&lock);
+            rc = lock.status;
+        }
+        PMIX_DESTRUCT_LOCK(&lock);
+        if (PMIX_SUCCESS != rc) {
+            pmix_output(0, "PMIx_server_register_client failed: %s", PMIx_Error_string(rc));
+            exit_code = 1;
+            break;
+        }
+        env = PMIx_Argv_copy(environ);
+        if (PMIX_SUCCESS != (rc = PMIx_server_setup_fork(&proc, &env))) {
+            pmix_output(0, "PMIx_server_setup_fork failed: %s", PMIx_Error_string(rc));
+            PMIx_Argv_free(env);
+            exit_code = 1;
+            break;
+        }
+        pids[n] = fork();
+        if (0 == pids[n]) {
+            execve(exe, argv, env);
+            _exit(1);
+        }
+        PMIx_Argv_free(env);
+        if (0 > pids[n]) {
+            pmix_output(0, "fork failed: %s", strerror(errno));
+            pids[n] = 0;
+            exit_code = 1;
+            break;
+        }
+    }
+
+    /* serve phase requests until every client has finalized,
+     * watching for any that die along the way */
+    pthread_mutex_lock(&srv.lock);
+    while (0 == exit_code && srv.nfinalized < nprocs && nexited < nprocs) {
+        if (NULL == srv.phase) {
+            clock_gettime(CLOCK_REALTIME, &ts);
+            ts.tv_nsec += 100000000;
+            if (1000000000 <= ts.tv_nsec) {
+                ts.tv_sec += 1;
+                ts.tv_nsec -= 1000000000;
+            }
+            pthread_cond_timedwait(&srv.cond, &srv.lock, &ts);
+            if (deadline <= time(NULL)) {
+                pmix_output(0, "loopback timed out after %d seconds", timeout);
+                exit_code = 1;
+                break;
+            }
+            while (0 < (pid = waitpid(-1, &status, WNOHANG))) {
+                for (n = 0; n < nprocs; n++) {
+                    if (pids[n] == pid) {
+                        pids[n] = 0;
+                    }
+                }
+                ++nexited;
+                if (!WIFEXITED(status) || 0 != WEXITSTATUS(status)) {
+                    exit_code = 1;
+                }
+            }
+            continue;
+        }
+        pthread_mutex_unlock(&srv.lock);
+        for (n = 0; n < iters; n++) {
+            if (0 == strcmp(srv.phase, "event")) {
+                stamp_event();
+            } else {
+                stamp_iof(&source);
+            }
+        }
+        pthread_mutex_lock(&srv.lock);
+        free(srv.phase);
+        srv.phase = NULL;
+        srv.cbfunc(PMIX_SUCCESS, srv.data, srv.ndata, srv.cbdata, NULL, NULL);
+    }
+    pthread_mutex_unlock(&srv.lock);
+
+    /* once anything has failed the remaining clients may never
+     * finish, so stop them rather than wait */
+    if (0 != exit_code) {
+        for (n = 0; n < nprocs; n++) {
+            if (0 < pids[n]) {
+                kill(pids[n], SIGTERM);
+            }
+        }
+        deadline = time(NULL) + 5;
+    }
+    for (n = 0; n < nprocs; n++) {
+        if (0 < pids[n] && !reap(pids[n], deadline)) {
+            exit_code = 1;
+        }
+    }
+    free(pids);
+    perf_server_finalize();
+    return exit_code;
+}
+
+/****    CLIENT    ****/
+
+typedef struct {
+    const char *name;
+    uint64_t *lat;
+    int n;
+    uint64_t start;
+    uint64_t end;
+} series_t;
+
+static pmix_proc_t myproc;
+static series_t *current = NULL;
+static int expected = 0;
+static pmix_lock_t arrived;
+
+static int cmp(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *) a, y = *(const uint64_t *) b;
+
+    return (x < y) ? -1 : (x > y);
+}
+
+static void report(series_t *s)
+{
+    double rate;
+
+    if (0 != myproc.rank) {
+        return;
+    }
+    if (0 == s->n) {
+        fprintf(stdout, "%-12s no samples\n", s->name);
+        return;
+    }
+    qsort(s->lat, s->n, sizeof(uint64_t), cmp);
+    rate = (s->end > s->start) ? (double) s->n * 1.0e9 / (double) (s->end - s->start) : 0.0;
+    fprintf(stdout, "%-12s %8d %12.0f %9.1f %9.1f %9.1f %9.1f\n", s->name, s->n, rate,
+            s->lat[s->n / 2] / 1000.0, s->lat[(s->n * 9) / 10] / 1000.0,
+            s->lat[(s->n * 99) / 100] / 1000.0, s->lat[s->n - 1] / 1000.0);
+}
+
+static void record(series_t *s, uint64_t start, uint64_t end)
+{
+    if (0 == s->n) {
+        s->start = start;
+    }
+    s->lat[s->n++] = end - start;
+    s->end = end;
+}
+
+static void evhandler(size_t evhdlr_registration_id, pmix_status_t status,
+                      const pmix_proc_t *source, pmix_info_t info[], size_t ninfo,
+                      pmix_info_t results[], size_t nresults,
+                      pmix_event_notification_cbfunc_fn_t cbfunc, void *cbdata)
+{
+    uint64_t t = perf_now();
+    size_t n;
+    PMIX_HIDE_UNUSED_PARAMS(evhdlr_registration_id, status, source, results, nresults);
+
+    for (n = 0; n < ninfo; n++) {
+        if (PMIX_CHECK_KEY(&info[n], LOOPBACK_STAMP) && NULL != current) {
+            record(current, info[n].value.data.uint64, t);
+            if (current->n == expected) {
+                PMIX_WAKEUP_THREAD(&arrived);
+            }
+            break;
+        }
+    }
+    if (NULL != cbfunc) {
+        cbfunc(PMIX_EVENT_ACTION_COMPLETE, NULL, 0, NULL, NULL, cbdata);
+    }
+}
+
+static void iofhandler(size_t iofhdlr, pmix_iof_channel_t channel, pmix_proc_t *source,
+                       pmix_byte_object_t *payload, pmix_info_t info[], size_t ninfo)
+{
+    uint64_t t = perf_now(), stamp;
+    char *line, *next, *end;
+    PMIX_HIDE_UNUSED_PARAMS(iofhdlr, channel, source, info, ninfo);
+
+    if (NULL == payload || NULL == current) {
+        return;
+    }
+    /* chunks may be coalesced on the way */
+    line = strndup(payload->bytes, payload->size);
+    for (next = line; '\0' != *next && current->n < expected;) {
+        stamp = strtoull(next, &end, 10);
+        if (end != next) {
+            record(current, stamp, t);
+        } else {
+            /* not a stamp - skip the rest of the line */
+            end = next + strcspn(next, "\n");
+        }
+        next = end;
+        while ('\n' == *next) {
+            ++next;
+        }
+    }
+    free(line);
+    if (current->n == expected) {
+        PMIX_WAKEUP_THREAD(&arrived);
+    }
+}
+
+static void regcbfunc(pmix_status_t status, size_t ref, void *cbdata)
+{
+    pmix_lock_t *lock = (pmix_lock_t *) cbdata;
+    PMIX_HIDE_UNUSED_PARAMS(ref);
+
+    lock->status = status;
+    PMIX_WAKEUP_THREAD(lock);
+}
+
+/* ask the server to send the stamped items and wait for them */
+static pmix_status_t phase(const char *name, series_t *s, int iters)
+{
+    pmix_info_t info;
+    pmix_status_t rc;
+
+    PMIX_CONSTRUCT_LOCK(&arrived);
+    expected = iters;
+    current = s;
+    PMIX_INFO_LOAD(&info, LOOPBACK_PHASE, name, PMIX_STRING);
+    rc = PMIx_Fence(NULL, 0, &info, 1);
+    PMIX_INFO_DESTRUCT(&info);
+    if (PMIX_SUCCESS == rc) {
+        PMIX_WAIT_THREAD(&arrived);
+    }
+    current = NULL;
+    PMIX_DESTRUCT_LOCK(&arrived);
+    return rc;
+}
+
+static int run_client(int iters, int timeout)
+{
+    series_t series[] = {{"put+commit", NULL, 0, 0, 0}, {"fence", NULL, 0, 0, 0},
+                         {"get-server", NULL, 0, 0, 0}, {"fence-data", NULL, 0, 0, 0},
+                         {"get-cached", NULL, 0, 0, 0}, {"event", NULL, 0, 0, 0},
+                         {"iof", NULL, 0, 0, 0}};
+    size_t nseries = sizeof(series) / sizeof(series[0]);
+    pmix_info_t info;
+    pmix_value_t val, *vp;
+    pmix_proc_t peer, wildcard;
+    pmix_lock_t lock;
+    pmix_status_t rc, code = LOOPBACK_EVENT;
+    uint32_t size;
+    uint64_t t;
+    char key[PMIX_MAX_KEYLEN], *ring;
+    bool flag = true;
+    size_t m;
+    int n, exit_code = 0;
+
+    /* don't outlive a server that has given up on us */
+    alarm(timeout);
+    if (PMIX_SUCCESS != (rc = PMIx_Init(&myproc, NULL, 0))) {
+        pmix_output(0, "PMIx_Init failed: %s", PMIx_Error_string(rc));
+        return rc;
+    }
+    for (m = 0; m < nseries; m++) {
+        series[m].lat = (uint64_t *) calloc(iters, sizeof(uint64_t));
+    }
+    if (NULL != (ring = getenv("LOOPBACK_RING"))
+        && (0 == strcmp(ring, "on")) != (NULL != pmix_client_globals.myserver->ring)) {
+        pmix_output(0, "loopback client %u: rings expected %s", myproc.rank, ring);
+        rc = PMIX_ERR_NOT_SUPPORTED;
+        goto done;
+    }
+    PMIX_LOAD_PROCID(&wildcard, myproc.nspace, PMIX_RANK_WILDCARD);
+    rc = PMIx_Get(&wildcard, PMIX_JOB_SIZE, NULL, 0, &vp);
+    if (PMIX_SUCCESS != rc) {
+        goto done;
+    }
+    size = vp->data.uint32;
+    PMIX_VALUE_RELEASE(vp);
+    PMIX_LOAD_PROCID(&peer, myproc.nspace, (myproc.rank + 1) % size);
+
+    for (n = 0; n < iters; n++) {
+        snprintf(key, sizeof(key), "loopback.%d", n);
+        val.type = PMIX_UINT64;
+        val.data.uint64 = n;
+        t = perf_now();
+        if (PMIX_SUCCESS != (rc = PMIx_Put(PMIX_GLOBAL, key, &val))
+            || PMIX_SUCCESS != (rc = PMIx_Commit())) {
+            goto done;
+        }
+        record(&series[0], t, perf_now());
+    }
+
+    for (n = 0; n < iters; n++) {
+        t = perf_now();
+        if (PMIX_SUCCESS != (rc = PMIx_Fence(NULL, 0, NULL, 0))) {
+            goto done;
+        }
+        record(&series[1], t, perf_now());
+    }
+
+    /* without collected data a get for a key we have not seen goes
+     * to the server - the reply brings everything the peer has
+     * posted, so post a new key before each one */
+    for (n = 0; n < iters; n++) {
+        snprintf(key, sizeof(key), "loopback.get.%d", n);
+        val.type = PMIX_UINT64;
+        val.data.uint64 = n;
+        if (PMIX_SUCCESS != (rc = PMIx_Put(PMIX_GLOBAL, key, &val))
+            || PMIX_SUCCESS != (rc = PMIx_Commit())
+            || PMIX_SUCCESS != (rc = PMIx_Fence(NULL, 0, NULL, 0))) {
+            goto done;
+        }
+        t = perf_now();
+        if (PMIX_SUCCESS != (rc = PMIx_Get(&peer, key, NULL, 0, &vp))) {
+            goto done;
+        }
+        record(&series[2], t, perf_now());
+        PMIX_VALUE_RELEASE(vp);
+    }
+
+    PMIX_INFO_LOAD(&info, PMIX_COLLECT_DATA, &flag, PMIX_BOOL);
+    for (n = 0; n < iters; n++) {
+        t = perf_now();
+        if (PMIX_SUCCESS != (rc = PMIx_Fence(NULL, 0, &info, 1))) {
+            goto done;
+        }
+        record(&series[3], t, perf_now());
+    }
+    PMIX_INFO_DESTRUCT(&info);
+
+    for (n = 0; n < iters; n++) {
+        snprintf(key, sizeof(key), "loopback.%d", n);
+        t = perf_now();
+        if (PMIX_SUCCESS != (rc = PMIx_Get(&peer, key, NULL, 0, &vp))) {
+            goto done;
+        }
+        record(&series[4], t, perf_now());
+        PMIX_VALUE_RELEASE(vp);
+    }
+
+    PMIX_CONSTRUCT_LOCK(&lock);
+    rc = PMIx_Register_event_handler(&code, 1, NULL, 0, evhandler, regcbfunc, &lock);
+    if (PMIX_SUCCESS == rc) {
+        PMIX_WAIT_THREAD(&lock);
+        rc = lock.status;
+    }
+    PMIX_DESTRUCT_LOCK(&lock);
+    if (PMIX_SUCCESS != rc || PMIX_SUCCESS != (rc = phase("event", &series[5], iters))) {
+        goto done;
+    }
+
+    PMIX_CONSTRUCT_LOCK(&lock);
+    rc = PMIx_IOF_pull(&wildcard, 1, NULL, 0, PMIX_FWD_STDOUT_CHANNEL, iofhandler, regcbfunc,
+                       &lock);
+    if (PMIX_SUCCESS == rc) {
+        PMIX_WAIT_THREAD(&lock);
+        rc = lock.status;
+    }
+    PMIX_DESTRUCT_LOCK(&lock);
+    if (PMIX_SUCCESS != rc || PMIX_SUCCESS != (rc = phase("iof", &series[6], iters))) {
+        goto done;
+    }
+
+    if (0 == myproc.rank) {
+        fprintf(stdout, "%d clients  %d iterations  latencies in usec\n", size, iters);
+        fprintf(stdout, "%-12s %8s %12s %9s %9s %9s %9s\n", "operation", "count", "ops/sec",
+                "p50", "p90", "p99", "max");
+    }
+    for (m = 0; m < nseries; m++) {
+        report(&series[m]);
+    }
+
+done:
+    if (PMIX_SUCCESS != rc) {
+        pmix_output(0, "loopback client %u failed: %s", myproc.rank, PMIx_Error_string(rc));
+        exit_code = 1;
+    }
+    for (m = 0; m < nseries; m++) {
+        free(series[m].lat);
+    }
+    PMIx_Finalize(NULL, 0);
+    return exit_code;
+}
+
+int main(int argc, char **argv)
+{
+    int nprocs = 4, iters = 1000, timeout = 300;
+
+    if (1 < argc) {
+        nprocs = strtol(argv[1], NULL, 10);
+    }
+    if (2 < argc) {
+        iters = strtol(argv[2], NULL, 10);
+    }
+    if (NULL != getenv("LOOPBACK_TIMEOUT")) {
+        timeout = strtol(getenv("LOOPBACK_TIMEOUT"), NULL, 10);
+    }
+    if (NULL != getenv("PMIX_NAMESPACE")) {
+        return run_client(iters, timeout);
+    }
+    return run_server(argv[0], nprocs, iters, timeout);
+}
@@ -0,0 +1,33 @@
+#!/bin/sh
+#
+# Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+# $COPYRIGHT$
+#
+# Additional copyrights may follow
+#
+# $HEADER$
+#
+# Run the loopback server and clients with the shared-memory
+# rings enabled, disabled, and requested by clients of a server
+# that does not offer them - the clients must complete their
+# handshake and run over the socket in the last two cases
+
+nclients=2
+iters=100
+
+unset PMIX_PTL_RING_SIZE
+
+echo "rings on"
+PMIX_MCA_ptl_base_ring_size=65536 LOOPBACK_RING=on \
+    ./loopback $nclients $iters || exit 1
+
+echo "rings off"
+PMIX_MCA_ptl_base_ring_size=0 LOOPBACK_RING=off \
+    ./loopback $nclients $iters || exit 1
+
+# the clients inherit the request from our environment
+echo "rings requested but not offered"
+PMIX_PTL_RING_SIZE=65536 PMIX_MCA_ptl_base_ring_size=0 LOOPBACK_RING=off \
+    ./loopback $nclients $iters || exit 1
+
+exit 0
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "perf_common.h"
+
+#include "include/pmix.h"
+#include "src/util/pmix_output.h"
+
+static pmix_server_module_t empty_module = {0};
+
+double perf_elapsed(struct timespec *start, struct timespec *end)
+{
+    return (double) (end->tv_sec - start->tv_sec) * 1.0e9
+           + (double) (end->tv_nsec - start->tv_nsec);
+}
+
+uint64_t perf_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+pmix_status_t perf_server_init(pmix_server_module_t *module)
+{
+    pmix_status_t rc;
+
+    if (NULL == module) {
+        module = &empty_module;
+    }
+    rc = PMIx_server_init(module, NULL, 0);
+    if (PMIX_SUCCESS != rc) {
+        pmix_output(0, "PMIx_server_init failed: %s", PMIx_Error_string(rc));
+    }
+    return rc;
+}
+
+void perf_server_finalize(void)
+{
+    (void) PMIx_server_finalize();
+}
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Support shared by the microbenchmarks
+ */
+
+#ifndef PERF_COMMON_H
+#define PERF_COMMON_H
+
+#include "src/include/pmix_config.h"
+#include "include/pmix_server.h"
+
+#include <stdint.h>
+#include <time.h>
+
+/* nanoseconds between two CLOCK_MONOTONIC readings */
+double perf_elapsed(struct timespec *start, struct timespec *end);
+
+/* CLOCK_MONOTONIC in nanoseconds - the clock is shared by
+ * every process on the node, so stamps can be compared
+ * across processes */
+uint64_t perf_now(void);
+
+/* start the library as a server so the benchmark can reach the
+ * internal code paths. A NULL module selects an empty host
+ * module. Any error is reported before it is returned */
+pmix_status_t perf_server_init(pmix_server_module_t *module);
+
+void perf_server_finalize(void);
+
+#endif // PERF_COMMON_H
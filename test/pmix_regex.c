@@ -27,8 +27,10 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 
+#include "src/mca/preg/base/base.h"
 #include "src/mca/preg/preg.h"
 #include "src/server/pmix_server_ops.h"
 #include "src/util/pmix_argv.h"
@@ -41,14 +43,122 @@
 #define TEST_NODES  "odin001,odin002,odin003,odin010,odin011,odin075"
 #define TEST_PROCS  "1,2,3,4;5-8;9,11-12;17-20;21-24;100"
 #define TEST_NODES2 "c712f6n01,c712f6n02,c712f6n03"
+/* a mix of numbered, suffixed and uncompressible names, and
+ * of single ranks and ranges spread across the nodes */
+#define TEST_NODES3 "node01,node02,node03,node10,login-a,gpu001x,gpu002x,gpu003x,c712f6n01"
+#define TEST_PROCS3 "0,1,2,3;4,5,6,7;8,9;10,11,20;12;13,14,15;16;17,18,19;21"
+/* the ranks of TEST_PROCS listed one by one, as a host would give
+ * them - only then is the regex shorter than the list */
+#define TEST_PROCS4 "1,2,3,4;5,6,7,8;9,11,12;17,18,19,20;21,22,23,24;100"
 
 bool spawn_wait = false;
 
+/* decode a node and proc list with the compiled map and check
+ * every lookup against the full expansion of the same regexes */
+static int check_map(const char *nodelist, const char *proclist)
+{
+    char *nregex = NULL, *pregex = NULL, **nodes = NULL, **procs = NULL;
+    char *host, *peers, **ranks;
+    pmix_preg_map_t *map = NULL;
+    uint32_t nodeid, nlocal;
+    uint16_t lrank;
+    pmix_rank_t leader, rank;
+    int n, m, errors = 0;
+
+    PMIx_generate_regex(nodelist, &nregex);
+    PMIx_generate_ppn(proclist, &pregex);
+    if (PMIX_SUCCESS != pmix_preg.compile_map(nregex, pregex, &map)
+        || PMIX_SUCCESS != pmix_preg.parse_nodes(nregex, &nodes)
+        || PMIX_SUCCESS != pmix_preg.parse_procs(pregex, &procs)) {
+        fprintf(stderr, "MAP: failed to decode %s / %s\n", nregex, pregex);
+        errors = 1;
+        goto done;
+    }
+    if (map->nnodes != (uint32_t) PMIx_Argv_count(nodes)
+        || PMIx_Argv_count(nodes) != PMIx_Argv_count(procs)) {
+        fprintf(stderr, "MAP: %u nodes in map, %d nodes and %d proc lists expanded\n",
+                map->nnodes, PMIx_Argv_count(nodes), PMIx_Argv_count(procs));
+        errors = 1;
+        goto done;
+    }
+
+    for (n = 0; NULL != nodes[n]; n++) {
+        if (PMIX_SUCCESS != pmix_preg_base_map_hostname(map, n, &host)
+            || 0 != strcmp(host, nodes[n])) {
+            fprintf(stderr, "MAP: node %d is %s, expected %s\n", n, host, nodes[n]);
+            ++errors;
+        }
+        free(host);
+        peers = NULL;
+        if (PMIX_SUCCESS != pmix_preg_base_map_local_peers(map, n, &peers)
+            || 0 != strcmp(peers, procs[n])) {
+            fprintf(stderr, "MAP: node %d hosts %s, expected %s\n", n, peers, procs[n]);
+            ++errors;
+        }
+        free(peers);
+
+        ranks = PMIx_Argv_split(procs[n], ',');
+        if (PMIX_SUCCESS != pmix_preg_base_map_local_procs(map, n, &nlocal, &leader)
+            || nlocal != (uint32_t) PMIx_Argv_count(ranks)
+            || (0 < nlocal && leader != strtoul(ranks[0], NULL, 10))) {
+            fprintf(stderr, "MAP: node %d has %u procs led by %u, expected %s\n", n, nlocal,
+                    leader, procs[n]);
+            ++errors;
+        }
+        for (m = 0; NULL != ranks && NULL != ranks[m]; m++) {
+            rank = strtoul(ranks[m], NULL, 10);
+            if (PMIX_SUCCESS != pmix_preg_base_map_locate(map, rank, &nodeid, &lrank)
+                || nodeid != (uint32_t) n || lrank != m) {
+                fprintf(stderr, "MAP: rank %u located on node %u as local rank %u,"
+                        " expected node %d local rank %d\n", rank, nodeid, lrank, n, m);
+                ++errors;
+            }
+        }
+        PMIx_Argv_free(ranks);
+    }
+
+done:
+    fprintf(stderr, "MAP: %s / %s %s\n", nregex, pregex, (0 == errors) ? "matches" : "MISMATCH");
+    free(nregex);
+    free(pregex);
+    PMIx_Argv_free(nodes);
+    PMIx_Argv_free(procs);
+    if (NULL != map) {
+        PMIX_RELEASE(map);
+    }
+    return errors;
+}
+
+/* many non-contiguous nodes, each holding two ranks from
+ * opposite ends of the job, to exercise a map with many
+ * node and proc ranges */
+static int check_large_map(int nnodes)
+{
+    char **nodes = NULL, **procs = NULL, tmp[64], *nodelist, *proclist;
+    int n, errors;
+
+    for (n = 0; n < nnodes; n++) {
+        snprintf(tmp, sizeof(tmp), "n%04d", 2 * n + 1);
+        PMIx_Argv_append_nosize(&nodes, tmp);
+        snprintf(tmp, sizeof(tmp), "%d,%d", n, n + nnodes);
+        PMIx_Argv_append_nosize(&procs, tmp);
+    }
+    nodelist = PMIx_Argv_join(nodes, ',');
+    proclist = PMIx_Argv_join(procs, ';');
+    PMIx_Argv_free(nodes);
+    PMIx_Argv_free(procs);
+    errors = check_map(nodelist, proclist);
+    free(nodelist);
+    free(proclist);
+    return errors;
+}
+
 int main(int argc, char **argv)
 {
     char *regex;
     char **nodes, **procs;
     pmix_status_t rc;
+    int errors = 0;
 
     PMIX_HIDE_UNUSED_PARAMS(argc, argv);
 
@@ -111,5 +221,14 @@ int main(int argc, char **argv)
     } else {
         fprintf(stderr, "Node reverse failed: %d\n\n\n", rc);
     }
-    return 0;
+
+    /* the compiled map must agree with the full expansion - the
+     * short lists stay raw as the regex would be longer */
+    errors += check_map(TEST_NODES, TEST_PROCS4);
+    errors += check_map(TEST_NODES2, "0,1;2,5;3,4");
+    errors += check_map(TEST_NODES3, TEST_PROCS3);
+    errors += check_large_map(500);
+
+    PMIx_server_finalize();
+    return (0 == errors) ? 0 : 1;
 }
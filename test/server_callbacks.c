@@ -157,6 +157,108 @@ pmix_status_t dmodex_fn(const pmix_proc_t *proc, const pmix_info_t info[], size_
     return server_dmdx_get(proc->nspace, proc->rank, cbfunc, cbdata);
 }
 
+/* the test servers track only one outstanding direct modex request
+ * per remote server, so batches are queued and the procs of the
+ * active batch are requested one after another */
+typedef struct dmdx_batch {
+    struct dmdx_batch *next_batch;
+    const pmix_proc_t *procs;
+    size_t nprocs;
+    size_t next;
+    pmix_dmodex_batch_cbfunc_t cbfunc;
+    void *cbdata;
+} dmdx_batch_t;
+
+static pthread_mutex_t dmdx_lock = PTHREAD_MUTEX_INITIALIZER;
+static dmdx_batch_t *dmdx_head = NULL, *dmdx_tail = NULL;
+
+static void dmdx_batch_request(dmdx_batch_t *batch);
+
+static void dmdx_batch_cbfunc(pmix_status_t status, const char *data, size_t ndata, void *cbdata,
+                              pmix_release_cbfunc_t release_fn, void *release_cbdata)
+{
+    dmdx_batch_t *batch = (dmdx_batch_t *) cbdata, *start = NULL;
+    const pmix_proc_t *proc = &batch->procs[batch->next];
+    bool done;
+
+    ++batch->next;
+    done = (batch->next == batch->nprocs);
+    if (done) {
+        pthread_mutex_lock(&dmdx_lock);
+        dmdx_head = batch->next_batch;
+        if (NULL == dmdx_head) {
+            dmdx_tail = NULL;
+        }
+        start = dmdx_head;
+        pthread_mutex_unlock(&dmdx_lock);
+    }
+    /* the procs array is only guaranteed until the last callback */
+    batch->cbfunc(status, proc, data, ndata, batch->cbdata, release_fn, release_cbdata);
+    if (!done) {
+        dmdx_batch_request(batch);
+        return;
+    }
+    free(batch);
+    if (NULL != start) {
+        dmdx_batch_request(start);
+    }
+}
+
+static void dmdx_batch_request(dmdx_batch_t *batch)
+{
+    /* any error is reported through the callback */
+    (void) server_dmdx_get(batch->procs[batch->next].nspace, batch->procs[batch->next].rank,
+                           dmdx_batch_cbfunc, batch);
+}
+
+pmix_status_t dmodex_batch_fn(const pmix_proc_t procs[], size_t nprocs, const pmix_info_t info[],
+                              size_t ninfo, pmix_dmodex_batch_cbfunc_t cbfunc, void *cbdata)
+{
+    dmdx_batch_t *batch;
+    bool start;
+    size_t n;
+
+    TEST_VERBOSE(("Getting data for %lu procs of %s", (unsigned long) nprocs, procs[0].nspace));
+
+    if (NULL != info) {
+        for (n = 0; n < ninfo; n++) {
+            if (PMIX_CHECK_KEY(&info[n], PMIX_TIMEOUT)) {
+                return PMIX_ERR_NOT_SUPPORTED;
+            }
+        }
+    }
+
+    /* decline in single server mode - the procs are then
+     * requested individually */
+    if ((pmix_list_get_size(server_list) == 1) && (my_server_id == 0)) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+
+    batch = (dmdx_batch_t *) calloc(1, sizeof(dmdx_batch_t));
+    if (NULL == batch) {
+        return PMIX_ERR_NOMEM;
+    }
+    batch->procs = procs;
+    batch->nprocs = nprocs;
+    batch->cbfunc = cbfunc;
+    batch->cbdata = cbdata;
+
+    pthread_mutex_lock(&dmdx_lock);
+    start = (NULL == dmdx_head);
+    if (start) {
+        dmdx_head = batch;
+    } else {
+        dmdx_tail->next_batch = batch;
+    }
+    dmdx_tail = batch;
+    pthread_mutex_unlock(&dmdx_lock);
+
+    if (start) {
+        dmdx_batch_request(batch);
+    }
+    return PMIX_SUCCESS;
+}
+
 pmix_status_t publish_fn(const pmix_proc_t *proc, const pmix_info_t info[], size_t ninfo,
                          pmix_op_cbfunc_t cbfunc, void *cbdata)
 {
@@ -27,6 +27,8 @@ pmix_status_t fencenb_fn(const pmix_proc_t procs[], size_t nprocs, const pmix_in
                          void *cbdata);
 pmix_status_t dmodex_fn(const pmix_proc_t *proc, const pmix_info_t info[], size_t ninfo,
                         pmix_modex_cbfunc_t cbfunc, void *cbdata);
+pmix_status_t dmodex_batch_fn(const pmix_proc_t procs[], size_t nprocs, const pmix_info_t info[],
+                              size_t ninfo, pmix_dmodex_batch_cbfunc_t cbfunc, void *cbdata);
 pmix_status_t publish_fn(const pmix_proc_t *proc, const pmix_info_t info[], size_t ninfo,
                          pmix_op_cbfunc_t cbfunc, void *cbdata);
 pmix_status_t lookup_fn(const pmix_proc_t *proc, char **keys, const pmix_info_t info[],
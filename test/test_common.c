@@ -94,6 +94,7 @@ void parse_cmd(int argc, char **argv, test_params *params)
                     "\t--test-internal N  test store internal key, N - number of internal keys\n");
             fprintf(stderr, "\t--gds <external gds name>           set GDS module \"--gds "
                             "hash|ds12\", default is hash\n");
+            fprintf(stderr, "\t--dmodex-batch    servers answer direct modex requests in batches\n");
             exit(0);
         } else if (0 == strcmp(argv[i], "--exec") || 0 == strcmp(argv[i], "-e")) {
             i++;
@@ -214,6 +215,8 @@ void parse_cmd(int argc, char **argv, test_params *params)
             } else {
                 params->test_internal = 1;
             }
+        } else if (0 == strcmp(argv[i], "--dmodex-batch")) {
+            params->dmodex_batch = 1;
         } else if (0 == strcmp(argv[i], "--gds")) {
             i++;
             params->gds_mode = strdup(argv[i]);
@@ -143,6 +143,7 @@ typedef struct {
     int test_internal;
     char *gds_mode;
     int nservers;
+    int dmodex_batch;
     uint32_t lsize;
 } test_params;
 
@@ -157,6 +158,7 @@ typedef struct {
         params.ns_id = -1;                     \
         params.timeout = TEST_DEFAULT_TIMEOUT; \
         params.test_job_fence = 0;             \
+        params.dmodex_batch = 0;               \
         params.use_same_keys = 0;              \
         params.collect = 0;                    \
         params.collect_bad = 0;                \
@@ -919,6 +919,9 @@ int server_init(test_params *params)
 
     server_nspace = PMIX_NEW(pmix_list_t);
 
+    if (params->dmodex_batch) {
+        mymodule.direct_modex_batch = dmodex_batch_fn;
+    }
     if (PMIX_SUCCESS != (rc = PMIx_server_init(&mymodule, info, 2))) {
         TEST_ERROR(("Init failed with error %d", rc));
         goto error;